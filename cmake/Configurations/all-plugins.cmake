@@ -92,6 +92,7 @@ else()
 
 
   score-plugin-avnd
+  score-plugin-fx
   score-plugin-jit
   score-plugin-spline3d
   score-plugin-vst
@@ -101,7 +102,6 @@ else()
   score-plugin-faust
   score-plugin-pd
   score-plugin-ysfx
-  score-plugin-fx
   score-plugin-ui
   score-plugin-analysis
   score-plugin-threedim
@@ -13,6 +13,7 @@
 
 #include <score_git_info.hpp>
 
+#include <algorithm>
 #include <thread>
 namespace score
 {
@@ -86,6 +87,28 @@ void ApplicationSettings::parse(QStringList cargs, int& argc, char** argv)
       "file", "");
   parser.addOption(uiOptDebug);
 
+  QCommandLineOption bounceOpt(
+      "bounce",
+      QCoreApplication::translate(
+          "main",
+          "Render the loaded scenario offline to an audio file (.wav, .flac), then exit. "
+          "Video file outputs are rendered along, one frame per period of score time."),
+      "file", "");
+  parser.addOption(bounceOpt);
+
+  QCommandLineOption bounceStemsOpt(
+      "bounce-stems",
+      QCoreApplication::translate(
+          "main", "When bouncing, also render one file per audio output bus."));
+  parser.addOption(bounceStemsOpt);
+
+  QCommandLineOption bounceTailOpt(
+      "bounce-tail",
+      QCoreApplication::translate(
+          "main", "When bouncing, keep rendering N seconds after the end."),
+      "N", "0");
+  parser.addOption(bounceTailOpt);
+
 #if defined(__APPLE__)
   // Bogus macOS gatekeeper BS:
   // https://stackoverflow.com/questions/55562155/qt-application-for-mac-not-being-launched
@@ -166,6 +189,14 @@ void ApplicationSettings::parse(QStringList cargs, int& argc, char** argv)
   if(parser.isSet(waitLoadOpt))
     waitAfterLoad = parser.value(waitLoadOpt).toInt();
 
+  if(parser.isSet(bounceOpt))
+  {
+    bounce = QFileInfo{parser.value(bounceOpt)}.absoluteFilePath();
+    bounceStems = parser.isSet(bounceStemsOpt);
+    bounceTail = std::max(0., parser.value(bounceTailOpt).toDouble());
+    tryToRestore = false;
+  }
+
   if(!args.empty() && QFile::exists(args[0]))
   {
     loadList.push_back(args[0]);
@@ -45,6 +45,15 @@ struct SCORE_LIB_BASE_EXPORT ApplicationSettings
   //! Seconds to wait before playing
   int waitAfterLoad = 0;
 
+  //! If set, the loaded scenario is rendered offline to this audio file, then score exits
+  QString bounce;
+
+  //! Also render one file per audio output bus when bouncing
+  bool bounceStems = false;
+
+  //! Seconds rendered after the end of the scenario when bouncing
+  double bounceTail = 0.;
+
   //! Complete list of arguments passed to parse
   QStringList arguments;
 
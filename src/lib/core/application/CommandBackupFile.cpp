@@ -8,48 +8,55 @@
 
 #include <core/command/CommandStack.hpp>
 
+#include <QDataStream>
+
+#include <algorithm>
+
 namespace score
 {
-CommandStackBackup::CommandStackBackup(const CommandStack& stack)
+namespace
 {
-  // Load initial state
-  for(const auto& cmd : stack.m_undoable)
-  {
-    savedUndo.push(CommandData{*cmd});
-  }
-  for(const auto& cmd : stack.m_redoable)
-  {
-    savedRedo.push(CommandData{*cmd});
-  }
+// "SCOREJNL"
+constexpr quint64 journal_magic = 0x53434F52454A4E4CULL;
+constexpr quint32 journal_version = 1;
+
+// Below this count of records we never compact, to not rewrite small
+// stacks on every command.
+constexpr int journal_min_records = 256;
+
+bool isJournal(const QByteArray& data)
+{
+  QDataStream s{data};
+  quint64 magic{};
+  s >> magic;
+  return s.status() == QDataStream::Ok && magic == journal_magic;
+}
 }
 
 CommandBackupFile::CommandBackupFile(const score::CommandStack& stack, QObject* parent)
     : QObject{parent}
     , m_stack{stack}
-    , m_backup{m_stack}
 {
   init_connections();
 
   m_file.open();
 
   // Initial backup so that the file is always in a loadable state.
-  commit();
+  compact();
 }
 
 CommandBackupFile::CommandBackupFile(
     const CommandStack& stack, const QByteArray& restored, QObject* parent)
     : QObject{parent}
     , m_stack{stack}
-    , m_backup{m_stack}
 {
   init_connections();
 
   m_file.open();
 
-  m_file.resize(0);
-  m_file.reset();
-  m_file.write(restored);
-  m_file.flush();
+  // The stack is only replayed later: until then, keep the restored data
+  // so that another crash restores the same thing.
+  writeCheckpoint(toCommandStack(restored));
 }
 
 QString CommandBackupFile::fileName() const
@@ -57,92 +64,146 @@ QString CommandBackupFile::fileName() const
   return m_file.fileName();
 }
 
+void CommandBackupFile::restored()
+{
+  // The replay stops at the first command which fails:
+  // the next records must apply to what actually is on the stack.
+  compact();
+}
+
 void CommandBackupFile::init_connections()
 {
   // Set-up signals
+  // Note: setIndex emits sig_undo / sig_redo for each step, thus
+  // sig_indexChanged does not need to be tracked.
   con(m_stack, &CommandStack::sig_push, this, &CommandBackupFile::on_push);
   con(m_stack, &CommandStack::sig_undo, this, &CommandBackupFile::on_undo);
   con(m_stack, &CommandStack::sig_redo, this, &CommandBackupFile::on_redo);
-  con(m_stack, &CommandStack::sig_indexChanged, this,
-      &CommandBackupFile::on_indexChanged);
 }
 
 void CommandBackupFile::on_push()
 {
-  /*
-  // A new command is added to m_undoable
-  // m_redoable should be cleared
-  auto cmd = m_stack.m_undoable.last();
-  m_backup.savedUndo.push(CommandData{*cmd});
-
-  m_backup.savedRedo.clear();
-
-  m_previousIndex = m_stack.currentIndex();
-  */
-  commit();
+  // A new command is added to m_undoable, m_redoable is cleared
+  QByteArray cmd;
+  DataStream::Serializer ser(&cmd);
+  ser.readFrom(CommandData{*m_stack.m_undoable.top()});
+  append(Push, cmd);
 }
 
 void CommandBackupFile::on_undo()
 {
-  /*
   // Pop from undoable to redoable
-  m_backup.savedRedo.push(m_savedUndo.pop());
-
-  m_previousIndex = m_stack.currentIndex();
-  */
-  commit();
+  append(Undo, {});
 }
 
 void CommandBackupFile::on_redo()
 {
-  /*
   // Pop from redoable to undoable
-  m_backup.savedUndo.push(m_savedRedo.pop());
-
-  m_previousIndex = m_stack.currentIndex();
-  */
-  commit();
+  append(Redo, {});
 }
 
-void CommandBackupFile::on_indexChanged()
+void CommandBackupFile::compact()
 {
-  /*
-  // Pop a lot
-  auto index = m_stack.currentIndex();
-  if(index > m_previousIndex)
-  {
-      for(int i = 0; i < index - m_previousIndex; i++)
-      {
-          m_backup.savedUndo.push(m_savedRedo.pop());
-      }
-  }
-  else if(index < m_previousIndex)
-  {
-      for(int i = 0; i < m_previousIndex - index ; i++)
-      {
-          m_backup.savedRedo.push(m_savedUndo.pop());
-      }
-  }
+  QByteArray stack;
+  DataStream::Serializer ser(&stack);
+  ser.readFrom(m_stack);
 
-  m_previousIndex = m_stack.currentIndex();
-  */
-  commit();
+  writeCheckpoint(stack);
 }
 
-void CommandBackupFile::commit()
+void CommandBackupFile::writeCheckpoint(const QByteArray& stack)
 {
-  // OPTIMIZEME: right now all the data is flushed each time.
-  // It should be better to only incrementally modify the file.
-  // See :
-  // http://www.boost.org/doc/libs/1_59_0/doc/html/interprocess/sharedmemorybetweenprocesses.html#interprocess.sharedmemorybetweenprocesses.mapped_file
-
-  // Another possibility would be to save the commands to a db ?
   m_file.resize(0);
   m_file.reset();
 
-  DataStream::Serializer ser(&m_file);
-  ser.readFrom(m_stack);
+  QDataStream s{&m_file};
+  s << journal_magic << journal_version;
+  s << quint8(Checkpoint) << stack;
 
   m_file.flush();
+  m_records = 0;
+}
+
+void CommandBackupFile::append(RecordType t, const QByteArray& payload)
+{
+  if(++m_records > std::max(journal_min_records, m_stack.size()))
+  {
+    compact();
+    return;
+  }
+
+  m_file.seek(m_file.size());
+
+  QDataStream s{&m_file};
+  s << quint8(t) << payload;
+
+  m_file.flush();
+}
+
+QByteArray CommandBackupFile::toCommandStack(const QByteArray& journal)
+{
+  if(!isJournal(journal))
+    return journal;
+
+  QDataStream s{journal};
+  quint64 magic{};
+  quint32 version{};
+  s >> magic >> version;
+  if(version > journal_version)
+    return {};
+
+  std::vector<score::CommandData> undoStack, redoStack;
+  for(;;)
+  {
+    quint8 type{};
+    QByteArray payload;
+    s >> type >> payload;
+
+    // End of file, or last record only partially written
+    if(s.status() != QDataStream::Ok)
+      break;
+
+    switch(type)
+    {
+      case Checkpoint: {
+        undoStack.clear();
+        redoStack.clear();
+        DataStream::Deserializer writer{payload};
+        writer.writeTo(undoStack);
+        writer.writeTo(redoStack);
+        writer.checkDelimiter();
+        break;
+      }
+      case Push: {
+        DataStream::Deserializer writer{payload};
+        writer.writeTo(undoStack.emplace_back());
+        redoStack.clear();
+        break;
+      }
+      case Undo:
+        if(!undoStack.empty())
+        {
+          redoStack.push_back(std::move(undoStack.back()));
+          undoStack.pop_back();
+        }
+        break;
+      case Redo:
+        if(!redoStack.empty())
+        {
+          undoStack.push_back(std::move(redoStack.back()));
+          redoStack.pop_back();
+        }
+        break;
+      default:
+        break;
+    }
+  }
+
+  QByteArray res;
+  DataStream::Serializer ser(&res);
+  ser.readFrom(undoStack);
+  ser.readFrom(redoStack);
+  ser.insertDelimiter();
+  return res;
 }
 }
@@ -3,55 +3,73 @@
 #include <score/command/CommandData.hpp>
 
 #include <QObject>
-#include <QStack>
 #include <QString>
 #include <QTemporaryFile>
 
+#include <score_lib_base_export.h>
+
 namespace score
 {
 class CommandStack;
-/**
- * @brief Serialized command stack data for backup / restore
- */
-struct CommandStackBackup
-{
-  CommandStackBackup(const score::CommandStack& stack);
-
-  QStack<CommandData> savedUndo;
-  QStack<CommandData> savedRedo;
-};
 
 /**
  * @brief Abstraction over the backup of commands
  *
  * Synchronizes the commands of a document to an on-disk file,
- * by maintaining serialized stacks of commands at each new command.
+ * by appending a record to a journal at each new command, undo or redo.
  *
  * This way, if there is a crash, the document can be restored from the
  * last successful command and only the latest user action is lost.
+ *
+ * The journal starts with a checkpoint of the whole command stack, and is
+ * compacted into a new checkpoint once it contains more records than
+ * commands in the stack, so that each operation costs O(1) I/O on average.
  */
-class CommandBackupFile final : public QObject
+class SCORE_LIB_BASE_EXPORT CommandBackupFile final : public QObject
 {
 public:
   CommandBackupFile(const score::CommandStack& stack, QObject* parent);
+
+  //! restored is command stack data as returned by toCommandStack
   CommandBackupFile(
       const score::CommandStack& stack, const QByteArray& restored, QObject* parent);
   QString fileName() const;
 
+  //! To call once the restored commands have been replayed on the stack.
+  void restored();
+
+  /**
+   * @brief Replays a journal.
+   *
+   * Returns the command stack in the format expected by loadCommandStack.
+   * Data which is not a journal (backups from older versions) is returned
+   * as-is; a truncated last record is ignored.
+   */
+  static QByteArray toCommandStack(const QByteArray& journal);
+
 private:
+  enum RecordType : quint8
+  {
+    Checkpoint = 0,
+    Push,
+    Undo,
+    Redo
+  };
+
   void init_connections();
 
   void on_push();
   void on_undo();
   void on_redo();
-  void on_indexChanged();
 
-  //! Writes the current buffers to disk.
-  void commit();
+  //! Rewrites the file with a single checkpoint of the current stack.
+  void compact();
+  void writeCheckpoint(const QByteArray& stack);
+  void append(RecordType t, const QByteArray& payload);
 
   const score::CommandStack& m_stack;
-  CommandStackBackup m_backup;
 
   QTemporaryFile m_file;
+  int m_records{};
 };
 }
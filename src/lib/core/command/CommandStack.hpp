@@ -28,7 +28,6 @@ class SCORE_LIB_BASE_EXPORT CommandStack final : public QObject
   W_OBJECT(CommandStack)
 
   friend class CommandBackupFile;
-  friend struct CommandStackBackup;
 
 public:
   explicit CommandStack(const score::Document& ctx, QObject* parent = nullptr);
@@ -59,6 +59,11 @@ DocumentBackupManager::~DocumentBackupManager()
 #endif
 }
 
+void DocumentBackupManager::commandsRestored()
+{
+  m_commandFile->restored();
+}
+
 QTemporaryFile& DocumentBackupManager::crashDataFile()
 {
   return m_modelFile;
@@ -50,6 +50,9 @@ public:
 
   void updateBackupData();
 
+  //! Called once the commands of a restored document have been replayed
+  void commandsRestored();
+
 private:
   QTemporaryFile& crashDataFile();
   CommandBackupFile& crashCommandFile();
@@ -5,6 +5,7 @@
 #include <score/tools/QMapHelper.hpp>
 #include <score/widgets/MessageBox.hpp>
 
+#include <core/application/CommandBackupFile.hpp>
 #include <core/application/OpenDocumentsFile.hpp>
 
 #include <ossia/detail/algorithms.hpp>
@@ -61,7 +62,7 @@ static void loadRestorableDocumentData(
     {
       arr.push_back(
           {save_filename, data_filename, command_filename, data_file.readAll(),
-           command_file.readAll()});
+           score::CommandBackupFile::toCommandStack(command_file.readAll())});
     }
     else
     {
@@ -75,7 +76,7 @@ static void loadRestorableDocumentData(
         it->docPath = data_filename;
         it->commandsPath = command_filename;
         it->doc = data_file.readAll();
-        it->commandsPath = command_file.readAll();
+        it->commands = score::CommandBackupFile::toCommandStack(command_file.readAll());
       }
     }
   }
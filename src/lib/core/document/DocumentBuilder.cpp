@@ -203,6 +203,8 @@ Document* DocumentBuilder::restoreDocument(
           return false;
         }
       });
+      if(auto backup = doc->backupManager())
+        backup->commandsRestored();
       doc->m_loaded = true;
     }, Qt::QueuedConnection);
 
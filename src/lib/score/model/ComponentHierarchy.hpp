@@ -206,6 +206,16 @@ public:
 
     child_models.removing.template connect<&hierarchy_t::remove>(this);
   }
+
+  //! Inverse of init_hierarchy: the component stays but has no children anymore
+  void clear_hierarchy()
+  {
+    auto& child_models = ParentComponent_T::template models<ChildModel_T>();
+    child_models.mutable_added.template disconnect<&hierarchy_t::add>(this);
+    child_models.removing.template disconnect<&hierarchy_t::remove>(this);
+
+    clear();
+  }
   const auto& children() const { return m_children; }
 
   void add(ChildModel_T& element)
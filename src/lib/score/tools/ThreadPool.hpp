@@ -42,6 +42,20 @@ public:
     m_queue.enqueue(std::forward<F>(func));
   }
 
+  //! A producer keeps the slots it used once, so that it can post
+  //! again without allocating: create it outside of the realtime thread.
+  using Producer = moodycamel::ProducerToken;
+  std::shared_ptr<Producer> producer() { return std::make_shared<Producer>(m_queue); }
+
+  //! Only allocates when all the slots of the producer are in use
+  template <typename F>
+  void post(Producer& producer, F&& func)
+  {
+    task t{std::forward<F>(func)};
+    if(!m_queue.try_enqueue(producer, std::move(t)))
+      m_queue.enqueue(producer, std::move(t));
+  }
+
 private:
   using task = smallfun::function<
       void(),
@@ -52,7 +66,7 @@ private:
 #endif
       std::max((int)8, (int)std::max(alignof(std::function<void()>), alignof(double))),
       smallfun::Methods::Move>;
-  moodycamel::BlockingConcurrentQueue<task> m_queue;
+  moodycamel::BlockingConcurrentQueue<task> m_queue{1024};
   std::array<std::thread, 4> m_threads;
   std::atomic_bool m_running{};
 };
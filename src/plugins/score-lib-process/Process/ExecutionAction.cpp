@@ -8,6 +8,10 @@ ExecutionAction::~ExecutionAction() { }
 void ExecutionAction::startTick(const ossia::audio_tick_state& st) { }
 
 void ExecutionAction::endTick(const ossia::audio_tick_state& st) { }
+
+void ExecutionAction::beginOfflineRender(double sampleRate) { }
+
+void ExecutionAction::endOfflineRender() { }
 Execution::ExecutionActionList::~ExecutionActionList() { }
 
 }
@@ -15,6 +15,16 @@ public:
   virtual ~ExecutionAction();
   virtual void startTick(const ossia::audio_tick_state& st);
   virtual void endTick(const ossia::audio_tick_state& st);
+
+  /**
+   * @brief Called from the UI thread around an offline render.
+   *
+   * The ticks then follow each other as fast as possible instead of being paced
+   * by the sound card: st.seconds is the score time, and sampleRate gives
+   * the duration of a tick.
+   */
+  virtual void beginOfflineRender(double sampleRate);
+  virtual void endOfflineRender();
 };
 
 class SCORE_LIB_PROCESS_EXPORT ExecutionActionList final
@@ -190,6 +190,32 @@ public:
   }
 };
 
+/**
+ * @brief Results of work done outside of the execution thread, e.g. by avnd
+ * workers, to be applied in the execution thread.
+ *
+ * Unlike ExecutionCommandQueue any thread can push to it, so that the
+ * results do not have to go through the UI thread and wait for it when it is busy.
+ * It is drained at the beginning of each tick.
+ */
+struct WorkerResultQueue : private moodycamel::ConcurrentQueue<ExecutionCommand>
+{
+public:
+  using ConcurrentQueue<ExecutionCommand>::ConcurrentQueue;
+  template <typename... Args>
+  inline auto enqueue(Args&&... args) -> decltype(auto)
+  {
+    return ConcurrentQueue<ExecutionCommand>::enqueue(std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  inline auto try_dequeue(Args&&... args) -> decltype(auto)
+  {
+    OSSIA_ENSURE_CURRENT_THREAD_KIND(ossia::thread_type::Audio);
+    return ConcurrentQueue<ExecutionCommand>::try_dequeue(std::forward<Args>(args)...);
+  }
+};
+
 //! Useful structures when creating the execution elements.
 //!
 struct SCORE_LIB_PROCESS_EXPORT Context
@@ -226,6 +252,10 @@ struct SCORE_LIB_PROCESS_EXPORT Context
   {
     return std::shared_ptr<Execution::GCCommandQueue>(alias.lock(), &gcQueue);
   }
+  std::weak_ptr<Execution::WorkerResultQueue> weakWorkerQueue() const noexcept
+  {
+    return std::shared_ptr<Execution::WorkerResultQueue>(alias.lock(), &workerQueue);
+  }
 
   const score::DocumentContext& doc;
   const std::atomic_bool& created;
@@ -242,6 +272,7 @@ struct SCORE_LIB_PROCESS_EXPORT Context
   ExecutionCommandQueue& executionQueue;
   EditionCommandQueue& editionQueue;
   GCCommandQueue& gcQueue;
+  WorkerResultQueue& workerQueue;
   SetupContext& setup;
 
   const std::shared_ptr<ossia::graph_interface>& execGraph;
@@ -129,6 +129,10 @@ struct SCORE_LIB_PROCESS_EXPORT SetupContext final
       runtime_connections;
   score::hash_map<const ossia::graph_node*, const Process::ProcessModel*> proc_map;
 
+  //! When non-zero, the processes of the intervals are only created
+  //! when the intervals get within this duration of the playhead.
+  TimeVal lookAhead{};
+
 private:
   template <typename Impl>
   void register_node_impl(
@@ -135,6 +135,8 @@ DefaultHeaderDelegate::DefaultHeaderDelegate(
 
   con(m_model, &Process::ProcessModel::benchmark, this,
       [this](double d) { updateBench(d); });
+  con(m_model, &Process::ProcessModel::renderBenchmark, this,
+      [this](double ms) { updateRenderBench(ms); });
   con(
       m_model.selection, &Selectable::changed, this,
       [this](bool b) {
@@ -163,6 +165,22 @@ void DefaultHeaderDelegate::updateBench(double d)
   update();
 }
 
+void DefaultHeaderDelegate::updateRenderBench(double ms)
+{
+  if(ms >= 0.)
+  {
+    const auto& style = Process::Style::instance();
+    m_renderBench = makeGlyphs(
+        QString::number(ms, 'f', 2) + QStringLiteral("ms"),
+        m_sel ? style.IntervalHeaderTextPen() : style.SlotHeaderTextPen());
+  }
+  else
+  {
+    m_renderBench = QPixmap{};
+  }
+  update();
+}
+
 void DefaultHeaderDelegate::updateText()
 {
   auto& style = Process::Style::instance();
@@ -257,6 +275,14 @@ void DefaultHeaderDelegate::paint(
 
     if(!m_bench.isNull())
       painter->drawPixmap(QPointF{w - 32., SCORE_YPOS(2., -1.)}, m_bench);
+
+    // Next to the share of the audio tick
+    if(!m_renderBench.isNull())
+    {
+      const double x = (m_bench.isNull() ? w : w - 32.)
+                       - m_renderBench.width() / m_renderBench.devicePixelRatio() - 4.;
+      painter->drawPixmap(QPointF{x, SCORE_YPOS(2., -1.)}, m_renderBench);
+    }
   }
 }
 
@@ -40,6 +40,7 @@ public:
   textPen(Process::Style&, const Process::ProcessModel& model) const noexcept;
 
   void updateBench(double d);
+  void updateRenderBench(double ms);
   void setSize(QSizeF sz) final override;
   void on_zoomRatioChanged(ZoomRatio) final override { updateText(); }
 
@@ -48,7 +49,7 @@ protected:
   void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
       override;
 
-  QPixmap m_line, m_bench;
+  QPixmap m_line, m_bench, m_renderBench;
   QGraphicsItem* m_ui{};
   QGraphicsItem* m_record{};
   QGraphicsItem* m_snapshot{};
@@ -236,6 +236,10 @@ public:
       E_SIGNAL(SCORE_LIB_PROCESS_EXPORT, controlOutletRemoved, arg_1)
 
   void benchmark(double arg_1) E_SIGNAL(SCORE_LIB_PROCESS_EXPORT, benchmark, arg_1)
+
+  //! Milliseconds spent by the gfx renderer on this process per frame
+  void renderBenchmark(double arg_1)
+      E_SIGNAL(SCORE_LIB_PROCESS_EXPORT, renderBenchmark, arg_1)
   void externalUIVisible(bool v) const
       E_SIGNAL(SCORE_LIB_PROCESS_EXPORT, externalUIVisible, v)
   void scriptUIVisible(bool v) const
@@ -11,6 +11,7 @@
 #include <ossia/network/value/value.hpp>
 
 #include <Analysis/Helpers.hpp>
+#include <Analysis/SpectrumCache.hpp>
 
 #include <Gist.h>
 
@@ -31,6 +32,8 @@ struct GistState
     gist.reserve(2);
     gist.emplace_back(bufferSize, rate);
     gist.emplace_back(bufferSize, rate);
+
+    SpectrumCache::instance().prepare(bufferSize, rate);
   }
 
   explicit GistState(Audio::Settings::Model& settings)
@@ -80,6 +83,55 @@ struct GistState
     }
   }
 
+  // Evaluates a feature on a frame. Features which only depend on the
+  // current frame are taken from the SpectrumCache when another process
+  // already analysed the same frame, otherwise this channel's Gist is used.
+  template <auto Func, typename... GainGate>
+  float compute(Gist<double>& g, const double* frame, int samples, GainGate... gg)
+  {
+    float ret{};
+    evaluate<Func>(g, frame, samples, gg..., [&ret](auto res) { ret = float(res); });
+    return ret;
+  }
+
+  template <auto Func>
+  void evaluate(Gist<double>& g, const double* frame, int samples, auto&& f)
+  {
+    if constexpr(SpectrumCache::shareable<Func>)
+    {
+      if(SpectrumCache::instance().analyse(
+             frame, samples, rate, 1.f, 0.f, false,
+             [&f](Gist<double>& shared) { f((shared.*Func)()); }))
+        return;
+    }
+
+    if(g.getAudioFrameSize() != samples)
+      g.setAudioFrameSize(samples);
+
+    g.processAudioFrame(frame, samples);
+    f((g.*Func)());
+  }
+
+  template <auto Func>
+  void evaluate(
+      Gist<double>& g, const double* frame, int samples, float gain, float gate,
+      auto&& f)
+  {
+    if constexpr(SpectrumCache::shareable<Func>)
+    {
+      if(SpectrumCache::instance().analyse(
+             frame, samples, rate, gain, gate, true,
+             [&f](Gist<double>& shared) { f((shared.*Func)()); }))
+        return;
+    }
+
+    if(g.getAudioFrameSize() != samples)
+      g.setAudioFrameSize(samples);
+
+    g.processAudioFrame(frame, samples, gain, gate);
+    f((g.*Func)());
+  }
+
   // No gain //
   template <auto Func>
   void process_mono(const auto& audio, auto& out_port, int d)
@@ -91,11 +143,7 @@ struct GistState
       const auto samples = frames(c0, d);
       if(samples > 0)
       {
-        if(g0.getAudioFrameSize() != samples)
-          g0.setAudioFrameSize(samples);
-
-        g0.processAudioFrame(data(c0), samples);
-        ret = (g0.*Func)();
+        ret = compute<Func>(g0, data(c0), samples);
       }
     }
 
@@ -112,11 +160,7 @@ struct GistState
       const auto samples = frames(c0, d);
       if(samples > 0)
       {
-        if(g0.getAudioFrameSize() != samples)
-          g0.setAudioFrameSize(samples);
-
-        g0.processAudioFrame(data(c0), samples);
-        ret[0] = (g0.*Func)();
+        ret[0] = compute<Func>(g0, data(c0), samples);
       }
     }
     decltype(auto) c1 = audio.get()[1];
@@ -125,11 +169,7 @@ struct GistState
       const auto samples = frames(c1, d);
       if(samples > 0)
       {
-        if(g1.getAudioFrameSize() != samples)
-          g1.setAudioFrameSize(samples);
-
-        g1.processAudioFrame(data(c1), samples);
-        ret[1] = (g1.*Func)();
+        ret[1] = compute<Func>(g1, data(c1), samples);
       }
     }
 
@@ -146,11 +186,7 @@ struct GistState
       const auto samples = frames(channel, d);
       if(samples > 0)
       {
-        if(git->getAudioFrameSize() != samples)
-          git->setAudioFrameSize(samples);
-
-        git->processAudioFrame(data(channel), samples);
-        *it = float(((*git).*Func)());
+        *it = compute<Func>(*git, data(channel), samples);
       }
       else
       {
@@ -174,11 +210,7 @@ struct GistState
       const auto samples = frames(c0, d);
       if(samples > 0)
       {
-        if(g0.getAudioFrameSize() != samples)
-          g0.setAudioFrameSize(samples);
-
-        g0.processAudioFrame(data(c0), samples, gain, gate);
-        ret = (g0.*Func)();
+        ret = compute<Func>(g0, data(c0), samples, gain, gate);
       }
     }
 
@@ -195,11 +227,7 @@ struct GistState
       const auto samples = frames(c0, d);
       if(samples > 0)
       {
-        if(g0.getAudioFrameSize() != samples)
-          g0.setAudioFrameSize(samples);
-
-        g0.processAudioFrame(data(c0), samples, gain, gate);
-        ret[0] = (g0.*Func)();
+        ret[0] = compute<Func>(g0, data(c0), samples, gain, gate);
       }
     }
     decltype(auto) c1 = audio.get()[1];
@@ -208,11 +236,7 @@ struct GistState
       const auto samples = frames(c1, d);
       if(samples > 0)
       {
-        if(g1.getAudioFrameSize() != samples)
-          g1.setAudioFrameSize(samples);
-
-        g1.processAudioFrame(data(c1), samples, gain, gate);
-        ret[1] = (g1.*Func)();
+        ret[1] = compute<Func>(g1, data(c1), samples, gain, gate);
       }
     }
 
@@ -229,12 +253,8 @@ struct GistState
       const auto samples = frames(channel, d);
       if(samples > 0)
       {
-        if(git->getAudioFrameSize() != samples)
-          git->setAudioFrameSize(samples);
-
-        git->processAudioFrame(data(channel), samples, gain, gate);
         float r{};
-        *it = r = float(((*git).*Func)());
+        *it = r = compute<Func>(*git, data(channel), samples, gain, gate);
       }
       else
       {
@@ -259,11 +279,7 @@ struct GistState
       const auto samples = frames(c0, d);
       if(samples > 0)
       {
-        if(g0.getAudioFrameSize() != samples)
-          g0.setAudioFrameSize(samples);
-
-        g0.processAudioFrame(data(c0), samples, gain, gate);
-        ret = (g0.*Func)();
+        ret = compute<Func>(g0, data(c0), samples, gain, gate);
       }
     }
 
@@ -284,11 +300,7 @@ struct GistState
       const auto samples = frames(c0, d);
       if(samples > 0)
       {
-        if(g0.getAudioFrameSize() != samples)
-          g0.setAudioFrameSize(samples);
-
-        g0.processAudioFrame(data(c0), samples, gain, gate);
-        ret[0] = (g0.*Func)();
+        ret[0] = compute<Func>(g0, data(c0), samples, gain, gate);
       }
     }
     decltype(auto) c1 = audio.get()[1];
@@ -297,11 +309,7 @@ struct GistState
       const auto samples = frames(c1, d);
       if(samples > 0)
       {
-        if(g1.getAudioFrameSize() != samples)
-          g1.setAudioFrameSize(samples);
-
-        g1.processAudioFrame(data(c1), samples, gain, gate);
-        ret[1] = (g1.*Func)();
+        ret[1] = compute<Func>(g1, data(c1), samples, gain, gate);
       }
     }
 
@@ -322,12 +330,8 @@ struct GistState
       const auto samples = frames(channel, d);
       if(samples > 0)
       {
-        if(git->getAudioFrameSize() != samples)
-          git->setAudioFrameSize(samples);
-
-        git->processAudioFrame(data(channel), samples, gain, gate);
         float r{};
-        *it = r = float(((*git).*Func)());
+        *it = r = compute<Func>(*git, data(channel), samples, gain, gate);
         bang |= (r >= 1.f);
       }
       else
@@ -378,13 +382,9 @@ struct GistState
       const auto samples = frames(channel, d);
       if(samples > 0)
       {
-        if(git->getAudioFrameSize() != samples)
-          git->setAudioFrameSize(samples);
-
-        git->processAudioFrame(data(channel), samples);
-
-        auto& res = ((*git).*Func)();
-        it->assign(res.begin(), res.end());
+        evaluate<Func>(*git, data(channel), samples, [it](const auto& res) {
+          it->assign(res.begin(), res.end());
+        });
       }
       else
       {
@@ -412,14 +412,10 @@ struct GistState
       std::fill_n(*it, d, 0.f);
       if(samples > 0)
       {
-        if(git->getAudioFrameSize() != samples)
-          git->setAudioFrameSize(samples);
-
-        git->processAudioFrame(data(channel), samples, gain, gate);
-
-        decltype(auto) res = ((*git).*Func)();
-        SCORE_ASSERT(std::ssize(res) <= d);
-        std::copy_n(res.begin(), res.size(), *it);
+        evaluate<Func>(*git, data(channel), samples, gain, gate, [it, d](const auto& res) {
+          SCORE_ASSERT(std::ssize(res) <= d);
+          std::copy_n(res.begin(), res.size(), *it);
+        });
       }
       ++it;
       ++git;
@@ -0,0 +1,25 @@
+#include "SpectrumCache.hpp"
+
+namespace Analysis
+{
+SpectrumCache& SpectrumCache::instance()
+{
+  static SpectrumCache cache;
+  return cache;
+}
+
+void SpectrumCache::prepare(int bufferSize, int rate)
+{
+  for(auto& s : m_slots)
+  {
+    std::lock_guard lock{s.mutex};
+    if(s.prepared(bufferSize, rate))
+      continue;
+
+    s.gist = std::make_unique<Gist<double>>(bufferSize, rate);
+    s.frame.assign(bufferSize, 0.);
+    s.rate = rate;
+    s.key = {};
+  }
+}
+}
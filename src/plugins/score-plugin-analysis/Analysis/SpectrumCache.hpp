@@ -0,0 +1,161 @@
+#pragma once
+#include <Gist.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace Analysis
+{
+/**
+ * @brief Analysis of the frames seen in the current tick, shared across processes.
+ *
+ * Every analysis process gets its own copy of its input, so putting several
+ * descriptors on the same source gives them identical frames. The first one
+ * which runs processes the frame (windowing, FFT, magnitude spectrum) in a Gist
+ * of the cache; the next ones find it by comparing the frame content and only
+ * evaluate their own feature on it.
+ *
+ * The slots are created in prepare() and never waited on from the audio
+ * thread: if none is available, the caller uses its own Gist as before.
+ */
+class SpectrumCache
+{
+public:
+  static SpectrumCache& instance();
+
+  template <auto F, auto G>
+  static constexpr bool same_feature()
+  {
+    if constexpr(std::is_same_v<decltype(F), decltype(G)>)
+      return F == G;
+    else
+      return false;
+  }
+
+  //! Features which keep a history across frames cannot be shared.
+  template <auto Func>
+  static constexpr bool shareable
+      = !same_feature<Func, &Gist<double>::energyDifference>()
+        && !same_feature<Func, &Gist<double>::spectralDifference>()
+        && !same_feature<Func, &Gist<double>::spectralDifferenceHWR>()
+        && !same_feature<Func, &Gist<double>::complexSpectralDifference>()
+        && !same_feature<Func, &Gist<double>::pitch>();
+
+  //! Creates the Gists of the slots for frames of bufferSize samples.
+  //! Called outside of the audio thread, when a process is created.
+  void prepare(int bufferSize, int rate);
+
+  //! Calls f with a Gist which has processed the frame.
+  //! Returns false if the frame cannot be shared, in which case the caller
+  //! analyses it with its own Gist: the slots are busy, or were not prepared
+  //! for this frame size and rate. Never allocates.
+  template <typename F>
+  bool analyse(
+      const double* frame, int samples, int rate, float gain, float gate, bool gated,
+      F&& f)
+  {
+    const Key k{samples, rate, gain, gate, gated};
+    const auto first = slotIndex(frame, k);
+    const auto use = ++m_uses;
+
+    // Two sources of a tick may hash to the same slot: the next ones are
+    // looked at too, and a new frame goes to the least recently used of them
+    // so that it does not evict the other source.
+    Slot* oldest{};
+    for(std::size_t i = 0; i < probe_count; i++)
+    {
+      auto& s = m_slots[(first + i) % slot_count];
+
+      std::unique_lock lock{s.mutex, std::try_to_lock};
+      if(!lock.owns_lock() || !s.prepared(samples, rate))
+        continue;
+
+      if(s.key == k && std::equal(frame, frame + samples, s.frame.data()))
+      {
+        s.lastUse = use;
+        f(*s.gist);
+        return true;
+      }
+
+      if(!oldest || s.lastUse < oldest->lastUse)
+        oldest = &s;
+    }
+
+    if(!oldest)
+      return false;
+
+    auto& s = *oldest;
+    std::unique_lock lock{s.mutex, std::try_to_lock};
+    if(!lock.owns_lock() || !s.prepared(samples, rate))
+      return false;
+
+    if(gated)
+      s.gist->processAudioFrame(frame, samples, gain, gate);
+    else
+      s.gist->processAudioFrame(frame, samples);
+
+    std::copy_n(frame, samples, s.frame.data());
+    s.key = k;
+    s.lastUse = use;
+
+    f(*s.gist);
+    return true;
+  }
+
+private:
+  struct Key
+  {
+    int samples{};
+    int rate{};
+    float gain{};
+    float gate{};
+    bool gated{};
+
+    bool operator==(const Key&) const noexcept = default;
+  };
+
+  struct Slot
+  {
+    std::mutex mutex;
+    Key key;
+    int rate{};
+    uint64_t lastUse{};
+    std::vector<double> frame;
+    std::unique_ptr<Gist<double>> gist;
+
+    bool prepared(int samples, int r) const noexcept
+    {
+      return gist && std::ssize(frame) == samples && rate == r;
+    }
+  };
+
+  static std::size_t slotIndex(const double* frame, const Key& k) noexcept
+  {
+    // Only needs to tell apart the sources of a tick: the frame
+    // content is compared exactly afterwards.
+    const auto bits = [](double v) { return std::bit_cast<uint64_t>(v); };
+    uint64_t h = uint64_t(k.samples) * 0x9E3779B97F4A7C15ull;
+    h ^= std::bit_cast<uint32_t>(k.gain) + (uint64_t(k.gated) << 32);
+    if(k.samples > 0)
+    {
+      h = (h ^ bits(frame[0])) * 0xff51afd7ed558ccdull;
+      h = (h ^ bits(frame[k.samples / 2])) * 0xc4ceb9fe1a85ec53ull;
+      h = (h ^ bits(frame[k.samples - 1])) * 0xff51afd7ed558ccdull;
+    }
+    h ^= h >> 33;
+    return h % slot_count;
+  }
+
+  static constexpr std::size_t slot_count = 64;
+  static constexpr std::size_t probe_count = 4;
+  std::array<Slot, slot_count> m_slots;
+  std::atomic<uint64_t> m_uses{};
+};
+}
@@ -40,6 +40,8 @@ SETTINGS_PARAMETER_IMPL(Rate){QStringLiteral("Audio/SamplingRate"), 44100};
 SETTINGS_PARAMETER_IMPL(DefaultIn){QStringLiteral("Audio/DefaultIn"), 2};
 SETTINGS_PARAMETER_IMPL(DefaultOut){QStringLiteral("Audio/DefaultOut"), 2};
 SETTINGS_PARAMETER_IMPL(AutoStereo){QStringLiteral("Audio/AutoStereo"), true};
+SETTINGS_PARAMETER_IMPL(DecodedCache){QStringLiteral("Audio/DecodedCache"), true};
+SETTINGS_PARAMETER_IMPL(DecodedCacheSize){QStringLiteral("Audio/DecodedCacheSize"), 4096};
 SETTINGS_PARAMETER_IMPL(AutoConnect){QStringLiteral("Audio/AutoConnect"), true};
 SETTINGS_PARAMETER_IMPL(JackTransport){
     QStringLiteral("Audio/JackTransport"), ExternalTransport::None};
@@ -48,7 +50,7 @@ static auto list()
 {
   return std::tie(
       Rate, InputNames, OutputNames, CardIn, CardOut, BufferSize, DefaultIn, DefaultOut,
-      AutoStereo, AutoConnect, JackTransport, Driver);
+      AutoStereo, DecodedCache, DecodedCacheSize, AutoConnect, JackTransport, Driver);
 }
 }
 
@@ -297,6 +299,8 @@ SCORE_SETTINGS_PARAMETER_CPP(QString, Model, CardOut)
 SCORE_SETTINGS_PARAMETER_CPP(int, Model, DefaultIn)
 SCORE_SETTINGS_PARAMETER_CPP(int, Model, DefaultOut)
 SCORE_SETTINGS_PARAMETER_CPP(bool, Model, AutoStereo)
+SCORE_SETTINGS_PARAMETER_CPP(bool, Model, DecodedCache)
+SCORE_SETTINGS_PARAMETER_CPP(int, Model, DecodedCacheSize)
 SCORE_SETTINGS_PARAMETER_CPP(bool, Model, AutoConnect)
 SCORE_SETTINGS_PARAMETER_CPP(Audio::Settings::ExternalTransport, Model, JackTransport)
 }
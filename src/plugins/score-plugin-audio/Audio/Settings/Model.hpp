@@ -42,6 +42,12 @@ class SCORE_PLUGIN_AUDIO_EXPORT Model : public score::SettingsDelegateModel
   // When playing mono audio files, put them as stereo automatically
   bool m_AutoStereo{true};
 
+  // Keep a decoded copy of compressed audio files on disk
+  bool m_DecodedCache{true};
+
+  // In megabytes: the least recently used copies are removed past it
+  int m_DecodedCacheSize{4096};
+
   // Auto connect ports to system i/o (mostly relevant for jack)
   bool m_AutoConnect{true};
 
@@ -65,6 +71,8 @@ public:
   SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_AUDIO_EXPORT, int, DefaultIn)
   SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_AUDIO_EXPORT, int, DefaultOut)
   SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_AUDIO_EXPORT, bool, AutoStereo)
+  SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_AUDIO_EXPORT, bool, DecodedCache)
+  SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_AUDIO_EXPORT, int, DecodedCacheSize)
   SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_AUDIO_EXPORT, bool, AutoConnect)
   SCORE_SETTINGS_PARAMETER_HPP(
       SCORE_PLUGIN_AUDIO_EXPORT, Audio::Settings::ExternalTransport, JackTransport)
@@ -80,6 +88,8 @@ SCORE_SETTINGS_DEFERRED_PARAMETER(Model, Rate)
 SCORE_SETTINGS_DEFERRED_PARAMETER(Model, DefaultIn)
 SCORE_SETTINGS_DEFERRED_PARAMETER(Model, DefaultOut)
 SCORE_SETTINGS_DEFERRED_PARAMETER(Model, AutoStereo)
+SCORE_SETTINGS_DEFERRED_PARAMETER(Model, DecodedCache)
+SCORE_SETTINGS_DEFERRED_PARAMETER(Model, DecodedCacheSize)
 SCORE_SETTINGS_DEFERRED_PARAMETER(Model, AutoConnect)
 SCORE_SETTINGS_DEFERRED_PARAMETER(Model, JackTransport)
 }
@@ -27,6 +27,8 @@ Presenter::Presenter(Model& m, View& v, QObject* parent)
   v.setRate(m.getRate());
   v.setBufferSize(m.getBufferSize());
   v.setAutoStereo(m.getAutoStereo());
+  v.setDecodedCache(m.getDecodedCache());
+  v.setDecodedCacheSize(m.getDecodedCacheSize());
 
   con(v, &View::DriverChanged, this, [this, &m](auto val) {
     if(val != m.getDriver())
@@ -41,6 +43,18 @@ Presenter::Presenter(Model& m, View& v, QObject* parent)
       m_disp.submitDeferredCommand<SetModelAutoStereo>(m, val);
     }
   });
+  con(v, &View::DecodedCacheChanged, this, [this, &m](auto val) {
+    if(val != m.getDecodedCache())
+    {
+      m_disp.submitDeferredCommand<SetModelDecodedCache>(m, val);
+    }
+  });
+  con(v, &View::DecodedCacheSizeChanged, this, [this, &m](auto val) {
+    if(val != m.getDecodedCacheSize())
+    {
+      m_disp.submitDeferredCommand<SetModelDecodedCacheSize>(m, val);
+    }
+  });
 
   con(v, &View::BufferSizeChanged, this, [this, &m](auto val) {
     if(val != m.getBufferSize())
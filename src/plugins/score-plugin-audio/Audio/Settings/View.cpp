@@ -11,6 +11,7 @@
 #include <QComboBox>
 #include <QFormLayout>
 #include <QLabel>
+#include <QSpinBox>
 namespace Audio::Settings
 {
 View::View()
@@ -20,6 +21,9 @@ View::View()
 
   // General settings
   SETTINGS_UI_TOGGLE_SETUP("Auto-Stereo", AutoStereo);
+  SETTINGS_UI_TOGGLE_SETUP("Cache decoded audio files", DecodedCache);
+  SETTINGS_UI_SPINBOX_SETUP("Decoded audio cache size (MB)", DecodedCacheSize);
+  m_DecodedCacheSize->setRange(64, 1024 * 1024);
 
   // Driver combo-box
   m_Driver = new QComboBox{m_widg};
@@ -114,4 +118,6 @@ void View::setBufferSize(int val)
   }
 }
 SETTINGS_UI_TOGGLE_IMPL(AutoStereo)
+SETTINGS_UI_TOGGLE_IMPL(DecodedCache)
+SETTINGS_UI_SPINBOX_IMPL(DecodedCacheSize)
 }
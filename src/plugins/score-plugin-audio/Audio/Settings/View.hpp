@@ -33,6 +33,8 @@ public:
   void RateChanged(int arg) W_SIGNAL(RateChanged, arg)
 
   SETTINGS_UI_TOGGLE_HPP(AutoStereo)
+  SETTINGS_UI_TOGGLE_HPP(DecodedCache)
+  SETTINGS_UI_SPINBOX_HPP(DecodedCacheSize)
 
 private:
   QWidget* getWidget() override;
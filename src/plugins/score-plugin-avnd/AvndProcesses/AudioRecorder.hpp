@@ -3,20 +3,34 @@
 #include <score/tools/File.hpp>
 
 #include <ossia/audio/drwav_write_handle.hpp>
+#include <ossia/detail/thread.hpp>
 #include <ossia/network/value/detail/value_conversion_impl.hpp>
 
 #include <QDateTime>
+#include <QFileInfo>
 
 #include <AvndProcesses/AddressTools.hpp>
+#include <AvndProcesses/AudioRingBuffer.hpp>
 #include <AvndProcesses/Utils.hpp>
 #include <halp/audio.hpp>
 #include <halp/callback.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
 namespace avnd_tools
 {
 /** Records audio into a WAV file.
- *  
- *  Writing to the disk is done in a worker thread as is tradition.
+ *
+ *  The audio thread only copies its input in a ring buffer allocated
+ *  beforehand. A thread dedicated to each recorder empties it, and writes
+ *  to the disk in large chunks.
+ *
+ *  When not recording, the last seconds of audio are kept in the buffer, so
+ *  that a recording can start a bit before the moment it was asked for.
  */
 struct AudioRecorder
 {
@@ -30,119 +44,259 @@ struct AudioRecorder
       "https://ossia.io/score-docs/processes/audio-utilities.html#audio-recorder")
   halp_meta(uuid, "4463dddc-6acf-4106-a680-fed67d8030da")
 
-  using audio_buffer = boost::container::vector<double>;
+  struct recorder_config
+  {
+    const score::DocumentContext* context{};
+    std::string filename;
+    int channels{};
+    int rate{};
+    int buffer_seconds{};
+    int preroll_seconds{};
+    bool mono{};
+    int64_t generation{};
+  };
 
-  // Threaded worker
+  // Owns the ring buffer and the thread which writes it to the disk
   struct recorder_thread
   {
-    explicit recorder_thread(const score::DocumentContext& context)
-        : context{context}
+    // Frames written to the disk at once
+    static constexpr int64_t chunk_frames = 16384;
+
+    explicit recorder_thread(recorder_config c)
+        : context{*c.context}
+        , filename{std::move(c.filename)}
+        , channels{c.channels}
+        , rate{c.rate}
+        , mono{c.mono}
+        , generation{c.generation}
+        , preroll{int64_t(c.preroll_seconds) * c.rate}
+        , ring{c.channels, int64_t(c.buffer_seconds + c.preroll_seconds) * c.rate}
+        , scratch(std::size_t(c.channels) * chunk_frames)
+        , channel_ptrs(c.channels)
+        , files(c.mono ? c.channels : 1)
     {
+      thread = std::thread{[this] {
+        ossia::set_thread_name("ossia recorder");
+        run();
+      }};
     }
+
+    ~recorder_thread()
+    {
+      running.store(false, std::memory_order_release);
+      thread.join();
+    }
+
+    recorder_thread(const recorder_thread&) = delete;
+    recorder_thread& operator=(const recorder_thread&) = delete;
+
     const score::DocumentContext& context;
-    ossia::drwav_write_handle f;
-    std::string filename;
-    std::string actual_filename;
-    int channels = 0;
-    int rate = 0;
-    bool must_record = false;
+    const std::string filename;
+    const int channels{};
+    const int rate{};
+    const bool mono{};
+    const int64_t generation{};
+    const int64_t preroll{};
 
-    bool reopen()
+    audio_ring_buffer ring;
+
+    // Audio thread
+    void arm(bool must_record) noexcept
     {
       if(must_record)
+        start_position.store(ring.write_position(), std::memory_order_relaxed);
+      else
+        stop_position.store(ring.write_position(), std::memory_order_relaxed);
+      armed.store(must_record, std::memory_order_release);
+    }
+
+    //! Swaps the name of the last file which was completed, if any, without blocking
+    void finished(std::string& out) noexcept
+    {
+      std::unique_lock l{finished_mutex, std::try_to_lock};
+      if(l.owns_lock() && !finished_filename.empty())
       {
-        // Open the file with the correct substitutions
-        actual_filename = filter_filename(this->filename, context).toStdString();
-        if(actual_filename.empty())
-          return false;
+        using namespace std;
+        swap(out, finished_filename);
+      }
+    }
 
-        f.open(actual_filename, channels, rate, 16);
-        return false;
+  private:
+    void run()
+    {
+      while(running.load(std::memory_order_acquire))
+      {
+        step();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
       }
-      else
+
+      // What was recorded until the recorder was replaced or removed
+      if(recording)
+      {
+        flush(ring.write_position());
+        close();
+      }
+    }
+
+    void step()
+    {
+      const bool must_record = armed.load(std::memory_order_acquire);
+      if(must_record && !recording && !failed)
       {
-        bool must_reply = false;
-        if(f.is_open() && f.written_frames() > 0)
+        ring.skip_to(start_position.load(std::memory_order_relaxed) - preroll);
+        recording = open();
+        failed = !recording;
+      }
+      else if(!must_record)
+      {
+        failed = false;
+      }
+
+      if(recording)
+      {
+        if(must_record)
         {
-          must_reply = true;
+          const int64_t r = ring.read_position();
+          const int64_t available = ring.write_position() - r;
+          if(available >= chunk_frames)
+            flush(r + available - available % chunk_frames);
         }
-        f.close();
-        return must_reply;
+        else
+        {
+          flush(stop_position.load(std::memory_order_relaxed));
+          close();
+          recording = false;
+        }
+      }
+      else
+      {
+        // Only the pre-roll is kept. The recording may have been armed since
+        // armed was read above: then, what follows its start is kept for the
+        // next step. The write position is read first so that an arming after
+        // the second read starts after it.
+        const int64_t end = ring.write_position();
+        int64_t start = end;
+        if(armed.load(std::memory_order_acquire))
+          start = std::min(end, start_position.load(std::memory_order_relaxed));
+        ring.skip_to(start - preroll);
       }
     }
 
-    void write(int frames, audio_buffer& data)
+    bool open()
     {
-      int these_channels = data.size() / frames;
-      if(these_channels != channels)
+      // Open the file with the correct substitutions
+      actual_filename = QString::fromUtf8(filter_filename(this->filename, context));
+      if(actual_filename.isEmpty() || channels == 0)
+        return false;
+
+      if(mono)
       {
-        channels = these_channels;
-        reopen();
+        for(int c = 0; c < channels; c++)
+          files[c].open(channel_filename(c), 1, rate, 16);
       }
+      else
+      {
+        files[0].open(actual_filename.toStdString(), channels, rate, 16);
+      }
+      return files[0].is_open();
+    }
 
-      if(!f.is_open())
-        return;
-
-      // Put addresses to the first sample of each channel in an array,
-      // e.g. arr[0] points to the first channel, arr[1] to the second, etc.
-      const double** arr = (const double**)alloca(channels * sizeof(double*));
-      for(int c = 0; c < channels; ++c)
-        arr[c] = data.data() + c * frames;
+    void close()
+    {
+      const bool written = files[0].is_open() && files[0].written_frames() > 0;
+      for(auto& f : files)
+        f.close();
 
-      // Write the data
-      f.write_pcm_frames(frames, arr);
+      if(written)
+      {
+        std::lock_guard l{finished_mutex};
+        finished_filename = actual_filename.toStdString();
+      }
     }
-  };
-  std::shared_ptr<recorder_thread> impl;
 
-  struct reset_message
-  {
-    std::string path;
-    int rate{};
-    bool must_record{};
-    bool operator()(recorder_thread& self)
-    {
-      using namespace std;
-      swap(self.filename, path);
-      self.rate = rate;
-      self.must_record = must_record;
-      return self.reopen();
+    std::string channel_filename(int c) const
+    {
+      const QFileInfo info{actual_filename};
+      QString name = info.path() + '/' + info.completeBaseName()
+                     + QStringLiteral("_%1").arg(c + 1, 2, 10, QChar('0'));
+      if(const auto suffix = info.suffix(); !suffix.isEmpty())
+        name += '.' + suffix;
+      return name.toStdString();
     }
-  };
 
-  struct process_message
-  {
-    int frames{};
-    audio_buffer data;
-    bool operator()(recorder_thread& self)
+    void flush(int64_t end)
     {
-      self.write(frames, data);
-      return false;
+      for(int64_t r = ring.read_position(); r < end; r = ring.read_position())
+      {
+        int64_t frames = 0;
+        ring.consume(std::min(end, r + chunk_frames), [&](const float** chans, int64_t n) {
+          for(int c = 0; c < channels; c++)
+            std::copy_n(chans[c], n, scratch.data() + c * chunk_frames + frames);
+          frames += n;
+        });
+        if(frames == 0)
+          break;
+
+        write(frames);
+      }
     }
-  };
-  using worker_message = ossia::variant<reset_message, process_message>;
 
-  struct
-  {
-    std::function<void(std::shared_ptr<recorder_thread>, worker_message)> request;
-    static std::function<void(AudioRecorder&)>
-    work(std::shared_ptr<recorder_thread> t, worker_message&& mess)
-    {
-      bool reply = ossia::visit(
-          [&]<typename M>(M&& msg) { return std::forward<M>(msg)(*t); },
-          std::move(mess));
-      if(reply)
+    void write(int64_t frames)
+    {
+      for(int c = 0; c < channels; ++c)
+        channel_ptrs[c] = scratch.data() + c * chunk_frames;
+
+      if(mono)
       {
-        return [filename = t->actual_filename](AudioRecorder& self) mutable {
-          using namespace std;
-          swap(self.filename_to_output, filename);
-        };
+        for(int c = 0; c < channels; ++c)
+          files[c].write_pcm_frames(frames, &channel_ptrs[c]);
       }
       else
       {
-        return {};
+        files[0].write_pcm_frames(frames, channel_ptrs.data());
       }
     }
+
+    // Writer thread
+    std::vector<double> scratch;
+    std::vector<const double*> channel_ptrs;
+    std::vector<ossia::drwav_write_handle> files;
+    QString actual_filename;
+    bool recording{};
+    bool failed{};
+
+    std::mutex finished_mutex;
+    std::string finished_filename;
+
+    std::atomic_bool armed{};
+    std::atomic<int64_t> start_position{};
+    std::atomic<int64_t> stop_position{};
+    std::atomic_bool running{true};
+
+    std::thread thread;
+  };
+  std::shared_ptr<recorder_thread> impl;
+
+  struct
+  {
+    std::function<void(recorder_config)> request;
+    static std::function<void(AudioRecorder&)> work(recorder_config&& config)
+    {
+      // The ring buffer is allocated here, out of the audio thread
+      auto t = std::make_shared<recorder_thread>(std::move(config));
+      return [t = std::move(t)](AudioRecorder& self) mutable {
+        // An older request which finished last
+        if(self.impl && self.impl->generation > t->generation)
+          return;
+
+        using namespace std;
+        swap(self.impl, t);
+        self.impl->arm(self.inputs.record);
+
+        // The previous recorder, now in t, finishes writing its file
+        // when it is released on the main thread.
+      };
+    }
   } worker;
 
   // Object definition
@@ -151,7 +305,7 @@ struct AudioRecorder
     halp::dynamic_audio_bus<"Audio", double> audio;
     struct : halp::lineedit<"File pattern", "">
     {
-      void update(AudioRecorder& self) { self.update(); }
+      void update(AudioRecorder& self) { self.must_reset = true; }
     } filename;
 
     struct : halp::toggle<"Record">
@@ -161,16 +315,35 @@ struct AudioRecorder
         if(prev != value)
         {
           prev = value;
-          self.update();
+          if(self.impl)
+            self.impl->arm(value);
         }
       }
       bool prev{false};
     } record;
+
+    struct : halp::spinbox_i32<"Buffer (s)", halp::irange{1, 600, 10}>
+    {
+      void update(AudioRecorder& self) { self.must_reset = true; }
+    } buffer;
+
+    struct : halp::spinbox_i32<"Pre-roll (s)", halp::irange{0, 600, 0}>
+    {
+      void update(AudioRecorder& self) { self.must_reset = true; }
+    } preroll;
+
+    struct : halp::toggle<"Mono files">
+    {
+      void update(AudioRecorder& self) { self.must_reset = true; }
+    } mono;
   } inputs;
 
   struct
   {
     halp::callback<"Filename", std::string> finished;
+
+    //! Frames which were dropped as the disk did not keep up
+    halp::val_port<"Overruns", int> overruns;
   } outputs;
 
   const score::DocumentContext* ossia_document_context{};
@@ -179,32 +352,37 @@ struct AudioRecorder
   {
     current_rate = s.rate;
     SCORE_ASSERT(ossia_document_context);
-    impl = std::make_shared<recorder_thread>(*ossia_document_context);
-    update();
+    must_reset = true;
   }
 
-  void update()
+  void reset()
   {
-    if(impl)
-      worker.request(impl, reset_message{inputs.filename, current_rate, inputs.record});
+    must_reset = false;
+    requested_channels = inputs.audio.channels;
+    worker.request(recorder_config{
+        .context = ossia_document_context,
+        .filename = inputs.filename,
+        .channels = inputs.audio.channels,
+        .rate = current_rate,
+        .buffer_seconds = inputs.buffer,
+        .preroll_seconds = inputs.preroll,
+        .mono = inputs.mono,
+        .generation = ++generation});
   }
 
   void operator()(int frames)
   {
-    if(!std::exchange(started, true))
-      update();
+    if(must_reset || inputs.audio.channels != requested_channels)
+      reset();
 
-    data.resize(inputs.audio.channels * frames, boost::container::default_init);
-    for(int c = 0; c < inputs.audio.channels; c++)
-    {
-      double* src = inputs.audio.samples[c];
-      double* ptr = data.data() + c * frames;
-      for(int i = 0; i < frames; i++)
-        ptr[i] = src[i];
-    }
+    // Until the recorder for the new channel count is ready, the input is dropped
+    if(impl && impl->channels == inputs.audio.channels)
+      impl->ring.write(inputs.audio.samples, frames);
 
-    worker.request(impl, process_message{frames, std::move(data)});
+    outputs.overruns.value = impl ? int(impl->ring.overruns()) : 0;
 
+    if(impl)
+      impl->finished(filename_to_output);
     if(!filename_to_output.empty())
     {
       outputs.finished(filename_to_output);
@@ -212,11 +390,10 @@ struct AudioRecorder
     }
   }
 
-  bool started{};
-  std::optional<int64_t> first_message_sent_pos;
-  std::optional<int64_t> last_message_sent_pos;
+  bool must_reset{true};
+  int requested_channels{-1};
+  int64_t generation{};
 
-  audio_buffer data;
   std::string filename_to_output;
 };
 
@@ -0,0 +1,121 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace avnd_tools
+{
+/**
+ * @brief Single-producer / single-consumer ring of multichannel audio.
+ *
+ * The storage is allocated once, in the constructor: the audio thread only
+ * copies its samples in it, and never blocks nor allocates. Frames which do
+ * not fit in the free space are dropped and counted in overruns().
+ *
+ * Positions are counted in frames since the creation of the ring, so that the
+ * consumer can refer to a moment of the stream, e.g. to keep a pre-roll.
+ * Each channel is stored contiguously so that the consumer reads long runs
+ * of samples.
+ */
+class audio_ring_buffer
+{
+public:
+  //! The capacity is rounded up to a power of two
+  audio_ring_buffer(int channels, int64_t capacity)
+      : m_channels{std::max(channels, 0)}
+      , m_capacity{int64_t(std::bit_ceil(uint64_t(std::max(capacity, int64_t(1)))))}
+      , m_mask{m_capacity - 1}
+      , m_samples(m_channels * m_capacity)
+      , m_runs(m_channels)
+  {
+  }
+
+  int channels() const noexcept { return m_channels; }
+  int64_t capacity() const noexcept { return m_capacity; }
+
+  // Producer
+  //! Returns the number of frames which were written
+  int64_t write(const double* const* samples, int64_t frames) noexcept
+  {
+    const int64_t w = m_write.load(std::memory_order_relaxed);
+    const int64_t r = m_read.load(std::memory_order_acquire);
+    const int64_t n = std::clamp(m_capacity - (w - r), int64_t(0), frames);
+
+    const int64_t first = std::min(n, m_capacity - (w & m_mask));
+    for(int c = 0; c < m_channels; c++)
+    {
+      float* chan = m_samples.data() + c * m_capacity;
+      const double* src = samples[c];
+      std::copy_n(src, first, chan + (w & m_mask));
+      std::copy_n(src + first, n - first, chan);
+    }
+
+    m_write.store(w + n, std::memory_order_release);
+    if(n < frames)
+      m_overruns.fetch_add(frames - n, std::memory_order_relaxed);
+    return n;
+  }
+
+  // Consumer
+  int64_t write_position() const noexcept
+  {
+    return m_write.load(std::memory_order_acquire);
+  }
+  int64_t read_position() const noexcept
+  {
+    return m_read.load(std::memory_order_relaxed);
+  }
+
+  //! Calls f(channel_pointers, frames) on the contiguous runs of the frames
+  //! between the read position and end, then releases them to the producer.
+  template <typename F>
+  int64_t consume(int64_t end, F&& f) noexcept
+  {
+    const int64_t r0 = m_read.load(std::memory_order_relaxed);
+    end = std::min(end, m_write.load(std::memory_order_acquire));
+
+    const float** chans = m_runs.data();
+    for(int64_t r = r0; r < end;)
+    {
+      const int64_t n = std::min(end - r, m_capacity - (r & m_mask));
+      for(int c = 0; c < m_channels; c++)
+        chans[c] = m_samples.data() + c * m_capacity + (r & m_mask);
+      f(chans, n);
+      r += n;
+    }
+
+    if(end > r0)
+    {
+      m_read.store(end, std::memory_order_release);
+      return end - r0;
+    }
+    return 0;
+  }
+
+  //! Releases the frames before pos without reading them
+  void skip_to(int64_t pos) noexcept
+  {
+    const int64_t r = m_read.load(std::memory_order_relaxed);
+    pos = std::min(pos, m_write.load(std::memory_order_acquire));
+    if(pos > r)
+      m_read.store(pos, std::memory_order_release);
+  }
+
+  int64_t overruns() const noexcept { return m_overruns.load(std::memory_order_relaxed); }
+
+private:
+  int m_channels{};
+  int64_t m_capacity{};
+  int64_t m_mask{};
+  std::vector<float> m_samples;
+
+  // Consumer-local
+  std::vector<const float*> m_runs;
+
+  alignas(64) std::atomic<int64_t> m_write{};
+  alignas(64) std::atomic<int64_t> m_read{};
+  std::atomic<int64_t> m_overruns{};
+};
+}
@@ -428,31 +428,32 @@ public:
 
     auto& tq = score::TaskPool::instance();
     node.soundfiles.load_request
-        = [&tq, p = std::weak_ptr{ptr}, &ctx](std::string& str, int idx) {
+        = [&tq, producer = tq.producer(), p = std::weak_ptr{ptr}, &ctx,
+           wq_ptr = ctx.weakWorkerQueue()](std::string& str, int idx) {
       auto eff_ptr = p.lock();
       if(!eff_ptr)
         return;
-      tq.post([eff_ptr = std::move(eff_ptr), filename = str, &ctx, idx]() mutable {
+      tq.post(
+          *producer,
+          [eff_ptr = std::move(eff_ptr), filename = str, &ctx, wq_ptr, idx]() mutable {
         if(auto file = loadSoundfile(filename, ctx.doc, ctx.execState))
         {
-          // Sadly we have to go back to the main thread as execution queue is SPSC
-          QMetaObject::invokeMethod(
-              QCoreApplication::instance(),
-              [&ctx, file = std::move(file), eff_ptr = std::move(eff_ptr), idx = idx] {
-            ctx.executionQueue.enqueue(
-                [sf = std::move(file), p = std::weak_ptr{eff_ptr}, idx]() mutable {
-              auto eff_ptr = p.lock();
-              if(!eff_ptr)
-                return;
+          std::shared_ptr wq = wq_ptr.lock();
+          if(!wq)
+            return;
 
-              avnd::effect_container<Node>& eff = eff_ptr->impl;
-              soundfile_inputs_type::for_nth_mapped_n2(
-                  avnd::get_inputs<Node>(eff), idx,
-                  [&]<std::size_t NField, std::size_t N>(
-                      auto& field, avnd::predicate_index<N> p,
-                      avnd::field_index<NField> f) {
-                sf = eff_ptr->soundfile_loaded(sf, p, f);
-              });
+          wq->enqueue([sf = std::move(file), p = std::weak_ptr{eff_ptr}, idx]() mutable {
+            auto eff_ptr = p.lock();
+            if(!eff_ptr)
+              return;
+
+            avnd::effect_container<Node>& eff = eff_ptr->impl;
+            soundfile_inputs_type::for_nth_mapped_n2(
+                avnd::get_inputs<Node>(eff), idx,
+                [&]<std::size_t NField, std::size_t N>(
+                    auto& field, avnd::predicate_index<N> p,
+                    avnd::field_index<NField> f) {
+              sf = eff_ptr->soundfile_loaded(sf, p, f);
             });
           });
         }
@@ -549,15 +550,18 @@ public:
       for(auto& eff : eff.effects())
       {
         std::weak_ptr eff_ptr = std::shared_ptr<Node>(this->node, &eff);
-        std::weak_ptr qex_ptr = std::shared_ptr<Execution::ExecutionCommandQueue>(
-            ctx.alias.lock(), &ctx.executionQueue);
+        std::weak_ptr wq_ptr = ctx.weakWorkerQueue();
+
+        // Created here as request() is called in the DSP thread, which must not
+        // allocate: see TaskPool::post(Producer&, ...)
+        auto producer = tq.producer();
 
         eff.worker.request
-            = [&tq, qex_ptr = std::move(qex_ptr),
+            = [&tq, producer = std::move(producer), wq_ptr = std::move(wq_ptr),
                eff_ptr = std::move(eff_ptr)]<typename... Args>(Args&&... f) mutable {
           // request() is invoked in the DSP / processor thread
           // and just posts the task to the thread pool
-          tq.post([eff_ptr, qex_ptr, ... ff = std::forward<Args>(f)]() mutable {
+          tq.post(*producer, [eff_ptr, wq_ptr, ... ff = std::forward<Args>(f)]() mutable {
             // This happens in the worker thread
             // If for some reason the object has already been removed, not much
             // reason to perform the work
@@ -578,25 +582,19 @@ public:
               if(!res)
                 return;
 
-              // Execution queue is currently spsc from main thread to an exec thread,
-              // we cannot just yeet the result back from the thread-pool
-              ossia::qt::run_async(
-                  qApp, [eff_ptr = std::move(eff_ptr), qex_ptr = std::move(qex_ptr),
-                         res = std::move(res)]() mutable {
-                    // Main thread
-                    std::shared_ptr qex = qex_ptr.lock();
-                    if(!qex)
-                      return;
-
-                    qex->enqueue(
-                        [eff_ptr = std::move(eff_ptr), res = std::move(res)]() mutable {
-                  // DSP / processor thread
-                  // We need res to be mutable so that the worker can use it to e.g. store
-                  // old data which will be freed back in the main thread
-                  if(auto p = eff_ptr.lock())
-                    res(*p);
-                    });
-                  });
+              // Sent straight from the worker thread: the result queue is drained
+              // at the beginning of each tick.
+              std::shared_ptr wq = wq_ptr.lock();
+              if(!wq)
+                return;
+
+              wq->enqueue([eff_ptr = std::move(eff_ptr), res = std::move(res)]() mutable {
+                // DSP / processor thread
+                // We need res to be mutable so that the worker can use it to e.g. store
+                // old data which will be freed back in the main thread
+                if(auto p = eff_ptr.lock())
+                  res(*p);
+              });
             }
           });
         };
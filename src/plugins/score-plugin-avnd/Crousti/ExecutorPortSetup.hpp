@@ -43,6 +43,15 @@ struct con_unvalidated
     {
       control_value_type v;
       node->from_ossia_value(field, val, v, avnd::field_index<NField>{});
+
+      // The control starts its work from the UI thread, e.g. compiling an
+      // expression: the result gets to the node through its worker
+      if constexpr(requires { Field::request_work(std::declval<Node&>(), v); })
+      {
+        for(auto state : node->impl.full_state())
+          Field::request_work(state.effect, v);
+      }
+
       ctx.executionQueue.enqueue([weak_node = weak_node, v = std::move(v)]() mutable {
         if(auto n = weak_node.lock())
         {
@@ -110,6 +119,17 @@ struct setup_control_for_exec_base
       }
     }
   }
+
+  // Same as con_unvalidated, for the initial value
+  void invoke_request_work(Field& param)
+  {
+    if constexpr(requires { Field::request_work(std::declval<Node&>(), param.value); })
+    {
+      avnd::effect_container<Node>& eff = node_ptr->impl;
+      for(auto state : eff.full_state())
+        Field::request_work(state.effect, param.value);
+    }
+  }
 };
 template <typename Node, typename Field, std::size_t N, std::size_t NField>
 struct setup_control_for_exec;
@@ -432,6 +452,8 @@ struct dispatch_control_setup
 
         setup.invoke_update(param, k);
 
+        setup.invoke_request_work(param);
+
         setup.connect_control_to_ui(param, inlet, k);
       }
       k++;
@@ -15,6 +15,7 @@
 #include <Explorer/DocumentPlugin/DeviceDocumentPluginFactory.hpp>
 #include <Explorer/DocumentPlugin/NodeUpdateProxy.hpp>
 #include <Explorer/Listening/ListeningHandlerFactoryList.hpp>
+#include <Explorer/Settings/ExplorerModel.hpp>
 
 #include <score/application/ApplicationContext.hpp>
 #include <score/application/GUIApplicationContext.hpp>
@@ -100,6 +101,14 @@ void DeviceDocumentPlugin::init()
 {
   m_asioContext = std::make_shared<ossia::net::network_context>();
   m_processMessages = true;
+
+  auto& set = m_context.app.settings<Explorer::Settings::Model>();
+  m_valuesTimer = startTimer(1000 / std::max(1, set.getValueRefreshRate()));
+  con(set, &Explorer::Settings::Model::ValueRefreshRateChanged, this, [this](int rate) {
+    killTimer(m_valuesTimer);
+    m_valuesTimer = startTimer(1000 / std::max(1, rate));
+  });
+
 #if defined(__EMSCRIPTEN__)
   startTimer(8);
 #else
@@ -148,6 +157,12 @@ void DeviceDocumentPlugin::asyncConnect(Device::DeviceInterface& newdev)
 
 void DeviceDocumentPlugin::timerEvent(QTimerEvent* event)
 {
+  if(event->timerId() == m_valuesTimer)
+  {
+    flushValues();
+    return;
+  }
+
 #if defined(__EMSCRIPTEN__)
   if(m_processMessages)
     m_asioContext->poll();
@@ -425,9 +440,24 @@ void DeviceDocumentPlugin::reconnect(const QString& device)
 void DeviceDocumentPlugin::on_valueUpdated(
     const State::Address& addr, const ossia::value& v)
 {
-  ossia::qt::run_async(this, [this, aa = State::AddressAccessor{addr}, v] {
-    updateProxy.updateLocalValue(aa, v);
-  });
+  // Called from the network threads: only the latest value of each address
+  // is kept until the next refresh of the explorer.
+  std::lock_guard lock{m_valuesMutex};
+  m_pendingValues.insert_or_assign(addr, v);
+}
+
+void DeviceDocumentPlugin::flushValues()
+{
+  {
+    std::lock_guard lock{m_valuesMutex};
+    if(m_pendingValues.empty())
+      return;
+    // Both tables keep their storage from one refresh to the next
+    std::swap(m_pendingValues, m_flushedValues);
+  }
+
+  updateProxy.updateLocalValues(m_flushedValues);
+  m_flushedValues.clear();
 }
 
 }
@@ -12,6 +12,7 @@
 
 #include <score_plugin_deviceexplorer_export.h>
 
+#include <mutex>
 #include <thread>
 #include <verdigris>
 
@@ -86,6 +87,7 @@ public:
 private:
   void initDevice(Device::DeviceInterface&);
   void on_valueUpdated(const State::Address& addr, const ossia::value& v);
+  void flushValues();
 
   Device::Node m_rootNode;
   Device::DeviceList m_list;
@@ -98,6 +100,12 @@ private:
   ossia::hash_map<Device::DeviceInterface*, std::vector<QMetaObject::Connection>>
       m_connections;
 
+  // Latest value received for each address since the last UI refresh
+  std::mutex m_valuesMutex;
+  ossia::hash_map<State::Address, ossia::value> m_pendingValues;
+  ossia::hash_map<State::Address, ossia::value> m_flushedValues;
+  int m_valuesTimer{-1};
+
   void asyncConnect(Device::DeviceInterface& newdev);
   void timerEvent(QTimerEvent* event) override;
 
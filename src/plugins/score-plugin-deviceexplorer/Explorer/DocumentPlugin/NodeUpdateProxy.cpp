@@ -291,6 +291,22 @@ void NodeUpdateProxy::updateLocalValue(
   devModel.explorer().updateValue(n, addr, v);
 }
 
+void NodeUpdateProxy::updateLocalValues(
+    ossia::hash_map<State::Address, ossia::value>& values)
+{
+  std::vector<std::pair<Device::Node*, ossia::value>> nodes;
+  nodes.reserve(values.size());
+  for(auto& [addr, v] : values)
+  {
+    auto n = Device::try_getNodeFromAddress(devModel.rootNode(), addr);
+    if(n && n->template is<Device::AddressSettings>())
+      nodes.emplace_back(n, std::move(v));
+  }
+
+  if(!nodes.empty())
+    devModel.explorer().updateValues(nodes);
+}
+
 void NodeUpdateProxy::updateLocalSettings(
     const State::Address& addr, const Device::AddressSettings& set,
     Device::DeviceInterface& newdev)
@@ -1,17 +1,15 @@
 #pragma once
+#include <State/Address.hpp>
 #include <State/Value.hpp>
 
 #include <Device/Node/DeviceNode.hpp>
 
+#include <ossia/detail/hash_map.hpp>
+
 #include <QString>
 
 #include <score_plugin_deviceexplorer_export.h>
 
-namespace State
-{
-struct Address;
-}
-
 namespace Device
 {
 struct AddressSettings;
@@ -90,6 +88,8 @@ public:
 
   void removeLocalNode(const State::Address&);
   void updateLocalValue(const State::AddressAccessor&, const ossia::value&);
+  //! The values are moved out of the map
+  void updateLocalValues(ossia::hash_map<State::Address, ossia::value>& values);
   void updateLocalSettings(
       const State::Address&, const Device::AddressSettings&,
       Device::DeviceInterface& newdev);
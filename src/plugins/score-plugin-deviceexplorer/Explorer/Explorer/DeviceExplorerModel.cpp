@@ -54,6 +54,7 @@
 
 #include <wobjectimpl.h>
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -227,6 +228,34 @@ void DeviceExplorerModel::updateValue(
   dataChanged(nodeIndex, nodeIndex);
 }
 
+void DeviceExplorerModel::updateValues(
+    std::vector<std::pair<Device::Node*, ossia::value>>& values)
+{
+  for(auto& [n, v] : values)
+    n->get<Device::AddressSettings>().value = std::move(v);
+
+  // The indices of a dataChanged must share the same parent
+  std::sort(values.begin(), values.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.first->parent() < rhs.first->parent();
+  });
+
+  for(auto it = values.begin(); it != values.end();)
+  {
+    const auto parent = it->first->parent();
+    QModelIndex first = modelIndexFromNode(*it->first, 1);
+    QModelIndex last = first;
+    for(++it; it != values.end() && it->first->parent() == parent; ++it)
+    {
+      auto idx = modelIndexFromNode(*it->first, 1);
+      if(idx.row() < first.row())
+        first = idx;
+      else if(idx.row() > last.row())
+        last = idx;
+    }
+    dataChanged(first, last);
+  }
+}
+
 bool DeviceExplorerModel::checkDeviceInstantiatable(
     const Device::DeviceSettings& n) const
 {
@@ -103,6 +103,9 @@ public:
   void updateValue(
       Device::Node* n, const State::AddressAccessor& addr, const ossia::value& v);
 
+  //! Sets many values at once, with one dataChanged per parent node
+  void updateValues(std::vector<std::pair<Device::Node*, ossia::value>>& values);
+
   // Checks if the settings can be added; if not,
   // trigger a dialog to edit them as wanted.
   // Returns true if the device is to be added, false if
@@ -13,10 +13,12 @@ namespace Parameters
 SETTINGS_PARAMETER_IMPL(LocalTree){QStringLiteral("score_plugin_LocalTree"), true};
 SETTINGS_PARAMETER_IMPL(LogLevel){
     QStringLiteral("score_plugin_engine/LogLevel"), DeviceLogLevel{}.logEverything};
+SETTINGS_PARAMETER_IMPL(ValueRefreshRate){
+    QStringLiteral("DeviceExplorer/ValueRefreshRate"), 30};
 
 static auto list()
 {
-  return std::tie(LocalTree, LogLevel);
+  return std::tie(LocalTree, LogLevel, ValueRefreshRate);
 }
 }
 
@@ -30,6 +32,7 @@ Model::Model(
 
 SCORE_SETTINGS_PARAMETER_CPP(bool, Model, LocalTree)
 SCORE_SETTINGS_PARAMETER_CPP(QString, Model, LogLevel)
+SCORE_SETTINGS_PARAMETER_CPP(int, Model, ValueRefreshRate)
 }
 
 namespace Explorer::ProjectSettings
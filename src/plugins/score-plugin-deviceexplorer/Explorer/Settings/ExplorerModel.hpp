@@ -21,6 +21,7 @@ class SCORE_PLUGIN_DEVICEEXPLORER_EXPORT Model : public score::SettingsDelegateM
 
   bool m_LocalTree = false;
   QString m_LogLevel;
+  int m_ValueRefreshRate{30};
 
 public:
   Model(
@@ -29,9 +30,11 @@ public:
 
   SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_DEVICEEXPLORER_EXPORT, bool, LocalTree)
   SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_DEVICEEXPLORER_EXPORT, QString, LogLevel)
+  SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_DEVICEEXPLORER_EXPORT, int, ValueRefreshRate)
 };
 
 SCORE_SETTINGS_PARAMETER(Model, LogLevel)
+SCORE_SETTINGS_PARAMETER(Model, ValueRefreshRate)
 SCORE_SETTINGS_DEFERRED_PARAMETER(Model, LocalTree)
 }
 
@@ -5,10 +5,12 @@
 #include "ExplorerModel.hpp"
 
 #include <score/widgets/FormWidget.hpp>
+#include <score/widgets/HelpInteraction.hpp>
 #include <score/widgets/SignalUtils.hpp>
 
 #include <QCheckBox>
 #include <QFormLayout>
+#include <QSpinBox>
 namespace Explorer::Settings
 {
 View::View()
@@ -17,6 +19,12 @@ View::View()
   auto lay = m_widg->layout();
 
   SETTINGS_UI_COMBOBOX_SETUP("Log level", LogLevel, DeviceLogLevel{});
+  SETTINGS_UI_SPINBOX_SETUP("Value refresh rate (hz)", ValueRefreshRate);
+  score::setHelp(
+      m_ValueRefreshRate,
+      tr("Maximum rate at which incoming device values are shown in the explorer. "
+         "Only the latest value of each address is displayed."));
+  m_ValueRefreshRate->setRange(1, 240);
 
   m_cb = new QCheckBox{tr("Enable local tree")};
   lay->addRow(m_cb);
@@ -36,6 +44,7 @@ QWidget* View::getWidget()
 }
 
 SETTINGS_UI_COMBOBOX_IMPL(LogLevel)
+SETTINGS_UI_SPINBOX_IMPL(ValueRefreshRate)
 }
 
 namespace Explorer::ProjectSettings
@@ -22,6 +22,7 @@ public:
   void localTreeChanged(bool arg_1) W_SIGNAL(localTreeChanged, arg_1);
 
   SETTINGS_UI_COMBOBOX_HPP(LogLevel)
+  SETTINGS_UI_SPINBOX_HPP(ValueRefreshRate)
 
 private:
   QWidget* getWidget() override;
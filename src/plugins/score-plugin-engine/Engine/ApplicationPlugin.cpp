@@ -11,11 +11,14 @@
 #include <Scenario/Inspector/Interval/SpeedSlider.hpp>
 #include <Scenario/Settings/ScenarioSettingsModel.hpp>
 
+#include <Execution/Bounce/BounceClock.hpp>
 #include <Execution/DocumentPlugin.hpp>
+#include <Execution/Tuning/SchedulingDocumentPlugin.hpp>
 #include <LocalTree/Device/LocalProtocolFactory.hpp>
 #include <LocalTree/LocalTreeDocumentPlugin.hpp>
 
 #include <score/actions/ActionManager.hpp>
+#include <score/actions/MenuManager.hpp>
 #include <score/actions/ToolbarManager.hpp>
 #include <score/plugins/documentdelegate/plugin/DocumentPluginCreator.hpp>
 #include <score/tools/Bind.hpp>
@@ -26,19 +29,34 @@
 #include <Process/ApplicationPlugin.hpp>
 #include <core/application/ApplicationInterface.hpp>
 #include <core/application/ApplicationSettings.hpp>
+#include <core/document/Document.hpp>
 #include <core/presenter/DocumentManager.hpp>
 
 #include <ossia-qt/invoke.hpp>
 
 #include <QCommandLineParser>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QGuiApplication>
 #include <QLabel>
 #include <QMainWindow>
+#include <QMenu>
+#include <QMessageBox>
+#include <QProgressDialog>
 #include <QTabWidget>
 #include <QTimer>
 #include <QToolBar>
 
 #include <wobjectimpl.h>
 
+#include <cstdio>
+
+SCORE_DECLARE_ACTION(
+    BounceAudio, "&Bounce to audio file...", Common, QKeySequence::UnknownKey)
+SCORE_DECLARE_ACTION(
+    TuneScheduling, "&Measure the scheduling policies", Common,
+    QKeySequence::UnknownKey)
+
 namespace Engine
 {
 ApplicationPlugin::ApplicationPlugin(const score::GUIApplicationContext& ctx)
@@ -95,7 +113,34 @@ void ApplicationPlugin::afterStartup()
 {
   if(!context.documents.documents().empty())
   {
-    if(context.applicationSettings.autoplay)
+    if(!context.applicationSettings.bounce.isEmpty())
+    {
+      QTimer::singleShot(
+          (1 + context.applicationSettings.waitAfterLoad) * 1000, &m_execution, [this] {
+        auto& set = context.applicationSettings;
+        Execution::BounceSettings bounce;
+        bounce.path = set.bounce;
+        bounce.stems = set.bounceStems;
+        bounce.tail = TimeVal::fromMsecs(set.bounceTail * 1000.);
+
+        int percent = -1;
+        const bool ok = m_execution.bounce(bounce, [&percent](double p) {
+          if(int cur = int(p * 100.); cur != percent)
+          {
+            percent = cur;
+            std::fprintf(stderr, "\rBouncing: %d%%", percent);
+            std::fflush(stderr);
+          }
+          return true;
+        });
+        std::fprintf(stderr, "\n");
+        if(ok)
+          std::printf("Bounced to %s\n", qUtf8Printable(bounce.path));
+
+        score::GUIApplicationInterface::instance().forceExit();
+      });
+    }
+    else if(context.applicationSettings.autoplay)
     {
       // TODO what happens if we load multiple documents ?
       QTimer::singleShot(
@@ -259,9 +304,112 @@ score::GUIElements ApplicationPlugin::makeGUIElements()
     }
   }
 
+  if(context.mainWindow)
+  {
+    auto& play = context.menus.get().at(score::Menus::Play());
+    auto& cond = context.actions.condition<score::EnableActionIfDocument>();
+
+    m_bounceAct = new QAction{this};
+    score::setHelp(
+        m_bounceAct,
+        tr("Render the whole score to an audio file, faster than realtime."));
+    connect(m_bounceAct, &QAction::triggered, this, &ApplicationPlugin::bounce);
+    play.menu()->addSeparator();
+    play.menu()->addAction(m_bounceAct);
+
+    e.actions.add<Actions::BounceAudio>(m_bounceAct);
+    cond.add<Actions::BounceAudio>();
+
+    m_tuneSchedulingAct = new QAction{this};
+    score::setHelp(
+        m_tuneSchedulingAct,
+        tr("Run the score for a few seconds with each scheduling policy, without "
+           "sending anything to the devices, and keep the fastest one for this "
+           "document. Used when the scheduling policy is Auto."));
+    connect(
+        m_tuneSchedulingAct, &QAction::triggered, this,
+        &ApplicationPlugin::tuneScheduling);
+    play.menu()->addAction(m_tuneSchedulingAct);
+
+    e.actions.add<Actions::TuneScheduling>(m_tuneSchedulingAct);
+    cond.add<Actions::TuneScheduling>();
+  }
+
   return e;
 }
 
+void ApplicationPlugin::bounce()
+{
+  auto doc = currentDocument();
+  if(!doc)
+    return;
+
+  const auto& meta = doc->metadata();
+  QString suggested = meta.documentName() + QStringLiteral(".wav");
+  if(!meta.projectFolder().isEmpty())
+    suggested = meta.projectFolder() + '/' + suggested;
+
+  Execution::BounceSettings bounce;
+  bounce.path = QFileDialog::getSaveFileName(
+      context.mainWindow, tr("Bounce to audio file"), suggested,
+      tr("Audio files (*.wav *.flac)"));
+  if(bounce.path.isEmpty())
+    return;
+
+  const auto stems = QMessageBox::question(
+      context.mainWindow, tr("Bounce to audio file"),
+      tr("Also write one file per audio output bus, next to the main file?"),
+      QMessageBox::Yes | QMessageBox::No | QMessageBox::Cancel, QMessageBox::No);
+  if(stems == QMessageBox::Cancel)
+    return;
+  bounce.stems = stems == QMessageBox::Yes;
+
+  QProgressDialog progress{
+      tr("Bouncing to %1...").arg(QFileInfo{bounce.path}.fileName()), tr("Cancel"), 0,
+      1000, context.mainWindow};
+  progress.setWindowModality(Qt::WindowModal);
+  progress.setMinimumDuration(0);
+
+  m_execution.bounce(bounce, [&progress](double p) {
+    progress.setValue(int(p * 1000.));
+    return !progress.wasCanceled();
+  });
+
+  progress.close();
+}
+
+void ApplicationPlugin::tuneScheduling()
+{
+  if(!currentDocument())
+    return;
+
+  QGuiApplication::setOverrideCursor(Qt::WaitCursor);
+  const bool ok = m_execution.tune_scheduling();
+  QGuiApplication::restoreOverrideCursor();
+
+  if(!ok)
+  {
+    QMessageBox::warning(
+        context.mainWindow, tr("Scheduling"),
+        tr("The score could not be measured: Static (Fixed) will be used."));
+    return;
+  }
+
+  if(auto doc = currentDocument())
+  {
+    if(auto plug = doc->context().findPlugin<Execution::SchedulingDocumentPlugin>())
+    {
+      const auto& conf = plug->configuration;
+      QMessageBox::information(
+          context.mainWindow, tr("Scheduling"),
+          (conf.parallel ? tr("%1 (parallel) will be used: %2 µs per tick.")
+                         : tr("%1 will be used: %2 µs per tick."))
+              .arg(conf.scheduling)
+              .arg(plug->tickCost, 0, 'f', 1));
+    }
+  }
+}
+
 void ApplicationPlugin::on_initDocument(score::Document& doc)
 {
   score::addDocumentPlugin<LocalTree::DocumentPlugin>(doc);
@@ -68,10 +68,15 @@ public:
   QTimer execution_ui_clock_timer{};
 
 private:
+  void bounce();
+  void tuneScheduling();
+
   Execution::PlayContextMenu m_playActions;
   Execution::ExecutionController m_execution;
 
   Scenario::SpeedWidget* m_speedSlider{};
   QAction* m_musicalAct{};
+  QAction* m_bounceAct{};
+  QAction* m_tuneSchedulingAct{};
 };
 }
@@ -0,0 +1,122 @@
+#include "BenchmarkRing.hpp"
+
+#include <algorithm>
+
+namespace Execution
+{
+BenchmarkRing::BenchmarkRing(std::size_t capacity)
+{
+  std::size_t sz = 2;
+  while(sz < capacity)
+    sz *= 2;
+  m_samples.resize(sz);
+  m_mask = sz - 1;
+}
+
+void BenchmarkRing::push(const ossia::graph_node* node, int64_t ns) noexcept
+{
+  if(m_overflow)
+    return;
+
+  const auto w = m_write.load(std::memory_order_relaxed);
+  const auto r = m_read.load(std::memory_order_acquire);
+  const std::size_t free = m_samples.size() - (w - r);
+
+  // Always keep room for the end-of-tick marker
+  if(m_pending + 2 > free)
+  {
+    m_overflow = true;
+    return;
+  }
+
+  m_samples[(w + m_pending) & m_mask] = {node, ns};
+  m_pending++;
+}
+
+void BenchmarkRing::commit(int64_t total_ns) noexcept
+{
+  const auto w = m_write.load(std::memory_order_relaxed);
+  const auto r = m_read.load(std::memory_order_acquire);
+  const std::size_t free = m_samples.size() - (w - r);
+
+  if(m_overflow || m_pending + 1 > free)
+  {
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+  }
+  else
+  {
+    m_samples[(w + m_pending) & m_mask] = {nullptr, total_ns};
+    m_write.store(w + m_pending + 1, std::memory_order_release);
+  }
+
+  m_pending = 0;
+  m_overflow = false;
+}
+
+void BenchmarkAggregator::Window::push(int64_t v) noexcept
+{
+  samples[pos] = v;
+  pos = (pos + 1) % window_size;
+  count = std::min(count + 1, window_size);
+}
+
+BenchmarkStatistics BenchmarkAggregator::compute(const Window& w) noexcept
+{
+  BenchmarkStatistics s;
+  if(w.count == 0)
+    return s;
+
+  std::array<int64_t, window_size> sorted;
+  std::copy_n(w.samples.begin(), w.count, sorted.begin());
+  std::sort(sorted.begin(), sorted.begin() + w.count);
+
+  int64_t sum = 0;
+  for(int i = 0; i < w.count; i++)
+    sum += sorted[i];
+
+  // Nearest-rank percentile
+  const int p99_rank = std::clamp((99 * w.count + 99) / 100 - 1, 0, w.count - 1);
+
+  s.min = sorted[0];
+  s.max = sorted[w.count - 1];
+  s.mean = sum / w.count;
+  s.p99 = sorted[p99_rank];
+  s.count = w.count;
+  return s;
+}
+
+std::size_t BenchmarkAggregator::consume(BenchmarkRing& ring)
+{
+  return ring.consume([this](const BenchmarkSample& s) {
+    if(s.node)
+      m_nodes[s.node].push(s.ns);
+    else
+      m_total.push(s.ns);
+  });
+}
+
+void BenchmarkAggregator::clear()
+{
+  m_nodes.clear();
+  m_total = {};
+}
+
+void BenchmarkAggregator::remove(const ossia::graph_node* node)
+{
+  m_nodes.erase(node);
+}
+
+BenchmarkStatistics BenchmarkAggregator::total() const noexcept
+{
+  return compute(m_total);
+}
+
+BenchmarkStatistics
+BenchmarkAggregator::statistics(const ossia::graph_node* node) const noexcept
+{
+  auto it = m_nodes.find(node);
+  if(it != m_nodes.end())
+    return compute(it->second);
+  return {};
+}
+}
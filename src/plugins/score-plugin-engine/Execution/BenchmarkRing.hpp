@@ -0,0 +1,126 @@
+#pragma once
+#include <ossia/detail/hash_map.hpp>
+
+#include <score_plugin_engine_export.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace ossia
+{
+class graph_node;
+}
+
+namespace Execution
+{
+//! A timing sample of a node for one tick. A null node marks the end of a
+//! tick and carries the duration of the whole tick.
+struct BenchmarkSample
+{
+  const ossia::graph_node* node{};
+  int64_t ns{};
+};
+
+/**
+ * @brief Single-producer / single-consumer ring of node timings.
+ *
+ * The storage is allocated once when the execution graph is created.
+ * The audio thread writes the samples of a tick in place with push() and
+ * makes them visible to the UI thread with commit(), which only publishes the
+ * write index: nothing is allocated or copied into lambdas.
+ *
+ * If a tick does not fit in the free space it is discarded as a whole and
+ * counted in dropped().
+ */
+class SCORE_PLUGIN_ENGINE_EXPORT BenchmarkRing
+{
+public:
+  explicit BenchmarkRing(std::size_t capacity);
+
+  std::size_t capacity() const noexcept { return m_samples.size(); }
+
+  // Audio thread
+  void push(const ossia::graph_node* node, int64_t ns) noexcept;
+  void commit(int64_t total_ns) noexcept;
+
+  // UI thread
+  template <typename F>
+  std::size_t consume(F&& f) noexcept
+  {
+    const auto w = m_write.load(std::memory_order_acquire);
+    const auto r0 = m_read.load(std::memory_order_relaxed);
+    for(auto r = r0; r != w; ++r)
+      f(m_samples[r & m_mask]);
+    m_read.store(w, std::memory_order_release);
+    return w - r0;
+  }
+
+  int64_t dropped() const noexcept { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+  std::vector<BenchmarkSample> m_samples;
+  std::size_t m_mask{};
+
+  // Producer-local cursor of the tick being written
+  std::size_t m_pending{};
+  bool m_overflow{};
+
+  alignas(64) std::atomic<std::size_t> m_write{};
+  alignas(64) std::atomic<std::size_t> m_read{};
+  std::atomic<int64_t> m_dropped{};
+};
+
+//! Timings of a node over the last ticks that were measured, in nanoseconds.
+struct BenchmarkStatistics
+{
+  int64_t min{};
+  int64_t mean{};
+  int64_t p99{};
+  int64_t max{};
+  int count{};
+};
+
+/**
+ * @brief Aggregates the content of a BenchmarkRing on the UI thread.
+ *
+ * Keeps a sliding window of the last samples of each node, and of the total
+ * tick duration.
+ */
+class SCORE_PLUGIN_ENGINE_EXPORT BenchmarkAggregator
+{
+public:
+  static constexpr int window_size = 128;
+
+  //! Returns the number of samples read
+  std::size_t consume(BenchmarkRing& ring);
+  void clear();
+  void remove(const ossia::graph_node* node);
+
+  BenchmarkStatistics total() const noexcept;
+  BenchmarkStatistics statistics(const ossia::graph_node* node) const noexcept;
+
+  template <typename F>
+  void forEachNode(F&& f) const
+  {
+    for(const auto& [node, w] : m_nodes)
+      f(node, compute(w));
+  }
+
+private:
+  struct Window
+  {
+    std::array<int64_t, window_size> samples{};
+    int count{};
+    int pos{};
+
+    void push(int64_t v) noexcept;
+  };
+
+  static BenchmarkStatistics compute(const Window& w) noexcept;
+
+  ossia::hash_map<const ossia::graph_node*, Window> m_nodes;
+  Window m_total;
+};
+}
@@ -0,0 +1,227 @@
+#include "AudioFileWriter.hpp"
+
+#include <QDebug>
+#include <QFileInfo>
+
+#include <cstring>
+
+#if __has_include(<sndfile.h>)
+#if defined(_WIN32)
+#define ENABLE_SNDFILE_WINDOWS_PROTOTYPES 1
+#endif
+#include <sndfile.h>
+#define SCORE_BOUNCE_HAS_SNDFILE 1
+#endif
+
+namespace Execution
+{
+namespace
+{
+void put_u16(unsigned char* p, uint16_t v) noexcept
+{
+  p[0] = v & 0xFF;
+  p[1] = (v >> 8) & 0xFF;
+}
+void put_u32(unsigned char* p, uint32_t v) noexcept
+{
+  p[0] = v & 0xFF;
+  p[1] = (v >> 8) & 0xFF;
+  p[2] = (v >> 16) & 0xFF;
+  p[3] = (v >> 24) & 0xFF;
+}
+void put_u64(unsigned char* p, uint64_t v) noexcept
+{
+  put_u32(p, v & 0xFFFFFFFF);
+  put_u32(p + 4, v >> 32);
+}
+
+#if defined(SCORE_BOUNCE_HAS_SNDFILE)
+int sndfileFormat(const QString& suffix)
+{
+  if(suffix == "flac")
+    return SF_FORMAT_FLAC | SF_FORMAT_PCM_24;
+  if(suffix == "ogg")
+    return SF_FORMAT_OGG | SF_FORMAT_VORBIS;
+  if(suffix == "aif" || suffix == "aiff")
+    return SF_FORMAT_AIFF | SF_FORMAT_FLOAT;
+  return 0;
+}
+#endif
+}
+
+std::array<unsigned char, wavHeaderSize>
+wavHeader(int channels, int rate, int64_t frames) noexcept
+{
+  // WAVE_FORMAT_IEEE_FLOAT with a fact chunk, as required for non-PCM data
+  const uint32_t block_align = channels * sizeof(float);
+  const uint64_t data_size = uint64_t(frames) * block_align;
+  const uint64_t riff_size = wavHeaderSize - 8 + data_size;
+  const bool rf64 = riff_size > 0xFFFFFFFF;
+
+  std::array<unsigned char, wavHeaderSize> res{};
+  unsigned char* h = res.data();
+  std::memcpy(h, rf64 ? "RF64" : "RIFF", 4);
+  put_u32(h + 4, rf64 ? 0xFFFFFFFF : uint32_t(riff_size));
+  std::memcpy(h + 8, "WAVE", 4);
+
+  // Same size as the ds64 chunk, so that the samples do not move
+  std::memcpy(h + 12, rf64 ? "ds64" : "JUNK", 4);
+  put_u32(h + 16, 28);
+  if(rf64)
+  {
+    put_u64(h + 20, riff_size);
+    put_u64(h + 28, data_size);
+    put_u64(h + 36, frames);
+    put_u32(h + 44, 0);
+  }
+
+  std::memcpy(h + 48, "fmt ", 4);
+  put_u32(h + 52, 18);
+  put_u16(h + 56, 3);
+  put_u16(h + 58, channels);
+  put_u32(h + 60, rate);
+  put_u32(h + 64, rate * block_align);
+  put_u16(h + 68, block_align);
+  put_u16(h + 70, 32);
+  put_u16(h + 72, 0);
+
+  std::memcpy(h + 74, "fact", 4);
+  put_u32(h + 78, 4);
+  put_u32(h + 82, rf64 ? 0xFFFFFFFF : uint32_t(frames));
+
+  std::memcpy(h + 86, "data", 4);
+  put_u32(h + 90, rf64 ? 0xFFFFFFFF : uint32_t(data_size));
+  return res;
+}
+
+AudioFileWriter::~AudioFileWriter()
+{
+  close();
+}
+
+bool AudioFileWriter::open(const QString& path, int channels, int rate)
+{
+  close();
+  if(channels <= 0 || rate <= 0)
+    return false;
+
+  m_channels = channels;
+  m_rate = rate;
+  m_frames = 0;
+
+  const auto suffix = QFileInfo{path}.suffix().toLower();
+  if(suffix == "wav")
+  {
+    // The block alignment is 16-bit
+    if(channels > 0xFFFF / int(sizeof(float)))
+      return false;
+
+    m_wav.setFileName(path);
+    if(!m_wav.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+      qDebug() << "Could not open" << path << "for writing:" << m_wav.errorString();
+      return false;
+    }
+
+    // Placeholder, the sizes are known on close
+    if(!writeWavHeader())
+    {
+      m_wav.close();
+      return false;
+    }
+    return true;
+  }
+
+#if defined(SCORE_BOUNCE_HAS_SNDFILE)
+  if(int format = sndfileFormat(suffix))
+  {
+    SF_INFO info{};
+    info.samplerate = rate;
+    info.channels = channels;
+    info.format = format;
+#if defined(_WIN32)
+    m_sndfile = sf_wchar_open(path.toStdWString().c_str(), SFM_WRITE, &info);
+#else
+    m_sndfile = sf_open(QFile::encodeName(path).constData(), SFM_WRITE, &info);
+#endif
+    if(!m_sndfile)
+    {
+      qDebug() << "Could not open" << path << "for writing:" << sf_strerror(nullptr);
+      return false;
+    }
+
+    // Clip instead of wrapping around for the integer formats
+    sf_command((SNDFILE*)m_sndfile, SFC_SET_CLIPPING, nullptr, SF_TRUE);
+    return true;
+  }
+#endif
+
+  qDebug() << "Unsupported audio file format:" << suffix;
+  return false;
+}
+
+bool AudioFileWriter::isOpen() const noexcept
+{
+  return m_wav.isOpen() || m_sndfile;
+}
+
+bool AudioFileWriter::write(const float* const* channels, int64_t frames)
+{
+  if(!isOpen())
+    return false;
+  if(frames <= 0)
+    return true;
+
+  m_interleaved.resize(frames * m_channels);
+  for(int c = 0; c < m_channels; c++)
+  {
+    const float* src = channels[c];
+    float* dst = m_interleaved.data() + c;
+    for(int64_t i = 0; i < frames; i++)
+      dst[i * m_channels] = src[i];
+  }
+
+  if(m_wav.isOpen())
+  {
+    // The RIFF data is little-endian like all our targets
+    const auto bytes = qint64(m_interleaved.size() * sizeof(float));
+    if(m_wav.write((const char*)m_interleaved.data(), bytes) != bytes)
+      return false;
+  }
+#if defined(SCORE_BOUNCE_HAS_SNDFILE)
+  else if(m_sndfile)
+  {
+    if(sf_writef_float((SNDFILE*)m_sndfile, m_interleaved.data(), frames) != frames)
+      return false;
+  }
+#endif
+
+  m_frames += frames;
+  return true;
+}
+
+bool AudioFileWriter::close()
+{
+  bool ok = true;
+  if(m_wav.isOpen())
+  {
+    ok = m_wav.seek(0) && writeWavHeader() && m_wav.flush();
+    m_wav.close();
+  }
+
+#if defined(SCORE_BOUNCE_HAS_SNDFILE)
+  if(m_sndfile)
+  {
+    ok = sf_close((SNDFILE*)m_sndfile) == 0 && ok;
+    m_sndfile = nullptr;
+  }
+#endif
+  return ok;
+}
+
+bool AudioFileWriter::writeWavHeader()
+{
+  const auto h = wavHeader(m_channels, m_rate, m_frames);
+  return m_wav.write((const char*)h.data(), h.size()) == qint64(h.size());
+}
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <QFile>
+#include <QString>
+
+#include <score_plugin_engine_export.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace Execution
+{
+//! Size of the header of the .wav files written by AudioFileWriter
+static constexpr int wavHeaderSize = 94;
+
+/**
+ * @brief Header of a 32-bit float .wav file of `frames` samples per channel.
+ *
+ * A RIFF file if its size fits in 32 bits: the space of the RF64 ds64 chunk
+ * is then a JUNK chunk. Past 4 GiB, an RF64 file (EBU Tech 3306), whose
+ * 32-bit sizes are all set to 0xFFFFFFFF.
+ */
+SCORE_PLUGIN_ENGINE_EXPORT
+std::array<unsigned char, wavHeaderSize>
+wavHeader(int channels, int rate, int64_t frames) noexcept;
+
+/**
+ * @brief Writes planar float buffers to an audio file.
+ *
+ * .wav files are written directly as 32-bit float.
+ * Other formats (.flac, .ogg, .aiff...) go through libsndfile when available.
+ */
+class AudioFileWriter
+{
+public:
+  AudioFileWriter() = default;
+  AudioFileWriter(const AudioFileWriter&) = delete;
+  AudioFileWriter& operator=(const AudioFileWriter&) = delete;
+  ~AudioFileWriter();
+
+  bool open(const QString& path, int channels, int rate);
+  bool isOpen() const noexcept;
+
+  //! Writes `frames` samples from each of the `channels` buffers given to open.
+  //! Returns false if the file could not be written, e.g. disk full.
+  bool write(const float* const* channels, int64_t frames);
+
+  //! Returns false if the end of the file could not be written.
+  bool close();
+
+  int channels() const noexcept { return m_channels; }
+  int64_t writtenFrames() const noexcept { return m_frames; }
+
+private:
+  bool writeWavHeader();
+
+  QFile m_wav;
+  void* m_sndfile{};
+  std::vector<float> m_interleaved;
+  int m_channels{};
+  int m_rate{};
+  int64_t m_frames{};
+};
+}
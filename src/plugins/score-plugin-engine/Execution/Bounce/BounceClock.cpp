@@ -0,0 +1,281 @@
+#include "BounceClock.hpp"
+
+#include <Process/ExecutionAction.hpp>
+
+#include <Scenario/Document/Interval/IntervalExecution.hpp>
+
+#include <Audio/AudioApplicationPlugin.hpp>
+#include <Audio/AudioDevice.hpp>
+#include <Audio/AudioTick.hpp>
+#include <Execution/BaseScenarioComponent.hpp>
+#include <Execution/Bounce/AudioFileWriter.hpp>
+#include <Execution/DocumentPlugin.hpp>
+#include <Execution/ExecutionTick.hpp>
+
+#include <ossia/audio/audio_parameter.hpp>
+#include <ossia/dataflow/execution_state.hpp>
+#include <ossia/detail/thread.hpp>
+#include <ossia/network/base/device.hpp>
+#include <ossia/network/base/node.hpp>
+
+#include <QDir>
+#include <QFileInfo>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace Execution
+{
+namespace
+{
+void findOutputBuses(
+    const ossia::net::node_base& node,
+    std::vector<std::pair<QString, ossia::audio_mapping>>& buses)
+{
+  const auto& attr = node.get_extended_attributes();
+  if(auto kind_it = attr.find("audio-kind"); kind_it != attr.end())
+  {
+    if(ossia::any_cast<std::string>(kind_it->second) == "out")
+    {
+      if(auto map_it = attr.find("audio-mapping"); map_it != attr.end())
+      {
+        buses.emplace_back(
+            QString::fromStdString(node.get_name()),
+            ossia::any_cast<ossia::audio_mapping>(map_it->second));
+      }
+    }
+  }
+
+  for(auto& child : node.children())
+    findOutputBuses(*child, buses);
+}
+}
+
+BounceClock::BounceClock(const Execution::Context& ctx, BounceSettings settings)
+    : Execution::Clock{ctx}
+    , m_default{ctx}
+    , m_plug{context.doc.plugin<Execution::DocumentPlugin>()}
+    , m_engine{context.doc.app.guiApplicationPlugin<Audio::ApplicationPlugin>().audio}
+    , m_settings{std::move(settings)}
+{
+}
+
+BounceClock::~BounceClock()
+{
+  // The tick must not be destroyed while the worker uses it.
+  // Leaving the offline mode first releases a worker waiting for a frame.
+  m_cancel.store(true, std::memory_order_relaxed);
+  endOfflineRender();
+  while(m_running.load(std::memory_order_relaxed) && !done())
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+  // Destroying the execution tick posts its cleanup in the execution queue:
+  // the worker is still there to process it.
+  m_play_tick = {};
+
+  m_running.store(false, std::memory_order_release);
+  if(m_thread.joinable())
+    m_thread.join();
+
+  if(m_engine)
+    m_engine->set_tick(Audio::makePauseTick(context.doc.app));
+}
+
+double BounceClock::progress() const noexcept
+{
+  return double(m_rendered.load(std::memory_order_relaxed))
+         / double(m_total.load(std::memory_order_relaxed));
+}
+
+void BounceClock::play_impl(const TimeVal& t)
+{
+  auto& execState = *context.execState;
+  const int rate = execState.sampleRate;
+  const int frames = execState.bufferSize;
+  if(!m_engine || rate <= 0 || frames <= 0)
+  {
+    m_error = QObject::tr("The audio engine is not running.");
+    m_done = true;
+    return;
+  }
+
+  const int n_out = m_engine->effective_outputs;
+  if(!openFiles(n_out, rate))
+  {
+    m_done = true;
+    return;
+  }
+
+  auto& itv = scenario->baseInterval().scoreInterval();
+  const auto duration = itv.duration.defaultDuration() - t + m_settings.tail;
+  const int64_t total = std::max(
+      int64_t(1), int64_t(std::ceil(duration.impl * execState.modelToSamplesRatio)));
+  m_total = total;
+
+  m_default.play(t, *scenario);
+
+  m_play_tick = Execution::makeExecutionTick(
+      Execution::makeTickOptions(m_plug.settings), m_plug, scenario);
+
+  m_pause_tick = Execution::makeOfflinePauseTick(m_plug);
+
+  // Same actions as in Execution::makeExecutionTick
+  m_actions = m_plug.actions();
+  for(Execution::ExecutionAction& act :
+      context.doc.app.interfaces<Execution::ExecutionActionList>())
+    m_actions.push_back(&act);
+
+  for(auto act : m_actions)
+    act->beginOfflineRender(rate);
+  m_offline = true;
+
+  // The sound card stays silent during the render
+  m_engine->set_tick([](const ossia::audio_tick_state& t) {
+    for(int chan = 0; chan < t.n_out; chan++)
+      std::fill_n(t.outputs[chan], t.frames, 0.f);
+  });
+
+  m_running = true;
+  m_thread = std::thread{[this, n_in = m_engine->effective_inputs, n_out, frames, total,
+                          rate] { run(n_in, n_out, frames, total, rate); }};
+}
+
+void BounceClock::pause_impl() { }
+
+void BounceClock::resume_impl() { }
+
+void BounceClock::stop_impl()
+{
+  cancel();
+  endOfflineRender();
+  m_default.stop(*scenario);
+  m_plug.finished();
+}
+
+bool BounceClock::paused() const
+{
+  return false;
+}
+
+void BounceClock::endOfflineRender()
+{
+  if(!m_offline)
+    return;
+  m_offline = false;
+
+  for(auto act : m_actions)
+    act->endOfflineRender();
+}
+
+bool BounceClock::openFiles(int channels, int rate)
+{
+  m_master = std::make_unique<AudioFileWriter>();
+  if(!m_master->open(m_settings.path, channels, rate))
+  {
+    m_error = QObject::tr("Could not open %1 for writing.").arg(m_settings.path);
+    return false;
+  }
+
+  if(!m_settings.stems || !m_plug.audio_device)
+    return true;
+
+  auto dev = m_plug.audio_device->getDevice();
+  if(!dev)
+    return true;
+
+  std::vector<std::pair<QString, ossia::audio_mapping>> buses;
+  findOutputBuses(dev->get_root_node(), buses);
+
+  // Next to the master: foo.wav -> foo.bus.wav
+  const QFileInfo info{m_settings.path};
+  const QDir dir = info.absoluteDir();
+  for(auto& [name, mapping] : buses)
+  {
+    Stem stem;
+    for(int chan : mapping)
+      if(chan >= 0 && chan < channels)
+        stem.channels.push_back(chan);
+    if(stem.channels.empty())
+      continue;
+
+    const auto path = dir.filePath(
+        QStringLiteral("%1.%2.%3").arg(info.completeBaseName(), name, info.suffix()));
+    stem.file = std::make_unique<AudioFileWriter>();
+    if(!stem.file->open(path, stem.channels.size(), rate))
+    {
+      m_error = QObject::tr("Could not open %1 for writing.").arg(path);
+      return false;
+    }
+    m_stems.push_back(std::move(stem));
+  }
+  return true;
+}
+
+void BounceClock::run(int n_in, int n_out, int frames, int64_t total, int rate)
+{
+  ossia::set_thread_name("ossia bounce");
+  ossia::set_thread_pinned(ossia::thread_type::Audio, 0);
+
+  std::vector<float> buffers((n_in + n_out) * std::size_t(frames), 0.f);
+  std::vector<float*> inputs(n_in), outputs(n_out);
+  for(int i = 0; i < n_in; i++)
+    inputs[i] = buffers.data() + i * std::size_t(frames);
+  for(int i = 0; i < n_out; i++)
+    outputs[i] = buffers.data() + (n_in + i) * std::size_t(frames);
+
+  std::vector<std::vector<const float*>> stems;
+  stems.reserve(m_stems.size());
+  for(auto& stem : m_stems)
+  {
+    auto& chans = stems.emplace_back();
+    for(int c : stem.channels)
+      chans.push_back(outputs[c]);
+  }
+
+  ossia::audio_tick_state st;
+  st.inputs = inputs.data();
+  st.outputs = outputs.data();
+  st.n_in = n_in;
+  st.n_out = n_out;
+  st.frames = frames;
+
+  // Always full buffers: the graph expects the configured buffer size.
+  // The last one is cut when writing.
+  int64_t rendered = 0;
+  while(rendered < total && !m_cancel.load(std::memory_order_relaxed))
+  {
+    const int64_t n = std::min(int64_t(frames), total - rendered);
+    st.seconds = double(rendered) / rate;
+
+    std::fill(buffers.begin(), buffers.end(), 0.f);
+    m_play_tick(st);
+
+    bool written = m_master->write(outputs.data(), n);
+    for(std::size_t i = 0; i < m_stems.size(); i++)
+      written = m_stems[i].file->write(stems[i].data(), n) && written;
+    if(!written)
+      break;
+
+    rendered += n;
+    m_rendered.store(rendered, std::memory_order_relaxed);
+  }
+
+  // Read by the UI thread once done
+  bool closed = m_master->close();
+  for(auto& stem : m_stems)
+    closed = stem.file->close() && closed;
+  if(!closed || (rendered < total && !m_cancel.load(std::memory_order_relaxed)))
+    m_error = QObject::tr("Could not write the audio files, is the disk full?");
+  m_done.store(true, std::memory_order_release);
+
+  // Keep the execution queue alive like a paused engine would
+  const auto period = std::chrono::duration<double>(double(frames) / rate);
+  while(m_running.load(std::memory_order_acquire))
+  {
+    m_pause_tick(st);
+    std::this_thread::sleep_for(period);
+  }
+  m_pause_tick(st);
+}
+}
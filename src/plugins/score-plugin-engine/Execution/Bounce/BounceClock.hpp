@@ -0,0 +1,101 @@
+#pragma once
+#include <Process/TimeValue.hpp>
+
+#include <Execution/Clock/ClockFactory.hpp>
+#include <Execution/Clock/DefaultClock.hpp>
+
+#include <ossia/audio/audio_engine.hpp>
+
+#include <QString>
+
+#include <score_plugin_engine_export.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace Execution
+{
+class DocumentPlugin;
+class AudioFileWriter;
+class ExecutionAction;
+
+struct BounceSettings
+{
+  //! Master output. The extension gives the format: .wav, or .flac if libsndfile is available
+  QString path;
+
+  //! Also write one file per output bus of the audio device, next to the master
+  bool stems{};
+
+  //! Rendered after the end of the root interval, e.g. for reverb tails
+  TimeVal tail{};
+};
+
+/**
+ * @brief Renders the root interval offline, as fast as possible.
+ *
+ * Instead of waiting for the audio engine callbacks, a worker thread calls
+ * the execution tick in a loop, and streams the outputs to audio files.
+ * The sound card is silenced meanwhile.
+ *
+ * The execution actions are told that the render is offline: this is how
+ * e.g. the video outputs render exactly one frame per period of score time,
+ * in lock-step with the ticks, however long a frame takes.
+ *
+ * Once everything has been rendered, the thread keeps processing the
+ * execution commands like a paused engine would, until the clock is destroyed.
+ */
+class SCORE_PLUGIN_ENGINE_EXPORT BounceClock final : public Execution::Clock
+{
+public:
+  BounceClock(const Execution::Context& ctx, BounceSettings settings);
+  ~BounceClock() override;
+
+  //! Between 0 and 1
+  double progress() const noexcept;
+  bool done() const noexcept { return m_done.load(std::memory_order_acquire); }
+  void cancel() noexcept { m_cancel.store(true, std::memory_order_relaxed); }
+
+  //! Empty if everything went fine
+  const QString& error() const noexcept { return m_error; }
+
+private:
+  void play_impl(const TimeVal& t) override;
+  void pause_impl() override;
+  void resume_impl() override;
+  void stop_impl() override;
+  bool paused() const override;
+
+  bool openFiles(int channels, int rate);
+  void endOfflineRender();
+  void run(int n_in, int n_out, int frames, int64_t total, int rate);
+
+  Execution::DefaultClock m_default;
+  DocumentPlugin& m_plug;
+  std::shared_ptr<ossia::audio_engine> m_engine;
+  BounceSettings m_settings;
+  QString m_error;
+
+  ossia::audio_engine::fun_type m_play_tick{};
+  ossia::audio_engine::fun_type m_pause_tick{};
+
+  std::vector<ExecutionAction*> m_actions;
+  bool m_offline{};
+
+  std::unique_ptr<AudioFileWriter> m_master;
+  struct Stem
+  {
+    std::unique_ptr<AudioFileWriter> file;
+    std::vector<int> channels;
+  };
+  std::vector<Stem> m_stems;
+
+  std::atomic_int64_t m_rendered{};
+  std::atomic_int64_t m_total{1};
+  std::atomic_bool m_done{};
+  std::atomic_bool m_cancel{};
+  std::atomic_bool m_running{};
+  std::thread m_thread;
+};
+}
@@ -39,29 +39,7 @@ void Clock::play_impl(const TimeVal& t)
 
   m_default.play(t, *this->scenario);
 
-  auto tick = m_plug.settings.getTick();
-  auto commit = m_plug.settings.getCommit();
-
-  ossia::tick_setup_options opt;
-  if(tick == Execution::Settings::TickPolicies{}.Buffer)
-    opt.tick = ossia::tick_setup_options::Buffer;
-  else if(tick == Execution::Settings::TickPolicies{}.ScoreAccurate)
-    opt.tick = ossia::tick_setup_options::ScoreAccurate;
-  else if(tick == Execution::Settings::TickPolicies{}.Precise)
-    opt.tick = ossia::tick_setup_options::Precise;
-
-  if(commit == Execution::Settings::CommitPolicies{}.Default)
-    opt.commit = ossia::tick_setup_options::Default;
-  else if(commit == Execution::Settings::CommitPolicies{}.Ordered)
-    opt.commit = ossia::tick_setup_options::Ordered;
-  else if(commit == Execution::Settings::CommitPolicies{}.Priorized)
-    opt.commit = ossia::tick_setup_options::Priorized;
-  else if(commit == Execution::Settings::CommitPolicies{}.Merged)
-    opt.commit = ossia::tick_setup_options::Merged;
-  else if(commit == Execution::Settings::CommitPolicies{}.MergedThreaded)
-    opt.commit = ossia::tick_setup_options::MergedThreaded;
-  else if(commit == Execution::Settings::CommitPolicies{}.DirectThreaded)
-    opt.commit = ossia::tick_setup_options::DirectThreaded;
+  const auto opt = Execution::makeTickOptions(m_plug.settings);
 
   if(m_plug.settings.getBench() && m_plug.contextData()->bench)
   {
@@ -117,6 +95,17 @@ void Clock::play_impl(const TimeVal& t)
         {
         }
       }
+      while(context->m_workerQueue.try_dequeue(c))
+      {
+        try
+        {
+          c();
+          context->m_gcQueue.enqueue(Execution::gc(std::move(c)));
+        }
+        catch(...)
+        {
+        }
+      }
 
       context->m_gcQueue.enqueue(Execution::gc(std::move(context)));
     }
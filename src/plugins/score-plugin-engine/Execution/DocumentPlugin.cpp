@@ -9,6 +9,7 @@
 #include <Scenario/Application/ScenarioActions.hpp>
 #include <Scenario/Document/BaseScenario/BaseScenario.hpp>
 #include <Scenario/Document/Interval/IntervalExecution.hpp>
+#include <Scenario/Document/Interval/IntervalModel.hpp>
 #include <Scenario/Document/ScenarioDocument/ScenarioDocumentModel.hpp>
 #include <Scenario/Document/State/StateExecution.hpp>
 #include <Scenario/Execution/score2OSSIA.hpp>
@@ -50,8 +51,8 @@ DocumentPlugin::ContextData::ContextData(const score::DocumentContext& ctx)
     : setupContext{context}
     , context
 {
-  {}, ctx, m_created, {}, {}, m_execQueue, m_editionQueue, m_gcQueue, setupContext,
-      execGraph, execState
+  {}, ctx, m_created, {}, {}, m_execQueue, m_editionQueue, m_gcQueue, m_workerQueue,
+      setupContext, execGraph, execState
 #if(__cplusplus > 201703L) && !defined(_MSC_VER)
       ,
   {
@@ -185,23 +186,51 @@ void DocumentPlugin::initExecState()
                       .devices();
   if(audio_device)
     m_ctxData->execState->register_device(audio_device->getDevice());
-  if(local_device)
-    m_ctxData->execState->register_device(local_device->getDevice());
-  for(auto dev : devlist)
+  if(!m_devicesMuted)
   {
-    registerDevice(dev->getDevice());
+    if(local_device)
+      m_ctxData->execState->register_device(local_device->getDevice());
+    for(auto dev : devlist)
+    {
+      registerDevice(dev->getDevice());
+    }
   }
   m_ctxData->execState->apply_device_changes();
 }
 
+void DocumentPlugin::setDevicesMuted(bool muted)
+{
+  if(m_devicesMuted == muted)
+    return;
+  m_devicesMuted = muted;
+  initExecState();
+}
+
 void DocumentPlugin::timerEvent(QTimerEvent* event)
 {
   processEditCommands();
+  slot_bench();
+
+  // Until the first tick, the look-ahead is the one set up by reload
+  if(m_base && m_base->active())
+  {
+    auto& root = m_base->baseInterval();
+    if(root.scoreInterval().executing())
+      updateLookAhead(root.currentTime());
+  }
+}
+
+void DocumentPlugin::updateLookAhead(TimeVal now)
+{
+  if(m_ctxData->setupContext.lookAhead <= TimeVal::zero())
+    return;
+
+  m_base->baseInterval().updateLookAhead(TimeVal::zero(), now);
 }
 
 void DocumentPlugin::registerDevice(ossia::net::device_base* d)
 {
-  if(!d)
+  if(!d || m_devicesMuted)
     return;
   if(m_ctxData->execState)
   {
@@ -231,7 +260,8 @@ void DocumentPlugin::makeGraph()
   // valeurs. parallel avec dynamic il manque le cas "default score order" il
   // manque le log pour dynamic
 
-  auto sched = settings.getScheduling();
+  const auto conf = scheduling();
+  const auto& sched = conf.scheduling;
 
   auto& execGraph = m_ctxData->execGraph;
   auto& execState = m_ctxData->execState;
@@ -271,7 +301,7 @@ void DocumentPlugin::makeGraph()
   }
 
   ossia::graph_setup_options opt;
-  opt.parallel = settings.getParallel();
+  opt.parallel = conf.parallel;
   opt.parallel_threads = settings.getThreads();
   if(settings.getLogging())
     opt.log = ossia::logger_ptr();
@@ -280,7 +310,12 @@ void DocumentPlugin::makeGraph()
     bench = std::make_shared<bench_map>();
     opt.bench = bench;
     opt.bench->clear();
+
+    // One measured tick every 50 buffers: enough room for a few seconds of
+    // samples if the UI thread stalls.
+    m_ctxData->benchRing = std::make_shared<BenchmarkRing>(65536);
   }
+  m_bench.clear();
 
   if(sched == sched_t.StaticFixed)
     opt.scheduling = ossia::graph_setup_options::StaticFixed;
@@ -290,12 +325,31 @@ void DocumentPlugin::makeGraph()
     opt.scheduling = ossia::graph_setup_options::StaticTC;
   else if(sched == sched_t.Dynamic)
     opt.scheduling = ossia::graph_setup_options::Dynamic;
+  else
+    opt.scheduling = ossia::graph_setup_options::StaticFixed;
 
-  opt.scheduling = ossia::graph_setup_options::StaticFixed;
   execGraph = ossia::make_graph(opt);
 }
 
-void DocumentPlugin::reload(bool forcePlay, Scenario::IntervalModel& cst)
+SchedulingConfiguration DocumentPlugin::scheduling() const
+{
+  if(schedulingOverride)
+    return *schedulingOverride;
+
+  static const Execution::Settings::SchedulingPolicies sched_t;
+  auto sched = settings.getScheduling();
+  if(sched != sched_t.Auto)
+    return {sched, settings.getParallel()};
+
+  // Until the document has been measured
+  if(auto plug = m_context.findPlugin<SchedulingDocumentPlugin>())
+    if(!plug->configuration.scheduling.isEmpty())
+      return plug->configuration;
+  return {sched_t.StaticFixed, settings.getParallel()};
+}
+
+void DocumentPlugin::reload(
+    bool forcePlay, Scenario::IntervalModel& cst, TimeVal start)
 {
   if(m_base)
   {
@@ -315,7 +369,9 @@ void DocumentPlugin::reload(bool forcePlay, Scenario::IntervalModel& cst)
 
   // Notify devices that they have to start running stuff, polling frames, etc.
   auto& devs = m_context.plugin<Explorer::DeviceDocumentPlugin>();
-  devs.list().apply([](const Device::DeviceInterface& d) {
+  devs.list().apply([this](const Device::DeviceInterface& d) {
+    if(m_devicesMuted && &d != audio_device.data())
+      return;
     if(auto dev = d.getDevice())
       dev->get_protocol().start_execution();
   });
@@ -325,6 +381,9 @@ void DocumentPlugin::reload(bool forcePlay, Scenario::IntervalModel& cst)
   auto parent = dynamic_cast<Scenario::ScenarioInterface*>(cst.parent());
   SCORE_ASSERT(parent);
 
+  m_ctxData->setupContext.lookAhead
+      = TimeVal::fromMsecs(1000. * settings.getLookAhead());
+
   recreateBase();
   m_base->init(forcePlay, BaseScenarioRefContainer{cst, *parent});
   m_ctxData->m_created = true;
@@ -347,6 +406,9 @@ void DocumentPlugin::reload(bool forcePlay, Scenario::IntervalModel& cst)
   }
   t.run_all();
 
+  // Creates the processes of the intervals around the start position
+  updateLookAhead(start);
+
   m_tid = startTimer(32);
 }
 
@@ -471,23 +533,40 @@ void DocumentPlugin::registerAction(ExecutionAction& act)
   m_actions.push_back(&act);
 }
 
-void DocumentPlugin::slot_bench(ossia::bench_map b, int64_t ns)
+void DocumentPlugin::slot_bench()
 {
-  for(const auto& p : b)
-  {
-    if(p.second)
+  if(!m_ctxData || !m_ctxData->benchRing)
+    return;
+
+  if(m_bench.consume(*m_ctxData->benchRing) == 0)
+    return;
+
+  const auto total = m_bench.total();
+  if(total.mean <= 0)
+    return;
+
+  const auto& proc_map = m_ctxData->setupContext.proc_map;
+  std::vector<const ossia::graph_node*> stale;
+  m_bench.forEachNode(
+      [&](const ossia::graph_node* node, const BenchmarkStatistics& stats) {
+    auto proc = proc_map.find(node);
+    if(proc == proc_map.end())
     {
-      auto proc = m_ctxData->setupContext.proc_map.find(p.first);
-      if(proc != m_ctxData->setupContext.proc_map.end())
-      {
-        if(proc->second)
-        {
-          const_cast<Process::ProcessModel*>(proc->second)
-              ->benchmark(100. * *p.second / (double)ns);
-        }
-      }
+      stale.push_back(node);
+      return;
     }
-  }
+
+    if(proc->second)
+    {
+      const_cast<Process::ProcessModel*>(proc->second)
+          ->benchmark(100. * stats.mean / (double)total.mean);
+    }
+  });
+
+  // The node was removed from the graph, do not mix its timings with a node
+  // that could later be allocated at the same address
+  for(auto node : stale)
+    m_bench.remove(node);
 }
 
 void DocumentPlugin::on_deviceAdded(Device::DeviceInterface* dev)
@@ -1,11 +1,14 @@
 #pragma once
 #include "BaseScenarioComponent.hpp"
+#include "BenchmarkRing.hpp"
 
 #include <Process/Dataflow/Port.hpp>
 #include <Process/ExecutionAction.hpp>
 #include <Process/ExecutionContext.hpp>
 #include <Process/ExecutionSetup.hpp>
 
+#include <Execution/Tuning/SchedulingDocumentPlugin.hpp>
+
 #include <score/plugins/documentdelegate/plugin/DocumentPlugin.hpp>
 #include <score/tools/Metadata.hpp>
 
@@ -17,6 +20,7 @@
 #include <QTimer>
 
 #include <memory>
+#include <optional>
 #include <verdigris>
 inline QDataStream& operator<<(QDataStream& i, const ossia::bench_map& sel)
 {
@@ -68,11 +72,13 @@ public:
     ExecutionCommandQueue m_execQueue{1024};
     EditionCommandQueue m_editionQueue{1024};
     GCCommandQueue m_gcQueue{1024};
+    WorkerResultQueue m_workerQueue{1024};
     std::atomic_bool m_created{};
 
     std::shared_ptr<ossia::graph_interface> execGraph;
     std::shared_ptr<ossia::execution_state> execState;
     std::shared_ptr<ossia::bench_map> bench;
+    std::shared_ptr<BenchmarkRing> benchRing;
     SetupContext setupContext;
 
     Context context;
@@ -81,7 +87,8 @@ public:
   DocumentPlugin(const score::DocumentContext& ctx, QObject* parent);
 
   ~DocumentPlugin() override;
-  void reload(bool forcePlay, Scenario::IntervalModel& doc);
+  //! start is the date the execution will start from, in the interval
+  void reload(bool forcePlay, Scenario::IntervalModel& doc, TimeVal start);
   void clear();
 
   void on_documentClosing() override;
@@ -107,10 +114,23 @@ public:
   QPointer<Dataflow::AudioDevice> audio_device{};
   QPointer<Device::DeviceInterface> local_device{};
 
+  //! Used instead of the settings by the next graphs, to measure each scheduling
+  std::optional<SchedulingConfiguration> schedulingOverride;
+
+  /**
+   * While set, the execution states only know the audio device:
+   * the processes run, but their addresses are not found and nothing is sent
+   * to the other devices. Call it while the document is not executing.
+   */
+  void setDevicesMuted(bool muted);
+
 public:
   void finished() E_SIGNAL(SCORE_PLUGIN_ENGINE_EXPORT, finished)
 
-  void slot_bench(ossia::bench_map, int64_t ns);
+  void slot_bench();
+
+  //! Timings of the nodes measured since the graph was created
+  const BenchmarkAggregator& benchmarks() const noexcept { return m_bench; }
 
 private:
   void on_deviceAdded(Device::DeviceInterface* device);
@@ -119,13 +139,17 @@ private:
   void registerDevice(ossia::net::device_base*);
   void unregisterDevice(ossia::net::device_base*);
   void makeGraph();
+  SchedulingConfiguration scheduling() const;
   void initExecState();
   void recreateBase();
   void processEditCommands();
+  void updateLookAhead(TimeVal now);
 
   std::shared_ptr<ContextData> m_ctxData;
+  bool m_devicesMuted{};
   std::shared_ptr<BaseScenarioElement> m_base;
   std::vector<ExecutionAction*> m_actions;
+  BenchmarkAggregator m_bench;
 
   int m_tid{};
 };
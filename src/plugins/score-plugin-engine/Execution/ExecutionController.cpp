@@ -15,12 +15,18 @@
 
 #include <Audio/AudioApplicationPlugin.hpp>
 #include <Audio/Settings/Model.hpp>
+#include <Execution/Bounce/BounceClock.hpp>
 #include <Execution/Clock/ClockFactory.hpp>
 #include <Execution/DocumentPlugin.hpp>
 #include <Execution/Settings/ExecutorModel.hpp>
+#include <Execution/Tuning/SchedulingCommands.hpp>
+#include <Execution/Tuning/SchedulingDocumentPlugin.hpp>
+#include <Execution/Tuning/TuningClock.hpp>
 
 #include <score/actions/ActionManager.hpp>
+#include <score/command/Dispatchers/CommandDispatcher.hpp>
 #include <score/model/ComponentUtils.hpp>
+#include <score/plugins/documentdelegate/plugin/DocumentPluginCreator.hpp>
 #include <score/tools/Bind.hpp>
 #include <score/widgets/MessageBox.hpp>
 
@@ -32,8 +38,12 @@
 #include <ossia/editor/scenario/time_interval.hpp>
 #include <ossia/editor/state/state.hpp>
 
+#include <QEventLoop>
 #include <QGuiApplication>
 #include <QMainWindow>
+#include <QTimer>
+
+#include <cstdio>
 
 #include <Transport/DocumentPlugin.hpp>
 #include <Transport/TransportInterface.hpp>
@@ -209,6 +219,9 @@ void ExecutionController::request_stop()
 
 void ExecutionController::trigger_play()
 {
+  if(m_bouncing)
+    return;
+
   if(!m_intervalsToPlay.empty())
   {
     m_actions.onPlayLocal();
@@ -236,12 +249,18 @@ void ExecutionController::trigger_play()
 
 void ExecutionController::trigger_pause()
 {
+  if(m_bouncing)
+    return;
+
   m_actions.onPause();
   on_pause();
 }
 
 void ExecutionController::trigger_stop()
 {
+  if(m_bouncing)
+    return;
+
   m_actions.onStop();
   on_stop();
 
@@ -251,6 +270,9 @@ void ExecutionController::trigger_stop()
 
 void ExecutionController::trigger_reinitialize()
 {
+  if(m_bouncing)
+    return;
+
   m_actions.onStop();
   on_reinitialize();
 
@@ -335,7 +357,7 @@ void ExecutionController::on_pause()
 
 void ExecutionController::on_transport(TimeVal t)
 {
-  if(!m_clock)
+  if(!m_clock || m_bouncing)
     return;
 
   SCORE_ASSERT(m_clock->scenario);
@@ -478,6 +500,178 @@ void ExecutionController::request_end_scrub(TimeVal t)
   }
 }
 
+bool ExecutionController::bounce(
+    const BounceSettings& settings, std::function<bool(double)> progress)
+{
+  if(m_bouncing)
+    return false;
+
+  if(m_playing)
+    trigger_stop();
+
+  auto scenar = currentScenarioModel();
+  if(!scenar)
+    return false;
+
+  auto& ctx = scenar->context();
+  auto exec_plug = ctx.findPlugin<Execution::DocumentPlugin>();
+  if(!exec_plug)
+    return false;
+
+  ensure_audio_engine();
+  if(!context.guiApplicationPlugin<Audio::ApplicationPlugin>().audio)
+    return false;
+
+  if(auto explorer = Explorer::try_deviceExplorerFromObject(ctx.document))
+  {
+    if(!exec_plug->settings.getExecutionListening())
+      explorer->deviceModel().listening().stop();
+  }
+
+  // The transport requests are ignored until the render is finished
+  m_bouncing = true;
+
+  // Nobody is there to trigger the top-level conditions
+  exec_plug->reload(true, scenar->baseInterval(), TimeVal::zero());
+
+  auto clock = std::make_unique<BounceClock>(exec_plug->context(), settings);
+  auto& bounce = *clock;
+  m_clock = std::move(clock);
+  m_clock->play(TimeVal::zero());
+  m_playing = true;
+  m_paused = false;
+  ctx.execTimer.start();
+
+  bool cancelled = false;
+  if(!bounce.done())
+  {
+    QEventLoop loop;
+    QTimer timer;
+    connect(&timer, &QTimer::timeout, &loop, [&] {
+      if(progress && !progress(bounce.progress()) && !cancelled)
+      {
+        cancelled = true;
+        bounce.cancel();
+      }
+      if(bounce.done())
+        loop.quit();
+    });
+    timer.start(50);
+    loop.exec();
+  }
+
+  const QString error = bounce.error();
+  m_bouncing = false;
+  on_stop();
+
+  if(!error.isEmpty())
+  {
+    if(this->context.mainWindow)
+      score::warning(this->context.mainWindow, tr("Cannot bounce"), error);
+    else
+      std::fprintf(stderr, "Cannot bounce: %s\n", qUtf8Printable(error));
+    return false;
+  }
+  return !cancelled;
+}
+
+// Enough to get past the beginning of most scores, while staying under a few seconds
+static constexpr int scheduling_tuning_ticks = 1000;
+
+static std::vector<SchedulingConfiguration> schedulingCandidates()
+{
+  const Execution::Settings::SchedulingPolicies sched;
+  // The dynamic scheduling has no parallel implementation
+  return {
+      {sched.StaticFixed, false}, {sched.StaticBFS, false}, {sched.StaticTC, false},
+      {sched.Dynamic, false},     {sched.StaticFixed, true}, {sched.StaticBFS, true},
+      {sched.StaticTC, true}};
+}
+
+bool ExecutionController::tune_scheduling()
+{
+  if(m_bouncing || m_playing)
+    return false;
+
+  auto doc = currentDocument();
+  auto scenar = currentScenarioModel();
+  if(!doc || !scenar)
+    return false;
+
+  auto& ctx = scenar->context();
+  auto exec_plug = ctx.findPlugin<Execution::DocumentPlugin>();
+  if(!exec_plug)
+    return false;
+
+  ensure_audio_engine();
+  if(!context.guiApplicationPlugin<Audio::ApplicationPlugin>().audio)
+    return false;
+
+  // The transport requests are ignored until all the candidates have been measured
+  m_bouncing = true;
+
+  // The document runs for real: keep its messages away from the devices
+  exec_plug->setDevicesMuted(true);
+
+  std::optional<SchedulingConfiguration> best;
+  double best_cost = 0.;
+  for(const auto& conf : schedulingCandidates())
+  {
+    exec_plug->schedulingOverride = conf;
+
+    // Nobody is there to trigger the top-level conditions
+    exec_plug->reload(true, scenar->baseInterval(), TimeVal::zero());
+
+    auto clock = std::make_unique<TuningClock>(
+        exec_plug->context(), scheduling_tuning_ticks);
+    auto& tuning = *clock;
+    m_clock = std::move(clock);
+    m_clock->play(TimeVal::zero());
+
+    if(!tuning.done())
+    {
+      QEventLoop loop;
+      QTimer timer;
+      connect(&timer, &QTimer::timeout, &loop, [&] {
+        if(tuning.done())
+          loop.quit();
+      });
+      timer.start(20);
+      loop.exec();
+    }
+
+    const double cost = tuning.tickCost();
+    stop_clock();
+    exec_plug->clear();
+
+    if(cost > 0. && (!best || cost < best_cost))
+    {
+      best = conf;
+      best_cost = cost;
+    }
+  }
+
+  exec_plug->schedulingOverride.reset();
+  exec_plug->setDevicesMuted(false);
+  m_bouncing = false;
+  reset_edition();
+
+  // Undoable, and the document is marked as modified
+  CommandDispatcher<> disp{doc->context().commandStack};
+  if(!best)
+  {
+    // e.g. an empty document: keep the former default instead of measuring again
+    disp.submit(new SetMeasuredScheduling{
+        doc->context(),
+        {Settings::SchedulingPolicies{}.StaticFixed, exec_plug->settings.getParallel()},
+        0.});
+    return false;
+  }
+
+  disp.submit(new SetMeasuredScheduling{doc->context(), *best, best_cost});
+  return true;
+}
+
 void ExecutionController::ensure_audio_engine()
 {
   auto& audio_engine = this->context.guiApplicationPlugin<Audio::ApplicationPlugin>();
@@ -569,7 +763,7 @@ void ExecutionController::play_interval(
     {
       forcePlay = qApp->keyboardModifiers() & Qt::ControlModifier;
     }
-    exec_plug->reload(forcePlay, cst);
+    exec_plug->reload(forcePlay, cst, t);
 
     auto& c = exec_plug->context();
     m_clock = makeClock(c);
@@ -643,7 +837,7 @@ void ExecutionController::on_record(::TimeVal t)
     if(auto exec_plug = scenar->context().findPlugin<Execution::DocumentPlugin>())
     {
       // Listening isn't stopped here.
-      exec_plug->reload(false, scenar->baseInterval());
+      exec_plug->reload(false, scenar->baseInterval(), t);
       m_clock = makeClock(exec_plug->context());
       m_clock->play(t);
 
@@ -23,6 +23,7 @@ namespace Execution
 {
 using TransportInterface = Transport::TransportInterface;
 struct Context;
+struct BounceSettings;
 class Clock;
 class BaseScenarioElement;
 using exec_setup_fun
@@ -68,6 +69,32 @@ public:
   void request_scrub(TimeVal t);
   void request_end_scrub(TimeVal t);
 
+  /**
+   * @brief Renders the root interval of the current document offline.
+   *
+   * Blocks until done while processing the events.
+   * progress is called regularly with a value between 0 and 1,
+   * the render is cancelled if it returns false.
+   *
+   * @return true if the files were completely written.
+   */
+  bool bounce(const BounceSettings& settings, std::function<bool(double)> progress = {});
+
+  /**
+   * @brief Measures each scheduling policy on the current document, and keeps the fastest.
+   *
+   * Each candidate executes the root interval offline for a fixed number of ticks.
+   * The result is saved in the document, and used while the scheduling setting is Auto.
+   * Only the audio device is available to the processes during the measure,
+   * and the sound card is silenced: nothing is sent out.
+   *
+   * Blocks until done while processing the events.
+   *
+   * @return false if nothing could be measured, e.g. for an empty document.
+   * Static (Fixed) is then saved for the document.
+   */
+  bool tune_scheduling();
+
 private:
   // If the transport interface answers: these functions will "press" the Play, etc...
   // buttons programmatically to put them in the right state, and start the playback
@@ -123,5 +150,6 @@ private:
   bool m_playing{false};
   bool m_paused{false};
   bool m_requestLocalPlay{};
+  bool m_bouncing{};
 };
 }
@@ -4,8 +4,10 @@
 
 #include <Audio/AudioTick.hpp>
 #include <Execution/BaseScenarioComponent.hpp>
+#include <Execution/BenchmarkRing.hpp>
 #include <Execution/DocumentPlugin.hpp>
 #include <Execution/ExecutionController.hpp>
+#include <Execution/Settings/ExecutorModel.hpp>
 
 #include <ossia/audio/audio_protocol.hpp>
 #include <ossia/dataflow/execution_state.hpp>
@@ -20,6 +22,34 @@
 namespace Execution
 {
 
+ossia::tick_setup_options makeTickOptions(const Execution::Settings::Model& settings)
+{
+  auto tick = settings.getTick();
+  auto commit = settings.getCommit();
+
+  ossia::tick_setup_options opt;
+  if(tick == Execution::Settings::TickPolicies{}.Buffer)
+    opt.tick = ossia::tick_setup_options::Buffer;
+  else if(tick == Execution::Settings::TickPolicies{}.ScoreAccurate)
+    opt.tick = ossia::tick_setup_options::ScoreAccurate;
+  else if(tick == Execution::Settings::TickPolicies{}.Precise)
+    opt.tick = ossia::tick_setup_options::Precise;
+
+  if(commit == Execution::Settings::CommitPolicies{}.Default)
+    opt.commit = ossia::tick_setup_options::Default;
+  else if(commit == Execution::Settings::CommitPolicies{}.Ordered)
+    opt.commit = ossia::tick_setup_options::Ordered;
+  else if(commit == Execution::Settings::CommitPolicies{}.Priorized)
+    opt.commit = ossia::tick_setup_options::Priorized;
+  else if(commit == Execution::Settings::CommitPolicies{}.Merged)
+    opt.commit = ossia::tick_setup_options::Merged;
+  else if(commit == Execution::Settings::CommitPolicies{}.MergedThreaded)
+    opt.commit = ossia::tick_setup_options::MergedThreaded;
+  else if(commit == Execution::Settings::CommitPolicies{}.DirectThreaded)
+    opt.commit = ossia::tick_setup_options::DirectThreaded;
+  return opt;
+}
+
 namespace
 {
 struct AudioTickHelper
@@ -119,6 +149,19 @@ struct AudioTickHelper
       {
       }
     }
+
+    // Results sent directly by the worker threads
+    while(m_context->m_workerQueue.try_dequeue(c))
+    {
+      try
+      {
+        c();
+        m_context->m_gcQueue.enqueue(gc(std::move(c)));
+      }
+      catch(...)
+      {
+      }
+    }
   }
 
   void main_tick(const ossia::audio_tick_state& t) const
@@ -229,8 +272,7 @@ Audio::tick_fun makeBenchmarkTick(
     const std::shared_ptr<Execution::BaseScenarioElement>& scenar)
 {
   int i = 0;
-  QPointer<Execution::DocumentPlugin> plugPtr = &plug;
-  return [helper = std::make_shared<AudioTickHelper>(opt, plug, scenar), plugPtr,
+  return [helper = std::make_shared<AudioTickHelper>(opt, plug, scenar),
           i](const ossia::audio_tick_state& t) mutable {
     Audio::execution_status.store(ossia::transport_status::playing);
     Audio::execution_samples.fetch_add(t.frames, std::memory_order_release);
@@ -239,6 +281,7 @@ Audio::tick_fun makeBenchmarkTick(
     helper->dequeueCommands();
 
     auto& bench = *helper->m_context->bench;
+    auto& ring = *helper->m_context->benchRing;
     if(i % 50 == 0)
     {
       bench.measure = true;
@@ -248,18 +291,16 @@ Audio::tick_fun makeBenchmarkTick(
 
       auto t1 = std::chrono::steady_clock::now();
       auto total = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
-#if !defined(_MSC_VER)
-      //FIXME: MSVC unordered_map isn't move noexcept so it does not work here in Debug
-      helper->m_context->m_editionQueue.enqueue([plugPtr, bench, total]() mutable {
-        if(plugPtr)
-          plugPtr->slot_bench(std::move(bench), total);
-      });
-#endif
 
+      // Only copies the timings in the preallocated ring: the UI thread
+      // aggregates them in DocumentPlugin::slot_bench.
       for(auto& p : bench)
       {
+        if(p.second)
+          ring.push(p.first, *p.second);
         p.second = {};
       }
+      ring.commit(total);
     }
     else
     {
@@ -271,4 +312,41 @@ Audio::tick_fun makeBenchmarkTick(
     i++;
   };
 }
+
+Audio::tick_fun makeOfflinePauseTick(Execution::DocumentPlugin& plug)
+{
+  return [ctx = std::weak_ptr{plug.contextData()}](const ossia::audio_tick_state& t) {
+    Audio::execution_status.store(ossia::transport_status::stopped);
+
+    // Run the commands until the tick gets destroyed, see AudioTickHelper
+    if(auto context = ctx.lock())
+    {
+      Execution::ExecutionCommand c;
+      while(context->m_execQueue.try_dequeue(c))
+      {
+        try
+        {
+          c();
+          context->m_gcQueue.enqueue(Execution::gc(std::move(c)));
+        }
+        catch(...)
+        {
+        }
+      }
+      while(context->m_workerQueue.try_dequeue(c))
+      {
+        try
+        {
+          c();
+          context->m_gcQueue.enqueue(Execution::gc(std::move(c)));
+        }
+        catch(...)
+        {
+        }
+      }
+
+      context->m_gcQueue.enqueue(Execution::gc(std::move(context)));
+    }
+  };
+}
 }
@@ -7,11 +7,18 @@ namespace Execution
 {
 class DocumentPlugin;
 class BaseScenarioElement;
+namespace Settings
+{
+class Model;
+}
 }
 namespace Execution
 {
 using tick_fun = ossia::audio_engine::fun_type;
 
+//! Tick and commit policies chosen in the execution settings
+ossia::tick_setup_options makeTickOptions(const Execution::Settings::Model& settings);
+
 tick_fun makeExecutionTick(
     ossia::tick_setup_options opt, Execution::DocumentPlugin& plug,
     const std::shared_ptr<Execution::BaseScenarioElement>& scenar);
@@ -19,4 +26,8 @@ tick_fun makeExecutionTick(
 tick_fun makeBenchmarkTick(
     ossia::tick_setup_options opt, Execution::DocumentPlugin& plug,
     const std::shared_ptr<Execution::BaseScenarioElement>& scenar);
+
+//! For the clocks which call the ticks from their own thread:
+//! runs the execution commands like a paused engine would.
+tick_fun makeOfflinePauseTick(Execution::DocumentPlugin& plug);
 }
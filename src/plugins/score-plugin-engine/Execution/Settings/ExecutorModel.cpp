@@ -25,8 +25,9 @@ SETTINGS_PARAMETER_IMPL(Clock){
     Dataflow::ClockFactory::static_concreteKey()};
 SETTINGS_PARAMETER_IMPL(Rate){QStringLiteral("score_plugin_engine/Rate"), 50};
 SETTINGS_PARAMETER_IMPL(Threads){QStringLiteral("score_plugin_engine/Threads"), 8};
+SETTINGS_PARAMETER_IMPL(LookAhead){QStringLiteral("score_plugin_engine/LookAhead"), 0};
 SETTINGS_PARAMETER_IMPL(Scheduling){
-    QStringLiteral("score_plugin_engine/Scheduling"), SchedulingPolicies{}.StaticTC};
+    QStringLiteral("score_plugin_engine/Scheduling"), SchedulingPolicies{}.StaticFixed};
 SETTINGS_PARAMETER_IMPL(Ordering){
     QStringLiteral("score_plugin_engine/Ordering"), OrderingPolicies{}.CreationOrder};
 SETTINGS_PARAMETER_IMPL(Merging){
@@ -50,7 +51,7 @@ SETTINGS_PARAMETER_IMPL(TransportValueCompilation){
 static auto list()
 {
   return std::tie(
-      Clock, Rate, Threads, Scheduling, Ordering, Merging, Commit, Tick, Parallel,
+      Clock, Rate, Threads, LookAhead, Scheduling, Ordering, Merging, Commit, Tick, Parallel,
       ExecutionListening, Logging, Bench, ScoreOrder, ValueCompilation,
       TransportValueCompilation);
 }
@@ -113,6 +114,7 @@ SCORE_SETTINGS_PARAMETER_CPP(QString, Model, Commit)
 SCORE_SETTINGS_PARAMETER_CPP(QString, Model, Tick)
 SCORE_SETTINGS_PARAMETER_CPP(int, Model, Rate)
 SCORE_SETTINGS_PARAMETER_CPP(int, Model, Threads)
+SCORE_SETTINGS_PARAMETER_CPP(int, Model, LookAhead)
 SCORE_SETTINGS_PARAMETER_CPP(bool, Model, Parallel)
 SCORE_SETTINGS_PARAMETER_CPP(bool, Model, ExecutionListening)
 SCORE_SETTINGS_PARAMETER_CPP(bool, Model, Logging)
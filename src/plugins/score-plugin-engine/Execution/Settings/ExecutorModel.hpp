@@ -23,7 +23,13 @@ struct SchedulingPolicies
   const QString StaticBFS{"Static (BFS)"};
   const QString StaticTC{"Static (TC)"};
   const QString Dynamic{"Dynamic"};
-  operator QStringList() const { return {StaticFixed, StaticBFS, StaticTC, Dynamic}; }
+
+  //! Measured on each document, see ExecutionController::tune_scheduling
+  const QString Auto{"Auto"};
+  operator QStringList() const
+  {
+    return {StaticFixed, StaticBFS, StaticTC, Dynamic, Auto};
+  }
 };
 struct OrderingPolicies
 {
@@ -72,6 +78,7 @@ class SCORE_PLUGIN_ENGINE_EXPORT Model : public score::SettingsDelegateModel
   QString m_Tick;
   int m_Rate{};
   int m_Threads{};
+  int m_LookAhead{};
   bool m_Parallel{};
   bool m_ExecutionListening{};
   bool m_Logging{};
@@ -105,6 +112,7 @@ public:
   SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_ENGINE_EXPORT, QString, Tick)
   SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_ENGINE_EXPORT, int, Rate)
   SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_ENGINE_EXPORT, int, Threads)
+  SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_ENGINE_EXPORT, int, LookAhead)
   SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_ENGINE_EXPORT, bool, Parallel)
   SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_ENGINE_EXPORT, bool, ExecutionListening)
   SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_ENGINE_EXPORT, bool, Logging)
@@ -123,6 +131,7 @@ SCORE_SETTINGS_PARAMETER(Model, Commit)
 SCORE_SETTINGS_PARAMETER(Model, Tick)
 SCORE_SETTINGS_PARAMETER(Model, Rate)
 SCORE_SETTINGS_PARAMETER(Model, Threads)
+SCORE_SETTINGS_PARAMETER(Model, LookAhead)
 SCORE_SETTINGS_PARAMETER(Model, Parallel)
 SCORE_SETTINGS_PARAMETER(Model, ExecutionListening)
 SCORE_SETTINGS_PARAMETER(Model, Logging)
@@ -25,13 +25,14 @@ namespace Settings
 Presenter::Presenter(Model& m, View& v, QObject* parent)
     : score::GlobalSettingsPresenter{m, v, parent}
 {
-  //SETTINGS_PRESENTER(Scheduling);
+  SETTINGS_PRESENTER(Scheduling);
   //SETTINGS_PRESENTER(Ordering);
   //SETTINGS_PRESENTER(Merging);
   //SETTINGS_PRESENTER(Commit);
   //SETTINGS_PRESENTER(Tick);
   SETTINGS_PRESENTER(Parallel);
   SETTINGS_PRESENTER(Threads);
+  SETTINGS_PRESENTER(LookAhead);
   SETTINGS_PRESENTER(Logging);
   SETTINGS_PRESENTER(Bench);
   SETTINGS_PRESENTER(ExecutionListening);
@@ -45,8 +45,10 @@ View::View()
   group->setLayout(lay);
 */
   // SETTINGS_UI_COMBOBOX_SETUP("Tick policy", Tick, TickPolicies{});
-  // SETTINGS_UI_COMBOBOX_SETUP(
-  //     "Scheduling policy", Scheduling, SchedulingPolicies{});
+  SETTINGS_UI_COMBOBOX_SETUP(
+      "Scheduling policy\nAuto uses the fastest policy measured on a document with "
+      "Play > Measure the scheduling policies, and Static (Fixed) until then.",
+      Scheduling, SchedulingPolicies{});
   // SETTINGS_UI_COMBOBOX_SETUP("Ordering policy", Ordering, OrderingPolicies{});
   // SETTINGS_UI_COMBOBOX_SETUP("Merging policy", Merging, MergingPolicies{});
   // SETTINGS_UI_COMBOBOX_SETUP("Commit policy", Commit, CommitPolicies{});
@@ -63,6 +65,13 @@ View::View()
     m_Threads->setEnabled(m_Parallel->isChecked());
   });
 
+  SETTINGS_UI_SPINBOX_SETUP(
+      "Look-ahead (s)\nIf this is not zero, the processes of an interval are only "
+      "created when the playhead gets this close to it, and removed once it has "
+      "finished. This makes starting long scores faster.",
+      LookAhead);
+  m_LookAhead->setRange(0, 3600);
+
   // SETTINGS_UI_TOGGLE_SETUP("Use Score order", ScoreOrder);
 
   SETTINGS_UI_TOGGLE_SETUP(
@@ -84,6 +93,7 @@ SETTINGS_UI_COMBOBOX_IMPL(Merging)
 SETTINGS_UI_COMBOBOX_IMPL(Commit)
 
 SETTINGS_UI_SPINBOX_IMPL(Threads)
+SETTINGS_UI_SPINBOX_IMPL(LookAhead)
 
 SETTINGS_UI_TOGGLE_IMPL(ExecutionListening)
 SETTINGS_UI_TOGGLE_IMPL(ScoreOrder)
@@ -30,6 +30,7 @@ public:
   SETTINGS_UI_TOGGLE_HPP(Bench)
   SETTINGS_UI_TOGGLE_HPP(Parallel)
   SETTINGS_UI_SPINBOX_HPP(Threads)
+  SETTINGS_UI_SPINBOX_HPP(LookAhead)
   SETTINGS_UI_TOGGLE_HPP(ExecutionListening)
   SETTINGS_UI_TOGGLE_HPP(ScoreOrder)
   SETTINGS_UI_TOGGLE_HPP(ValueCompilation)
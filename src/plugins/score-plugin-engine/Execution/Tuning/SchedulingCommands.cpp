@@ -0,0 +1,53 @@
+#include "SchedulingCommands.hpp"
+
+#include <score/plugins/documentdelegate/plugin/DocumentPluginCreator.hpp>
+#include <score/serialization/DataStreamVisitor.hpp>
+
+namespace Execution
+{
+// The plug-in is only added to a document once it has been measured
+static SchedulingDocumentPlugin& schedulingPlugin(const score::DocumentContext& ctx)
+{
+  if(auto plug = ctx.findPlugin<SchedulingDocumentPlugin>())
+    return *plug;
+  return score::addDocumentPlugin<SchedulingDocumentPlugin>(ctx.document);
+}
+
+SetMeasuredScheduling::SetMeasuredScheduling(
+    const score::DocumentContext& ctx, SchedulingConfiguration conf, double tickCost)
+    : m_new{std::move(conf)}
+    , m_newCost{tickCost}
+{
+  if(auto plug = ctx.findPlugin<SchedulingDocumentPlugin>())
+  {
+    m_old = plug->configuration;
+    m_oldCost = plug->tickCost;
+  }
+}
+
+void SetMeasuredScheduling::undo(const score::DocumentContext& ctx) const
+{
+  auto& plug = schedulingPlugin(ctx);
+  plug.configuration = m_old;
+  plug.tickCost = m_oldCost;
+}
+
+void SetMeasuredScheduling::redo(const score::DocumentContext& ctx) const
+{
+  auto& plug = schedulingPlugin(ctx);
+  plug.configuration = m_new;
+  plug.tickCost = m_newCost;
+}
+
+void SetMeasuredScheduling::serializeImpl(DataStreamInput& s) const
+{
+  s << m_old.scheduling << m_old.parallel << m_oldCost << m_new.scheduling
+    << m_new.parallel << m_newCost;
+}
+
+void SetMeasuredScheduling::deserializeImpl(DataStreamOutput& s)
+{
+  s >> m_old.scheduling >> m_old.parallel >> m_oldCost >> m_new.scheduling
+      >> m_new.parallel >> m_newCost;
+}
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <Execution/Tuning/SchedulingDocumentPlugin.hpp>
+
+#include <score/command/Command.hpp>
+
+namespace Execution
+{
+inline const CommandGroupKey& CommandFactoryName()
+{
+  static const CommandGroupKey key{"Execution"};
+  return key;
+}
+
+//! Stores the scheduling measured for a document
+class SetMeasuredScheduling final : public score::Command
+{
+  SCORE_COMMAND_DECL(
+      CommandFactoryName(), SetMeasuredScheduling, "Measure the scheduling policies")
+public:
+  SetMeasuredScheduling(
+      const score::DocumentContext& ctx, SchedulingConfiguration conf, double tickCost);
+
+  void undo(const score::DocumentContext& ctx) const override;
+  void redo(const score::DocumentContext& ctx) const override;
+
+protected:
+  void serializeImpl(DataStreamInput& s) const override;
+  void deserializeImpl(DataStreamOutput& s) override;
+
+private:
+  SchedulingConfiguration m_old, m_new;
+  double m_oldCost{}, m_newCost{};
+};
+}
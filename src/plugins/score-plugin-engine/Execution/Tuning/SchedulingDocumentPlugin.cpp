@@ -0,0 +1,51 @@
+#include "SchedulingDocumentPlugin.hpp"
+
+#include <score/serialization/DataStreamVisitor.hpp>
+#include <score/serialization/JSONVisitor.hpp>
+
+#include <wobjectimpl.h>
+
+MODEL_METADATA_IMPL_CPP(Execution::SchedulingDocumentPlugin)
+W_OBJECT_IMPL(Execution::SchedulingDocumentPlugin)
+namespace Execution
+{
+SchedulingDocumentPlugin::SchedulingDocumentPlugin(
+    const score::DocumentContext& ctx, QObject* parent)
+    : score::SerializableDocumentPlugin{ctx, "Execution::SchedulingDocumentPlugin", parent}
+{
+}
+
+SchedulingDocumentPlugin::~SchedulingDocumentPlugin() { }
+}
+
+template <>
+void DataStreamReader::read(const Execution::SchedulingDocumentPlugin& plug)
+{
+  m_stream << plug.configuration.scheduling << plug.configuration.parallel
+           << plug.tickCost;
+  insertDelimiter();
+}
+
+template <>
+void DataStreamWriter::write(Execution::SchedulingDocumentPlugin& plug)
+{
+  m_stream >> plug.configuration.scheduling >> plug.configuration.parallel
+      >> plug.tickCost;
+  checkDelimiter();
+}
+
+template <>
+void JSONReader::read(const Execution::SchedulingDocumentPlugin& plug)
+{
+  obj["Scheduling"] = plug.configuration.scheduling;
+  obj["Parallel"] = plug.configuration.parallel;
+  obj["TickCost"] = plug.tickCost;
+}
+
+template <>
+void JSONWriter::write(Execution::SchedulingDocumentPlugin& plug)
+{
+  plug.configuration.scheduling <<= obj["Scheduling"];
+  plug.configuration.parallel = obj["Parallel"].toBool();
+  plug.tickCost = obj["TickCost"].toDouble();
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <score/plugins/documentdelegate/plugin/DocumentPlugin.hpp>
+#include <score/plugins/documentdelegate/plugin/DocumentPluginCreator.hpp>
+#include <score/tools/Metadata.hpp>
+
+#include <QString>
+
+#include <score_plugin_engine_export.h>
+
+#include <verdigris>
+
+namespace Execution
+{
+class SchedulingDocumentPlugin;
+}
+
+UUID_METADATA(
+    , score::DocumentPluginFactory, Execution::SchedulingDocumentPlugin,
+    "65d380ba-b1ef-49ba-8431-3c21dbfdc7f7")
+
+namespace Execution
+{
+//! How the execution graph of a document is scheduled
+struct SchedulingConfiguration
+{
+  //! One of Settings::SchedulingPolicies
+  QString scheduling;
+  bool parallel{};
+};
+
+/**
+ * @brief Scheduling chosen for a document when the policy is Auto.
+ *
+ * Saved with the document, so that the measures are only done
+ * when requested from the Play menu.
+ */
+class SCORE_PLUGIN_ENGINE_EXPORT SchedulingDocumentPlugin final
+    : public score::SerializableDocumentPlugin
+{
+  W_OBJECT(SchedulingDocumentPlugin)
+  SCORE_SERIALIZE_FRIENDS
+
+  MODEL_METADATA_IMPL_HPP(SchedulingDocumentPlugin)
+
+public:
+  explicit SchedulingDocumentPlugin(const score::DocumentContext& ctx, QObject* parent);
+  ~SchedulingDocumentPlugin() override;
+  template <typename Impl>
+  SchedulingDocumentPlugin(const score::DocumentContext& ctx, Impl& vis, QObject* parent)
+      : score::SerializableDocumentPlugin{ctx, vis, parent}
+  {
+    vis.writeTo(*this);
+  }
+
+  SchedulingConfiguration configuration;
+
+  //! Mean duration of a tick with this configuration when it was measured, in microseconds
+  double tickCost{};
+};
+
+using SchedulingDocumentPluginFactory
+    = score::DocumentPluginFactory_T<SchedulingDocumentPlugin>;
+}
@@ -0,0 +1,156 @@
+#include "TuningClock.hpp"
+
+#include <Scenario/Document/Interval/IntervalExecution.hpp>
+
+#include <Audio/AudioApplicationPlugin.hpp>
+#include <Audio/AudioTick.hpp>
+#include <Execution/BaseScenarioComponent.hpp>
+#include <Execution/DocumentPlugin.hpp>
+#include <Execution/ExecutionTick.hpp>
+
+#include <ossia/dataflow/execution_state.hpp>
+#include <ossia/detail/thread.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace Execution
+{
+TuningClock::TuningClock(const Execution::Context& ctx, int ticks)
+    : Execution::Clock{ctx}
+    , m_default{ctx}
+    , m_plug{context.doc.plugin<Execution::DocumentPlugin>()}
+    , m_engine{context.doc.app.guiApplicationPlugin<Audio::ApplicationPlugin>().audio}
+    , m_ticks{ticks}
+{
+}
+
+TuningClock::~TuningClock()
+{
+  m_cancel.store(true, std::memory_order_relaxed);
+  while(m_running.load(std::memory_order_relaxed) && !done())
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+  // Destroying the execution tick posts its cleanup in the execution queue:
+  // the worker is still there to process it.
+  m_play_tick = {};
+
+  m_running.store(false, std::memory_order_release);
+  if(m_thread.joinable())
+    m_thread.join();
+
+  if(m_engine)
+    m_engine->set_tick(Audio::makePauseTick(context.doc.app));
+}
+
+void TuningClock::play_impl(const TimeVal& t)
+{
+  auto& execState = *context.execState;
+  const int frames = execState.bufferSize;
+  if(!m_engine || frames <= 0)
+  {
+    m_done = true;
+    return;
+  }
+
+  // The root interval must not end during the measure:
+  // its end stops the execution.
+  auto& itv = scenario->baseInterval().scoreInterval();
+  const auto duration = itv.duration.defaultDuration() - t;
+  const int64_t samples = std::ceil(duration.impl * execState.modelToSamplesRatio);
+  const int ticks = std::min(int64_t(m_ticks), samples / frames - 1);
+  if(ticks <= 0)
+  {
+    m_done = true;
+    return;
+  }
+
+  m_default.play(t, *scenario);
+
+  m_play_tick = Execution::makeExecutionTick(
+      Execution::makeTickOptions(m_plug.settings), m_plug, scenario);
+  m_pause_tick = Execution::makeOfflinePauseTick(m_plug);
+
+  m_engine->set_tick([](const ossia::audio_tick_state& t) {
+    for(int chan = 0; chan < t.n_out; chan++)
+      std::fill_n(t.outputs[chan], t.frames, 0.f);
+  });
+
+  m_running = true;
+  m_thread = std::thread{[this, n_in = m_engine->effective_inputs,
+                          n_out = m_engine->effective_outputs, frames, ticks] {
+    run(n_in, n_out, frames, ticks);
+  }};
+}
+
+void TuningClock::pause_impl() { }
+
+void TuningClock::resume_impl() { }
+
+void TuningClock::stop_impl()
+{
+  m_cancel.store(true, std::memory_order_relaxed);
+  m_default.stop(*scenario);
+  m_plug.finished();
+}
+
+bool TuningClock::paused() const
+{
+  return false;
+}
+
+void TuningClock::run(int n_in, int n_out, int frames, int ticks)
+{
+  ossia::set_thread_name("ossia tuning");
+  ossia::set_thread_pinned(ossia::thread_type::Audio, 0);
+
+  std::vector<float> buffers((n_in + n_out) * std::size_t(frames), 0.f);
+  std::vector<float*> inputs(n_in), outputs(n_out);
+  for(int i = 0; i < n_in; i++)
+    inputs[i] = buffers.data() + i * std::size_t(frames);
+  for(int i = 0; i < n_out; i++)
+    outputs[i] = buffers.data() + (n_in + i) * std::size_t(frames);
+
+  ossia::audio_tick_state st;
+  st.inputs = inputs.data();
+  st.outputs = outputs.data();
+  st.n_in = n_in;
+  st.n_out = n_out;
+  st.frames = frames;
+
+  const int rate = std::max(1, context.execState->sampleRate);
+  const int warmup = ticks / 10;
+  std::chrono::steady_clock::duration total{};
+  int measured = 0;
+  for(int i = 0; i < ticks && !m_cancel.load(std::memory_order_relaxed); i++)
+  {
+    st.seconds = double(i) * frames / rate;
+
+    const auto t0 = std::chrono::steady_clock::now();
+    m_play_tick(st);
+    const auto t1 = std::chrono::steady_clock::now();
+
+    if(i >= warmup)
+    {
+      total += t1 - t0;
+      measured++;
+    }
+  }
+
+  if(measured > 0 && !m_cancel.load(std::memory_order_relaxed))
+  {
+    using us = std::chrono::duration<double, std::micro>;
+    m_cost.store(us(total).count() / measured, std::memory_order_release);
+  }
+  m_done.store(true, std::memory_order_release);
+
+  const auto period = std::chrono::duration<double>(double(frames) / rate);
+  while(m_running.load(std::memory_order_acquire))
+  {
+    m_pause_tick(st);
+    std::this_thread::sleep_for(period);
+  }
+  m_pause_tick(st);
+}
+}
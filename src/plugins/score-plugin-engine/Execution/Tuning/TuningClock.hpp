@@ -0,0 +1,61 @@
+#pragma once
+#include <Execution/Clock/ClockFactory.hpp>
+#include <Execution/Clock/DefaultClock.hpp>
+
+#include <ossia/audio/audio_engine.hpp>
+
+#include <score_plugin_engine_export.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace Execution
+{
+class DocumentPlugin;
+
+/**
+ * @brief Measures the cost of the ticks of the root interval.
+ *
+ * Like BounceClock, a worker thread calls the execution tick in a loop
+ * instead of the audio engine, while the sound card is silenced.
+ * The first ticks are not measured, as they allocate and prepare the nodes.
+ *
+ * Once done, the thread keeps processing the execution commands like a
+ * paused engine would, until the clock is destroyed.
+ */
+class SCORE_PLUGIN_ENGINE_EXPORT TuningClock final : public Execution::Clock
+{
+public:
+  TuningClock(const Execution::Context& ctx, int ticks);
+  ~TuningClock() override;
+
+  bool done() const noexcept { return m_done.load(std::memory_order_acquire); }
+
+  //! Mean duration of a tick in microseconds, zero if nothing was measured
+  double tickCost() const noexcept { return m_cost.load(std::memory_order_acquire); }
+
+private:
+  void play_impl(const TimeVal& t) override;
+  void pause_impl() override;
+  void resume_impl() override;
+  void stop_impl() override;
+  bool paused() const override;
+
+  void run(int n_in, int n_out, int frames, int ticks);
+
+  Execution::DefaultClock m_default;
+  DocumentPlugin& m_plug;
+  std::shared_ptr<ossia::audio_engine> m_engine;
+  int m_ticks{};
+
+  ossia::audio_engine::fun_type m_play_tick{};
+  ossia::audio_engine::fun_type m_pause_tick{};
+
+  std::atomic<double> m_cost{};
+  std::atomic_bool m_done{};
+  std::atomic_bool m_cancel{};
+  std::atomic_bool m_running{};
+  std::thread m_thread;
+};
+}
@@ -16,6 +16,8 @@
 #include <Execution/DocumentPlugin.hpp>
 #include <Execution/Settings/ExecutorFactory.hpp>
 #include <Execution/Transport/JackTransport.hpp>
+#include <Execution/Tuning/SchedulingCommands.hpp>
+#include <Execution/Tuning/SchedulingDocumentPlugin.hpp>
 #include <LocalTree/Device/LocalProtocolFactory.hpp>
 
 #include <score/plugins/FactorySetup.hpp>
@@ -29,6 +31,7 @@
 #include <Transport/TransportInterface.hpp>
 
 #include <score_plugin_deviceexplorer.hpp>
+#include <score_plugin_engine_commands_files.hpp>
 #include <score_plugin_scenario.hpp>
 #include <wobjectimpl.h>
 
@@ -69,6 +72,7 @@ std::vector<score::InterfaceBase*> score_plugin_engine::factories(
       FW<Device::ProtocolFactory, Protocols::LocalProtocolFactory>,
       FW<Explorer::ListeningHandlerFactory, Execution::PlayListeningHandlerFactory>,
       FW<score::SettingsDelegateFactory, Execution::Settings::Factory>,
+      FW<score::DocumentPluginFactory, Execution::SchedulingDocumentPluginFactory>,
 #if defined(OSSIA_AUDIO_JACK)
       FW<Execution::TransportInterface, Execution::JackTransport>,
 #endif
@@ -80,6 +84,20 @@ std::vector<score::InterfaceBase*> score_plugin_engine::factories(
          >>(ctx, key);
 }
 
+std::pair<const CommandGroupKey, CommandGeneratorMap>
+score_plugin_engine::make_commands()
+{
+  using namespace Execution;
+  std::pair<const CommandGroupKey, CommandGeneratorMap> cmds{
+      CommandFactoryName(), CommandGeneratorMap{}};
+
+  ossia::for_each_type<
+#include <score_plugin_engine_commands.hpp>
+      >(score::commands::FactoryInserter{cmds.second});
+
+  return cmds;
+}
+
 auto score_plugin_engine::required() const -> std::vector<score::PluginKey>
 {
   return {
@@ -1,12 +1,16 @@
 #pragma once
 #include <score/application/ApplicationContext.hpp>
+#include <score/command/Command.hpp>
+#include <score/command/CommandGeneratorMap.hpp>
 #include <score/plugins/Interface.hpp>
 #include <score/plugins/application/GUIApplicationPlugin.hpp>
+#include <score/plugins/qt_interfaces/CommandFactory_QtInterface.hpp>
 #include <score/plugins/qt_interfaces/FactoryFamily_QtInterface.hpp>
 #include <score/plugins/qt_interfaces/FactoryInterface_QtInterface.hpp>
 #include <score/plugins/qt_interfaces/GUIApplicationPlugin_QtInterface.hpp>
 #include <score/plugins/qt_interfaces/PluginRequirements_QtInterface.hpp>
 
+#include <utility>
 #include <vector>
 #include <verdigris>
 
@@ -161,6 +165,7 @@ class score_plugin_engine final
     : public score::ApplicationPlugin_QtInterface
     , public score::FactoryList_QtInterface
     , public score::FactoryInterface_QtInterface
+    , public score::CommandFactory_QtInterface
     , public score::Plugin_QtInterface
 {
   SCORE_PLUGIN_METADATA(1, "d4758f8d-64ac-41b4-8aaf-1cbd6f3feb91")
@@ -179,5 +184,7 @@ private:
       const score::ApplicationContext&,
       const score::InterfaceKey& factoryName) const override;
 
+  std::pair<const CommandGroupKey, CommandGeneratorMap> make_commands() override;
+
   std::vector<score::PluginKey> required() const override;
 };
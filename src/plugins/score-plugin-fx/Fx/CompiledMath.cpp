@@ -0,0 +1,98 @@
+#include "CompiledMath.hpp"
+
+#include <ossia/detail/hash_map.hpp>
+
+#include <mutex>
+
+namespace Nodes
+{
+MathCompiler::~MathCompiler() = default;
+
+namespace
+{
+struct MathCompilerRegistry
+{
+  std::mutex mutex;
+  std::shared_ptr<MathCompiler> compiler;
+  ossia::hash_map<std::string, std::shared_ptr<CompiledMathExpression>> cache;
+
+  static MathCompilerRegistry& instance()
+  {
+    static MathCompilerRegistry reg;
+    return reg;
+  }
+
+  // Only the cache still references the entries which no node uses
+  void release_unused()
+  {
+    for(auto it = cache.begin(); it != cache.end();)
+    {
+      if(it->second.use_count() == 1)
+      {
+        compiler->release(it->second->function);
+        it = cache.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+  }
+};
+}
+
+void setMathCompiler(std::shared_ptr<MathCompiler> compiler)
+{
+  auto& reg = MathCompilerRegistry::instance();
+  std::lock_guard lock{reg.mutex};
+  reg.compiler = std::move(compiler);
+  reg.cache.clear();
+}
+
+std::shared_ptr<const CompiledMathExpression>
+compileMathExpression(const std::string& expr, MathAudioKind kind)
+{
+  auto& reg = MathCompilerRegistry::instance();
+
+  std::string key;
+  key.reserve(expr.size() + 1);
+  key += char('0' + int(kind));
+  key += expr;
+
+  std::shared_ptr<MathCompiler> compiler;
+  {
+    std::lock_guard lock{reg.mutex};
+    if(!reg.compiler)
+      return {};
+
+    if(auto it = reg.cache.find(key); it != reg.cache.end())
+      return it->second;
+
+    reg.release_unused();
+    compiler = reg.compiler;
+  }
+
+  // Compiling takes a while: other nodes can get their code in the meantime
+  auto f = compiler->compile(expr, kind);
+  if(!f)
+    return {};
+
+  std::lock_guard lock{reg.mutex};
+  if(reg.compiler != compiler)
+  {
+    compiler->release(f);
+    return {};
+  }
+
+  auto& entry = reg.cache[std::move(key)];
+  if(entry)
+  {
+    // Another node compiled the same expression at the same time
+    compiler->release(f);
+    return entry;
+  }
+
+  entry = std::make_shared<CompiledMathExpression>(CompiledMathExpression{expr, f});
+  return entry;
+}
+}
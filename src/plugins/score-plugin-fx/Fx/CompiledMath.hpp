@@ -0,0 +1,132 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <score_plugin_fx_export.h>
+
+namespace Nodes
+{
+/**
+ * @brief Memory shared between the Math audio nodes and their compiled expressions.
+ *
+ * The vectors point to the exprtk symbols of the node, so that both
+ * implementations see the same state and the node can switch between them
+ * at any tick.
+ */
+struct MathAudioBlock
+{
+  const double* const* in{};
+  double* const* out{};
+
+  double* x{};
+  double* px{};
+  double* cur_out{};
+  double* m1{};
+  double* m2{};
+  double* m3{};
+
+  int64_t channels{};
+  int64_t out_channels{};
+  int64_t frames{};
+
+  double a{}, b{}, c{};
+  double pa{}, pb{}, pc{};
+  double fs{};
+};
+
+using MathAudioFunction = void(MathAudioBlock* block);
+
+enum class MathAudioKind : int8_t
+{
+  Filter,
+  Generator
+};
+
+/**
+ * @brief Native code generation for the Math audio nodes.
+ *
+ * Provided by the JIT plug-in when it is available.
+ */
+class SCORE_PLUGIN_FX_EXPORT MathCompiler
+{
+public:
+  virtual ~MathCompiler();
+
+  /**
+   * Called on a worker thread.
+   * Returns nullptr if the expression uses something which is not supported.
+   * The code stays valid until it is released.
+   */
+  virtual MathAudioFunction* compile(const std::string& expr, MathAudioKind kind) = 0;
+
+  //! Frees the code of a function returned by compile
+  virtual void release(MathAudioFunction* function) = 0;
+};
+
+SCORE_PLUGIN_FX_EXPORT
+void setMathCompiler(std::shared_ptr<MathCompiler> compiler);
+
+struct CompiledMathExpression
+{
+  std::string expr;
+  MathAudioFunction* function{};
+};
+
+/**
+ * @brief Compiled version of an expression.
+ *
+ * Blocks until the expression is compiled: to be called from a worker thread.
+ * Returns nullptr if no compiler is available or if the expression cannot
+ * be compiled, in which case the node keeps running it with exprtk.
+ *
+ * Entries are cached by expression, so all the nodes with the same
+ * expression share the same code. The code of the expressions which
+ * are not used by any node anymore is freed on the next call.
+ */
+SCORE_PLUGIN_FX_EXPORT
+std::shared_ptr<const CompiledMathExpression>
+compileMathExpression(const std::string& expr, MathAudioKind kind);
+
+/**
+ * @brief Held by a node: the code of its expression.
+ *
+ * Compiled in a worker thread when the expression changes,
+ * and swapped in through the worker queue of the execution.
+ * The registry keeps a reference to the code, so the node never
+ * frees it in the DSP thread.
+ */
+struct CompiledMathHandle
+{
+  //! Null until the current expression is compiled
+  MathAudioFunction* get(const std::string& e) const noexcept
+  {
+    return compiled && compiled->expr == e ? compiled->function : nullptr;
+  }
+
+  std::shared_ptr<const CompiledMathExpression> compiled;
+};
+
+//! Worker of the Math audio nodes: see avnd's worker concept
+template <typename Node, MathAudioKind Kind>
+struct MathCompileWorker
+{
+  std::function<void(std::string)> request;
+
+  // Called back in a worker thread.
+  // The returned function is applied in the processing thread of the node.
+  static std::function<void(Node&)> work(std::string expr)
+  {
+    auto compiled = compileMathExpression(expr, Kind);
+    if(!compiled)
+      return {};
+
+    return [compiled = std::move(compiled)](Node& n) mutable {
+      // The previous code goes away with this function
+      std::swap(n.state.compiled.compiled, compiled);
+    };
+  }
+};
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Fx/CompiledMath.hpp>
 #include <Fx/MathMapping_generic.hpp>
 #include <Fx/Types.hpp>
 
@@ -27,7 +28,7 @@ struct Node
   struct ins
   {
     halp::dynamic_audio_bus<"in", double> audio;
-    halp::lineedit<
+    struct : halp::lineedit<
         "Expression",
         "var n := x[];\n"
         "\n"
@@ -35,7 +36,14 @@ struct Node
         "  var dist := tanh(x[i]*log(1 + 200 * max(a,0)));\n"
         "  out[i] := clamp(-1, dist, 1);\n"
         "}\n">
-        expr;
+    {
+      // Called in the UI thread: the expression is compiled in a worker thread
+      static void request_work(Node& n, const std::string& expr)
+      {
+        if(n.worker.request)
+          n.worker.request(expr);
+      }
+    } expr;
     halp::hslider_f32<"Param (a)", halp::range{0., 1., 0.5}> a;
     halp::hslider_f32<"Param (b)", halp::range{0., 1., 0.5}> b;
     halp::hslider_f32<"Param (c)", halp::range{0., 1., 0.5}> c;
@@ -111,9 +119,12 @@ struct Node
     std::vector<double> m1, m2, m3;
     double fs{44100};
     ossia::math_expression expr;
+    Nodes::CompiledMathHandle compiled;
     bool ok = false;
   } state;
 
+  Nodes::MathCompileWorker<Node, Nodes::MathAudioKind::Filter> worker;
+
   halp::setup setup;
   void prepare(halp::setup s) { setup = s; }
 
@@ -137,24 +148,59 @@ struct Node
       self.a = this->inputs.a;
       self.b = this->inputs.b;
       self.c = this->inputs.c;
-      for(int64_t i = 0; i < tk.frames; i++)
+      if(auto native = self.compiled.get(inputs.expr.value))
       {
-        for(int j = 0; j < chans; j++)
-        {
-          self.cur_in[j] = inputs.audio.samples[j][i];
-        }
-        self.cur_time = i;
-
-        // Compute the value
-        self.expr.value();
-
-        // Apply the output
-        auto& channels = this->outputs.audio.samples;
-        for(int j = 0; j < std::min(chans, outputs.audio.channels); j++)
+        Nodes::MathAudioBlock block{
+            .in = inputs.audio.samples,
+            .out = outputs.audio.samples,
+            .x = self.cur_in.data(),
+            .px = self.prev_in.data(),
+            .cur_out = self.cur_out.data(),
+            .m1 = self.m1.data(),
+            .m2 = self.m2.data(),
+            .m3 = self.m3.data(),
+            .channels = chans,
+            .out_channels = std::min(chans, outputs.audio.channels),
+            .frames = tk.frames,
+            .a = self.a,
+            .b = self.b,
+            .c = self.c,
+            .pa = self.pa,
+            .pb = self.pb,
+            .pc = self.pc,
+            .fs = self.fs};
+        native(&block);
+
+        // The expression can assign the variables, like with exprtk
+        self.a = block.a;
+        self.b = block.b;
+        self.c = block.c;
+        self.pa = block.pa;
+        self.pb = block.pb;
+        self.pc = block.pc;
+        self.fs = block.fs;
+      }
+      else
+      {
+        for(int64_t i = 0; i < tk.frames; i++)
         {
-          channels[j][i] = self.cur_out[j];
+          for(int j = 0; j < chans; j++)
+          {
+            self.cur_in[j] = inputs.audio.samples[j][i];
+          }
+          self.cur_time = i;
+
+          // Compute the value
+          self.expr.value();
+
+          // Apply the output
+          auto& channels = this->outputs.audio.samples;
+          for(int j = 0; j < std::min(chans, outputs.audio.channels); j++)
+          {
+            channels[j][i] = self.cur_out[j];
+          }
+          self.prev_in = self.cur_in;
         }
-        self.prev_in = self.cur_in;
       }
       self.pa = self.a;
       self.pb = self.b;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Fx/CompiledMath.hpp>
 #include <Fx/MathMapping_generic.hpp>
 #include <Fx/Types.hpp>
 
@@ -28,14 +29,21 @@ struct Node
 
   struct ins
   {
-    halp::lineedit<
+    struct : halp::lineedit<
         "Expression",
         "var phi := 2 * pi * (20 + a * 500) / fs;\n"
         "m1[0] += phi;\n"
         "\n"
         "out[0] := b * sin(m1[0]);\n"
         "out[1] := b * sin(m1[0]);\n">
-        expr;
+    {
+      // Called in the UI thread: the expression is compiled in a worker thread
+      static void request_work(Node& n, const std::string& expr)
+      {
+        if(n.worker.request)
+          n.worker.request(expr);
+      }
+    } expr;
 
     halp::hslider_f32<"Param (a)", halp::range{0., 1., 0.5}> a;
     halp::hslider_f32<"Param (b)", halp::range{0., 1., 0.5}> b;
@@ -100,9 +108,12 @@ struct Node
     std::vector<double> m1, m2, m3;
     double fs{44100};
     ossia::math_expression expr;
+    Nodes::CompiledMathHandle compiled;
     bool ok = false;
   } state;
 
+  Nodes::MathCompileWorker<Node, Nodes::MathAudioKind::Generator> worker;
+
   halp::setup setup;
   static constexpr int chans = 2; // FIXME
   void prepare(halp::setup s)
@@ -126,18 +137,50 @@ struct Node
       self.a = this->inputs.a;
       self.b = this->inputs.b;
       self.c = this->inputs.c;
-      for(int64_t i = 0; i < tk.frames; i++)
+      if(auto native = self.compiled.get(inputs.expr.value))
       {
-        self.cur_time = i;
+        Nodes::MathAudioBlock block{
+            .out = outputs.audio.samples,
+            .cur_out = self.cur_out.data(),
+            .m1 = self.m1.data(),
+            .m2 = self.m2.data(),
+            .m3 = self.m3.data(),
+            .channels = chans,
+            .out_channels = std::min(chans, outputs.audio.channels),
+            .frames = tk.frames,
+            .a = self.a,
+            .b = self.b,
+            .c = self.c,
+            .pa = self.pa,
+            .pb = self.pb,
+            .pc = self.pc,
+            .fs = self.fs};
+        native(&block);
+
+        // The expression can assign the variables, like with exprtk
+        self.a = block.a;
+        self.b = block.b;
+        self.c = block.c;
+        self.pa = block.pa;
+        self.pb = block.pb;
+        self.pc = block.pc;
+        self.fs = block.fs;
+      }
+      else
+      {
+        for(int64_t i = 0; i < tk.frames; i++)
+        {
+          self.cur_time = i;
 
-        // Compute the value
-        self.expr.value();
+          // Compute the value
+          self.expr.value();
 
-        // Apply the output
-        auto& channels = this->outputs.audio.samples;
-        for(int j = 0; j < std::min(chans, outputs.audio.channels); j++)
-        {
-          channels[j][i] = self.cur_out[j];
+          // Apply the output
+          auto& channels = this->outputs.audio.samples;
+          for(int j = 0; j < std::min(chans, outputs.audio.channels); j++)
+          {
+            channels[j][i] = self.cur_out[j];
+          }
         }
       }
       self.pa = self.a;
@@ -1,12 +1,28 @@
 #include "GfxApplicationPlugin.hpp"
 
 #include <Execution/DocumentPlugin.hpp>
+#include <Execution/Settings/ExecutorModel.hpp>
+#include <LocalTree/LocalTreeDocumentPlugin.hpp>
+
+#include <Gfx/Graph/RenderProfiler.hpp>
+#include <Gfx/Graph/RenderState.hpp>
+#include <Gfx/Images/ImageCache.hpp>
+#include <Gfx/Settings/Model.hpp>
+
+#include <score/tools/Bind.hpp>
 
 #include <core/document/Document.hpp>
 #include <core/document/DocumentModel.hpp>
 
+#include <ossia/detail/algorithms.hpp>
+#include <ossia/network/base/node.hpp>
+#include <ossia/network/base/node_functions.hpp>
+#include <ossia/network/base/parameter.hpp>
+
 namespace Gfx
 {
+// How often the render timings are taken and shown
+static constexpr int timings_interval_ms = 500;
 
 DocumentPlugin::DocumentPlugin(const score::DocumentContext& ctx, QObject* parent)
     : score::DocumentPlugin{ctx, "Gfx::DocumentPlugin", parent}
@@ -14,14 +30,129 @@ DocumentPlugin::DocumentPlugin(const score::DocumentContext& ctx, QObject* paren
 {
   auto& exec_plug = ctx.plugin<Execution::DocumentPlugin>();
   exec_plug.registerAction(exec);
+
+  // The render timings are measured along with the ones of the audio nodes
+  m_timer = startTimer(timings_interval_ms);
+}
+
+DocumentPlugin::~DocumentPlugin()
+{
+  killTimer(m_timer);
+}
+
+void DocumentPlugin::timerEvent(QTimerEvent* event)
+{
+  auto& exec_plug = m_context.plugin<Execution::DocumentPlugin>();
+  const bool bench = exec_plug.settings.getBench();
+  if(bench != context.profiler().enabled())
+  {
+    context.profiler().setEnabled(bench);
+
+    // The outputs are recreated so that their QRhi records GPU timestamps
+    // only while profiling.
+    score::gfx::setGpuTimestampsRequested(bench);
+    context.recompute_graph();
+  }
+
+  if(bench)
+    publishTimings();
+  else if(std::exchange(m_profiling, false))
+    clearTimings();
+}
+
+void DocumentPlugin::publishTimings()
+{
+  auto stats = context.profiler().take();
+  m_profiling = true;
+
+  // Per process, next to the share of the audio tick
+  auto& exec_plug = m_context.plugin<Execution::DocumentPlugin>();
+  if(const auto& data = exec_plug.contextData())
+  {
+    for(const auto& [node, proc] : data->setupContext.proc_map)
+    {
+      auto gfx = dynamic_cast<const gfx_exec_node*>(node);
+      if(!gfx || !proc)
+        continue;
+      if(auto it = stats.nodes.find(gfx->id); it != stats.nodes.end())
+        const_cast<Process::ProcessModel*>(proc)->renderBenchmark(it->second.cpu_ms);
+    }
+  }
+
+  // Per output, in the local device so that they can be watched remotely
+  std::vector<std::string> published;
+  for(const auto& out : stats.outputs)
+  {
+    if(out.name.empty())
+      continue;
+    publishOutput(out.name, "cpu", out.cpu_ms);
+    publishOutput(out.name, "gpu", out.gpu_ms);
+    publishOutput(out.name, "fps", out.frames * 1000. / timings_interval_ms);
+    published.push_back(out.name);
+  }
+
+  // The nodes of the outputs which are gone
+  if(auto lt = m_context.findPlugin<LocalTree::DocumentPlugin>())
+  {
+    auto& root = lt->device().get_root_node();
+    for(const auto& name : m_publishedOutputs)
+    {
+      if(ossia::contains(published, name))
+        continue;
+      if(auto node = ossia::net::find_node(root, "/gfx/" + name))
+        if(auto parent = node->get_parent())
+          parent->remove_child(*node);
+    }
+  }
+  m_publishedOutputs = std::move(published);
 }
 
-DocumentPlugin::~DocumentPlugin() { }
+void DocumentPlugin::publishOutput(const std::string& name, const char* key, double value)
+{
+  auto lt = m_context.findPlugin<LocalTree::DocumentPlugin>();
+  if(!lt)
+    return;
+
+  // Looked up each time: the nodes can be removed from the device at any time
+  const std::string address = "/gfx/" + name + "/" + key;
+  auto& node = ossia::net::find_or_create_node(lt->device().get_root_node(), address);
+  auto param = node.get_parameter();
+  if(!param)
+    param = node.create_parameter(ossia::val_type::FLOAT);
+  if(param)
+    param->push_value(float(value));
+}
+
+void DocumentPlugin::clearTimings()
+{
+  auto& exec_plug = m_context.plugin<Execution::DocumentPlugin>();
+  if(const auto& data = exec_plug.contextData())
+  {
+    for(const auto& [node, proc] : data->setupContext.proc_map)
+    {
+      if(proc && dynamic_cast<const gfx_exec_node*>(node))
+        const_cast<Process::ProcessModel*>(proc)->renderBenchmark(-1.);
+    }
+  }
+
+  m_publishedOutputs.clear();
+  if(auto lt = m_context.findPlugin<LocalTree::DocumentPlugin>())
+  {
+    auto& root = lt->device().get_root_node();
+    if(auto node = ossia::net::find_node(root, "/gfx"))
+      root.remove_child(*node);
+  }
+}
 
 ApplicationPlugin::ApplicationPlugin(const score::GUIApplicationContext& app)
     : GUIApplicationPlugin{app}
 {
   // Early: the canvas watchers have to be in place before a context can be lost.
+
+  auto& set = app.settings<Gfx::Settings::Model>();
+  ::bind(set, Gfx::Settings::Model::p_ImageCacheSize{}, &set, [](int mb) {
+    ImageCache::instance().setBudget(int64_t(mb) * 1024 * 1024);
+  });
 }
 
 void ApplicationPlugin::on_createdDocument(score::Document& doc)
@@ -7,6 +7,9 @@
 
 #include <score_plugin_gfx_export.h>
 
+#include <string>
+#include <vector>
+
 namespace Gfx
 {
 class SCORE_PLUGIN_GFX_EXPORT DocumentPlugin final : public score::DocumentPlugin
@@ -17,6 +20,17 @@ public:
 
   GfxContext context;
   GfxExecutionAction exec{context};
+
+private:
+  void timerEvent(QTimerEvent* event) override;
+  void publishTimings();
+  void clearTimings();
+  void publishOutput(const std::string& name, const char* key, double value);
+
+  // The outputs which have nodes under /gfx in the local device
+  std::vector<std::string> m_publishedOutputs;
+  int m_timer{};
+  bool m_profiling{};
 };
 
 class ApplicationPlugin final : public score::GUIApplicationPlugin
@@ -34,8 +34,11 @@ GfxContext::GfxContext(const score::DocumentContext& ctx)
   con(settings, &Gfx::Settings::Model::VSyncChanged, this, &GfxContext::recompute_graph);
   con(settings, &Gfx::Settings::Model::BuffersChanged, this,
       &GfxContext::recompute_graph);
+  con(settings, &Gfx::Settings::Model::ShareRenderersChanged, this,
+      &GfxContext::recompute_graph);
 
   m_graph = new score::gfx::Graph;
+  m_graph->shareRenderers = settings.getShareRenderers();
 
   double rate = m_context.app.settings<Gfx::Settings::Model>().getRate();
   rate = qBound(1.0, rate, 1000.);
@@ -64,6 +67,11 @@ GfxContext::~GfxContext()
   delete m_graph;
 }
 
+score::gfx::RenderProfiler& GfxContext::profiler() const noexcept
+{
+  return m_graph->profiler;
+}
+
 int32_t GfxContext::register_node(std::unique_ptr<score::gfx::Node> node)
 {
   // OSSIA_ENSURE_CURRENT_THREAD(ossia::thread_type::Ui);
@@ -202,8 +210,13 @@ void GfxContext::recompute_graph()
   const double settings_rate = m_context.app.settings<Gfx::Settings::Model>().getRate();
   const auto api = settings.graphicsApiEnum();
 
+  m_graph->shareRenderers = settings.getShareRenderers();
   m_graph->createAllRenderLists(api);
 
+  // The execution requests the frames itself, see renderOfflineFrames
+  if(m_offline)
+    return;
+
   // Recreate new timers
   const bool vsync = settings.getVSync() && m_graph->canDoVSync();
 
@@ -340,6 +353,7 @@ void GfxContext::remove_node(
   if(auto node_it = nodes.find(index); node_it != nodes.end())
   {
     auto node = node_it->second.get();
+    m_offlineFrames.erase((score::gfx::OutputNode*)node);
 
     // Remove the node from the timers if it's in there
     for(auto timer_it = m_manualTimers.begin(); timer_it != m_manualTimers.end();)
@@ -483,11 +497,16 @@ void GfxContext::updateGraph()
 
 void GfxContext::on_no_vsync_timer(score::HighResolutionTimer* self)
 {
+  // e.g. a preview added during an offline render
+  if(m_offline)
+    return;
   updateGraph();
 }
 
 void GfxContext::on_watchdog_timer(score::HighResolutionTimer* self)
 {
+  if(m_offline)
+    return;
   if(m_manualTimers.empty() && !m_no_vsync_timer)
     updateGraph();
 }
@@ -501,4 +520,102 @@ void GfxContext::on_manual_timer(score::HighResolutionTimer* self)
     }
   }
 }
+
+void GfxContext::beginOfflineRender()
+{
+  OSSIA_ENSURE_CURRENT_THREAD(ossia::thread_type::Ui);
+  {
+    std::lock_guard l{m_offlineLock};
+    m_offlineNextFrame = 0.;
+    m_offline = true;
+  }
+  m_offlineFrames.clear();
+  m_offlineUpdate = 0;
+
+  // Stops the timers
+  recompute_graph();
+}
+
+void GfxContext::endOfflineRender()
+{
+  OSSIA_ENSURE_CURRENT_THREAD(ossia::thread_type::Ui);
+  {
+    std::lock_guard l{m_offlineLock};
+    if(!m_offline)
+      return;
+    m_offline = false;
+  }
+  m_offlineCv.notify_all();
+
+  for(auto& [output, frame] : m_offlineFrames)
+    output->setOfflineRendering(false);
+  m_offlineFrames.clear();
+
+  recompute_graph();
+}
+
+void GfxContext::renderOfflineFrames(double time)
+{
+  std::unique_lock l{m_offlineLock};
+  if(!m_offline || time < m_offlineNextFrame)
+    return;
+
+  // Rendering happens in the thread of the graph, where the outputs live
+  const int64_t request = ++m_offlineRequested;
+  QMetaObject::invokeMethod(
+      this, [this, time, request] { on_offline_frames(time, request); },
+      Qt::QueuedConnection);
+
+  m_offlineCv.wait(
+      l, [this, request] { return m_offlineRendered >= request || !m_offline; });
+}
+
+void GfxContext::on_offline_frames(double time, int64_t request)
+{
+  if(!m_offline)
+    return;
+
+  auto& settings = m_context.app.settings<Gfx::Settings::Model>();
+  const double rate = qBound(1.0, settings.getRate(), 1000.);
+
+  // Frame n of an output at N fps shows the state of the score at n / N seconds:
+  // it is due as soon as the tick covering that time has run.
+  // The graph itself is updated at the rate of the settings, e.g. for the previews.
+  if(m_offlineUpdate <= time * rate)
+  {
+    updateGraph();
+    while(m_offlineUpdate <= time * rate)
+      m_offlineUpdate++;
+  }
+  double next = m_offlineUpdate / rate;
+
+  for(auto output : m_graph->outputs())
+  {
+    auto conf = output->configuration();
+    if(!conf.manualRenderingRate)
+      continue;
+
+    auto [it, first] = m_offlineFrames.try_emplace(output, 0);
+    if(first)
+      output->setOfflineRendering(true);
+
+    // Several frames can be due during a single tick: they are all rendered
+    // so that the outputs get exactly one frame per period
+    const double fps = 1000. / *conf.manualRenderingRate;
+    auto& frame = it->second;
+    while(frame <= time * fps)
+    {
+      output->render();
+      frame++;
+    }
+    next = std::min(next, frame / fps);
+  }
+
+  {
+    std::lock_guard l{m_offlineLock};
+    m_offlineNextFrame = next;
+    m_offlineRendered = std::max(m_offlineRendered, request);
+  }
+  m_offlineCv.notify_all();
+}
 }
@@ -18,6 +18,8 @@
 
 #include <concurrentqueue.h>
 #include <score_plugin_gfx_export.h>
+
+#include <condition_variable>
 namespace score {
 class HighResolutionTimer;
 class Timers;
@@ -26,6 +28,7 @@ namespace score::gfx
 {
 struct Graph;
 class OutputNode;
+class RenderProfiler;
 }
 namespace score
 {
@@ -79,11 +82,31 @@ public:
   void update_inputs();
   void updateGraph();
 
+  //! Thread-safe
+  score::gfx::RenderProfiler& profiler() const noexcept;
+
   void send_message(score::gfx::Message&& msg) noexcept
   {
     tick_messages.enqueue(std::move(msg));
   }
 
+  /**
+   * @brief Offline rendering, see Execution::ExecutionAction::beginOfflineRender.
+   *
+   * The timers are stopped: the graph is only updated, and the outputs with a
+   * manual rendering rate only rendered, when the execution asks for the frames
+   * through renderOfflineFrames.
+   */
+  void beginOfflineRender();
+  void endOfflineRender();
+
+  /**
+   * @brief Execution thread: renders the frames due up to this score time, in seconds.
+   *
+   * Blocks until they are rendered, or until the offline render stops.
+   */
+  void renderOfflineFrames(double time);
+
 private:
   void run_commands();
   void add_preview_output(score::gfx::OutputNode& out);
@@ -95,6 +118,7 @@ private:
   void on_no_vsync_timer(score::HighResolutionTimer* self);
   void on_watchdog_timer(score::HighResolutionTimer* self);
   void on_manual_timer(score::HighResolutionTimer* self);
+  void on_offline_frames(double time, int64_t request);
   const score::DocumentContext& m_context;
   std::atomic_int32_t index{1};
   ossia::hash_map<int32_t, NodePtr> nodes;
@@ -143,6 +167,18 @@ private:
 
   ossia::object_pool<std::vector<score::gfx::gfx_input>> m_buffers;
 
+  // Offline rendering
+  std::mutex m_offlineLock;
+  std::condition_variable m_offlineCv;
+  std::atomic_bool m_offline{};
+  double m_offlineNextFrame TS_GUARDED_BY(m_offlineLock){};
+  int64_t m_offlineRequested TS_GUARDED_BY(m_offlineLock){};
+  int64_t m_offlineRendered TS_GUARDED_BY(m_offlineLock){};
+
+  // Index of the next frame of each output, and of the next graph update
+  ossia::hash_map<score::gfx::OutputNode*, int64_t> m_offlineFrames;
+  int64_t m_offlineUpdate{};
+
   score::Timers m_timers;
 };
 
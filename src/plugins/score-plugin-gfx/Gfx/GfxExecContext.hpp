@@ -25,11 +25,16 @@ public:
   void setEdge(port_index source, port_index sink, Process::CableType t);
   void endTick(const ossia::audio_tick_state& st) override;
 
+  void beginOfflineRender(double sampleRate) override;
+  void endOfflineRender() override;
+
   GfxContext* ui{};
   std::vector<EdgeSpec> prev_edges;
   std::vector<EdgeSpec> edges_cache;
   using edge_queue = moodycamel::ConcurrentQueue<EdgeSpec>;
   edge_queue incoming_edges;
+
+  double m_offlineSampleRate{};
 };
 
 }
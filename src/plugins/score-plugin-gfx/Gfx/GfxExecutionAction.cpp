@@ -93,5 +93,20 @@ void GfxExecutionAction::endTick(const ossia::audio_tick_state& st)
       ui->edges_changed = true;
     }
   }
+
+  // Offline: the frames due during this tick are rendered before the next one
+  if(ui->m_offline.load(std::memory_order_relaxed))
+    ui->renderOfflineFrames(st.seconds + st.frames / m_offlineSampleRate);
+}
+
+void GfxExecutionAction::beginOfflineRender(double sampleRate)
+{
+  m_offlineSampleRate = sampleRate;
+  ui->beginOfflineRender();
+}
+
+void GfxExecutionAction::endOfflineRender()
+{
+  ui->endOfflineRender();
 }
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include <Gfx/GfxContext.hpp>
 #include <Gfx/GfxExecContext.hpp>
+#include <Gfx/Graph/RenderProfiler.hpp>
 
 #include <ossia/gfx/texture_parameter.hpp>
 #include <ossia/network/base/device.hpp>
@@ -25,6 +26,7 @@ public:
       , node{node}
   {
     node_id = context->ui->register_node(std::unique_ptr<score::gfx::Node>{node});
+    context->ui->profiler().setOutputName(node_id, n.get_device().get_name());
   }
 
   void push_texture(port_index idx)
@@ -34,7 +36,11 @@ public:
     context->setEdge(source, sink, Process::CableType::ImmediateGlutton);
   }
 
-  virtual ~gfx_parameter_base() { context->ui->unregister_node(node_id); }
+  virtual ~gfx_parameter_base()
+  {
+    context->ui->profiler().removeOutput(node_id);
+    context->ui->unregister_node(node_id);
+  }
 };
 
 class gfx_protocol_base : public ossia::net::protocol_base
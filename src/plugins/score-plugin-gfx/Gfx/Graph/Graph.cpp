@@ -218,7 +218,10 @@ try
   if(output.renderState())
   {
     if(auto rl = createRenderList(&output, output.renderState()))
+    {
       m_renderers.push_back(std::move(rl));
+      shareRenderLists();
+    }
   }
 }
 catch(...)
@@ -265,6 +268,7 @@ void Graph::recreateOutputRenderList(OutputNode& output)
         output.setRenderer({});
         it = m_renderers.erase(it);
       }
+      shareRenderLists();
     }
     else
     {
@@ -397,6 +401,25 @@ void Graph::relinkGraph()
       }
     }
   }
+  shareRenderLists();
+}
+
+void Graph::shareRenderLists()
+{
+  for(auto it = m_renderers.begin(); it != m_renderers.end(); ++it)
+  {
+    auto& r = **it;
+    r.sharedWith.reset();
+    if(!shareRenderers || !r.state.rhi)
+      continue;
+
+    // The first list on a QRhi renders everything, the next ones reuse its textures
+    auto first = std::find_if(m_renderers.begin(), it, [&r](const auto& other) {
+      return other->state.rhi == r.state.rhi;
+    });
+    if(first != it)
+      r.sharedWith = *first;
+  }
 }
 
 bool Graph::canDoVSync() const noexcept
@@ -427,6 +450,7 @@ std::shared_ptr<RenderList>
 Graph::createRenderList(OutputNode* output, std::shared_ptr<RenderState> state)
 {
   auto ptr = std::make_shared<RenderList>(*output, state);
+  ptr->profiler = &profiler;
   state->renderer = ptr;
   output->setRenderer(ptr);
   for(auto& node : m_nodes)
@@ -602,6 +626,7 @@ void Graph::destroyOutputRenderList(score::gfx::OutputNode& output)
 
       output.setRenderer({});
       it = m_renderers.erase(it);
+      shareRenderLists();
     }
     else
     {
@@ -93,10 +93,25 @@ struct SCORE_PLUGIN_GFX_EXPORT Graph
     return m_outputs;
   }
 
+  /**
+   * @brief Timings of the nodes, committed by the render lists of the graph.
+   */
+  RenderProfiler profiler;
+
+  /**
+   * @brief Whether outputs on the same QRhi reuse the textures rendered for each other.
+   *
+   * See RenderList::sharedWith. Applies to the render lists created afterwards.
+   * Screen, Sh4lt, Spout and Syphon outputs each create their own QRhi: only
+   * the outputs which import the QRhi of another one share anything.
+   */
+  bool shareRenderers{};
+
 private:
   void initializeOutput(OutputNode* output, GraphicsApi graphicsApi);
   void createOutputRenderList(OutputNode& output);
   void recreateOutputRenderList(OutputNode& output);
+  void shareRenderLists();
   std::shared_ptr<RenderList>
   createRenderList(OutputNode*, std::shared_ptr<RenderState> state);
 
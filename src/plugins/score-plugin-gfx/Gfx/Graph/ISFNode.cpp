@@ -8,8 +8,12 @@
 
 #include <score/tools/Debug.hpp>
 
+#include <ossia/detail/algorithms.hpp>
+
 #include <boost/algorithm/string/replace.hpp>
 
+#include <QRegularExpression>
+
 namespace score::gfx
 {
 struct isf_input_port_vis
@@ -243,6 +247,41 @@ struct isf_input_port_vis
   }
 };
 
+static bool usesTime(const QString& shader)
+{
+  // The lines which define these uniforms are in every shader
+  static const QRegularExpression time{
+      QStringLiteral(R"_(\b(TIME|TIMEDELTA|PROGRESS|FRAMEINDEX|DATE)\b)_")};
+  for(const auto& line : QStringView{shader}.split(u'\n'))
+  {
+    if(!line.contains(u"isf_process_uniforms") && time.match(line).hasMatch())
+      return true;
+  }
+  return false;
+}
+
+// Whether the same inputs may give a different image in the next frame
+static bool isTimeVarying(
+    const isf::descriptor& desc, const QString& vert, const QString& frag)
+{
+  if(desc.mode != isf::descriptor::ISF)
+    return true;
+
+  if(ossia::any_of(desc.passes, [](const isf::pass& p) { return p.persistent; }))
+    return true;
+
+  for(const isf::input& input : desc.inputs)
+  {
+    if(ossia::get_if<isf::audio_input>(&input.data)
+       || ossia::get_if<isf::audioFFT_input>(&input.data)
+       || ossia::get_if<isf::audioHist_input>(&input.data)
+       || ossia::get_if<isf::event_input>(&input.data))
+      return true;
+  }
+
+  return usesTime(vert) || usesTime(frag);
+}
+
 ISFNode::ISFNode(const isf::descriptor& desc, const QString& vert, const QString& frag)
     : m_descriptor{desc}
 {
@@ -293,6 +332,7 @@ ISFNode::ISFNode(const isf::descriptor& desc, const QString& vert, const QString
         this->requiresDepth = true;
     }
   }
+  timeVarying = isTimeVarying(desc, vert, frag);
 }
 
 ISFNode::ISFNode(const isf::descriptor& desc, const QString& comp)
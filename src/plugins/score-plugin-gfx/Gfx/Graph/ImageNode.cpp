@@ -3,6 +3,9 @@
 #include <Gfx/Graph/RenderList.hpp>
 #include <Gfx/Graph/RenderState.hpp>
 #include <Gfx/Images/Process.hpp>
+#include <Gfx/Settings/Model.hpp>
+
+#include <score/document/DocumentContext.hpp>
 
 #if QT_SVG_LIB
 #include <QPainter>
@@ -207,27 +210,19 @@ void ImagesNode::process(Message&& msg)
 
         case 5: // Images
         {
-          auto new_images = Gfx::getImages(*val, this->ctx);
-          auto diff = [](const score::gfx::Image& lhs, const score::gfx::Image& rhs) {
-            return lhs.path != rhs.path;
-          };
-          bool images_changed = new_images.size() != images.size();
-          if(!images_changed)
-          {
-            for(int i = 0; i < images.size(); i++)
-              images_changed |= diff(images[i], new_images[i]);
-          }
-
-          if(images_changed)
+          // The images are decoded asynchronously by the renderers,
+          // only the headers of the animated ones are read here.
+          auto new_images = Gfx::getImagePaths(*val, this->ctx);
+          if(new_images != images)
           {
             clear();
             images = std::move(new_images);
-            for(auto& img : images)
+            for(auto& path : images)
             {
 #if Q_SVG_LIB
-              if(img.path.endsWith("svg"))
+              if(path.endsWith("svg"))
               {
-                auto renderer = new QSvgRenderer{img.path};
+                auto renderer = new QSvgRenderer{path};
                 if(renderer->animated())
                   renderer->setAnimationEnabled(true);
                 renderer->setFramesPerSecond(60);
@@ -236,9 +231,9 @@ void ImagesNode::process(Message&& msg)
               else
 #endif
               {
-                for(auto& frame : img.frames)
+                for(int i = 0, N = Gfx::ImageCache::frameCount(path); i < N; i++)
                 {
-                  linearImages.push_back(&frame);
+                  linearImages.push_back(CachedFrame{path, i});
                 }
               }
             }
@@ -261,6 +256,12 @@ void ImagesNode::process(Message&& msg)
           this->materialChange();
           break;
         }
+
+        case 8: // Downscale
+        {
+          this->downscale = ossia::convert<bool>(*val);
+          break;
+        }
       }
     }
 
@@ -281,7 +282,12 @@ void ImagesNode::clear()
 #endif
 
   linearImages.clear();
-  Gfx::releaseImages(images);
+  images.clear();
+}
+
+int ImagesNode::prefetchCount() const noexcept
+{
+  return ctx.app.settings<Gfx::Settings::Model>().getImagePrefetch();
 }
 
 ImagesNode::~ImagesNode()
@@ -318,13 +324,13 @@ static QRhiSampler* createSampler(ImageMode tile, QRhi& rhi)
   return sampler;
 }
 
-class ImagesNode::PreloadedRenderer : public GenericNodeRenderer
+class ImagesNode::CachedRenderer : public GenericNodeRenderer
 {
 public:
   using GenericNodeRenderer::GenericNodeRenderer;
 
 private:
-  ~PreloadedRenderer() { }
+  ~CachedRenderer() { }
 
   int imagesChanged = -1;
   ImageMode tile{};
@@ -334,48 +340,124 @@ private:
   float scale_w{1.f};
   float scale_h{1.f};
 
-  void recreateTextures(QRhi& rhi)
+  void bindTexture(QRhiTexture* tex)
   {
-    auto& n = static_cast<const ImagesNode&>(this->node);
+    auto replace_texture = [](PassMap& passes, QRhiSampler* sampler, QRhiTexture* tex) {
+      for(auto& pass : passes)
+        score::gfx::replaceTexture(*pass.second.srb, sampler, tex);
+    };
+    QRhiSampler* sampler = m_samplers[0].sampler;
+    m_samplers[0].texture = tex;
+    replace_texture(m_p, sampler, tex);
+    replace_texture(m_altPasses, sampler, tex);
+  }
 
+  // Resizes the texture if needed, and puts the new one in the passes
+  void setTextureSize(RenderList& renderer, QSize sz)
+  {
+    QRhi& rhi = *renderer.state.rhi;
     const int limits_min = rhi.resourceLimit(QRhi::ResourceLimit::TextureSizeMin);
     const int limits_max = rhi.resourceLimit(QRhi::ResourceLimit::TextureSizeMax);
+    const auto tex_size = resizeTextureSize(sz, limits_min, limits_max);
+
+    if(m_texture && m_texture->pixelSize() == tex_size)
+      return;
+
+    // The texture may still be used by the previous frame
+    if(m_texture)
+      m_texture->deleteLater();
 
-    for(int i = 0, N = n.linearImages.size(); i < N; i++)
+    m_texture = rhi.newTexture(imageTextureFormat(rhi), tex_size, 1, QRhiTexture::Flag{});
+    m_texture->setName("ImagesNode::tex");
+    m_texture->create();
+    bindTexture(m_texture);
+  }
+
+  void clearTexture(RenderList& renderer)
+  {
+    bindTexture(&renderer.emptyTexture());
+    if(m_texture)
     {
-      auto frame = n.linearImages[i];
-      QSize sz{limits_min, limits_min};
-      if(auto qimage = std::get_if<QImage*>(&frame))
-      {
-        sz = (*qimage)->size();
-      }
+      m_texture->deleteLater();
+      m_texture = nullptr;
+    }
+    m_sourceSize = {};
+  }
+
+  // Uploads the current image if it is decoded.
+  // Until then, the previous one stays on screen.
+  bool uploadCurrentImage(RenderList& renderer, QRhiResourceUpdateBatch& res, int index)
+  {
+    auto& n = static_cast<const ImagesNode&>(this->node);
+    if(!ossia::valid_index(index, n.linearImages))
+      return false;
+
+    if(auto cached = std::get_if<CachedFrame>(&n.linearImages[index]))
+    {
+      if(index == m_textureIndex)
+        return false;
+
+      auto img = Gfx::ImageCache::instance().request(cached->path, m_maxSize);
+      if(!img || img->frames.empty())
+        return false;
+
+      auto& frame = img->frames[std::min(cached->frame, int(img->frames.size()) - 1)];
+      setTextureSize(renderer, frame.size());
+      res.uploadTexture(m_texture, renderer.adaptImage(frame));
+
+      // Sizing follows the image in the file, not the downscaled one
+      m_sourceSize = img->sourceSize;
+      m_textureIndex = index;
+      return true;
+    }
 #if Q_SVG_LIB
-      else if(auto svg_p = std::get_if<QSvgRenderer*>(&frame))
-      {
-        auto* svg = *svg_p;
-        auto svg_size = svg->defaultSize();
-        svg_size = QSize(
-            svg_size.width() * std::abs(scale_w), svg_size.height() * std::abs(scale_h));
-        sz = svg_size;
-      }
+    else if(auto svg = std::get_if<QSvgRenderer*>(&n.linearImages[index]))
+    {
+      if(index == m_textureIndex && !(*svg)->animated())
+        return false;
+
+      static thread_local QImage temp_svg;
+      auto svg_size = (*svg)->defaultSize();
+      svg_size = QSize(
+          svg_size.width() * std::abs(scale_w), svg_size.height() * std::abs(scale_h));
+      if(svg_size.isEmpty())
+        return false;
+
+      if(temp_svg.size() != svg_size)
+        temp_svg = QImage(svg_size, QImage::Format_ARGB32);
+      QPainter temp_svg_painter{&temp_svg};
+      temp_svg.fill(0);
+      (*svg)->render(&temp_svg_painter);
+
+      setTextureSize(renderer, svg_size);
+      res.uploadTexture(m_texture, renderer.adaptImage(temp_svg));
+      m_sourceSize = svg_size;
+      m_textureIndex = index;
+      return true;
+    }
 #endif
-      const auto tex_size
-          = resizeTextureSize(QSize{sz.width(), sz.height()}, limits_min, limits_max);
+    return false;
+  }
 
-      if(m_textures.size() <= i)
-      {
-        QRhiTexture* tex = tex
-            = rhi.newTexture(imageTextureFormat(rhi), tex_size, 1, QRhiTexture::Flag{});
-        tex->setName("ImagesNode::tex");
-        tex->create();
-        m_textures.push_back(tex);
-      }
-      else if(m_textures[i]->pixelSize() != tex_size)
+  // The next images get decoded while the current one is shown
+  void prefetch(int index)
+  {
+    auto& n = static_cast<const ImagesNode&>(this->node);
+    const int N = n.linearImages.size();
+    const int count = std::min(n.prefetchCount(), N - 1);
+
+    auto& cache = Gfx::ImageCache::instance();
+    const QString* prev{};
+    for(int k = 1; k <= count; k++)
+    {
+      const int idx = imageIndex(index + k, N);
+      if(auto cached = std::get_if<CachedFrame>(&n.linearImages[idx]))
       {
-        auto tex = m_textures[i];
-        tex->destroy();
-        tex->setPixelSize(tex_size);
-        tex->create();
+        // The frames of an animated image are decoded together
+        if(prev && *prev == cached->path)
+          continue;
+        cache.prefetch(cached->path, m_maxSize);
+        prev = &cached->path;
       }
     }
   }
@@ -394,18 +476,15 @@ private:
     m_ubo.currentImageIndex = -1;
     QRhi& rhi = *renderer.state.rhi;
 
-    // Create GPU textures for each image
-    recreateTextures(rhi);
-
     tile = n.tileMode;
     std::tie(m_vertexS, m_fragmentS) = score::gfx::makeShaders(
         rs, images_single_vertex_shader, images_single_fragment_shader);
 
-    // Create the sampler in which we are going to put the texture
+    // Create the sampler in which we are going to put the texture.
+    // The empty texture is shown until the first image is decoded.
     {
       auto sampler = createSampler(tile, rhi);
-      auto tex = m_textures.empty() ? &renderer.emptyTexture() : m_textures.front();
-      m_samplers.push_back({sampler, tex});
+      m_samplers.push_back({sampler, &renderer.emptyTexture()});
     }
 
     // Initialize the passes for the "single" case
@@ -453,111 +532,29 @@ private:
 
       // Release the old sampler
       mustRecomputeSize = true;
-      imagesChanged = -1;
       s->deleteLater();
     }
 
-    bool updateCurrentTexture = false;
-    if(n.imagesChanged > imagesChanged)
+    // The images are decoded at the size of the output if asked to
+    const QSize maxSize = n.downscale ? renderer.state.renderSize : QSize{};
+    bool indexChanged = m_ubo.currentImageIndex != n.ubo.currentImageIndex;
+    if(n.imagesChanged > imagesChanged || maxSize != m_maxSize)
     {
       imagesChanged = n.imagesChanged;
-      if(m_textures.size() > n.linearImages.size())
-      {
-        for(int i = n.linearImages.size(); i < m_textures.size(); i++)
-        {
-          m_textures[i]->deleteLater();
-        }
-        m_textures.resize(n.linearImages.size());
-      }
-
-      m_uploaded = false;
+      m_maxSize = maxSize;
+      m_textureIndex = -1;
+      indexChanged = true;
+      if(n.linearImages.empty())
+        clearTexture(renderer);
     }
 
-    recreateTextures(*renderer.state.rhi);
-
-    // If images haven't been uploaded yet, upload them.
-    {
-      static thread_local QImage temp_svg;
-
-      std::size_t k = 0;
-      for(auto frame : n.linearImages)
-      {
-        if(auto qimage = std::get_if<QImage*>(&frame))
-        {
-          if(!m_uploaded)
-          {
-            res.uploadTexture(m_textures[k], renderer.adaptImage(**qimage));
-            updateCurrentTexture = true;
-          }
-        }
-#if Q_SVG_LIB
-        else if(auto svg = std::get_if<QSvgRenderer*>(&frame))
-        {
-          auto svg_size = (*svg)->defaultSize();
-          svg_size = QSize(
-              svg_size.width() * std::abs(scale_w),
-              svg_size.height() * std::abs(scale_h));
-          if(!svg_size.isEmpty())
-          {
-            if((*svg)->animated())
-            {
-              if(temp_svg.size() != svg_size)
-                temp_svg = QImage(svg_size, QImage::Format_ARGB32);
-              QPainter temp_svg_painter{&temp_svg};
-              temp_svg.fill(0);
-              (*svg)->render(&temp_svg_painter);
-              res.uploadTexture(m_textures[k], renderer.adaptImage(temp_svg));
-              updateCurrentTexture = true;
-            }
-            else
-            {
-              if(!m_uploaded)
-              {
-                if(temp_svg.size() != svg_size)
-                  temp_svg = QImage(svg_size, QImage::Format_ARGB32);
-                QPainter temp_svg_painter{&temp_svg};
-                temp_svg.fill(0);
-                (*svg)->render(&temp_svg_painter);
-                res.uploadTexture(m_textures[k], renderer.adaptImage(temp_svg));
-                updateCurrentTexture = true;
-              }
-            }
-          }
-        }
-#endif
-
-        k++;
-      }
-      m_uploaded = true;
-    }
-
-    // If the current image being displayed by this renderer (in m_prev_ubo)
-    // is out of date with the image in the data model, we switch the texture
-    int currentImageIndex = -1;
-    if(updateCurrentTexture || m_ubo.currentImageIndex != n.ubo.currentImageIndex)
+    const int currentImageIndex
+        = imageIndex(n.ubo.currentImageIndex, n.linearImages.size());
+    if(uploadCurrentImage(renderer, res, currentImageIndex))
+      mustRecomputeSize = true;
+    if(indexChanged)
     {
-      auto replace_texture
-          = [](PassMap& passes, QRhiSampler* sampler, QRhiTexture* tex) {
-        for(auto& pass : passes)
-          score::gfx::replaceTexture(*pass.second.srb, sampler, tex);
-      };
-
-      currentImageIndex = imageIndex(n.ubo.currentImageIndex, m_textures.size());
-      QRhiSampler* sampler = m_samplers[0].sampler;
-      QRhiTexture* new_tex{};
-      if(ossia::valid_index(currentImageIndex, m_textures))
-      {
-        new_tex = m_textures[currentImageIndex];
-      }
-      else
-      {
-        new_tex = &renderer.emptyTexture();
-      }
-
-      replace_texture(m_p, sampler, new_tex);
-      replace_texture(m_altPasses, sampler, new_tex);
-
-      m_ubo.currentImageIndex = n.ubo.currentImageIndex;
+      prefetch(currentImageIndex);
       mustRecomputeSize = true;
     }
 
@@ -576,16 +573,13 @@ private:
         scale_h = n.scale_h;
 
         QSizeF textureSize{1, 1};
+        if(m_texture && !m_sourceSize.isEmpty())
+          textureSize = m_sourceSize;
 
-        if(currentImageIndex == -1)
-          currentImageIndex = imageIndex(m_ubo.currentImageIndex, m_textures.size());
-        if(currentImageIndex < std::ssize(m_textures))
-          textureSize = m_textures[currentImageIndex]->pixelSize();
-
-        if(currentImageIndex < n.linearImages.size())
+        if(ossia::valid_index(m_textureIndex, n.linearImages))
         {
 #if Q_SVG_LIB
-          const bool is_svg = n.linearImages[currentImageIndex].index() == 1;
+          const bool is_svg = n.linearImages[m_textureIndex].index() == 1;
           if(is_svg)
           {
             if(tile == score::gfx::Single)
@@ -653,11 +647,13 @@ private:
 
   void release(RenderList& r) override
   {
-    for(auto tex : m_textures)
+    if(m_texture)
     {
-      tex->deleteLater();
+      m_texture->deleteLater();
+      m_texture = nullptr;
     }
-    m_textures.clear();
+    m_textureIndex = -1;
+    m_sourceSize = {};
 
     defaultRelease(r);
 
@@ -670,8 +666,12 @@ private:
 
   struct ImagesNode::UBO m_ubo;
   ossia::small_vector<std::pair<Edge*, Pipeline>, 2> m_altPasses;
-  std::vector<QRhiTexture*> m_textures;
-  bool m_uploaded = false;
+
+  // Only the image on screen is on the GPU
+  QRhiTexture* m_texture{};
+  int m_textureIndex{-1};
+  QSize m_sourceSize;
+  QSize m_maxSize;
 };
 
 #if 0
@@ -862,7 +862,7 @@ private:
 
 NodeRenderer* ImagesNode::createRenderer(RenderList& r) const noexcept
 {
-  return new PreloadedRenderer{*this};
+  return new CachedRenderer{*this};
 }
 
 }
@@ -916,6 +916,7 @@ FullScreenImageNode::FullScreenImageNode(QImage dec)
     : m_image{std::move(dec)}
 {
   output.push_back(new Port{this, {}, Types::Image, {}});
+  timeVarying = false;
 }
 
 FullScreenImageNode::~FullScreenImageNode() { }
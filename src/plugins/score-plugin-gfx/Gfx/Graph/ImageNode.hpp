@@ -26,7 +26,7 @@ public:
 
   score::gfx::NodeRenderer* createRenderer(RenderList& r) const noexcept override;
 
-  class PreloadedRenderer;
+  class CachedRenderer;
   class OnTheFlyRenderer;
 
 #pragma pack(push, 1)
@@ -41,6 +41,7 @@ public:
 
   std::atomic_int imagesChanged{};
   std::atomic<ImageMode> tileMode{};
+  std::atomic_bool downscale{};
   score::gfx::ScaleMode scaleMode{score::gfx::ScaleMode::Original};
   float scale_w{1.0f};
   float scale_h{1.0f};
@@ -49,9 +50,18 @@ private:
   void clear();
   void process(Message&& msg) override;
 
-  using image_type = std::variant<QImage*, QSvgRenderer*>;
+  //! How many of the next images are decoded in advance
+  int prefetchCount() const noexcept;
+
+  //! A frame of an image decoded by Gfx::ImageCache
+  struct CachedFrame
+  {
+    QString path;
+    int frame{};
+  };
+  using image_type = std::variant<CachedFrame, QSvgRenderer*>;
   const score::DocumentContext& ctx;
-  std::vector<score::gfx::Image> images;
+  std::vector<QString> images;
   std::vector<image_type> linearImages;
 };
 struct SCORE_PLUGIN_GFX_EXPORT FullScreenImageNode : NodeModel
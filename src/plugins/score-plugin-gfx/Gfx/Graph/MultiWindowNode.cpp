@@ -1089,7 +1089,8 @@ void MultiWindowNode::updateGraphicsAPI(GraphicsApi api)
   if(!m_renderState)
     return;
 
-  if(m_renderState->api != api)
+  if(m_renderState->api != api
+     || m_renderState->timestamps != gpuTimestampsRequested())
     destroyOutput();
 }
 
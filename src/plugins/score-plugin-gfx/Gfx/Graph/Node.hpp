@@ -162,6 +162,15 @@ public:
   bool requiresDepth{};
   bool addedToGraph{};
 
+  /**
+   * @brief Whether the output of this node may change from a frame to the next
+   * without any change of its inputs, e.g. if it depends on the time.
+   *
+   * When false, the last texture rendered from this node is reused until a
+   * control of the node or of a node upstream changes.
+   */
+  bool timeVarying{true};
+
   QSize resolveRenderTargetSize(int32_t port, RenderList& renderer) const noexcept;
   RenderTargetSpecs
   resolveRenderTargetSpecs(int32_t port, RenderList& renderer) const noexcept;
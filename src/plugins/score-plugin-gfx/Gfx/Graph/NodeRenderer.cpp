@@ -311,6 +311,11 @@ void NodeRenderer::updateInputTexture(const Port& input, QRhiTexture* tex)
 {
 }
 
+bool NodeRenderer::acceptsSharedInputs() const noexcept
+{
+  return false;
+}
+
 void NodeRenderer::inputAboutToFinish(
     RenderList& renderer, const Port& p, QRhiResourceUpdateBatch*&)
 {
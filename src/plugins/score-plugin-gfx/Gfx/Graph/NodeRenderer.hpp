@@ -26,10 +26,15 @@ public:
   //! downstream-provided render target.
   virtual QRhiTexture* textureForOutput(const Port& output);
 
-  //! Updates the sampler texture for a GrabsFromSource input port.
+  //! Updates the sampler texture for a GrabsFromSource input port, or for an
+  //! input rendered by another RenderList.
   //! Called from the render loop when the upstream texture may have changed.
   virtual void updateInputTexture(const Port& input, QRhiTexture* tex);
 
+  //! True if updateInputTexture works for any image input port, so that the
+  //! input can sample a texture rendered by another RenderList.
+  virtual bool acceptsSharedInputs() const noexcept;
+
   //! Called when all the inbound nodes to a texture input have finished rendering.
   //! Mainly useful to slip in a readback.
   virtual void
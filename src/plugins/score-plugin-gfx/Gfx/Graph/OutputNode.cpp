@@ -8,6 +8,7 @@ OutputNode::~OutputNode() { }
 
 void OutputNode::updateGraphicsAPI(GraphicsApi) { }
 void OutputNode::setVSyncCallback(std::function<void()>) { }
+void OutputNode::setOfflineRendering(bool) { }
 OutputNodeRenderer::~OutputNodeRenderer() { }
 
 void OutputNodeRenderer::finishFrame(
@@ -51,6 +51,15 @@ public:
    */
   virtual void setVSyncCallback(std::function<void()>);
 
+  /**
+   * @brief Called when render() starts or stops following the score time
+   * instead of the wall clock.
+   *
+   * Offline, every call to render() is a frame that must not be lost,
+   * however long it takes.
+   */
+  virtual void setOfflineRendering(bool);
+
   virtual void createOutput(OutputConfiguration conf) = 0;
 
   virtual void updateGraphicsAPI(GraphicsApi);
@@ -8,6 +8,10 @@
 
 #include <score/tools/Debug.hpp>
 
+#include <ossia/detail/algorithms.hpp>
+
+#include <chrono>
+
 //#define RENDERDOC_PROFILING 0
 #if defined(RENDERDOC_PROFILING)
 #include "renderdoc_app.h"
@@ -151,6 +155,9 @@ void RenderList::release()
   }
   m_inputRenderTargets.clear();
 
+  // The renderers sample their own render targets again after init()
+  m_borrowedInputs.clear();
+
   for(auto& bufs : m_vertexBuffers)
   {
     for(auto& b : bufs.second.buffers)
@@ -521,11 +528,168 @@ const Mesh& RenderList::defaultTriangle() const noexcept
   */
 }
 
+void RenderList::addTiming(const NodeRenderer& renderer, int64_t ns)
+{
+  const int32_t id = renderer.node.nodeId;
+  for(auto& [node, t] : m_timings)
+  {
+    if(node == id)
+    {
+      t += ns;
+      return;
+    }
+  }
+  m_timings.emplace_back(id, ns);
+}
+
+QRhiTexture*
+RenderList::sharedTexture(RenderList& other, Node& node, const Port& input)
+{
+  auto mine = node.renderedNodes.find(this);
+  auto theirs = node.renderedNodes.find(&other);
+  if(mine == node.renderedNodes.end() || theirs == node.renderedNodes.end())
+    return nullptr;
+  if(!mine->second->acceptsSharedInputs())
+    return nullptr;
+
+  // Only the render targets created by the lists can be shared
+  if(mine->second->renderTargetForInput(input) || theirs->second->renderTargetForInput(input))
+    return nullptr;
+
+  auto ours = renderTargetForInputPort(input);
+  auto shared = other.renderTargetForInputPort(input);
+  if(!ours.texture || !shared.texture)
+    return nullptr;
+  if(ours.texture->pixelSize() != shared.texture->pixelSize()
+     || ours.texture->format() != shared.texture->format())
+    return nullptr;
+
+  return shared.texture;
+}
+
+void RenderList::shareInputs()
+{
+  m_sharedInputs.clear();
+  m_usedNodes.clear();
+
+  auto other = sharedWith.lock();
+  if(other && other->canRender() && other->frame > 0)
+  {
+    for(auto node : this->nodes)
+    {
+      if(node == &output)
+        continue;
+
+      for(auto input : node->input)
+      {
+        if(input->type != Types::Image || input->edges.empty())
+          continue;
+        if((input->flags & Flag::GrabsFromSource) == Flag::GrabsFromSource)
+          continue;
+
+        if(auto tex = sharedTexture(*other, *node, *input))
+          m_sharedInputs.emplace(input, tex);
+      }
+    }
+  }
+
+  // The nodes which were not rendered while an input was shared
+  // have to be rendered again entirely
+  m_sharingChanged = ossia::any_of(m_borrowedInputs, [this](const auto& p) {
+    return m_sharedInputs.find(p.first) == m_sharedInputs.end();
+  });
+  if(m_sharedInputs.empty())
+    return;
+
+  // Sinks come before their sources in nodes: only the nodes which still
+  // feed an input which is not shared are rendered.
+  m_usedNodes.insert(&output);
+  for(auto node : this->nodes)
+  {
+    if(m_usedNodes.find(node) == m_usedNodes.end())
+      continue;
+
+    for(auto input : node->input)
+    {
+      if(m_sharedInputs.find(input) != m_sharedInputs.end())
+        continue;
+      for(auto edge : input->edges)
+        m_usedNodes.insert(edge->source->node);
+    }
+  }
+}
+
+void RenderList::markDirtyNodes()
+{
+  m_dirtyNodes.clear();
+
+  // Sources come after their sinks in nodes
+  for(auto it = this->nodes.rbegin(); it != this->nodes.rend(); ++it)
+  {
+    const Node* node = *it;
+    bool dirty = m_sharingChanged || node->timeVarying;
+    if(!dirty)
+    {
+      auto rendered = node->renderedNodes.find(this);
+      dirty = rendered == node->renderedNodes.end()
+              || rendered->second->materialChanged
+              || rendered->second->renderTargetSpecsChanged;
+    }
+
+    for(auto input : node->input)
+    {
+      if(dirty)
+        break;
+      dirty = inputChanged(*input);
+    }
+
+    if(dirty)
+      m_dirtyNodes.insert(node);
+  }
+}
+
+bool RenderList::inputChanged(const Port& input) const noexcept
+{
+  // We cannot know when the list which renders it last did
+  if(m_borrowedInputs.find(&input) != m_borrowedInputs.end())
+    return true;
+
+  for(auto edge : input.edges)
+  {
+    // A feedback loop reads what was rendered in the previous frame
+    if(edge->type == Process::CableType::DelayedGlutton
+       || edge->type == Process::CableType::DelayedStrict)
+      return true;
+    if(m_dirtyNodes.find(edge->source->node) != m_dirtyNodes.end())
+      return true;
+  }
+  return false;
+}
+
 void RenderList::render(QRhiCommandBuffer& commands, bool force)
 {
   if(renderers.size() <= 1 && !force)
     return;
 
+  using clock = std::chrono::steady_clock;
+  m_profiling = profiler && profiler->enabled();
+  m_timings.clear();
+  const auto frameStart = m_profiling ? clock::now() : clock::time_point{};
+
+  // Time spent by a node on the CPU, recording its commands
+  const auto timed = [this](NodeRenderer& renderer, auto&& f) {
+    if(!m_profiling)
+    {
+      f();
+      return;
+    }
+    const auto t0 = clock::now();
+    f();
+    addTiming(
+        renderer,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - t0).count());
+  };
+
   bool rt_changed = false;
   for(auto* renderer : renderers)
   {
@@ -573,6 +737,13 @@ void RenderList::render(QRhiCommandBuffer& commands, bool force)
       node->renderTargetSpecsChanged = true;
     }
   }
+
+  shareInputs();
+
+  // After a rebuild every renderer has its materialChanged flag set,
+  // thus all the nodes are rendered again.
+  markDirtyNodes();
+
   // Check if the viewport has changed
 
   update(*updateBatch);
@@ -601,7 +772,7 @@ void RenderList::render(QRhiCommandBuffer& commands, bool force)
   updated_nodes.clear();
 
   const auto prepare_render
-      = [this, &prevRenderers, &commands, &updateBatch](score::gfx::Port* input) {
+      = [this, &prevRenderers, &commands, &updateBatch, &timed](score::gfx::Port* input) {
     prevRenderers.clear();
     prevRenderers.reserve(input->edges.size());
 
@@ -617,7 +788,7 @@ void RenderList::render(QRhiCommandBuffer& commands, bool force)
 
       prevRenderers.push_back({edge, prev_renderer});
 
-      prev_renderer->update(*this, *updateBatch, edge);
+      timed(*prev_renderer, [&] { prev_renderer->update(*this, *updateBatch, edge); });
       updated_nodes.insert(&prev_renderer->node);
     }
 
@@ -644,7 +815,9 @@ void RenderList::render(QRhiCommandBuffer& commands, bool force)
         updateBatch = state.rhi->nextResourceUpdateBatch();
         SCORE_ASSERT(updateBatch);
 
-        prev_renderer->runInitialPasses(*this, commands, updateBatch, *edge);
+        timed(*prev_renderer, [&] {
+          prev_renderer->runInitialPasses(*this, commands, updateBatch, *edge);
+        });
       }
     }
   };
@@ -653,6 +826,11 @@ void RenderList::render(QRhiCommandBuffer& commands, bool force)
   for(auto it = this->nodes.rbegin(); it != this->nodes.rend(); ++it)
   {
     auto node = *it;
+
+    // Only feeds inputs rendered by the list we share with
+    if(!m_usedNodes.empty() && m_usedNodes.find(node) == m_usedNodes.end())
+      continue;
+
     for(auto input : node->input)
     {
       // For each edge incoming to each image input ports of this node,
@@ -664,10 +842,45 @@ void RenderList::render(QRhiCommandBuffer& commands, bool force)
       {
         const bool grabs = (input->flags & Flag::GrabsFromSource) == Flag::GrabsFromSource;
 
-        prepare_render(input);
+        const auto shared = m_sharedInputs.find(input);
+        const bool isShared = shared != m_sharedInputs.end();
+        bool restored = false;
+        if(isShared)
+        {
+          // Sample the texture rendered by the other list instead
+          if(auto& tex = m_borrowedInputs[input]; tex != shared->second)
+          {
+            node->renderedNodes.find(this)->second->updateInputTexture(
+                *input, shared->second);
+            tex = shared->second;
+          }
+        }
+        else if(auto borrowed = m_borrowedInputs.find(input);
+                borrowed != m_borrowedInputs.end())
+        {
+          // Back to our own render target, which has to be rendered again
+          node->renderedNodes.find(this)->second->updateInputTexture(
+              *input, renderTargetForInputPort(*input).texture);
+          m_borrowedInputs.erase(borrowed);
+          restored = true;
+        }
 
-        if(grabs)
+        if(isShared || (!restored && node != &output && !inputChanged(*input)))
         {
+          // Nothing upstream changed since the last frame: the texture
+          // of this input still has the right content.
+          // The output node is always rendered as its render target may be
+          // a swapchain.
+          if(updateBatch)
+          {
+            commands.resourceUpdate(updateBatch);
+            updateBatch = nullptr;
+          }
+        }
+        else if(grabs)
+        {
+          prepare_render(input);
+
           // GrabsFromSource: upstream already produced the texture
           // in runInitialPasses. No render pass needed.
           // Update the downstream node's sampler to point to the
@@ -692,6 +905,8 @@ void RenderList::render(QRhiCommandBuffer& commands, bool force)
         }
         else
         {
+          prepare_render(input);
+
           // Then do the final render of each node on the edge sink's render target
           // We *have* to do that in a single beginPass / endPass as every beginPass
           // issues a clearBuffers command.
@@ -713,14 +928,16 @@ void RenderList::render(QRhiCommandBuffer& commands, bool force)
               // FIXME z-sort
               for(auto [edge, prev_renderer] : prevRenderers)
               {
-                prev_renderer->runRenderPass(*this, commands, *edge);
+                timed(*prev_renderer, [&] {
+                  prev_renderer->runRenderPass(*this, commands, *edge);
+                });
               }
 
               // Allow the node to do some actions, for instance if a readback
               // of a node's input is going to be needed.
-              {
+              timed(*renderer, [&] {
                 renderer->inputAboutToFinish(*this, *input, updateBatch);
-              }
+              });
               commands.endPass(updateBatch);
               updateBatch = nullptr;
             }
@@ -754,7 +971,9 @@ void RenderList::render(QRhiCommandBuffer& commands, bool force)
             updateBatch = nullptr;
           }
 
-          renderer->inputAboutToFinish(*this, *input, updateBatch);
+          timed(*renderer, [&] {
+            renderer->inputAboutToFinish(*this, *input, updateBatch);
+          });
 
           if(updateBatch)
           {
@@ -792,12 +1011,16 @@ void RenderList::render(QRhiCommandBuffer& commands, bool force)
       // FIXME remove this hack
       score::gfx::Port p;
       score::gfx::Edge dummy{&p, &p, Process::CableType::ImmediateGlutton};
-      output_renderer->update(*this, *updateBatch, nullptr);
-      output_renderer->runInitialPasses(*this, commands, updateBatch, dummy);
-      output_renderer->runRenderPass(*this, commands, dummy);
+      timed(*output_renderer, [&] {
+        output_renderer->update(*this, *updateBatch, nullptr);
+        output_renderer->runInitialPasses(*this, commands, updateBatch, dummy);
+        output_renderer->runRenderPass(*this, commands, dummy);
+      });
     }
 
-    output_renderer->finishFrame(*this, commands, updateBatch);
+    timed(*output_renderer, [&] {
+      output_renderer->finishFrame(*this, commands, updateBatch);
+    });
 
     if(updateBatch)
       updateBatch->release();
@@ -808,6 +1031,20 @@ void RenderList::render(QRhiCommandBuffer& commands, bool force)
     renderdoc_api->EndFrameCapture(NULL, NULL);
 #endif
 
+  if(m_profiling)
+  {
+    // The GPU time is the one of an earlier frame, which has completed by now
+    double gpu_ms = 0.;
+#if QT_VERSION >= QT_VERSION_CHECK(6, 6, 0)
+    gpu_ms = commands.lastCompletedGpuTime() * 1000.;
+#endif
+    profiler->commit(
+        output.nodeId, m_timings,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - frameStart)
+            .count(),
+        gpu_ms);
+  }
+
   frame++;
 }
 
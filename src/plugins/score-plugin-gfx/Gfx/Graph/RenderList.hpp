@@ -1,6 +1,9 @@
 #pragma once
 #include <Gfx/Graph/CommonUBOs.hpp>
 #include <Gfx/Graph/Node.hpp>
+#include <Gfx/Graph/RenderProfiler.hpp>
+
+#include <ossia/detail/flat_set.hpp>
 
 namespace score::gfx
 {
@@ -158,9 +161,31 @@ public:
 
   int64_t frame = 0;
 
+  /**
+   * @brief Where the timings of the nodes are committed, see RenderProfiler
+   */
+  RenderProfiler* profiler{};
+
+  /**
+   * @brief Earlier RenderList on the same QRhi, whose input textures can be reused.
+   *
+   * Set by the Graph when renderers are shared between outputs. The image inputs
+   * which that list renders with the same size and format are not rendered again
+   * by this one: they sample its texture, as it was after its last frame, and
+   * the nodes upstream of them are skipped.
+   */
+  std::weak_ptr<RenderList> sharedWith;
+
   void createAllInputRenderTargets();
 
 private:
+  void addTiming(const NodeRenderer& renderer, int64_t ns);
+
+  void shareInputs();
+  QRhiTexture* sharedTexture(RenderList& other, Node& node, const Port& input);
+  void markDirtyNodes();
+  bool inputChanged(const Port& input) const noexcept;
+
   OutputUBO m_outputUBOData;
 
   QRhiResourceUpdateBatch* m_initialBatch{};
@@ -193,6 +218,26 @@ private:
   int m_maxTexSize{};
   int m_samples{1};
 
+  // CPU time of each node in the current frame, when profiling
+  std::vector<std::pair<int32_t, int64_t>> m_timings;
+  bool m_profiling{};
+
+  /**
+   * @brief Nodes whose output may differ from the one of the previous frame.
+   *
+   * The render targets fed only by the other nodes are not rendered again.
+   */
+  ossia::flat_set<const Node*> m_dirtyNodes;
+
+  // Inputs which sample the texture of sharedWith in this frame,
+  // and the nodes still needed by the other inputs
+  ossia::flat_map<const Port*, QRhiTexture*> m_sharedInputs;
+  ossia::flat_set<const Node*> m_usedNodes;
+
+  // Inputs whose renderer currently samples a texture of sharedWith
+  ossia::flat_map<const Port*, QRhiTexture*> m_borrowedInputs;
+  bool m_sharingChanged{};
+
   bool m_requiresDepth{};
   bool m_ready{};
   bool m_built{};
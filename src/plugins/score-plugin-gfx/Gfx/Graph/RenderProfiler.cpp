@@ -0,0 +1,83 @@
+#include "RenderProfiler.hpp"
+
+namespace score::gfx
+{
+void RenderProfiler::setEnabled(bool b) noexcept
+{
+  if(m_enabled.exchange(b, std::memory_order_relaxed) == b)
+    return;
+
+  // Do not mix the timings of two runs
+  std::lock_guard l{m_mutex};
+  m_nodes.clear();
+  m_outputs.clear();
+}
+
+void RenderProfiler::setOutputName(int32_t output, std::string name)
+{
+  std::lock_guard l{m_mutex};
+  m_names[output] = std::move(name);
+}
+
+void RenderProfiler::removeOutput(int32_t output)
+{
+  std::lock_guard l{m_mutex};
+  m_names.erase(output);
+  m_outputs.erase(output);
+}
+
+void RenderProfiler::commit(
+    int32_t output, std::span<const std::pair<int32_t, int64_t>> nodes, int64_t cpu_ns,
+    double gpu_ms)
+{
+  std::lock_guard l{m_mutex};
+  for(auto [node, ns] : nodes)
+  {
+    auto& n = m_nodes[node];
+    n.ns += ns;
+    n.frames++;
+  }
+
+  auto& o = m_outputs[output];
+  o.cpu_ns += cpu_ns;
+  o.frames++;
+  if(gpu_ms > 0.)
+  {
+    o.gpu_ms += gpu_ms;
+    o.gpu_frames++;
+  }
+}
+
+RenderStatistics RenderProfiler::take()
+{
+  RenderStatistics res;
+
+  std::lock_guard l{m_mutex};
+  res.nodes.reserve(m_nodes.size());
+  for(auto& [node, n] : m_nodes)
+  {
+    if(n.frames > 0)
+      res.nodes[node] = {.cpu_ms = double(n.ns) / (1e6 * n.frames), .frames = n.frames};
+  }
+  m_nodes.clear();
+
+  res.outputs.reserve(m_outputs.size());
+  for(auto& [output, o] : m_outputs)
+  {
+    if(o.frames == 0)
+      continue;
+
+    OutputRenderStatistics s{
+        .output = output,
+        .cpu_ms = double(o.cpu_ns) / (1e6 * o.frames),
+        .gpu_ms = o.gpu_frames > 0 ? o.gpu_ms / o.gpu_frames : 0.,
+        .frames = o.frames};
+    if(auto it = m_names.find(output); it != m_names.end())
+      s.name = it->second;
+    res.outputs.push_back(std::move(s));
+    o = {};
+  }
+
+  return res;
+}
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <ossia/detail/hash_map.hpp>
+
+#include <score_plugin_gfx_export.h>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace score::gfx
+{
+//! Mean timings of a node over the frames in which it was rendered
+struct NodeRenderStatistics
+{
+  double cpu_ms{};
+  int frames{};
+};
+
+//! Mean timings of the frames of an output
+struct OutputRenderStatistics
+{
+  int32_t output{};
+  std::string name;
+  double cpu_ms{};
+
+  //! Zero if the backend does not support timestamps
+  double gpu_ms{};
+  int frames{};
+};
+
+struct RenderStatistics
+{
+  ossia::hash_map<int32_t, NodeRenderStatistics> nodes;
+  std::vector<OutputRenderStatistics> outputs;
+};
+
+/**
+ * @brief Timings of the nodes of a Graph, measured as they are rendered.
+ *
+ * Each RenderList measures the time its nodes spend on the CPU in their
+ * update, initial passes and render passes, and the GPU time of its frames
+ * when the QRhi backend supports timestamps. It commits them once per frame,
+ * from the thread of its output.
+ *
+ * The UI thread takes the mean timings since its last call with take().
+ */
+class SCORE_PLUGIN_GFX_EXPORT RenderProfiler
+{
+public:
+  bool enabled() const noexcept { return m_enabled.load(std::memory_order_relaxed); }
+  void setEnabled(bool b) noexcept;
+
+  //! The outputs are nodes of the graph, without a process to name them
+  void setOutputName(int32_t output, std::string name);
+  void removeOutput(int32_t output);
+
+  // Render threads
+  void commit(
+      int32_t output, std::span<const std::pair<int32_t, int64_t>> nodes,
+      int64_t cpu_ns, double gpu_ms);
+
+  // UI thread
+  RenderStatistics take();
+
+private:
+  struct NodeAccumulator
+  {
+    int64_t ns{};
+    int frames{};
+  };
+  struct OutputAccumulator
+  {
+    int64_t cpu_ns{};
+    double gpu_ms{};
+    int gpu_frames{};
+    int frames{};
+  };
+
+  std::atomic_bool m_enabled{};
+
+  std::mutex m_mutex;
+  ossia::hash_map<int32_t, NodeAccumulator> m_nodes;
+  ossia::hash_map<int32_t, OutputAccumulator> m_outputs;
+  ossia::hash_map<int32_t, std::string> m_names;
+};
+}
@@ -29,6 +29,15 @@ enum GraphicsApi
 };
 
 class Window;
+struct RenderState;
+
+//! Restores the pipelines compiled by the driver in a previous run
+SCORE_PLUGIN_GFX_EXPORT
+void loadPipelineCache(RenderState& state);
+
+//! Needs the QRhi to have been created with QRhi::EnablePipelineCacheDataSave
+SCORE_PLUGIN_GFX_EXPORT
+void savePipelineCache(const RenderState& state);
 
 /**
  * @brief Global state associated to a rendering context.
@@ -55,6 +64,9 @@ struct RenderState
   GraphicsApi api{};
   QShaderVersion version{};
 
+  //! The QRhi was created with QRhi::EnableTimestamps
+  bool timestamps{};
+
 #if QT_VERSION >= QT_VERSION_CHECK(6, 12, 0)
   struct
   {
@@ -70,6 +82,7 @@ struct RenderState
   {
     window.reset();
 
+    savePipelineCache(*this);
     delete rhi;
     rhi = nullptr;
 
@@ -89,5 +102,12 @@ SCORE_PLUGIN_GFX_EXPORT
 std::shared_ptr<RenderState>
 createRenderState(GraphicsApi graphicsApi, QSize sz, QWindow* window);
 
+//! Whether the render states created from now on record GPU timestamps.
+//! They cost a query per frame, so only while the RenderProfiler is on.
+SCORE_PLUGIN_GFX_EXPORT
+void setGpuTimestampsRequested(bool) noexcept;
+SCORE_PLUGIN_GFX_EXPORT
+bool gpuTimestampsRequested() noexcept;
+
 static const constexpr int32_t invalid_node_index = -1;
 }
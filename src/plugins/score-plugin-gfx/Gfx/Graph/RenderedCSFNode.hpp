@@ -18,6 +18,7 @@ struct RenderedCSFNode : score::gfx::NodeRenderer
   virtual ~RenderedCSFNode();
 
   void updateInputTexture(const Port& input, QRhiTexture* tex) override;
+  bool acceptsSharedInputs() const noexcept override { return true; }
   QRhiTexture* textureForOutput(const Port& output) override;
 
   void init(RenderList& renderer, QRhiResourceUpdateBatch& res) override;
@@ -12,6 +12,7 @@ struct RenderedISFNode : score::gfx::NodeRenderer
   virtual ~RenderedISFNode();
 
   void updateInputTexture(const Port& input, QRhiTexture* tex) override;
+  bool acceptsSharedInputs() const noexcept override { return true; }
 
   void init(RenderList& renderer, QRhiResourceUpdateBatch& res) override;
   void update(RenderList& renderer, QRhiResourceUpdateBatch& res, Edge* e) override;
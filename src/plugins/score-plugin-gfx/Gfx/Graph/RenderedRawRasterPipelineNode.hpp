@@ -15,6 +15,7 @@ struct RenderedRawRasterPipelineNode : score::gfx::NodeRenderer
   virtual ~RenderedRawRasterPipelineNode();
 
   void updateInputTexture(const Port& input, QRhiTexture* tex) override;
+  bool acceptsSharedInputs() const noexcept override { return true; }
 
   void init(RenderList& renderer, QRhiResourceUpdateBatch& res) override;
   void update(RenderList& renderer, QRhiResourceUpdateBatch& res, Edge* edge) override;
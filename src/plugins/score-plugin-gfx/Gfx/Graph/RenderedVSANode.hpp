@@ -13,6 +13,7 @@ struct SimpleRenderedVSANode : score::gfx::NodeRenderer
   virtual ~SimpleRenderedVSANode();
 
   void updateInputTexture(const Port& input, QRhiTexture* tex) override;
+  bool acceptsSharedInputs() const noexcept override { return true; }
 
   void init(RenderList& renderer, QRhiResourceUpdateBatch& res) override;
   void update(RenderList& renderer, QRhiResourceUpdateBatch& res, Edge* edge) override;
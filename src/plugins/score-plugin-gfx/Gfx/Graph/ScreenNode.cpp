@@ -46,6 +46,8 @@
 #include <QScreen>
 #include <QWindow>
 
+#include <atomic>
+
 namespace score::gfx
 {
 namespace
@@ -64,6 +66,18 @@ bool gpuDebugRequested() noexcept
   return requested;
 #endif
 }
+
+std::atomic_bool g_gpuTimestamps{};
+}
+
+void setGpuTimestampsRequested(bool b) noexcept
+{
+  g_gpuTimestamps.store(b, std::memory_order_relaxed);
+}
+
+bool gpuTimestampsRequested() noexcept
+{
+  return g_gpuTimestamps.load(std::memory_order_relaxed);
 }
 
 std::shared_ptr<RenderState>
@@ -77,6 +91,7 @@ createRenderState(GraphicsApi graphicsApi, QSize sz, QWindow* window)
   state.samples = settings.resolveSamples(graphicsApi);
 
   auto populateCaps = [](RenderState& s) {
+    loadPipelineCache(s);
 #if QT_VERSION >= QT_VERSION_CHECK(6, 12, 0)
     if(s.rhi)
     {
@@ -123,9 +138,17 @@ createRenderState(GraphicsApi graphicsApi, QSize sz, QWindow* window)
     }
   };
 
-  QRhi::Flags flags{};
+  QRhi::Flags flags{QRhi::EnablePipelineCacheDataSave};
   if(gpuDebugRequested())
     flags |= QRhi::EnableDebugMarkers;
+#if QT_VERSION >= QT_VERSION_CHECK(6, 6, 0)
+  // For the GPU timings of the RenderProfiler
+  if(gpuTimestampsRequested())
+  {
+    flags |= QRhi::EnableTimestamps;
+    state.timestamps = true;
+  }
+#endif
 
 #ifndef QT_NO_OPENGL
   if(graphicsApi == OpenGL)
@@ -367,6 +390,7 @@ ScreenNode::~ScreenNode()
     delete m_depthStencil;
     m_depthStencil = nullptr;
 
+    savePipelineCache(*m_window->state);
     delete m_window->state->rhi;
     m_window->state->rhi = nullptr;
 
@@ -749,7 +773,9 @@ void ScreenNode::updateGraphicsAPI(GraphicsApi api)
   if(!m_window)
     return;
 
-  if(m_window->api() != api)
+  // The QRhi has to be recreated to start or stop recording GPU timestamps
+  if(m_window->api() != api
+     || (m_window->state && m_window->state->timestamps != gpuTimestampsRequested()))
   {
     destroyOutput();
   }
@@ -2,11 +2,97 @@
 
 #include <Gfx/Graph/RenderState.hpp>
 
+#include <score/tools/ThreadPool.hpp>
+
 #include <ossia/detail/algorithms.hpp>
 #include <ossia/detail/mutex.hpp>
 
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+
 namespace score::gfx
 {
+// Bump when the way the shaders are baked changes
+static constexpr int cache_version = 1;
+
+// A few thousand shaders
+static constexpr int64_t cache_max_size = 64 * 1024 * 1024;
+
+// Removes the least recently used shaders until the cache fits
+static void evict(const QString& folder)
+{
+  const auto files = QDir{folder}.entryInfoList(
+      {QStringLiteral("*.qsb")}, QDir::Files, QDir::Time | QDir::Reversed);
+
+  int64_t total = 0;
+  for(const auto& f : files)
+    total += f.size();
+
+  for(const auto& f : files)
+  {
+    if(total <= cache_max_size)
+      break;
+    if(QFile::remove(f.absoluteFilePath()))
+      total -= f.size();
+  }
+}
+
+static QString cacheFolder()
+{
+  static const QString folder = []() -> QString {
+    const auto cache
+        = QStandardPaths::standardLocations(QStandardPaths::StandardLocation::CacheLocation);
+    if(cache.empty())
+      return {};
+
+    QDir dir{cache.first()};
+    if(!dir.mkpath("shaders") || !dir.cd("shaders"))
+      return {};
+
+    // Once per process, before anything is read from it
+    auto path = dir.absolutePath();
+    evict(path);
+    return path;
+  }();
+  return folder;
+}
+
+static QString diskEntry(
+    GraphicsApi api, const QShaderVersion& version, const QByteArray& shader,
+    QShader::Stage stage)
+{
+  const auto& folder = cacheFolder();
+  if(folder.isEmpty())
+    return {};
+
+  // The Qt version is part of the key as it defines both the serialization
+  // format of QShader and the compilers used by the baker
+  QCryptographicHash h{QCryptographicHash::Sha1};
+  h.addData(QByteArray::number(cache_version));
+  h.addData(QByteArrayLiteral(QT_VERSION_STR));
+  h.addData(QByteArray::number(int(api)));
+  h.addData(QByteArray::number(version.version()));
+  h.addData(QByteArray::number(int(version.flags())));
+  h.addData(QByteArray::number(int(stage)));
+  h.addData(shader);
+
+  return folder + QStringLiteral("/") + QString::fromLatin1(h.result().toHex())
+         + QStringLiteral(".qsb");
+}
+
+static void writeFile(const QString& path, const QByteArray& data)
+{
+  // Written to a temporary file then renamed, so that another instance of score
+  // never reads a partial file
+  QSaveFile f{path};
+  if(!f.open(QIODevice::WriteOnly) || f.write(data) != data.size() || !f.commit())
+    qDebug() << "Cannot write the shader cache" << path;
+}
 
 const std::pair<QShader, QString>& ShaderCache::get(
     GraphicsApi api, const QShaderVersion& version, const QByteArray& shader,
@@ -15,33 +101,39 @@ const std::pair<QShader, QString>& ShaderCache::get(
   static std::mutex mut;
   static ShaderCache self TS_GUARDED_BY(mut);
 
-  std::lock_guard<std::mutex> m{mut};
-
-  auto ver_it = ossia::find_if(self.m_bakers, [&](const auto& p) {
-    return p->api == api && p->version == version;
-  });
   Baker* bb{};
-  if(ver_it == self.m_bakers.end())
-  {
-    self.m_bakers.push_back(std::make_unique<Baker>(api, version));
-    bb = self.m_bakers.back().get();
-  }
-  else
+  Entry* entry{};
   {
-    bb = ver_it->get();
-  }
+    // Only held for the lookup: the baking happens without it
+    std::lock_guard<std::mutex> m{mut};
 
-  Baker& b = *bb;
-  if(auto it = b.shaders.find(shader); it != b.shaders.end())
-    return it->second;
+    auto ver_it = ossia::find_if(self.m_bakers, [&](const auto& p) {
+      return p->api == api && p->version == version;
+    });
+    if(ver_it == self.m_bakers.end())
+    {
+      self.m_bakers.push_back(std::make_unique<Baker>(api, version));
+      bb = self.m_bakers.back().get();
+    }
+    else
+    {
+      bb = ver_it->get();
+    }
 
-  b.baker.setSourceString(shader, stage);
-  b.baker.setPerTargetCompilation(true);
+    auto& e = bb->shaders[shader];
+    if(!e)
+      e = std::make_unique<Entry>();
+    entry = e.get();
+  }
 
-  // FIXME serialize / deserialize
-  QShader baked = b.baker.bake();
-  auto res = b.shaders.insert({shader, {std::move(baked), b.baker.errorMessage()}});
-  return res.first->second;
+  // Another thread asking for the same shader waits until it is baked
+  std::lock_guard<std::mutex> l{entry->mutex};
+  if(!entry->ready)
+  {
+    entry->shader = bake(*bb, shader, stage);
+    entry->ready = true;
+  }
+  return entry->shader;
 }
 
 const std::pair<QShader, QString>&
@@ -50,6 +142,53 @@ ShaderCache::get(const RenderState& v, const QByteArray& shader, QShader::Stage
   return ShaderCache::get(v.api, v.version, shader, stage);
 }
 
+void ShaderCache::prebake(
+    GraphicsApi api, const QShaderVersion& version, const QByteArray& shader,
+    QShader::Stage stage)
+{
+  score::TaskPool::instance().post(
+      [api, version, shader, stage] { ShaderCache::get(api, version, shader, stage); });
+}
+
+void ShaderCache::prebake(
+    const RenderState& v, const QByteArray& shader, QShader::Stage stage)
+{
+  prebake(v.api, v.version, shader, stage);
+}
+
+std::pair<QShader, QString>
+ShaderCache::bake(const Baker& b, const QByteArray& shader, QShader::Stage stage)
+{
+  const auto path = diskEntry(b.api, b.version, shader, stage);
+  if(!path.isEmpty())
+  {
+    if(QFile f{path}; f.open(QIODevice::ReadWrite))
+    {
+      if(auto cached = QShader::fromSerialized(f.readAll()); cached.isValid())
+      {
+        // The eviction goes by modification time
+        f.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+        return {std::move(cached), QString{}};
+      }
+    }
+  }
+
+  // QShaderBaker is not thread-safe, and cheap to create
+  QShaderBaker baker;
+  baker.setGeneratedShaders(b.targets);
+  baker.setGeneratedShaderVariants({{}});
+  baker.setSourceString(shader, stage);
+  baker.setPerTargetCompilation(true);
+
+  QShader baked = baker.bake();
+
+  // Shaders which do not compile are not cached, to get the error message again
+  if(baked.isValid() && !path.isEmpty())
+    writeFile(path, baked.serialized());
+
+  return {std::move(baked), baker.errorMessage()};
+}
+
 ShaderCache::ShaderCache() { }
 
 ShaderCache::Baker::Baker(GraphicsApi api, const QShaderVersion& version)
@@ -59,22 +198,57 @@ ShaderCache::Baker::Baker(GraphicsApi api, const QShaderVersion& version)
   switch(api)
   {
     case GraphicsApi::Null:
-      baker.setGeneratedShaders({{QShader::SpirvShader, version}});
+      targets = {{QShader::SpirvShader, version}};
       break;
     case GraphicsApi::OpenGL:
-      baker.setGeneratedShaders({{QShader::GlslShader, version}});
+      targets = {{QShader::GlslShader, version}};
       break;
     case GraphicsApi::Vulkan:
-      baker.setGeneratedShaders({{QShader::SpirvShader, version}});
+      targets = {{QShader::SpirvShader, version}};
       break;
     case GraphicsApi::D3D11:
     case GraphicsApi::D3D12:
-      baker.setGeneratedShaders({{QShader::HlslShader, version}});
+      targets = {{QShader::HlslShader, version}};
       break;
     case GraphicsApi::Metal:
-      baker.setGeneratedShaders({{QShader::MslShader, version}});
+      targets = {{QShader::MslShader, version}};
       break;
   }
-  baker.setGeneratedShaderVariants({{}});
+}
+
+static QString pipelineCacheEntry(GraphicsApi api)
+{
+  const auto& folder = cacheFolder();
+  if(folder.isEmpty())
+    return {};
+  return folder + QStringLiteral("/pipelines-%1.bin").arg(int(api));
+}
+
+void loadPipelineCache(RenderState& state)
+{
+  if(!state.rhi)
+    return;
+
+  const auto path = pipelineCacheEntry(state.api);
+  if(path.isEmpty())
+    return;
+
+  // QRhi discards the data if it was saved with another driver or device
+  if(QFile f{path}; f.open(QIODevice::ReadOnly))
+    state.rhi->setPipelineCacheData(f.readAll());
+}
+
+void savePipelineCache(const RenderState& state)
+{
+  if(!state.rhi)
+    return;
+
+  const auto path = pipelineCacheEntry(state.api);
+  if(path.isEmpty())
+    return;
+
+  // Empty if the QRhi was not created with EnablePipelineCacheDataSave
+  if(const auto data = state.rhi->pipelineCacheData(); !data.isEmpty())
+    writeFile(path, data);
 }
 }
@@ -6,6 +6,9 @@
 
 #include <ossia/detail/hash_map.hpp>
 
+#include <memory>
+#include <mutex>
+
 #if __has_include(<QtShaderTools/rhi/qshaderbaker.h>)
 #include <QtShaderTools/rhi/qshaderbaker.h>
 #else
@@ -16,6 +19,14 @@ namespace score::gfx
 {
 /**
  * @brief Cache of baked QShader instances
+ *
+ * Shaders are baked once per process, and are also kept on the disk across
+ * runs, keyed on a hash of their source, stage and target API and version.
+ * The least recently used ones are removed from the disk past 64 MiB.
+ *
+ * Different shaders can be baked at the same time from several threads:
+ * prebake starts baking on a worker a shader which will be needed soon,
+ * get waits for it if it is not done yet.
  */
 struct SCORE_PLUGIN_GFX_EXPORT ShaderCache
 {
@@ -31,19 +42,37 @@ public:
   get(GraphicsApi api, const QShaderVersion& v, const QByteArray& shader,
       QShader::Stage stage);
 
+  //! Bakes a shader in the background, for a later get
+  static void
+  prebake(const RenderState& v, const QByteArray& shader, QShader::Stage stage);
+  static void prebake(
+      GraphicsApi api, const QShaderVersion& v, const QByteArray& shader,
+      QShader::Stage stage);
+
 private:
   ShaderCache();
 
+  struct Entry
+  {
+    // Held while the shader is baked
+    std::mutex mutex;
+    bool ready{};
+    std::pair<QShader, QString> shader;
+  };
+
   struct Baker
   {
     explicit Baker(GraphicsApi api, const QShaderVersion& v);
 
     GraphicsApi api;
     QShaderVersion version;
-    QShaderBaker baker;
-    ossia::hash_map<QByteArray, std::pair<QShader, QString>> shaders;
+    QList<QShaderBaker::GeneratedShader> targets;
+    ossia::hash_map<QByteArray, std::unique_ptr<Entry>> shaders;
   };
 
+  static std::pair<QShader, QString>
+  bake(const Baker& b, const QByteArray& shader, QShader::Stage stage);
+
   std::vector<std::unique_ptr<Baker>> m_bakers;
 };
 }
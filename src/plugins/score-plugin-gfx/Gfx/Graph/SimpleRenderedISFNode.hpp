@@ -15,6 +15,7 @@ struct SimpleRenderedISFNode : score::gfx::NodeRenderer
   virtual ~SimpleRenderedISFNode();
 
   void updateInputTexture(const Port& input, QRhiTexture* tex) override;
+  bool acceptsSharedInputs() const noexcept override { return true; }
   QRhiTexture* textureForOutput(const Port& output) override;
 
   void init(RenderList& renderer, QRhiResourceUpdateBatch& res) override;
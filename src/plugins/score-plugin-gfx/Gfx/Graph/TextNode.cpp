@@ -73,6 +73,7 @@ TextNode::TextNode()
   output.push_back(new Port{this, {}, Types::Image, {}});
 
   m_materialData.reset((char*)&ubo);
+  timeVarying = false;
 }
 
 TextNode::~TextNode()
@@ -206,6 +207,7 @@ NodeRenderer* TextNode::createRenderer(RenderList& r) const noexcept
 void TextNode::process(Message&& msg)
 {
   ProcessNode::process(msg.token);
+  const auto rerender = mustRerender.load(std::memory_order_relaxed);
 
   int32_t p = 0;
   for(const gfx_input& m : msg.input)
@@ -288,6 +290,10 @@ void TextNode::process(Message&& msg)
 
     p++;
   }
+
+  // The text is drawn again by the renderers: they have to be rendered again
+  if(mustRerender.load(std::memory_order_relaxed) != rerender)
+    this->materialChange();
 }
 
 }
@@ -651,6 +651,9 @@ Pipeline buildPipeline(
 
 std::pair<QShader, QShader> makeShaders(const RenderState& v, QString vert, QString frag)
 {
+  // Baked on a worker while this thread bakes the vertex shader
+  ShaderCache::prebake(v, frag.toUtf8(), QShader::FragmentStage);
+
   auto [vertexS, vertexError] = ShaderCache::get(v, vert.toUtf8(), QShader::VertexStage);
   if(!vertexError.isEmpty())
   {
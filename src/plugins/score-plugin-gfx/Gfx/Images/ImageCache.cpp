@@ -0,0 +1,234 @@
+#include "ImageCache.hpp"
+
+#include <Gfx/Images/Process.hpp>
+
+#include <ossia/detail/thread.hpp>
+
+#include <QFileInfo>
+#include <QImageReader>
+
+#include <algorithm>
+
+namespace Gfx
+{
+static QString cacheKey(const QString& path, QSize maxSize)
+{
+  if(maxSize.isEmpty())
+    return path;
+  return QStringLiteral("%1@%2x%3").arg(path).arg(maxSize.width()).arg(maxSize.height());
+}
+
+ImageCache::ImageCache() { }
+
+ImageCache::~ImageCache()
+{
+  {
+    std::lock_guard l{m_mutex};
+    m_stop = true;
+    m_jobs.clear();
+  }
+  m_cv.notify_all();
+
+  for(auto& t : m_workers)
+    t.join();
+}
+
+ImageCache& ImageCache::instance() noexcept
+{
+  static ImageCache img;
+  return img;
+}
+
+bool ImageCache::isSupportedImage(const QString& path)
+{
+  static const auto set = Images::DropHandler{}.fileExtensions();
+  return set.contains(QFileInfo{path}.suffix().toLower());
+}
+
+int ImageCache::frameCount(const QString& path)
+{
+  if(!isSupportedImage(path))
+    return 0;
+
+  // Only the formats which can be animated are opened
+  const auto suffix = QFileInfo{path}.suffix().toLower();
+  if(suffix != "gif" && suffix != "tiff")
+    return 1;
+
+  QImageReader reader{path};
+  return std::max(1, reader.imageCount());
+}
+
+std::shared_ptr<DecodedImage> ImageCache::decode(const QString& path, QSize maxSize)
+{
+  if(!isSupportedImage(path))
+    return {};
+
+  QImageReader reader{path};
+  reader.setBackgroundColor(Qt::transparent);
+
+  auto res = std::make_shared<DecodedImage>();
+  res->sourceSize = reader.size();
+
+  // Most decoders, e.g. libjpeg, are much faster when asked for a smaller image
+  if(!maxSize.isEmpty() && res->sourceSize.isValid()
+     && (res->sourceSize.width() > maxSize.width()
+         || res->sourceSize.height() > maxSize.height()))
+  {
+    reader.setScaledSize(res->sourceSize.scaled(maxSize, Qt::KeepAspectRatio));
+  }
+
+  while(reader.canRead())
+  {
+    QImage img = reader.read();
+
+    if(img.isNull() || img.size() == QSize{})
+      continue;
+
+    if(img.format() != QImage::Format_ARGB32)
+      img.convertTo(QImage::Format_ARGB32);
+
+    res->frames.push_back(std::move(img));
+  }
+
+  if(res->frames.empty())
+    return {};
+
+  if(!res->sourceSize.isValid())
+    res->sourceSize = res->frames.front().size();
+  return res;
+}
+
+ImageCache::image_ptr ImageCache::request(const QString& path, QSize maxSize)
+{
+  return schedule(path, maxSize, true);
+}
+
+void ImageCache::prefetch(const QString& path, QSize maxSize)
+{
+  schedule(path, maxSize, false);
+}
+
+ImageCache::image_ptr ImageCache::schedule(const QString& path, QSize maxSize, bool urgent)
+{
+  auto key = cacheKey(path, maxSize);
+
+  std::unique_lock l{m_mutex};
+  if(auto it = m_entries.find(key); it != m_entries.end())
+  {
+    auto& e = it->second;
+    if(e.image)
+    {
+      m_lru.splice(m_lru.begin(), m_lru, e.lru);
+      return e.image;
+    }
+
+    // Being decoded, or failed: the current image goes before the prefetches
+    if(urgent && e.pending)
+    {
+      if(auto job = std::find_if(
+             m_jobs.begin(), m_jobs.end(), [&](const Job& j) { return j.key == key; });
+         job != m_jobs.end() && job != m_jobs.begin())
+      {
+        auto j = std::move(*job);
+        m_jobs.erase(job);
+        m_jobs.push_front(std::move(j));
+      }
+    }
+    return {};
+  }
+
+  m_entries[key] = Entry{.pending = true, .lru = m_lru.end()};
+  if(urgent)
+    m_jobs.push_front(Job{key, path, maxSize});
+  else
+    m_jobs.push_back(Job{key, path, maxSize});
+
+  if(m_workers.empty())
+  {
+    const int threads = std::clamp(int(std::thread::hardware_concurrency()) / 2, 1, 4);
+    for(int i = 0; i < threads; i++)
+      m_workers.emplace_back([this] {
+        ossia::set_thread_name("ossia images");
+        run();
+      });
+  }
+  l.unlock();
+
+  m_cv.notify_one();
+  return {};
+}
+
+void ImageCache::run()
+{
+  for(;;)
+  {
+    Job job;
+    {
+      std::unique_lock l{m_mutex};
+      m_cv.wait(l, [this] { return m_stop || !m_jobs.empty(); });
+      if(m_stop)
+        return;
+
+      job = std::move(m_jobs.front());
+      m_jobs.pop_front();
+    }
+
+    finished(job, decode(job.path, job.maxSize));
+  }
+}
+
+void ImageCache::finished(const Job& job, image_ptr img)
+{
+  std::lock_guard l{m_mutex};
+  auto it = m_entries.find(job.key);
+  if(it == m_entries.end())
+    return;
+
+  // Failed images are kept so that they are not decoded again and again
+  auto& e = it->second;
+  e.pending = false;
+  if(!img)
+    return;
+
+  e.image = std::move(img);
+  e.bytes = 0;
+  for(auto& frame : e.image->frames)
+    e.bytes += frame.sizeInBytes();
+
+  m_lru.push_front(job.key);
+  e.lru = m_lru.begin();
+  m_bytes += e.bytes;
+
+  evict();
+}
+
+void ImageCache::evict()
+{
+  // The most recent image always stays, even if it is bigger than the budget.
+  // Evicted images still used e.g. by a renderer are freed when it releases them.
+  while(m_bytes > m_budget && m_lru.size() > 1)
+  {
+    auto it = m_entries.find(m_lru.back());
+    m_lru.pop_back();
+    if(it != m_entries.end())
+    {
+      m_bytes -= it->second.bytes;
+      m_entries.erase(it);
+    }
+  }
+}
+
+void ImageCache::setBudget(int64_t bytes)
+{
+  std::lock_guard l{m_mutex};
+  m_budget = std::max(int64_t(0), bytes);
+  evict();
+}
+
+int64_t ImageCache::usedBytes() const noexcept
+{
+  std::lock_guard l{m_mutex};
+  return m_bytes;
+}
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include <ossia/detail/hash_map.hpp>
+
+#include <QImage>
+#include <QSize>
+#include <QString>
+
+#include <score_plugin_gfx_export.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Gfx
+{
+struct DecodedImage
+{
+  std::vector<QImage> frames;
+
+  //! Size in the file, before any downscaling
+  QSize sourceSize;
+};
+
+/**
+ * @brief Decodes the images of the Images process on worker threads.
+ *
+ * The decoded images are kept up to a global budget in bytes, the least
+ * recently used ones being evicted first. An image can be decoded directly
+ * at a smaller size, e.g. the size of the output it is rendered to:
+ * each size is cached separately.
+ *
+ * Nothing ever blocks on a decode: request() returns nothing until the
+ * image is ready, and the caller asks again later.
+ */
+class SCORE_PLUGIN_GFX_EXPORT ImageCache
+{
+public:
+  using image_ptr = std::shared_ptr<const DecodedImage>;
+
+  ImageCache();
+  ~ImageCache();
+
+  //! The image if it is decoded, otherwise schedules it with a high priority
+  image_ptr request(const QString& path, QSize maxSize = {});
+
+  //! Schedules the image with a low priority if it is not decoded yet
+  void prefetch(const QString& path, QSize maxSize = {});
+
+  //! Number of frames in the file, reading only its header
+  static int frameCount(const QString& path);
+
+  static bool isSupportedImage(const QString& path);
+
+  //! Synchronous decoding, without the cache. Null if the file cannot be read.
+  static std::shared_ptr<DecodedImage> decode(const QString& path, QSize maxSize = {});
+
+  void setBudget(int64_t bytes);
+  int64_t usedBytes() const noexcept;
+
+  static ImageCache& instance() noexcept;
+
+private:
+  struct Entry
+  {
+    image_ptr image;
+    int64_t bytes{};
+    bool pending{};
+    std::list<QString>::iterator lru;
+  };
+
+  struct Job
+  {
+    QString key;
+    QString path;
+    QSize maxSize;
+  };
+
+  image_ptr schedule(const QString& path, QSize maxSize, bool urgent);
+  void run();
+  void finished(const Job& job, image_ptr img);
+  void evict();
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_cv;
+
+  ossia::hash_map<QString, Entry> m_entries;
+
+  // Most recently used first, only the decoded images
+  std::list<QString> m_lru;
+  int64_t m_bytes{};
+  int64_t m_budget{1024LL * 1024 * 1024};
+
+  // The requests for the current images are in front of the prefetches
+  std::deque<Job> m_jobs;
+  std::vector<std::thread> m_workers;
+  bool m_stop{};
+};
+}
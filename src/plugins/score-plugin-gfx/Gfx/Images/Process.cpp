@@ -10,50 +10,25 @@
 #include <Gfx/TexturePort.hpp>
 
 #include <ossia/detail/logger.hpp>
-#include <span>
 #include <ossia/network/value/format_value.hpp>
 
-#include <QFileInfo>
-#include <QImageReader>
-
 #include <wobjectimpl.h>
 
 W_OBJECT_IMPL(Gfx::Images::Model)
 namespace Gfx
 {
-ossia::value fromImageSet(const std::span<score::gfx::Image>& images)
-{
-  std::vector<ossia::value> v;
-  for(auto& img : images)
-  {
-    v.push_back(img.path.toStdString());
-  }
-  return v;
-}
-
-void releaseImages(std::vector<score::gfx::Image>& imgs)
-{
-  auto& cache = ImageCache::instance();
-  for(auto& img : imgs)
-    cache.release(std::move(img));
-  imgs.clear();
-}
-
-std::vector<score::gfx::Image>
-getImages(const ossia::value& val, const score::DocumentContext& ctx)
+std::vector<QString>
+getImagePaths(const ossia::value& val, const score::DocumentContext& ctx)
 {
-  auto& cache = ImageCache::instance();
-  std::vector<score::gfx::Image> imgs;
+  std::vector<QString> paths;
   for(auto& img : ossia::convert<std::vector<ossia::value>>(val))
   {
     auto image_path = QString::fromStdString(ossia::convert<std::string>(img));
     image_path = score::locateFilePath(image_path, ctx);
-    if(auto image = cache.acquire(image_path))
-    {
-      imgs.push_back(std::move(*image));
-    }
+    if(ImageCache::isSupportedImage(image_path))
+      paths.push_back(std::move(image_path));
   }
-  return imgs;
+  return paths;
 }
 }
 
@@ -117,13 +92,15 @@ Model::Model(
     auto tile = new Process::ComboBox{combo, 0, tr("Scale"), Id<Process::Port>(7), this};
     m_inlets.push_back(tile);
   }
+
+  {
+    auto downscale = new Process::Toggle{false, tr("Downscale"), Id<Process::Port>(8), this};
+    m_inlets.push_back(downscale);
+  }
   m_outlets.push_back(new TextureOutlet{"Texture Out", Id<Process::Port>(0), this});
 }
 
-Model::~Model()
-{
-  releaseImages(m_currentImages);
-}
+Model::~Model() { }
 
 void Model::mapExternalFiles(Process::ExternalFileMap& map)
 {
@@ -138,17 +115,17 @@ void Model::mapExternalFiles(Process::ExternalFileMap& map)
 
 void Model::on_imagesChanged(const ossia::value& v)
 {
-  releaseImages(m_currentImages);
-  m_currentImages = getImages(
+  // Only the headers are read here, the images are decoded when rendered
+  const auto paths = getImagePaths(
       safe_cast<ImageListChooser*>(m_inlets[5])->value(),
       score::IDocument::documentContext(*this));
 
   int count = 0;
-  for(const auto& img : m_currentImages)
-    count += img.frames.size();
+  for(const auto& path : paths)
+    count += ImageCache::frameCount(path);
 
   auto spinbox = safe_cast<Process::IntSpinBox*>(m_inlets[0]);
-  if(!m_currentImages.empty())
+  if(count > 0)
     spinbox->setDomain(ossia::make_domain(int(0), int(count) - 1));
   else
     spinbox->setDomain(ossia::make_domain(int(0), int(0)));
@@ -176,38 +153,13 @@ QSet<QString> DropHandler::fileExtensions() const noexcept
           "tiff", "heic", "jp2", "svg",  "tga", "wbmp"};
 }
 
-static bool isSupportedImage(const QFileInfo& filepath)
-{
-  static const auto set = DropHandler{}.fileExtensions();
-  return set.contains(filepath.suffix().toLower());
-}
-
 static std::optional<score::gfx::Image> readImage(const QString& filename)
 {
-  QFileInfo info{filename};
-  if(!isSupportedImage(info))
-    return {};
-
-  QImageReader reader{filename};
-  reader.setBackgroundColor(Qt::transparent);
-  std::vector<QImage> frames;
-  while(reader.canRead())
-  {
-    QImage img = reader.read();
-
-    if(img.isNull() || img.size() == QSize{})
-      continue;
-
-    if(img.format() != QImage::Format_ARGB32)
-      img.convertTo(QImage::Format_ARGB32);
-
-    frames.push_back(std::move(img));
-  }
-
-  if(frames.empty())
+  auto img = ImageCache::decode(filename);
+  if(!img)
     return {};
 
-  return score::gfx::Image{filename, std::move(frames)};
+  return score::gfx::Image{filename, std::move(img->frames)};
 }
 
 void DropHandler::dropCustom(
@@ -221,61 +173,22 @@ void DropHandler::dropCustom(
   p.creation.key = Metadata<ConcreteKey_k, Gfx::Images::Model>::get();
   p.setup = [files = data.urls()](Process::ProcessModel& m, score::Dispatcher& disp) {
     auto& proc = static_cast<Model&>(m);
-    std::vector<score::gfx::Image> images;
+    std::vector<ossia::value> images;
 
     for(const auto& url : files)
     {
-      if(auto img = Gfx::ImageCache::instance().acquire(url.toLocalFile()))
-      {
-        images.push_back(*std::move(img));
-      }
+      auto path = url.toLocalFile();
+      if(Gfx::ImageCache::isSupportedImage(path))
+        images.push_back(path.toStdString());
     }
 
     if(!images.empty())
       disp.submit(new Process::SetControlValue{
-          safe_cast<Process::ControlInlet&>(*proc.inlets()[5]), fromImageSet(images)});
+          safe_cast<Process::ControlInlet&>(*proc.inlets()[5]), std::move(images)});
   };
   vec.push_back(std::move(p));
   return;
 }
-}
-namespace Gfx
-{
-
-std::optional<score::gfx::Image> ImageCache::acquire(const QString& path)
-{
-  if(auto it = m_images.find(path); it != m_images.end())
-  {
-    it->second.first++;
-    return it->second.second;
-  }
-
-  if(auto img = Images::readImage(path))
-  {
-    auto [it, ok] = m_images.insert({path, {0, *std::move(img)}});
-    return it->second.second;
-  }
-  return {};
-}
-
-void ImageCache::release(score::gfx::Image&& img)
-{
-  if(auto it = m_images.find(img.path); it != m_images.end())
-  {
-    it->second.first--;
-    if(it->second.first <= 0)
-    {
-      m_images.erase(it);
-    }
-  }
-}
-
-ImageCache& ImageCache::instance() noexcept
-{
-  static ImageCache img;
-  return img;
-}
-
 }
 template <>
 void DataStreamReader::read(const score::gfx::Image& proc)
@@ -371,6 +284,13 @@ void JSONWriter::write(Gfx::Images::Model& proc)
     }
   }
 
+  if(proc.m_inlets.size() < 9)
+  {
+    auto port = new Process::Toggle{
+        false, QObject::tr("Downscale"), Id<Process::Port>(8), &proc};
+    proc.m_inlets.push_back(port);
+  }
+
   proc.on_imagesChanged(((Process::ControlInlet*)(proc.m_inlets[5]))->value());
 }
 
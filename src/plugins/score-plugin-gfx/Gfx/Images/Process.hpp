@@ -6,6 +6,7 @@
 
 #include <Gfx/CommandFactory.hpp>
 #include <Gfx/Graph/ImageNode.hpp>
+#include <Gfx/Images/ImageCache.hpp>
 #include <Gfx/Images/Metadata.hpp>
 #include <Library/LibraryInterface.hpp>
 
@@ -15,22 +16,8 @@
 
 namespace Gfx
 {
-std::vector<score::gfx::Image>
-getImages(const ossia::value& val, const score::DocumentContext& ctx);
-ossia::value fromImageSet(const std::span<score::gfx::Image>& images);
-void releaseImages(std::vector<score::gfx::Image>& imgs);
-
-struct ImageCache
-{
-public:
-  std::optional<score::gfx::Image> acquire(const QString& path);
-  void release(score::gfx::Image&& img);
-
-  static ImageCache& instance() noexcept;
-
-private:
-  ossia::hash_map<QString, std::pair<int, score::gfx::Image>> m_images;
-};
+//! The located paths of the supported images in the value of an ImageListChooser
+std::vector<QString> getImagePaths(const ossia::value& val, const score::DocumentContext& ctx);
 }
 W_REGISTER_ARGTYPE(score::gfx::Image)
 
@@ -66,7 +53,6 @@ public:
 private:
   void on_imagesChanged(const ossia::value& v);
   QString prettyName() const noexcept override;
-  std::vector<score::gfx::Image> m_currentImages;
 };
 
 using ProcessFactory = Process::ProcessFactory_T<Gfx::Images::Model>;
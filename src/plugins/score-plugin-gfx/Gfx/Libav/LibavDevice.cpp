@@ -9,6 +9,7 @@
 #include <Gfx/Graph/VideoNode.hpp>
 #include <Gfx/Libav/LibavEncoder.hpp>
 #include <Gfx/Libav/LibavEncoderNode.hpp>
+#include <Gfx/Libav/LibavFrameQueue.hpp>
 #include <Gfx/Libav/LibavOutputStream.hpp>
 #include <Gfx/Libav/LibavSettingsWidget.hpp>
 #include <Media/LibavIntrospection.hpp>
@@ -90,6 +91,29 @@ static QString resolveLibavPath(
   return resolved.isEmpty() ? path : resolved;
 }
 
+// Exposes the dropped_frames / late_frames counters of a frame queue
+static void addFrameStatsNodes(
+    ossia::net::device_base& dev, ossia::net::generic_node& root,
+    LibavFrameQueue& frames)
+{
+  auto dropped_node
+      = std::make_unique<ossia::net::generic_node>("dropped_frames", dev, root);
+  auto late_node = std::make_unique<ossia::net::generic_node>("late_frames", dev, root);
+  auto* dropped = dropped_node->create_parameter(ossia::val_type::INT);
+  auto* late = late_node->create_parameter(ossia::val_type::INT);
+  if(dropped && late)
+  {
+    dropped->set_access(ossia::access_mode::GET);
+    late->set_access(ossia::access_mode::GET);
+    frames.onStatsChanged = [dropped, late](int64_t d, int64_t l) {
+      dropped->push_value(int(d));
+      late->push_value(int(l));
+    };
+  }
+  root.add_child(std::move(dropped_node));
+  root.add_child(std::move(late_node));
+}
+
 // Protocol for FFmpeg input
 class libav_input_protocol : public ossia::net::protocol_base
 {
@@ -291,6 +315,7 @@ class libav_output_protocol : public Gfx::gfx_protocol_base
 {
 public:
   LibavEncoder encoder;
+  LibavFrameQueue frames;
   ossia::net::parameter_base* path_param{};
   const score::DocumentContext& m_ctx;
 
@@ -299,6 +324,7 @@ public:
       const score::DocumentContext& docCtx)
       : gfx_protocol_base{ctx}
       , encoder{set}
+      , frames{encoder, set}
       , m_ctx{docCtx}
   {
   }
@@ -328,8 +354,16 @@ public:
 
     if(!encoder.m_set.path.isEmpty())
       encoder.start();
+
+    // Also when there is no path yet: it may be set during the execution
+    frames.start();
+  }
+
+  void stop_execution() override
+  {
+    frames.stop();
+    encoder.stop();
   }
-  void stop_execution() override { encoder.stop(); }
 };
 
 // Device tree for FFmpeg output
@@ -346,7 +380,7 @@ public:
   {
     auto& p = *static_cast<gfx_protocol_base*>(m_protocol.get());
     auto& out_proto = *static_cast<libav_output_protocol*>(m_protocol.get());
-    auto node = new LibavEncoderNode{set, enc, 0};
+    auto node = new LibavEncoderNode{set, enc, out_proto.frames, 0};
     root.add_child(std::make_unique<gfx_node_base>(*this, p, node, "Video"));
 
     if(set.audio_channels > 0 && !set.audio_encoder_short.isEmpty())
@@ -392,6 +426,9 @@ public:
       }
       root.add_child(std::move(path_node));
     }
+
+    // Frames which the encoder could not keep up with
+    addFrameStatsNodes(*this, root, out_proto.frames);
   }
 
   const ossia::net::generic_node& get_root_node() const override { return root; }
@@ -585,20 +622,22 @@ void DataStreamReader::read(const Gfx::LibavSettings& n)
            << n.audio_encoder_long << n.audio_converted_smpfmt << n.audio_sample_rate
            << n.video_encoder_short << n.video_encoder_long << n.video_render_pixfmt
            << n.video_converted_pixfmt << n.muxer << n.muxer_long << n.options
-           << n.input_transfer;
+           << n.input_transfer << (int)n.frame_policy << n.frame_queue;
   insertDelimiter();
 }
 
 template <>
 void DataStreamWriter::write(Gfx::LibavSettings& n)
 {
-  int dir{};
+  int dir{}, policy{};
   m_stream >> dir >> n.path >> n.width >> n.height >> n.rate >> n.audio_channels
       >> n.threads >> n.audio_encoder_short >> n.audio_encoder_long
       >> n.audio_converted_smpfmt >> n.audio_sample_rate >> n.video_encoder_short
       >> n.video_encoder_long >> n.video_render_pixfmt >> n.video_converted_pixfmt
-      >> n.muxer >> n.muxer_long >> n.options >> n.input_transfer;
+      >> n.muxer >> n.muxer_long >> n.options >> n.input_transfer >> policy
+      >> n.frame_queue;
   n.direction = (Gfx::LibavSettings::Direction)dir;
+  n.frame_policy = (Gfx::LibavOutputSettings::FramePolicy)policy;
   checkDelimiter();
 }
 
@@ -624,6 +663,8 @@ void JSONReader::read(const Gfx::LibavSettings& n)
   obj["MuxerLong"] = n.muxer_long;
   obj["Options"] = n.options;
   obj["InputTransfer"] = n.input_transfer;
+  obj["FramePolicy"] = (int)n.frame_policy;
+  obj["FrameQueue"] = n.frame_queue;
 }
 
 template <>
@@ -649,6 +690,10 @@ void JSONWriter::write(Gfx::LibavSettings& n)
   n.options <<= obj["Options"];
   if(auto v = obj.tryGet("InputTransfer"))
     n.input_transfer = v->toInt();
+  if(auto v = obj.tryGet("FramePolicy"))
+    n.frame_policy = (Gfx::LibavOutputSettings::FramePolicy)v->toInt();
+  if(auto v = obj.tryGet("FrameQueue"))
+    n.frame_queue = v->toInt();
 }
 
 #endif
@@ -52,6 +52,8 @@ struct LibavSettings
   QString muxer, muxer_long;
   ossia::hash_map<QString, QString> options;
   int input_transfer{13}; // AVColorTransferCharacteristic: 13=sRGB
+  LibavOutputSettings::FramePolicy frame_policy{LibavOutputSettings::DropOldest};
+  int frame_queue{8};
 
   // Convert to LibavOutputSettings for the encoder
   LibavOutputSettings toOutputSettings() const
@@ -75,6 +77,8 @@ struct LibavSettings
     s.muxer_long = muxer_long;
     s.options = options;
     s.input_transfer = input_transfer;
+    s.frame_policy = frame_policy;
+    s.frame_queue = frame_queue;
     return s;
   }
 };
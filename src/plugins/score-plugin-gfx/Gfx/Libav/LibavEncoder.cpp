@@ -277,6 +277,18 @@ int LibavEncoder::add_frame_converted(
   return stream.write_video_frame_direct(m_formatContext, frame);
 }
 
+void LibavEncoder::skip_video_frames(int64_t count)
+{
+  std::lock_guard lock{m_muxMutex};
+
+  if(!m_formatContext)
+    return;
+  if(video_stream_index < 0)
+    return;
+
+  streams[video_stream_index].next_pts += count;
+}
+
 int LibavEncoder::stop()
 {
   std::lock_guard lock{m_muxMutex};
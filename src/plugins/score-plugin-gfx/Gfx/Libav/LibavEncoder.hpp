@@ -33,6 +33,8 @@ struct LibavEncoder
   int add_frame_converted(
       const unsigned char* const planes[], const int strides[], int planeCount,
       int width, int height);
+  // Advances the video timestamps over frames which were not rendered or dropped
+  void skip_video_frames(int64_t count);
   int stop();
   int stop_impl(); // Must be called with m_muxMutex held
 
@@ -7,6 +7,7 @@
 #include <Gfx/Graph/encoders/UYVY.hpp>
 #include <Gfx/InvertYRenderer.hpp>
 #include <Gfx/Libav/LibavEncoder.hpp>
+#include <Gfx/Libav/LibavFrameQueue.hpp>
 
 #include <score/gfx/OpenGL.hpp>
 #include <score/gfx/QRhiGles2.hpp>
@@ -34,9 +35,11 @@ makeEncoderForPixfmt(const QString& pixfmt)
 }
 
 LibavEncoderNode::LibavEncoderNode(
-    const LibavOutputSettings& set, LibavEncoder& encoder, int stream)
+    const LibavOutputSettings& set, LibavEncoder& encoder, LibavFrameQueue& frames,
+    int stream)
     : OutputNode{}
     , encoder{encoder}
+    , frames{frames}
     , stream{stream}
     , m_settings{set}
 {
@@ -75,34 +78,35 @@ void LibavEncoderNode::render()
       currentEnc.exec(*rhi, *cb);
       rhi->endOffscreenFrame();
 
-      // Push the PREVIOUS frame's readback to the encoder
+      // Queue the PREVIOUS frame's readback for the encoder thread
       if(prevEnc.readback(0).data.size() > 0)
       {
-        const int planeCount = prevEnc.planeCount();
-        const unsigned char* planes[4] = {};
-        int strides[4] = {};
-
-        for(int i = 0; i < planeCount; i++)
+        if(auto frame = frames.acquire())
         {
-          auto& rb = prevEnc.readback(i);
-          planes[i] = (const unsigned char*)rb.data.constData();
-          strides[i] = rb.pixelSize.width()
-                       * ((i == 0 || planeCount == 1)
-                              ? (planeCount == 1 ? 4 : 1)  // UYVY=4bpp, Y=1bpp
-                              : (planeCount == 2 ? 2 : 1)); // UV=2bpp (NV12) or U/V=1bpp (I420)
+          const int planeCount = std::min(prevEnc.planeCount(), 4);
+          for(int i = 0; i < planeCount; i++)
+          {
+            auto& rb = prevEnc.readback(i);
+            frame->planes[i].assign(
+                (const unsigned char*)rb.data.constData(),
+                (const unsigned char*)rb.data.constData() + rb.data.size());
+
+            // Strides from the readback data size and height
+            if(rb.pixelSize.height() > 0)
+              frame->strides[i] = rb.data.size() / rb.pixelSize.height();
+            else
+              frame->strides[i]
+                  = rb.pixelSize.width()
+                    * ((i == 0 || planeCount == 1)
+                           ? (planeCount == 1 ? 4 : 1)  // UYVY=4bpp, Y=1bpp
+                           : (planeCount == 2 ? 2 : 1)); // UV=2bpp (NV12) or U/V=1bpp (I420)
+          }
+          frame->planeCount = planeCount;
+          frame->width = m_settings.width;
+          frame->height = m_settings.height;
+          frame->format = AV_PIX_FMT_NONE;
+          frames.submit(frame);
         }
-
-        // Compute strides from readback data size and height
-        for(int i = 0; i < planeCount; i++)
-        {
-          auto& rb = prevEnc.readback(i);
-          if(rb.pixelSize.height() > 0)
-            strides[i] = rb.data.size() / rb.pixelSize.height();
-        }
-
-        encoder.add_frame_converted(
-            planes, strides, planeCount,
-            m_settings.width, m_settings.height);
       }
 
       m_encoderIdx ^= 1;
@@ -117,9 +121,17 @@ void LibavEncoderNode::render()
       int bytes = readback.data.size();
       if(bytes > 0 && bytes >= sz)
       {
-        encoder.add_frame(
-            (const unsigned char*)readback.data.constData(), AV_PIX_FMT_RGBA,
-            readback.pixelSize.width(), readback.pixelSize.height());
+        if(auto frame = frames.acquire())
+        {
+          auto data = (const unsigned char*)readback.data.constData();
+          frame->planes[0].assign(data, data + sz);
+          frame->strides[0] = readback.pixelSize.width() * 4;
+          frame->planeCount = 1;
+          frame->width = readback.pixelSize.width();
+          frame->height = readback.pixelSize.height();
+          frame->format = AV_PIX_FMT_RGBA;
+          frames.submit(frame);
+        }
       }
 
       // Swap readback buffer for next frame
@@ -141,6 +153,11 @@ void LibavEncoderNode::onRendererChange() { }
 
 void LibavEncoderNode::stopRendering() { }
 
+void LibavEncoderNode::setOfflineRendering(bool offline)
+{
+  frames.setOffline(offline);
+}
+
 void LibavEncoderNode::setRenderer(std::shared_ptr<score::gfx::RenderList> r)
 {
   m_renderer = r;
@@ -7,13 +7,16 @@
 namespace Gfx
 {
 struct LibavEncoder;
+class LibavFrameQueue;
 struct LibavEncoderNode : score::gfx::OutputNode
 {
   explicit LibavEncoderNode(
-      const LibavOutputSettings&, LibavEncoder& encoder, int stream);
+      const LibavOutputSettings&, LibavEncoder& encoder, LibavFrameQueue& frames,
+      int stream);
   virtual ~LibavEncoderNode();
 
   LibavEncoder& encoder;
+  LibavFrameQueue& frames;
   int stream{};
 
   std::weak_ptr<score::gfx::RenderList> m_renderer{};
@@ -36,6 +39,7 @@ struct LibavEncoderNode : score::gfx::OutputNode
   void render() override;
   bool canRender() const override;
   void stopRendering() override;
+  void setOfflineRendering(bool) override;
 
   void setRenderer(std::shared_ptr<score::gfx::RenderList> r) override;
   score::gfx::RenderList* renderer() const override;
@@ -0,0 +1,203 @@
+#include "LibavFrameQueue.hpp"
+
+#if SCORE_HAS_LIBAV
+#include <Gfx/Libav/LibavEncoder.hpp>
+
+#include <ossia/detail/thread.hpp>
+
+#include <QDebug>
+
+#include <algorithm>
+
+namespace Gfx
+{
+LibavFrameQueue::LibavFrameQueue(LibavEncoder& encoder, const LibavOutputSettings& set)
+    : m_encoder{encoder}
+    , m_pool(std::max(2, set.frame_queue))
+    , m_policy{set.frame_policy}
+{
+  using namespace std::chrono;
+  m_period = duration_cast<steady_clock::duration>(
+      duration<double>(1. / (set.rate > 0. ? set.rate : 30.)));
+
+  // RGBA, or the luma plane and the chroma planes of the YUV formats
+  const std::size_t pixels = std::size_t(std::max(set.width, 1)) * std::max(set.height, 1);
+  for(auto& frame : m_pool)
+  {
+    frame.planes[0].reserve(pixels * 4);
+    if(!set.video_converted_pixfmt.isEmpty())
+    {
+      frame.planes[1].reserve(pixels / 2);
+      frame.planes[2].reserve(pixels / 2);
+    }
+    m_free.push_back(&frame);
+  }
+}
+
+LibavFrameQueue::~LibavFrameQueue()
+{
+  stop();
+}
+
+void LibavFrameQueue::start()
+{
+  stop();
+
+  {
+    std::lock_guard lock{m_mutex};
+    m_nextIndex = 0;
+    m_running = true;
+  }
+  m_lastIndex = -1;
+  m_publishedDropped = 0;
+  m_publishedLate = 0;
+  m_dropped = 0;
+  m_late = 0;
+
+  m_thread = std::thread{[this] {
+    ossia::set_thread_name("ossia libav enc");
+    run();
+  }};
+}
+
+void LibavFrameQueue::stop()
+{
+  {
+    std::lock_guard lock{m_mutex};
+    m_running = false;
+  }
+  m_readyCv.notify_one();
+  m_freeCv.notify_all();
+
+  if(!m_thread.joinable())
+    return;
+  m_thread.join();
+
+  if(m_dropped > 0 || m_late > 0)
+    qDebug() << "FFmpeg output:" << m_dropped.load() << "frames dropped,"
+             << m_late.load() << "frames late";
+}
+
+LibavVideoFrame* LibavFrameQueue::acquire()
+{
+  std::unique_lock lock{m_mutex};
+  if(!m_running)
+    return nullptr;
+
+  // Dropped frames keep their index so that the timestamps skip over them
+  const int64_t index = m_nextIndex++;
+  if(m_free.empty())
+  {
+    switch(m_offline ? LibavOutputSettings::BlockRendering : m_policy)
+    {
+      case LibavOutputSettings::BlockRendering:
+        m_freeCv.wait(lock, [this] { return !m_free.empty() || !m_running; });
+        if(!m_running)
+          return nullptr;
+        break;
+
+      case LibavOutputSettings::DropOldest:
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        if(m_ready.empty())
+          return nullptr;
+        m_free.push_back(m_ready.front());
+        m_ready.pop_front();
+        break;
+
+      case LibavOutputSettings::DropNewest:
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+  }
+
+  auto frame = m_free.back();
+  m_free.pop_back();
+  frame->index = index;
+  return frame;
+}
+
+void LibavFrameQueue::submit(LibavVideoFrame* frame)
+{
+  frame->queued = std::chrono::steady_clock::now();
+  {
+    std::lock_guard lock{m_mutex};
+    if(!m_running)
+    {
+      m_free.push_back(frame);
+      return;
+    }
+    m_ready.push_back(frame);
+  }
+  m_readyCv.notify_one();
+}
+
+void LibavFrameQueue::setOffline(bool offline)
+{
+  std::lock_guard lock{m_mutex};
+  m_offline = offline;
+}
+
+void LibavFrameQueue::run()
+{
+  for(;;)
+  {
+    LibavVideoFrame* frame{};
+    {
+      std::unique_lock lock{m_mutex};
+      m_readyCv.wait(lock, [this] { return !m_ready.empty() || !m_running; });
+
+      // When stopping, what was rendered is still written
+      if(m_ready.empty())
+        return;
+
+      frame = m_ready.front();
+      m_ready.pop_front();
+    }
+
+    encode(*frame);
+
+    {
+      std::lock_guard lock{m_mutex};
+      m_free.push_back(frame);
+    }
+    m_freeCv.notify_one();
+
+    if(onStatsChanged)
+    {
+      const auto dropped = droppedFrames();
+      const auto late = lateFrames();
+      if(dropped != m_publishedDropped || late != m_publishedLate)
+      {
+        m_publishedDropped = dropped;
+        m_publishedLate = late;
+        onStatsChanged(dropped, late);
+      }
+    }
+  }
+}
+
+void LibavFrameQueue::encode(LibavVideoFrame& frame)
+{
+  if(const int64_t gap = frame.index - m_lastIndex - 1; gap > 0)
+    m_encoder.skip_video_frames(gap);
+  m_lastIndex = frame.index;
+
+  if(frame.format == AV_PIX_FMT_NONE)
+  {
+    const unsigned char* planes[4]{};
+    for(int i = 0; i < frame.planeCount; i++)
+      planes[i] = frame.planes[i].data();
+
+    m_encoder.add_frame_converted(
+        planes, frame.strides, frame.planeCount, frame.width, frame.height);
+  }
+  else
+  {
+    m_encoder.add_frame(frame.planes[0].data(), frame.format, frame.width, frame.height);
+  }
+
+  if(std::chrono::steady_clock::now() - frame.queued > m_period)
+    m_late.fetch_add(1, std::memory_order_relaxed);
+}
+}
+#endif
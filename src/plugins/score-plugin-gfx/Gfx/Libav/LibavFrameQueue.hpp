@@ -0,0 +1,108 @@
+#pragma once
+
+#include <Media/Libav.hpp>
+#if SCORE_HAS_LIBAV
+#include <Gfx/Libav/LibavOutputSettings.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Gfx
+{
+struct LibavEncoder;
+
+//! A video frame waiting to be encoded
+struct LibavVideoFrame
+{
+  std::vector<unsigned char> planes[4];
+  int strides[4]{};
+  int planeCount{};
+  int width{};
+  int height{};
+
+  //! AV_PIX_FMT_RGBA, or AV_PIX_FMT_NONE if already in the encoder pixel format
+  AVPixelFormat format{AV_PIX_FMT_NONE};
+
+  int64_t index{};
+  std::chrono::steady_clock::time_point queued{};
+};
+
+/**
+ * @brief Encodes the video frames of a LibavEncoder on a dedicated thread.
+ *
+ * The render thread fills frames taken from a fixed pool, so that a slow
+ * codec never stalls the rendering. When the pool is exhausted, the
+ * LibavOutputSettings::FramePolicy decides between waiting for the encoder,
+ * or dropping a frame. Dropped frames still advance the timestamps,
+ * so that the video stays in sync with the audio.
+ */
+class LibavFrameQueue
+{
+public:
+  LibavFrameQueue(LibavEncoder& encoder, const LibavOutputSettings& set);
+  ~LibavFrameQueue();
+
+  void start();
+
+  //! Encodes the frames still in the queue, then stops the thread
+  void stop();
+
+  /**
+   * Render thread: returns a frame to fill then submit,
+   * or nullptr if this frame is dropped.
+   */
+  LibavVideoFrame* acquire();
+  void submit(LibavVideoFrame* frame);
+
+  //! Offline, the rendering always waits for the encoder whatever the policy
+  void setOffline(bool offline);
+
+  int64_t droppedFrames() const noexcept { return m_dropped.load(std::memory_order_relaxed); }
+
+  //! Frames encoded more than one frame period after they were rendered
+  int64_t lateFrames() const noexcept { return m_late.load(std::memory_order_relaxed); }
+
+  //! Called from the encoder thread when the counters change
+  std::function<void(int64_t dropped, int64_t late)> onStatsChanged;
+
+private:
+  void run();
+  void encode(LibavVideoFrame& frame);
+
+  LibavEncoder& m_encoder;
+
+  std::mutex m_mutex;
+  std::condition_variable m_readyCv;
+  std::condition_variable m_freeCv;
+
+  // Allocated once: the render thread may still hold a frame while restarting
+  std::vector<LibavVideoFrame> m_pool;
+
+  // Protected by m_mutex
+  std::vector<LibavVideoFrame*> m_free;
+  std::deque<LibavVideoFrame*> m_ready;
+  int64_t m_nextIndex{};
+  bool m_running{};
+  bool m_offline{};
+
+  // Encoder thread
+  int64_t m_lastIndex{-1};
+  int64_t m_publishedDropped{};
+  int64_t m_publishedLate{};
+
+  LibavOutputSettings::FramePolicy m_policy{};
+  std::chrono::steady_clock::duration m_period{};
+  std::atomic_int64_t m_dropped{};
+  std::atomic_int64_t m_late{};
+
+  std::thread m_thread;
+};
+}
+#endif
@@ -14,6 +14,14 @@ namespace Gfx
 {
 struct LibavOutputSettings
 {
+  //! What to do with a new video frame when the encoder is too slow
+  enum FramePolicy
+  {
+    BlockRendering,
+    DropOldest,
+    DropNewest
+  };
+
   QString path;
   int width{};
   int height{};
@@ -30,5 +38,7 @@ struct LibavOutputSettings
   ossia::hash_map<QString, QString> options;
   int threads{};
   int input_transfer{13}; // AVColorTransferCharacteristic: 13=sRGB, 8=Linear, 16=PQ, 18=HLG, 2=Passthrough
+  FramePolicy frame_policy{DropOldest};
+  int frame_queue{8}; // Video frames buffered for the encoder thread
 };
 }
@@ -380,12 +380,28 @@ LibavSettingsWidget::LibavSettingsWidget(QWidget* parent)
     m_inputTransfer->addItem(tr("HLG"), 18);
     m_inputTransfer->addItem(tr("Passthrough"), 2);
 
+    m_framePolicy = new QComboBox{page};
+    m_framePolicy->addItem(tr("Drop oldest frames"), (int)LibavOutputSettings::DropOldest);
+    m_framePolicy->addItem(tr("Drop newest frames"), (int)LibavOutputSettings::DropNewest);
+    m_framePolicy->addItem(
+        tr("Wait for the encoder"), (int)LibavOutputSettings::BlockRendering);
+    m_framePolicy->setToolTip(
+        tr("What to do when the encoder cannot keep up with the rendering.\n"
+           "Waiting for the encoder keeps every frame but slows down all the outputs."));
+
+    m_frameQueue = new QSpinBox{page};
+    m_frameQueue->setRange(2, 120);
+    m_frameQueue->setValue(8);
+    m_frameQueue->setToolTip(tr("Frames buffered before the policy above applies"));
+
     m_validationLabel = new QLabel{page};
     m_validationLabel->setWordWrap(true);
 
     form->addRow(tr("Options"), m_outOptions);
     form->addRow("", m_showOptions);
     form->addRow(tr("Input Transfer"), m_inputTransfer);
+    form->addRow(tr("Slow encoder"), m_framePolicy);
+    form->addRow(tr("Frame queue"), m_frameQueue);
     form->addRow(m_validationLabel);
 
     auto* pageLayout = new QVBoxLayout{page};
@@ -729,6 +745,9 @@ Device::DeviceSettings LibavSettingsWidget::getSettings() const
     set.audio_converted_smpfmt = m_smpfmt->currentText();
     set.options = textToOptions(m_outOptions->toPlainText());
     set.input_transfer = m_inputTransfer->currentData().toInt();
+    set.frame_policy
+        = (LibavOutputSettings::FramePolicy)m_framePolicy->currentData().toInt();
+    set.frame_queue = m_frameQueue->value();
   }
 
   s.deviceSpecificSettings = QVariant::fromValue(set);
@@ -773,6 +792,9 @@ void LibavSettingsWidget::setSettings(const Device::DeviceSettings& settings)
       int idx = m_inputTransfer->findData(set.input_transfer);
       if(idx >= 0)
         m_inputTransfer->setCurrentIndex(idx);
+      if(int idx = m_framePolicy->findData((int)set.frame_policy); idx >= 0)
+        m_framePolicy->setCurrentIndex(idx);
+      m_frameQueue->setValue(set.frame_queue);
     }
 
     onDirectionChanged();
@@ -40,6 +40,8 @@ private:
   QPlainTextEdit* m_outOptions{};
   QPushButton* m_showOptions{};
   QComboBox* m_inputTransfer{};
+  QComboBox* m_framePolicy{};
+  QSpinBox* m_frameQueue{};
   QLabel* m_validationLabel{};
 
   Device::DeviceSettings m_settings;
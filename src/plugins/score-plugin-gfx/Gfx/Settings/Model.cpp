@@ -47,11 +47,19 @@ SETTINGS_PARAMETER_IMPL(DecodingThreads){
     QStringLiteral("score_plugin_gfx/DecodingThreads"), 2};
 SETTINGS_PARAMETER_IMPL(VSync){QStringLiteral("score_plugin_gfx/VSync"), true};
 SETTINGS_PARAMETER_IMPL(Buffers){QStringLiteral("score_plugin_gfx/Buffers"), 3};
+SETTINGS_PARAMETER_IMPL(ImageCacheSize){
+    QStringLiteral("score_plugin_gfx/ImageCacheSize"), 1024};
+SETTINGS_PARAMETER_IMPL(ImagePrefetch){QStringLiteral("score_plugin_gfx/ImagePrefetch"), 4};
+SETTINGS_PARAMETER_IMPL(ExactThumbnails){
+    QStringLiteral("score_plugin_gfx/ExactThumbnails"), false};
+SETTINGS_PARAMETER_IMPL(ShareRenderers){
+    QStringLiteral("score_plugin_gfx/ShareRenderers"), false};
 
 static auto list()
 {
   return std::tie(
-      GraphicsApi, HardwareDecode, DecodingThreads, Samples, Rate, VSync, Buffers);
+      GraphicsApi, HardwareDecode, DecodingThreads, Samples, Rate, VSync, Buffers,
+      ImageCacheSize, ImagePrefetch, ExactThumbnails, ShareRenderers);
 }
 }
 
@@ -274,4 +282,8 @@ SCORE_SETTINGS_PARAMETER_CPP(int, Model, Samples)
 SCORE_SETTINGS_PARAMETER_CPP(int, Model, DecodingThreads)
 SCORE_SETTINGS_PARAMETER_CPP(bool, Model, VSync)
 SCORE_SETTINGS_PARAMETER_CPP(int, Model, Buffers)
+SCORE_SETTINGS_PARAMETER_CPP(int, Model, ImageCacheSize)
+SCORE_SETTINGS_PARAMETER_CPP(int, Model, ImagePrefetch)
+SCORE_SETTINGS_PARAMETER_CPP(bool, Model, ExactThumbnails)
+SCORE_SETTINGS_PARAMETER_CPP(bool, Model, ShareRenderers)
 }
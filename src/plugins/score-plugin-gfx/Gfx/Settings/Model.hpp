@@ -48,6 +48,10 @@ class SCORE_PLUGIN_GFX_EXPORT Model : public score::SettingsDelegateModel
   int m_Samples{1};
   bool m_VSync{};
   int m_Buffers{3};
+  int m_ImageCacheSize{1024};
+  int m_ImagePrefetch{4};
+  bool m_ExactThumbnails{};
+  bool m_ShareRenderers{};
 
 public:
   Model(
@@ -61,6 +65,16 @@ public:
   SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_GFX_EXPORT, bool, VSync)
   SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_GFX_EXPORT, int, Buffers)
 
+  //! In MB, for the images decoded by the Images process
+  SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_GFX_EXPORT, int, ImageCacheSize)
+  SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_GFX_EXPORT, int, ImagePrefetch)
+
+  //! Video thumbnails from the exact frame instead of the previous keyframe
+  SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_GFX_EXPORT, bool, ExactThumbnails)
+
+  //! Outputs on the same GPU context render their common upstream nodes once
+  SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_GFX_EXPORT, bool, ShareRenderers)
+
 public:
   score::gfx::GraphicsApi graphicsApiEnum() const noexcept;
   QString getGraphicsApi() const;
@@ -81,6 +95,10 @@ SCORE_SETTINGS_PARAMETER(Model, Rate)
 SCORE_SETTINGS_PARAMETER(Model, Samples)
 SCORE_SETTINGS_PARAMETER(Model, VSync)
 SCORE_SETTINGS_PARAMETER(Model, Buffers)
+SCORE_SETTINGS_PARAMETER(Model, ImageCacheSize)
+SCORE_SETTINGS_PARAMETER(Model, ImagePrefetch)
+SCORE_SETTINGS_PARAMETER(Model, ExactThumbnails)
+SCORE_SETTINGS_PARAMETER(Model, ShareRenderers)
 
 SCORE_PLUGIN_GFX_EXPORT
 QShaderVersion shaderVersionForAPI(score::gfx::GraphicsApi) noexcept;
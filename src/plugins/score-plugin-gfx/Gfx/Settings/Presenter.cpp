@@ -25,6 +25,10 @@ Presenter::Presenter(Model& m, View& v, QObject* parent)
   SETTINGS_PRESENTER(Rate);
   SETTINGS_PRESENTER(VSync);
   SETTINGS_PRESENTER(Buffers);
+  SETTINGS_PRESENTER(ImageCacheSize);
+  SETTINGS_PRESENTER(ImagePrefetch);
+  SETTINGS_PRESENTER(ExactThumbnails);
+  SETTINGS_PRESENTER(ShareRenderers);
 }
 
 QString Presenter::settingsName()
@@ -38,6 +38,17 @@ View::View()
 
   static constexpr int buffers_values[]{1, 2, 3};
   SETTINGS_UI_NUM_COMBOBOX_SETUP("Buffer count", Buffers, buffers_values);
+
+  SETTINGS_UI_SPINBOX_SETUP("Image cache (MB)", ImageCacheSize);
+  m_ImageCacheSize->setRange(16, 1024 * 1024);
+  SETTINGS_UI_SPINBOX_SETUP("Images decoded in advance", ImagePrefetch);
+  m_ImagePrefetch->setRange(0, 64);
+  SETTINGS_UI_TOGGLE_SETUP("Exact video thumbnails", ExactThumbnails);
+  SETTINGS_UI_TOGGLE_SETUP(
+      "Share renderers between outputs\nOnly outputs which render with the same GPU "
+      "context reuse each other's textures. Windows, Sh4lt, Spout and Syphon outputs "
+      "each have their own context and are not affected.",
+      ShareRenderers);
 }
 
 QWidget* View::getWidget()
@@ -52,4 +63,8 @@ SETTINGS_UI_NUM_COMBOBOX_IMPL(Samples)
 SETTINGS_UI_DOUBLE_SPINBOX_IMPL(Rate)
 SETTINGS_UI_TOGGLE_IMPL(VSync)
 SETTINGS_UI_NUM_COMBOBOX_IMPL(Buffers)
+SETTINGS_UI_SPINBOX_IMPL(ImageCacheSize)
+SETTINGS_UI_SPINBOX_IMPL(ImagePrefetch)
+SETTINGS_UI_TOGGLE_IMPL(ExactThumbnails)
+SETTINGS_UI_TOGGLE_IMPL(ShareRenderers)
 }
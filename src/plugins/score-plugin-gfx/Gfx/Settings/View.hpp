@@ -22,6 +22,10 @@ public:
   SETTINGS_UI_NUM_COMBOBOX_HPP(Samples)
   SETTINGS_UI_TOGGLE_HPP(VSync)
   SETTINGS_UI_NUM_COMBOBOX_HPP(Buffers)
+  SETTINGS_UI_SPINBOX_HPP(ImageCacheSize)
+  SETTINGS_UI_SPINBOX_HPP(ImagePrefetch)
+  SETTINGS_UI_TOGGLE_HPP(ExactThumbnails)
+  SETTINGS_UI_TOGGLE_HPP(ShareRenderers)
 
 private:
   QWidget* getWidget() override;
@@ -363,7 +363,10 @@ ProgramCache::get(const ShaderSource& program) noexcept
           auto& settings = score::AppContext().settings<Gfx::Settings::Model>();
           const auto api = settings.graphicsApiEnum();
 
-          // Create QShader objects
+          // Create QShader objects, the fragment one on a worker meanwhile
+          score::gfx::ShaderCache::prebake(
+              api, Gfx::Settings::shaderVersionForAPI(api), processed.fragment.toUtf8(),
+              QShader::FragmentStage);
           auto [vertexS, vertexError] = score::gfx::ShaderCache::get(
               api, Gfx::Settings::shaderVersionForAPI(api), processed.vertex.toUtf8(),
               QShader::VertexStage);
@@ -2,9 +2,11 @@
 
 #include <Process/Style/ScenarioStyle.hpp>
 
+#include <Gfx/Settings/Model.hpp>
 #include <Gfx/Video/Process.hpp>
 #include <Video/Thumbnailer.hpp>
 
+#include <score/application/ApplicationContext.hpp>
 #include <score/graphics/GraphicsItem.hpp>
 #include <score/tools/Bind.hpp>
 #include <score/tools/ThreadPool.hpp>
@@ -40,6 +42,9 @@ View::View(const Model& model, QGraphicsItem* parent)
     m_images.clear();
     widthChanged(width());
   });
+  con(score::AppContext().settings<Gfx::Settings::Model>(),
+      &Gfx::Settings::Model::ExactThumbnailsChanged, this,
+      [this, &model](bool) { onPathChanged(model.absolutePath()); });
   onPathChanged(model.absolutePath());
 }
 
@@ -76,7 +81,9 @@ void View::onPathChanged(const QString& str)
 
   m_images.clear();
 
-  m_thumb = new ::Video::VideoThumbnailer{str};
+  const bool exact
+      = score::AppContext().settings<Gfx::Settings::Model>().getExactThumbnails();
+  m_thumb = new ::Video::VideoThumbnailer{str, exact};
   if(oldThread)
     m_thumb->moveToThread(oldThread);
   else
@@ -0,0 +1,589 @@
+#include "MathJit.hpp"
+
+#include <JitCpp/Compiler/Driver.hpp>
+
+#include <QDebug>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace Jit
+{
+namespace
+{
+// The generated code declares its own copy of the struct.
+static_assert(offsetof(Nodes::MathAudioBlock, x) == 2 * sizeof(void*));
+static_assert(offsetof(Nodes::MathAudioBlock, channels) == 8 * sizeof(void*));
+static_assert(
+    offsetof(Nodes::MathAudioBlock, a) == 8 * sizeof(void*) + 3 * sizeof(int64_t));
+static_assert(
+    sizeof(Nodes::MathAudioBlock)
+    == 8 * sizeof(void*) + 3 * sizeof(int64_t) + 7 * sizeof(double));
+
+static constexpr const char* math_prelude = R"_(
+namespace score_math
+{
+using int64_t = long long;
+inline double abs(double v) { return __builtin_fabs(v); }
+inline double acos(double v) { return __builtin_acos(v); }
+inline double acosh(double v) { return __builtin_acosh(v); }
+inline double asin(double v) { return __builtin_asin(v); }
+inline double asinh(double v) { return __builtin_asinh(v); }
+inline double atan(double v) { return __builtin_atan(v); }
+inline double atan2(double y, double x) { return __builtin_atan2(y, x); }
+inline double atanh(double v) { return __builtin_atanh(v); }
+inline double ceil(double v) { return __builtin_ceil(v); }
+inline double cos(double v) { return __builtin_cos(v); }
+inline double cosh(double v) { return __builtin_cosh(v); }
+inline double cot(double v) { return 1. / __builtin_tan(v); }
+inline double csc(double v) { return 1. / __builtin_sin(v); }
+inline double sec(double v) { return 1. / __builtin_cos(v); }
+inline double erf(double v) { return __builtin_erf(v); }
+inline double erfc(double v) { return __builtin_erfc(v); }
+inline double exp(double v) { return __builtin_exp(v); }
+inline double expm1(double v) { return __builtin_expm1(v); }
+inline double floor(double v) { return __builtin_floor(v); }
+inline double frac(double v) { return v - __builtin_trunc(v); }
+inline double hypot(double x, double y) { return __builtin_hypot(x, y); }
+inline double log(double v) { return __builtin_log(v); }
+inline double log10(double v) { return __builtin_log10(v); }
+inline double log1p(double v) { return __builtin_log1p(v); }
+inline double log2(double v) { return __builtin_log2(v); }
+inline double logn(double v, double n) { return __builtin_log(v) / __builtin_log(n); }
+inline double pow(double x, double y) { return __builtin_pow(x, y); }
+inline double root(double x, double n) { return __builtin_pow(x, 1. / n); }
+inline double round(double v) { return __builtin_round(v); }
+inline double roundn(double v, double n)
+{
+  const double p = __builtin_pow(10., __builtin_trunc(n));
+  return __builtin_round(v * p) / p;
+}
+inline double sgn(double v) { return v > 0. ? 1. : v < 0. ? -1. : 0.; }
+inline double sin(double v) { return __builtin_sin(v); }
+inline double sinc(double v) { return v != 0. ? __builtin_sin(v) / v : 1.; }
+inline double sinh(double v) { return __builtin_sinh(v); }
+inline double sqrt(double v) { return __builtin_sqrt(v); }
+inline double tan(double v) { return __builtin_tan(v); }
+inline double tanh(double v) { return __builtin_tanh(v); }
+inline double trunc(double v) { return __builtin_trunc(v); }
+inline double deg2rad(double v) { return v * (3.141592653589793238462643383279502 / 180.); }
+inline double rad2deg(double v) { return v * (180. / 3.141592653589793238462643383279502); }
+inline double clamp(double lo, double v, double hi) { return v < lo ? lo : v > hi ? hi : v; }
+inline double inrange(double lo, double v, double hi) { return lo <= v && v <= hi ? 1. : 0.; }
+inline double min(double v) { return v; }
+inline double max(double v) { return v; }
+template <typename... T>
+inline double min(double v, T... rest) { const double r = min(rest...); return v < r ? v : r; }
+template <typename... T>
+inline double max(double v, T... rest) { const double r = max(rest...); return v > r ? v : r; }
+template <typename... T>
+inline double avg(T... v) { return (0. + ... + v) / sizeof...(T); }
+
+struct block
+{
+  const double* const* in;
+  double* const* out;
+  double* x;
+  double* px;
+  double* cur_out;
+  double* m1;
+  double* m2;
+  double* m3;
+  int64_t channels;
+  int64_t out_channels;
+  int64_t frames;
+  double a, b, c;
+  double pa, pb, pc;
+  double fs;
+};
+}
+)_";
+
+struct Token
+{
+  enum Kind
+  {
+    Number,
+    Identifier,
+    Symbol
+  } kind;
+  std::string text;
+};
+
+bool isIdentStart(char c) noexcept
+{
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+bool isDigit(char c) noexcept
+{
+  return c >= '0' && c <= '9';
+}
+
+std::optional<std::vector<Token>> tokenize(std::string_view s)
+{
+  static constexpr std::string_view two_char_symbols[]
+      = {":=", "+=", "-=", "*=", "/=", "<=", ">=", "==", "!=", "<>", "&&", "||"};
+  static constexpr std::string_view one_char_symbols = "+-*/<>=!()[]{},;?:&|";
+
+  std::vector<Token> res;
+  std::size_t i = 0;
+  const std::size_t n = s.size();
+  while(i < n)
+  {
+    const char c = s[i];
+    if(c == ' ' || c == '\t' || c == '\n' || c == '\r')
+    {
+      i++;
+    }
+    else if(c == '#' || s.substr(i, 2) == "//")
+    {
+      while(i < n && s[i] != '\n')
+        i++;
+    }
+    else if(s.substr(i, 2) == "/*")
+    {
+      auto end = s.find("*/", i + 2);
+      if(end == std::string_view::npos)
+        return std::nullopt;
+      i = end + 2;
+    }
+    else if(isDigit(c) || (c == '.' && i + 1 < n && isDigit(s[i + 1])))
+    {
+      const std::size_t start = i;
+      bool integral = true;
+      while(i < n && isDigit(s[i]))
+        i++;
+      if(i < n && s[i] == '.')
+      {
+        integral = false;
+        i++;
+        while(i < n && isDigit(s[i]))
+          i++;
+      }
+      if(i < n && (s[i] == 'e' || s[i] == 'E'))
+      {
+        integral = false;
+        i++;
+        if(i < n && (s[i] == '+' || s[i] == '-'))
+          i++;
+        if(i == n || !isDigit(s[i]))
+          return std::nullopt;
+        while(i < n && isDigit(s[i]))
+          i++;
+      }
+      // exprtk does not support implicit multiplication with C++ semantics
+      if(i < n && (isIdentStart(s[i]) || s[i] == '.'))
+        return std::nullopt;
+
+      std::string num{s.substr(start, i - start)};
+      if(integral)
+        num += '.';
+      res.push_back({Token::Number, std::move(num)});
+    }
+    else if(isIdentStart(c))
+    {
+      const std::size_t start = i;
+      while(i < n && (isIdentStart(s[i]) || isDigit(s[i])))
+        i++;
+      res.push_back({Token::Identifier, std::string{s.substr(start, i - start)}});
+    }
+    else
+    {
+      auto two = s.substr(i, 2);
+      if(std::find(std::begin(two_char_symbols), std::end(two_char_symbols), two)
+         != std::end(two_char_symbols))
+      {
+        res.push_back({Token::Symbol, std::string{two}});
+        i += 2;
+      }
+      else if(one_char_symbols.find(c) != std::string_view::npos)
+      {
+        res.push_back({Token::Symbol, std::string(1, c)});
+        i++;
+      }
+      else
+      {
+        // ^, %, strings, ~, $...
+        return std::nullopt;
+      }
+    }
+  }
+  return res;
+}
+
+bool isReserved(std::string_view id) noexcept
+{
+  // exprtk constructs that do not map to C++, and C++ keywords
+  // that are plain identifiers in exprtk.
+  static constexpr std::string_view reserved[]
+      = {"return",       "repeat",      "until",       "switch",
+         "case",         "default",     "xor",         "nand",
+         "nor",          "xnor",        "in",          "like",
+         "ilike",        "mand",        "mor",         "null",
+         "swap",         "sum",         "equal",       "not_equal",
+         "alignas",      "alignof",     "asm",         "auto",
+         "bitand",       "bitor",       "bool",        "catch",
+         "char",         "class",       "compl",       "concept",
+         "const",        "consteval",   "constexpr",   "constinit",
+         "const_cast",   "co_await",    "co_return",   "co_yield",
+         "decltype",     "delete",      "do",          "double",
+         "dynamic_cast", "enum",        "explicit",    "export",
+         "extern",       "float",       "friend",      "goto",
+         "inline",       "int",         "long",        "mutable",
+         "namespace",    "new",         "noexcept",    "not_eq",
+         "nullptr",      "operator",    "or_eq",       "and_eq",
+         "private",      "protected",   "public",      "register",
+         "reinterpret_cast", "requires", "short",      "signed",
+         "sizeof",       "static",      "static_assert", "static_cast",
+         "struct",       "template",    "this",        "thread_local",
+         "throw",        "try",         "typedef",     "typeid",
+         "typename",     "union",       "unsigned",    "using",
+         "virtual",      "void",        "volatile",    "wchar_t",
+         "xor_eq",       "block",       "int64_t"};
+
+  if(id.starts_with("score_") || id.starts_with("__"))
+    return true;
+  return std::find(std::begin(reserved), std::end(reserved), id) != std::end(reserved);
+}
+
+struct Translator
+{
+  const std::vector<Token>& tokens;
+  Nodes::MathAudioKind kind{};
+  std::string out;
+  std::string last;
+
+  void emit(std::string_view tok)
+  {
+    out += tok;
+    out += ' ';
+    last = tok;
+  }
+
+  bool isVector(std::string_view id) const noexcept
+  {
+    if(id == "out" || id == "m1" || id == "m2" || id == "m3")
+      return true;
+    if(kind == Nodes::MathAudioKind::Filter)
+      return id == "x" || id == "px";
+    return false;
+  }
+
+  bool isSymbol(std::size_t i, std::string_view s) const noexcept
+  {
+    return i < tokens.size() && tokens[i].kind == Token::Symbol && tokens[i].text == s;
+  }
+
+  // Index of the bracket matching the one at i, or npos.
+  std::size_t matching(std::size_t i) const noexcept
+  {
+    const auto& open = tokens[i].text;
+    const std::string_view close = open == "(" ? ")" : open == "[" ? "]" : "}";
+    int depth = 0;
+    for(std::size_t k = i; k < tokens.size(); k++)
+    {
+      if(tokens[k].kind != Token::Symbol)
+        continue;
+      if(tokens[k].text == open)
+        depth++;
+      else if(tokens[k].text == close && --depth == 0)
+        return k;
+    }
+    return std::string::npos;
+  }
+
+  // Positions of the commas at the top level of [begin, end)
+  std::vector<std::size_t> topLevelCommas(std::size_t begin, std::size_t end) const
+  {
+    std::vector<std::size_t> commas;
+    int depth = 0;
+    for(std::size_t k = begin; k < end; k++)
+    {
+      if(tokens[k].kind != Token::Symbol)
+        continue;
+      const auto& t = tokens[k].text;
+      if(t == "(" || t == "[" || t == "{")
+        depth++;
+      else if(t == ")" || t == "]" || t == "}")
+        depth--;
+      else if(t == "," && depth == 0)
+        commas.push_back(k);
+    }
+    return commas;
+  }
+
+  bool translate(std::size_t begin, std::size_t end)
+  {
+    for(std::size_t i = begin; i < end;)
+    {
+      const auto& tok = tokens[i];
+      switch(tok.kind)
+      {
+        case Token::Number:
+          emit(tok.text);
+          i++;
+          break;
+
+        case Token::Identifier: {
+          const auto& id = tok.text;
+          if(isReserved(id))
+            return false;
+
+          if(id == "var")
+          {
+            if(i + 1 >= end || tokens[i + 1].kind != Token::Identifier
+               || isReserved(tokens[i + 1].text) || isVector(tokens[i + 1].text))
+              return false;
+            if(isSymbol(i + 2, "["))
+              return false;
+
+            emit("double");
+            emit(tokens[i + 1].text);
+            if(isSymbol(i + 2, ":="))
+            {
+              emit("=");
+              i += 3;
+            }
+            else
+            {
+              emit("=");
+              emit("0.");
+              i += 2;
+            }
+          }
+          else if(id == "if" && isSymbol(i + 1, "("))
+          {
+            const auto close = matching(i + 1);
+            if(close == std::string::npos || close >= end)
+              return false;
+
+            auto commas = topLevelCommas(i + 2, close);
+            if(commas.empty())
+            {
+              // Statement form, the parentheses are handled normally
+              emit("if");
+              i++;
+              break;
+            }
+            if(commas.size() != 2)
+              return false;
+
+            // Function form: if(cond, a, b)
+            emit("((");
+            if(!translate(i + 2, commas[0]))
+              return false;
+            emit(") ? (");
+            if(!translate(commas[0] + 1, commas[1]))
+              return false;
+            emit(") : (");
+            if(!translate(commas[1] + 1, close))
+              return false;
+            emit("))");
+            i = close + 1;
+          }
+          else if(isVector(id))
+          {
+            if(!isSymbol(i + 1, "["))
+              return false;
+
+            if(isSymbol(i + 2, "]"))
+            {
+              // x[] is the size of the vector
+              emit("score_N");
+              i += 3;
+              break;
+            }
+
+            const auto close = matching(i + 1);
+            if(close == std::string::npos || close >= end)
+              return false;
+            emit(id);
+            emit("[score_idx(");
+            if(!translate(i + 2, close))
+              return false;
+            emit(")]");
+            i = close + 1;
+          }
+          else if(id == "and")
+          {
+            emit("&&");
+            i++;
+          }
+          else if(id == "or")
+          {
+            emit("||");
+            i++;
+          }
+          else if(id == "not")
+          {
+            emit("!");
+            i++;
+          }
+          else
+          {
+            emit(id);
+            i++;
+          }
+          break;
+        }
+
+        case Token::Symbol: {
+          const auto& s = tok.text;
+          if(s == ":=")
+            emit("=");
+          else if(s == "=")
+            emit("==");
+          else if(s == "<>")
+            emit("!=");
+          else if(s == "&")
+            emit("&&");
+          else if(s == "|")
+            emit("||");
+          else if(s == "}")
+          {
+            if(last != ";" && last != "{" && last != "}")
+              emit(";");
+            emit("}");
+          }
+          else
+            emit(s);
+          i++;
+          break;
+        }
+      }
+    }
+    return true;
+  }
+};
+}
+
+std::optional<std::string>
+translateMathExpression(std::string_view expr, Nodes::MathAudioKind kind)
+{
+  auto tokens = tokenize(expr);
+  if(!tokens || tokens->empty())
+    return std::nullopt;
+
+  Translator tr{*tokens, kind};
+  if(!tr.translate(0, tokens->size()))
+    return std::nullopt;
+  if(tr.last != ";" && tr.last != "}")
+    tr.emit(";");
+
+  const bool filter = kind == Nodes::MathAudioKind::Filter;
+
+  std::string src = math_prelude;
+  src += R"_(
+extern "C" void score_math_audio(score_math::block* score_blk)
+{
+  using namespace score_math;
+  const int64_t score_n = score_blk->channels;
+  const int64_t score_out_n = score_blk->out_channels;
+  const int64_t score_frames = score_blk->frames;
+  const double score_N = score_n;
+  const auto score_idx = [score_n](double i) -> int64_t {
+    const int64_t k = (int64_t)i;
+    return k < 0 ? 0 : k >= score_n ? score_n - 1 : k;
+  };
+
+  const double pi = 3.141592653589793238462643383279502;
+  const double epsilon = 0.0000000001;
+  const double inf = __builtin_inf();
+
+  double& a = score_blk->a;
+  double& b = score_blk->b;
+  double& c = score_blk->c;
+  double& pa = score_blk->pa;
+  double& pb = score_blk->pb;
+  double& pc = score_blk->pc;
+  double& fs = score_blk->fs;
+  double* const out = score_blk->cur_out;
+  double* const m1 = score_blk->m1;
+  double* const m2 = score_blk->m2;
+  double* const m3 = score_blk->m3;
+)_";
+  if(filter)
+  {
+    src += R"_(
+  double* const x = score_blk->x;
+  double* const px = score_blk->px;
+)_";
+  }
+
+  src += R"_(
+  for(int64_t score_i = 0; score_i < score_frames; score_i++)
+  {
+    double t = score_i;
+)_";
+  if(filter)
+  {
+    src += R"_(
+    for(int64_t score_c = 0; score_c < score_n; score_c++)
+      x[score_c] = score_blk->in[score_c][score_i];
+)_";
+  }
+
+  src += "    {\n      ";
+  src += tr.out;
+  src += "\n    }\n";
+  src += R"_(
+    for(int64_t score_c = 0; score_c < score_out_n; score_c++)
+      score_blk->out[score_c][score_i] = out[score_c];
+)_";
+  if(filter)
+  {
+    src += R"_(
+    for(int64_t score_c = 0; score_c < score_n; score_c++)
+      px[score_c] = x[score_c];
+)_";
+  }
+  src += "  }\n}\n";
+  return src;
+}
+
+MathCompiler::MathCompiler() = default;
+MathCompiler::~MathCompiler() = default;
+
+Nodes::MathAudioFunction*
+MathCompiler::compile(const std::string& expr, Nodes::MathAudioKind kind)
+{
+  auto src = translateMathExpression(expr, kind);
+  if(!src)
+    return nullptr;
+
+  // The LLVM contexts are not shared, but clang's diagnostics and
+  // the bitcode cache are: compile one expression at a time.
+  std::lock_guard lock{m_mutex};
+  auto driver = std::make_unique<Driver>("score_math_audio");
+  try
+  {
+    auto fun = (*driver).operator()<Nodes::MathAudioFunction>(
+        *src, {}, CompilerOptions{true});
+    auto tgt = fun.target<Nodes::MathAudioFunction*>();
+    if(!tgt || !*tgt)
+      return nullptr;
+
+    m_drivers.emplace_back(*tgt, std::move(driver));
+    return *tgt;
+  }
+  catch(const std::exception& e)
+  {
+    qDebug() << "Math expression not compiled, using exprtk:" << e.what();
+  }
+  catch(...)
+  {
+  }
+  return nullptr;
+}
+
+void MathCompiler::release(Nodes::MathAudioFunction* function)
+{
+  std::lock_guard lock{m_mutex};
+  auto it = std::find_if(m_drivers.begin(), m_drivers.end(), [function](const auto& p) {
+    return p.first == function;
+  });
+  if(it != m_drivers.end())
+    m_drivers.erase(it);
+}
+}
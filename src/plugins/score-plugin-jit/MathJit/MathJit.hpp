@@ -0,0 +1,55 @@
+#pragma once
+#include <Fx/CompiledMath.hpp>
+
+#include <score_plugin_jit_export.h>
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Jit
+{
+struct Driver;
+
+/**
+ * @brief Translates the expression of a Math audio node to C++.
+ *
+ * Only a subset of the exprtk language is supported: arithmetic, comparisons,
+ * the usual math functions, local variables, if / for / while and indexed
+ * access to the vectors of the node. Anything else gives std::nullopt, and
+ * the node keeps running the expression with exprtk.
+ *
+ * The generated function processes a whole block of samples.
+ */
+SCORE_PLUGIN_JIT_EXPORT
+std::optional<std::string>
+translateMathExpression(std::string_view expr, Nodes::MathAudioKind kind);
+
+/**
+ * @brief Compiles the Math audio expressions with clang.
+ *
+ * The generated source only depends on the expression,
+ * so the bitcode cache of ClangCC1Driver is hit when an expression
+ * has already been compiled in a previous session.
+ */
+class MathCompiler final : public Nodes::MathCompiler
+{
+public:
+  MathCompiler();
+  ~MathCompiler() override;
+
+  Nodes::MathAudioFunction*
+  compile(const std::string& expr, Nodes::MathAudioKind kind) override;
+  void release(Nodes::MathAudioFunction* function) override;
+
+private:
+  std::mutex m_mutex;
+
+  // Each driver owns the code of one expression
+  std::vector<std::pair<Nodes::MathAudioFunction*, std::unique_ptr<Driver>>> m_drivers;
+};
+}
@@ -6,6 +6,9 @@
 #include <JitCpp/ApplicationPlugin.hpp>
 #include <JitCpp/AvndJit.hpp>
 #include <JitCpp/JitModel.hpp>
+#if defined(SCORE_JIT_HAS_MATH)
+#include <MathJit/MathJit.hpp>
+#endif
 #include <Texgen/Texgen.hpp>
 
 #include <score/plugins/FactorySetup.hpp>
@@ -36,9 +39,19 @@ score_plugin_jit::score_plugin_jit()
   InitializeNativeTarget();
   InitializeNativeTargetAsmPrinter();
   InitializeNativeTargetAsmParser();
+
+#if defined(SCORE_JIT_HAS_MATH)
+  Nodes::setMathCompiler(std::make_shared<Jit::MathCompiler>());
+#endif
 }
 
-score_plugin_jit::~score_plugin_jit() { }
+score_plugin_jit::~score_plugin_jit()
+{
+#if defined(SCORE_JIT_HAS_MATH)
+  // The compiled code must go away before llvm_shutdown
+  Nodes::setMathCompiler(nullptr);
+#endif
+}
 
 std::vector<score::InterfaceBase*> score_plugin_jit::factories(
     const score::ApplicationContext& ctx, const score::InterfaceKey& key) const
@@ -24,6 +24,38 @@
 namespace JS
 {
 
+bool js_audio_views::update(
+    QJSEngine& engine, const QJSValue& ctor, ossia::audio_vector& chans,
+    int64_t offset, int64_t frames)
+{
+  const std::size_t n = chans.size();
+  const auto view = [&](std::size_t i) -> std::pair<double*, int64_t> {
+    auto& c = chans[i];
+    return {c.data() + offset, frames < 0 ? int64_t(c.size()) - offset : frames};
+  };
+
+  bool changed = array.isUndefined() || channels.size() != n;
+  for(std::size_t i = 0; !changed && i < n; i++)
+    changed = channels[i] != view(i);
+  if(!changed)
+    return false;
+
+  channels.resize(n);
+  array = engine.newArray(n);
+  for(std::size_t i = 0; i < n; i++)
+  {
+    channels[i] = view(i);
+    const auto [ptr, len] = channels[i];
+
+    // A raw QByteArray becomes an ArrayBuffer which does not own
+    // nor copy the samples.
+    auto buf = engine.toScriptValue(QByteArray::fromRawData(
+        reinterpret_cast<const char*>(ptr), len * qsizetype(sizeof(double))));
+    array.setProperty(i, ctor.callAsConstructor({buf}));
+  }
+  return true;
+}
+
 js_node::js_node(ossia::execution_state& st)
     : m_st{st}
 {
@@ -42,6 +74,9 @@ void js_node::clear() noexcept
 {
   OSSIA_ENSURE_CURRENT_THREAD(ossia::thread_type::Audio);
   m_tickCall.reset();
+  m_audInletViews.clear();
+  m_audOutletViews.clear();
+  m_float64Array = QJSValue{};
 
   delete m_context;
   m_context = nullptr;
@@ -102,6 +137,7 @@ void js_node::setupComponent()
     {
       m_jsInlets.push_back(aud_in);
       m_audInlets.push_back({aud_in, m_inlets[input_i++]});
+      m_audInletViews.emplace_back();
     }
     else if(auto mid_in = qobject_cast<MidiInlet*>(n))
     {
@@ -115,6 +151,7 @@ void js_node::setupComponent()
     else if(auto aud_out = qobject_cast<AudioOutlet*>(n))
     {
       m_audOutlets.push_back({aud_out, m_outlets[output_i++]});
+      m_audOutletViews.emplace_back();
     }
     else if(auto mid_out = qobject_cast<MidiOutlet*>(n))
     {
@@ -148,6 +185,8 @@ void js_node::setScript(const QString& rootPath, const QString& val)
     m_context->setContextProperty("Device", m_execFuncs);
     setupExecFuncs(this, m_uiContext, m_execFuncs);
   }
+  if(m_float64Array.isUndefined())
+    m_float64Array = m_engine->globalObject().property("Float64Array");
 
   m_jsInlets.clear();
   m_ctrlInlets.clear();
@@ -158,6 +197,8 @@ void js_node::setScript(const QString& rootPath, const QString& val)
   m_valOutlets.clear();
   m_audOutlets.clear();
   m_midOutlets.clear();
+  m_audInletViews.clear();
+  m_audOutletViews.clear();
 
   delete m_object;
   if((m_object = createJSObject(rootPath, val, m_engine.get(), m_context)))
@@ -196,12 +237,23 @@ void js_node::run(
       m_object->resume().call();
   }
 
+  const auto [tick_start, d] = estate.timings(tk);
+
   // Copy audio
   for(std::size_t inl_i = 0; inl_i < m_audInlets.size(); inl_i++)
   {
     auto& inlet = *m_audInlets[inl_i].first;
     auto& dat = m_audInlets[inl_i].second->target<ossia::audio_port>()->get();
 
+    if(inlet.block())
+    {
+      // The script reads the port buffers in place
+      auto& views = m_audInletViews[inl_i];
+      if(views.update(*m_engine, m_float64Array, dat, 0, -1))
+        inlet.setBuffers(views.array);
+      continue;
+    }
+
     const int dat_size = std::ssize(dat);
     QVector<QVector<double>> audio = std::move(inlet.audio());
     audio.resize(dat_size);
@@ -278,6 +330,26 @@ void js_node::run(
     m_midInlets[i].first->setMidi(dat);
   }
 
+  // Outlets in block mode are written in place by the script
+  for(std::size_t out = 0; out < m_audOutlets.size(); out++)
+  {
+    auto& outlet = *m_audOutlets[out].first;
+    if(!outlet.block())
+      continue;
+
+    auto& snk = m_audOutlets[out].second->target<ossia::audio_port>()->get();
+    snk.resize(outlet.channels());
+    for(auto& chan : snk)
+    {
+      chan.resize(tick_start + d);
+      std::fill(chan.begin(), chan.end(), 0.);
+    }
+
+    auto& views = m_audOutletViews[out];
+    if(views.update(*m_engine, m_float64Array, snk, tick_start, d))
+      outlet.setBuffers(views.array);
+  }
+
   if(!m_tickCall || m_tickCall->empty())
     m_tickCall = QJSValueList{{}, {}};
 
@@ -291,7 +363,6 @@ void js_node::run(
              << res.toString();
   }
 
-  const auto [tick_start, d] = estate.timings(tk);
   for(std::size_t i = 0; i < m_valOutlets.size(); i++)
   {
     auto& ossia_port = *m_valOutlets[i].second->target<ossia::value_port>();
@@ -327,6 +398,9 @@ void js_node::run(
 
   for(std::size_t out = 0; out < m_audOutlets.size(); out++)
   {
+    if(m_audOutlets[out].first->block())
+      continue;
+
     auto& src = m_audOutlets[out].first->audio();
     auto& snk = m_audOutlets[out].second->target<ossia::audio_port>()->get();
     snk.resize(src.size());
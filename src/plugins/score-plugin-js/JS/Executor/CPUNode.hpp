@@ -29,6 +29,25 @@ class qml_engine_functions;
 
 namespace JS
 {
+/**
+ * @brief Float64Array views over the channels of an audio port.
+ *
+ * Used for the ports in block mode. The views share the memory of
+ * the ossia port: they are only rebuilt when its buffers are reallocated
+ * or change size, so most ticks do not allocate anything in the JS heap.
+ */
+struct js_audio_views
+{
+  std::vector<std::pair<double*, int64_t>> channels;
+  QJSValue array;
+
+  //! frames < 0 means up to the end of each channel.
+  //! Returns true if the views had to be rebuilt.
+  bool update(
+      QJSEngine& engine, const QJSValue& ctor, ossia::audio_vector& chans,
+      int64_t offset, int64_t frames);
+};
+
 class js_node final : public ossia::graph_node
 {
 public:
@@ -55,6 +74,9 @@ public:
   std::vector<std::pair<AudioOutlet*, ossia::outlet_ptr>> m_audOutlets;
   std::vector<std::pair<MidiInlet*, ossia::inlet_ptr>> m_midInlets;
   std::vector<std::pair<MidiOutlet*, ossia::outlet_ptr>> m_midOutlets;
+  std::vector<js_audio_views> m_audInletViews;
+  std::vector<js_audio_views> m_audOutletViews;
+  QJSValue m_float64Array;
   JS::Script* m_object{};
   ossia::qt::qml_engine_functions* m_execFuncs{};
   std::optional<QJSValueList> m_tickCall;
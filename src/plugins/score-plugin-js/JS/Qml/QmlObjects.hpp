@@ -686,6 +686,19 @@ public:
   }
   W_INVOKABLE(channel);
 
+  /**
+   * Block mode: the samples are not copied in audio() / channel().
+   * Instead, buffers is an array of Float64Array, one per channel, which
+   * share the memory of the port. They are only valid during tick().
+   */
+  bool block() const noexcept { return m_block; }
+  void setBlock(bool b) { m_block = b; }
+  W_PROPERTY(bool, block READ block WRITE setBlock CONSTANT)
+
+  const QJSValue& buffers() const noexcept { return m_buffers; }
+  void setBuffers(const QJSValue& v) { m_buffers = v; }
+  W_PROPERTY(QJSValue, buffers READ buffers CONSTANT)
+
   Process::Inlet* make(Id<Process::Port>&& id, QObject* parent) override
   {
     return new Process::AudioInlet(objectName(), id, parent);
@@ -693,6 +706,8 @@ public:
 
 private:
   QVector<QVector<double>> m_audio;
+  QJSValue m_buffers;
+  bool m_block{};
 };
 
 class SCORE_PLUGIN_JS_EXPORT AudioOutlet : public Outlet
@@ -714,8 +729,29 @@ public:
 
   void setChannel(int i, const QJSValue& v);
   W_INVOKABLE(setChannel)
+
+  /**
+   * Block mode: instead of setChannel, the script writes in buffers,
+   * an array of channels() Float64Array which share the memory of the port
+   * for the frames of the current tick. They are only valid during tick().
+   */
+  bool block() const noexcept { return m_block; }
+  void setBlock(bool b) { m_block = b; }
+  W_PROPERTY(bool, block READ block WRITE setBlock CONSTANT)
+
+  int channels() const noexcept { return m_channels; }
+  void setChannels(int c) { m_channels = std::max(c, 0); }
+  W_PROPERTY(int, channels READ channels WRITE setChannels CONSTANT)
+
+  const QJSValue& buffers() const noexcept { return m_buffers; }
+  void setBuffers(const QJSValue& v) { m_buffers = v; }
+  W_PROPERTY(QJSValue, buffers READ buffers CONSTANT)
+
 private:
   QVector<QVector<double>> m_audio;
+  QJSValue m_buffers;
+  int m_channels{2};
+  bool m_block{};
 };
 
 class SCORE_PLUGIN_JS_EXPORT MidiMessage
@@ -373,16 +373,22 @@ namespace Media
 AudioDecoder::AudioDecoder(int rate)
     : convertedSampleRate{rate}
 {
-  connect(
-      this, &AudioDecoder::startDecode, this, &AudioDecoder::on_startDecode,
-      Qt::QueuedConnection);
 }
 
 AudioDecoder::~AudioDecoder()
 {
-  m_decodeThread.exit();
-  while(m_decodeThread.isRunning())
-    ;
+  // Stops a decode in progress, or removes it from the queue if not started yet
+  m_cancelled = true;
+  if(m_job)
+    AudioDecoderPool::instance().cancel(m_job);
+}
+
+void AudioDecoder::raisePriority(DecodePriority p)
+{
+  if(m_job)
+    AudioDecoderPool::instance().raisePriority(*m_job, p);
+  else if(p > m_priority)
+    m_priority = p;
 }
 
 struct AVCodecContext_Free
@@ -550,7 +556,7 @@ void AudioDecoder::decode(const QString& path, int trackToUse, audio_handle hdl)
     catch(...)
     {
       qDebug("Cannot decode without info");
-      finishedDecoding(hdl);
+      finishedDecoding(hdl, false);
       return;
     }
   }
@@ -579,9 +585,8 @@ void AudioDecoder::decode(const QString& path, int trackToUse, audio_handle hdl)
   if(data.size() == 0)
     return;
 
-  this->moveToThread(&m_decodeThread);
-  m_decodeThread.start();
-  startDecode(path, hdl);
+  m_job = AudioDecoderPool::instance().submit(
+      [this, path, hdl] { on_startDecode(path, hdl); }, m_priority);
 #endif
 }
 
@@ -703,6 +708,7 @@ void AudioDecoder::on_startDecode(QString path, audio_handle hdl)
 {
 #if SCORE_HAS_LIBAV
   auto& data = hdl->data;
+  bool complete = false;
   try
   {
     const std::size_t channels = data.size();
@@ -808,7 +814,7 @@ void AudioDecoder::on_startDecode(QString path, audio_handle hdl)
 
       debug_ffmpeg(ret, "av_read_frame");
       int update = 0;
-      while(ret >= 0)
+      while(ret >= 0 && !m_cancelled)
       {
         ret = avcodec_send_packet(codec_ctx.get(), &packet);
         debug_ffmpeg(ret, "avcodec_send_packet");
@@ -818,7 +824,7 @@ void AudioDecoder::on_startDecode(QString path, audio_handle hdl)
           debug_ffmpeg(ret, "avcodec_receive_frame");
           if(ret == 0)
           {
-            while(ret == 0)
+            while(ret == 0 && !m_cancelled)
             {
               decodeFrame(dec, data, *frame);
               ret = avcodec_receive_frame(codec_ctx.get(), frame.get());
@@ -866,6 +872,12 @@ void AudioDecoder::on_startDecode(QString path, audio_handle hdl)
       // Flush
       ret = avcodec_send_packet(codec_ctx.get(), nullptr);
 
+      if(m_cancelled)
+      {
+        av_packet_unref(&packet);
+        return;
+      }
+
       decodeRemaining(dec, data, *frame);
       newData();
         },
@@ -875,15 +887,15 @@ void AudioDecoder::on_startDecode(QString path, audio_handle hdl)
     for(auto swr : resampler)
       swr_free(&swr);
     resampler.clear();
+    complete = true;
   }
   catch(std::exception& e)
   {
     qDebug() << "Decoder error: " << e.what();
   }
 
-  finishedDecoding(hdl);
-  m_decodeThread.quit();
-
+  if(!m_cancelled)
+    finishedDecoding(hdl, complete);
 #endif
   return;
 }
@@ -2,11 +2,12 @@
 #include <Process/TimeValue.hpp>
 
 #include <Media/AudioArray.hpp>
+#include <Media/AudioDecoderPool.hpp>
 
 #include <ossia/detail/flicks.hpp>
 #include <ossia/detail/optional.hpp>
 
-#include <QThread>
+#include <QObject>
 
 #include <score_plugin_media_export.h>
 
@@ -44,6 +45,9 @@ public:
   static std::optional<AudioInfo> do_probe(const QString& path);
   void decode(const QString& path, int track, audio_handle hdl);
 
+  //! Files shown or about to be played are decoded before the others
+  void raisePriority(DecodePriority p);
+
   static std::optional<std::pair<AudioInfo, audio_array>>
   decode_synchronous(const QString& path, int rate);
 
@@ -57,19 +61,19 @@ public:
 
 public:
   void newData() W_SIGNAL(newData);
-  void finishedDecoding(audio_handle hdl) W_SIGNAL(finishedDecoding, hdl);
-
-  void startDecode(QString str, audio_handle hdl) W_SIGNAL(startDecode, str, hdl);
+  //! complete is false if the decoding stopped on an error: hdl only has the beginning
+  void finishedDecoding(audio_handle hdl, bool complete)
+      W_SIGNAL(finishedDecoding, hdl, complete);
 
 public:
   void on_startDecode(QString, audio_handle hdl);
-  W_SLOT(on_startDecode);
 
 private:
   static double read_length(const QString& path);
 
-  QThread* m_baseThread{};
-  QThread m_decodeThread;
+  AudioDecoderPool::job_ptr m_job;
+  DecodePriority m_priority{DecodePriority::Background};
+  std::atomic_bool m_cancelled{};
 
   template <typename Decoder>
   void decodeFrame(Decoder dec, audio_array& data, AVFrame& frame);
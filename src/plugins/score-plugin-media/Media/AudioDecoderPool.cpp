@@ -0,0 +1,144 @@
+#include "AudioDecoderPool.hpp"
+
+#include <ossia/detail/thread.hpp>
+
+#include <QDebug>
+
+#include <algorithm>
+#include <string>
+
+namespace Media
+{
+AudioDecoderPool::AudioDecoderPool()
+{
+  // Decoding is mostly bound by I/O and memory bandwidth: a few threads are
+  // enough and leave the other cores to the UI and the audio engine.
+  int n = std::thread::hardware_concurrency() / 2;
+  n = std::clamp(n, 1, 4);
+
+  for(int i = 0; i < n; i++)
+  {
+    m_threads.emplace_back([this, i] {
+      ossia::set_thread_name("ossia decode " + std::to_string(i));
+      worker();
+    });
+  }
+}
+
+AudioDecoderPool::~AudioDecoderPool()
+{
+  {
+    std::lock_guard lock{m_mutex};
+    m_running = false;
+    m_pending.clear();
+  }
+  m_jobsCv.notify_all();
+
+  for(auto& t : m_threads)
+  {
+    if(t.joinable())
+      t.join();
+  }
+}
+
+AudioDecoderPool& AudioDecoderPool::instance()
+{
+  static AudioDecoderPool pool;
+  return pool;
+}
+
+void AudioDecoderPool::enqueue(const job_ptr& job)
+{
+  {
+    std::lock_guard lock{m_mutex};
+    job->order = m_order++;
+    m_pending.push_back(job);
+  }
+  m_jobsCv.notify_one();
+}
+
+void AudioDecoderPool::raisePriority(Job& job, DecodePriority p) noexcept
+{
+  int cur = job.priority.load(std::memory_order_relaxed);
+  while(cur < (int)p && !job.priority.compare_exchange_weak(cur, (int)p))
+    ;
+}
+
+void AudioDecoderPool::cancel(const job_ptr& job)
+{
+  if(!job)
+    return;
+
+  std::unique_lock lock{m_mutex};
+  switch(job->state)
+  {
+    case Job::Pending: {
+      auto it = std::find(m_pending.begin(), m_pending.end(), job);
+      if(it != m_pending.end())
+        m_pending.erase(it);
+      job->state = Job::Done;
+      break;
+    }
+    case Job::Running:
+      m_doneCv.wait(lock, [&] { return job->state == Job::Done; });
+      break;
+    case Job::Done:
+      break;
+  }
+}
+
+AudioDecoderPool::job_ptr AudioDecoderPool::takeNext()
+{
+  // Called with the mutex locked. The queue is at most a few hundred files
+  // long and priorities can change at any time, thus a linear search.
+  auto it = std::max_element(
+      m_pending.begin(), m_pending.end(), [](const job_ptr& lhs, const job_ptr& rhs) {
+    const int lp = lhs->priority.load(std::memory_order_relaxed);
+    const int rp = rhs->priority.load(std::memory_order_relaxed);
+    if(lp != rp)
+      return lp < rp;
+    return lhs->order > rhs->order;
+  });
+
+  auto job = std::move(*it);
+  m_pending.erase(it);
+  return job;
+}
+
+void AudioDecoderPool::worker()
+{
+  for(;;)
+  {
+    job_ptr job;
+    {
+      std::unique_lock lock{m_mutex};
+      m_jobsCv.wait(lock, [this] { return !m_running || !m_pending.empty(); });
+      if(!m_running)
+        return;
+
+      job = takeNext();
+      job->state = Job::Running;
+    }
+
+    try
+    {
+      job->run();
+    }
+    catch(const std::exception& e)
+    {
+      qDebug() << "AudioDecoderPool: job threw:" << e.what();
+    }
+    catch(...)
+    {
+      qDebug() << "AudioDecoderPool: job threw an unknown exception";
+    }
+
+    {
+      std::lock_guard lock{m_mutex};
+      job->state = Job::Done;
+      job->run = {};
+    }
+    m_doneCv.notify_all();
+  }
+}
+}
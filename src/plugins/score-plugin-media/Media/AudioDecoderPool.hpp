@@ -0,0 +1,83 @@
+#pragma once
+#include <score_plugin_media_export.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Media
+{
+//! Order in which pending files are decoded: higher first.
+enum class DecodePriority : int
+{
+  Background = 0,
+  Visible = 1, //!< Shown in the current view
+  Playback = 2 //!< About to be played
+};
+
+/**
+ * @brief Bounded set of threads shared by all the AudioDecoder.
+ *
+ * Opening a project with hundreds of compressed files used to start one
+ * thread per file. Jobs are now queued and run by a few workers, highest
+ * priority first, then in submission order.
+ */
+class SCORE_PLUGIN_MEDIA_EXPORT AudioDecoderPool
+{
+public:
+  struct Job
+  {
+    std::function<void()> run;
+    std::atomic<int> priority{};
+    uint64_t order{};
+
+    enum State
+    {
+      Pending,
+      Running,
+      Done
+    } state{Pending};
+  };
+  using job_ptr = std::shared_ptr<Job>;
+
+  AudioDecoderPool();
+  ~AudioDecoderPool();
+  static AudioDecoderPool& instance();
+
+  template <typename F>
+  job_ptr submit(F&& f, DecodePriority p)
+  {
+    auto job = std::make_shared<Job>();
+    job->run = std::forward<F>(f);
+    job->priority = (int)p;
+    enqueue(job);
+    return job;
+  }
+
+  //! Priorities are only ever raised
+  void raisePriority(Job& job, DecodePriority p) noexcept;
+
+  /**
+   * Removes the job if it has not started yet, otherwise waits for it to finish.
+   * A running job must check its own cancellation flag to stop early.
+   */
+  void cancel(const job_ptr& job);
+
+private:
+  void enqueue(const job_ptr& job);
+  void worker();
+  job_ptr takeNext();
+
+  std::mutex m_mutex;
+  std::condition_variable m_jobsCv;
+  std::condition_variable m_doneCv;
+  std::vector<job_ptr> m_pending;
+  std::vector<std::thread> m_threads;
+  uint64_t m_order{};
+  bool m_running{true};
+};
+}
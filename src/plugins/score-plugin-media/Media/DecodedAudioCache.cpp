@@ -0,0 +1,131 @@
+#include "DecodedAudioCache.hpp"
+
+#include <Audio/Settings/Model.hpp>
+#include <Media/MediaFileHandle.hpp>
+
+#include <score/application/GUIApplicationContext.hpp>
+#include <score/tools/ThreadPool.hpp>
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QStandardPaths>
+
+namespace Media::DecodedAudioCache
+{
+// Bump when the layout of the cached files changes
+static constexpr int cache_version = 1;
+
+static QString cacheFolder()
+{
+  static const QString folder = []() -> QString {
+    const auto cache
+        = QStandardPaths::standardLocations(QStandardPaths::StandardLocation::CacheLocation);
+    if(cache.empty())
+      return {};
+
+    QDir dir{cache.first()};
+    if(!dir.mkpath("decoded-audio") || !dir.cd("decoded-audio"))
+      return {};
+    return dir.absolutePath();
+  }();
+  return folder;
+}
+
+// Removes the oldest entries until the folder fits in maxSize
+static void evict(const QString& folder, int64_t maxSize)
+{
+  const auto files = QDir{folder}.entryInfoList(
+      {QStringLiteral("*.wav")}, QDir::Files, QDir::Time | QDir::Reversed);
+
+  int64_t total = 0;
+  for(const auto& f : files)
+    total += f.size();
+
+  for(const auto& f : files)
+  {
+    if(total <= maxSize)
+      break;
+
+    // Fails on Windows for the entries currently mapped: they are kept
+    if(QFile::remove(f.absoluteFilePath()))
+      total -= f.size();
+  }
+}
+
+QString entry(const QString& absoluteFilePath, int track, int rate)
+{
+  const auto& folder = cacheFolder();
+  if(folder.isEmpty())
+    return {};
+
+  QFileInfo fi{absoluteFilePath};
+  if(!fi.exists())
+    return {};
+
+  QCryptographicHash h{QCryptographicHash::Sha1};
+  h.addData(fi.canonicalFilePath().toUtf8());
+  h.addData(QByteArray::number(fi.size()));
+  h.addData(QByteArray::number(fi.lastModified().toMSecsSinceEpoch()));
+  h.addData(QByteArray::number(track));
+  h.addData(QByteArray::number(rate));
+  h.addData(QByteArray::number(cache_version));
+
+  return folder + QStringLiteral("/")
+         + QString::fromLatin1(h.result().toHex()) + QStringLiteral(".wav");
+}
+
+void store(const QString& entry, audio_handle data, int rate)
+{
+  if(entry.isEmpty() || !data || data->data.empty() || data->data[0].empty())
+    return;
+
+  const auto& settings = score::GUIAppContext().settings<Audio::Settings::Model>();
+  const int64_t maxSize = int64_t(settings.getDecodedCacheSize()) * 1024 * 1024;
+  const int64_t expected
+      = int64_t(data->data.size()) * int64_t(data->data[0].size()) * sizeof(float);
+  if(expected > maxSize)
+    return;
+
+  score::TaskPool::instance().post([entry, data = std::move(data), rate, expected,
+                                    maxSize] {
+    // Written under a temporary name so that a file being written
+    // or left incomplete after a crash is never picked up.
+    const auto part = entry + QStringLiteral(".part");
+    writeAudioArrayToFile(part, data->data, rate);
+
+    // writeAudioArrayToFile gives up without telling when the disk is full
+    if(QFileInfo{part}.size() < expected)
+    {
+      QFile::remove(part);
+      return;
+    }
+
+    QFile::remove(entry);
+    if(!QFile::rename(part, entry))
+    {
+      QFile::remove(part);
+      return;
+    }
+
+    evict(cacheFolder(), maxSize);
+  });
+}
+
+void used(const QString& entry)
+{
+  // The eviction goes by modification time
+  QFile f{entry};
+  if(f.open(QIODevice::ReadWrite))
+    f.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+}
+
+void invalidate(const QString& entry)
+{
+  qDebug() << "Removing invalid decoded audio cache entry" << entry;
+  QFile::remove(entry);
+}
+}
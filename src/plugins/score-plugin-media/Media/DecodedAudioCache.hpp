@@ -0,0 +1,47 @@
+#pragma once
+#include <Media/AudioArray.hpp>
+
+#include <QString>
+
+#include <score_plugin_media_export.h>
+
+namespace Media
+{
+/**
+ * @brief On-disk cache of the decoded content of compressed audio files.
+ *
+ * Files which have to go through libav (mp3, flac, resampled wav...) are
+ * stored once decoded as 32-bit float .wav files in the cache folder, so that
+ * the next time they are loaded they can be mmapped like any wav file instead
+ * of being decoded again into memory.
+ *
+ * Entries are keyed on the path, size and modification time of the source
+ * file, and on the track and sample rate they were decoded to: a file edited
+ * on disk or a change of the audio settings gives a new entry.
+ *
+ * The size of the folder is bounded by the Audio/DecodedCacheSize setting:
+ * the entries least recently written or loaded are removed past it.
+ */
+namespace DecodedAudioCache
+{
+//! Path of the cache entry for a file decoded at the given rate, or an empty string
+//! if there is no usable cache folder.
+SCORE_PLUGIN_MEDIA_EXPORT
+QString entry(const QString& absoluteFilePath, int track, int rate);
+
+/**
+ * Writes the entry asynchronously, then evicts the oldest entries if the cache
+ * is too large. The data must be fully decoded, and not be modified anymore.
+ */
+SCORE_PLUGIN_MEDIA_EXPORT
+void store(const QString& entry, audio_handle data, int rate);
+
+//! Called when an entry is loaded, so that it is evicted last.
+SCORE_PLUGIN_MEDIA_EXPORT
+void used(const QString& entry);
+
+//! Called when an entry could not be read back.
+SCORE_PLUGIN_MEDIA_EXPORT
+void invalidate(const QString& entry);
+}
+}
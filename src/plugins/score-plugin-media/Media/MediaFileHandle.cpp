@@ -2,6 +2,7 @@
 
 #include <Audio/Settings/Model.hpp>
 #include <Media/AudioDecoder.hpp>
+#include <Media/DecodedAudioCache.hpp>
 #include <Media/RMSData.hpp>
 
 #include <score/application/GUIApplicationContext.hpp>
@@ -126,8 +127,26 @@ void AudioFile::load(DecodingSetup opt)
   switch(opt.method)
   {
     case DecodingMethod::Libav:
+    {
+#if !defined(__EMSCRIPTEN__)
+      if(audioSettings.getDecodedCache())
+      {
+        m_decodedCacheEntry = DecodedAudioCache::entry(m_file, m_track, rate);
+        if(QFile::exists(m_decodedCacheEntry))
+        {
+          qDebug() << "AudioFile::load(): using decoded cache for" << m_file;
+          if(load_drwav(m_decodedCacheEntry))
+          {
+            DecodedAudioCache::used(m_decodedCacheEntry);
+            break;
+          }
+          DecodedAudioCache::invalidate(m_decodedCacheEntry);
+        }
+      }
+#endif
       load_libav(rate);
       break;
+    }
     case DecodingMethod::Mmap:
       load_drwav();
       break;
@@ -233,6 +252,12 @@ const RMSData& AudioFile::rms() const
   return *m_rms;
 }
 
+void AudioFile::raiseDecodingPriority(DecodePriority p)
+{
+  if(auto r = m_impl.target<libav_ptr>())
+    (*r)->decoder.raisePriority(p);
+}
+
 std::optional<double> AudioFile::knownTempo() const noexcept
 {
   auto& db = AudioDecoder::database();
@@ -245,6 +270,9 @@ std::optional<double> AudioFile::knownTempo() const noexcept
 
 AudioFileManager::AudioFileManager() noexcept
 {
+  // Makes sure that the pool outlives the files when the statics are destroyed
+  AudioDecoderPool::instance();
+
   auto& audioSettings = score::GUIAppContext().settings<Audio::Settings::Model>();
   con(audioSettings, &Audio::Settings::Model::RateChanged, this,
       [this](auto newRate) { m_handles.clear(); });
@@ -290,6 +318,26 @@ std::shared_ptr<AudioFile> AudioFileManager::get(const QString& abspath, int str
   return r;
 }
 
+void AudioFileManager::release(std::shared_ptr<AudioFile>& file)
+{
+  auto f = std::move(file);
+  if(!f || f->finishedDecoding())
+    return;
+
+  // The cache and us
+  if(f.use_count() > 2)
+    return;
+
+  for(auto it = m_handles.begin(); it != m_handles.end(); ++it)
+  {
+    if(it->second == f)
+    {
+      m_handles.erase(it);
+      break;
+    }
+  }
+}
+
 AudioFile::ViewHandle::ViewHandle(const AudioFile::Handle& handle)
 {
   struct
@@ -101,6 +101,9 @@ public:
   bool empty() const { return channels() == 0 || samples() == 0; }
   bool finishedDecoding() const noexcept { return m_fullyDecoded; }
 
+  //! Moves the file ahead in the decoding queue if it is still waiting
+  void raiseDecodingPriority(DecodePriority p);
+
   const RMSData& rms() const;
 
   //! Get a copy of the audio array, as 32 bit floats, whatever the input format is
@@ -233,6 +236,7 @@ private:
   void load_libav(int rate);
   void load_libav_stream();
   void load_drwav();
+  bool load_drwav(const QString& path);
   void load_sndfile();
 
   friend class SoundComponentSetup;
@@ -240,6 +244,8 @@ private:
   QString m_originalFile;
   QString m_file;
   QString m_fileName;
+  // Where the decoded data is saved once libav is done, if enabled
+  QString m_decodedCacheEntry;
   int m_track{-1};
 
   RMSData* m_rms{};
@@ -261,6 +267,13 @@ public:
 
   std::shared_ptr<AudioFile> get(const QString& absolutePath, int stream);
 
+  /**
+   * Called by the users of a file when they do not need it anymore.
+   * If nobody else uses it and it is still being decoded, it is dropped from
+   * the cache, which cancels the decoding.
+   */
+  void release(std::shared_ptr<AudioFile>& file);
+
 private:
   struct StreamInfo
   {
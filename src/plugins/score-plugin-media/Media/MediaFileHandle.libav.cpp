@@ -1,3 +1,4 @@
+#include <Media/DecodedAudioCache.hpp>
 #include <Media/MediaFileHandle.hpp>
 #include <Media/RMSData.hpp>
 
@@ -51,7 +52,7 @@ void AudioFile::load_libav(int rate)
 
       connect(
           &r.decoder, &AudioDecoder::finishedDecoding, this,
-          [this] {
+          [this](audio_handle, bool complete) {
         const auto& r = **m_impl.target<std::shared_ptr<LibavReader>>();
         std::vector<std::span<const audio_sample>> samples;
         auto& handle = r.handle->data;
@@ -65,6 +66,10 @@ void AudioFile::load_libav(int rate)
         m_rms->decodeLast(samples);
 
         m_fullyDecoded = true;
+
+        // A failed decode would otherwise be loaded from the cache from now on
+        if(complete && decoded > 0 && !m_decodedCacheEntry.isEmpty())
+          DecodedAudioCache::store(m_decodedCacheEntry, r.handle, m_sampleRate);
         on_finishedDecoding();
           },
           Qt::QueuedConnection);
@@ -13,35 +13,34 @@ void AudioFile::load_drwav()
 {
   qDebug() << "AudioFileHandle::load_drwav(): " << m_file;
 
+  if(!load_drwav(m_file))
+  {
+    qDebug() << "Cannot open file" << m_file;
+    m_impl = Handle{};
+    on_mediaChanged();
+  }
+}
+
+bool AudioFile::load_drwav(const QString& path)
+{
   // Loading with drwav is done when the file can be
   // mmapped directly in to memory.
+  // path is either m_file or its decoded copy in the DecodedAudioCache.
 
   MmapReader r;
   r.file = std::make_shared<QFile>();
-  r.file->setFileName(m_file);
+  r.file->setFileName(path);
 
-  bool ok = r.file->open(QIODevice::ReadOnly);
-  if(!ok)
-  {
-    qDebug() << "Cannot open file" << m_file;
-    m_impl = Handle{};
-    on_mediaChanged();
-  }
+  if(!r.file->open(QIODevice::ReadOnly))
+    return false;
 
   r.data = r.file->map(0, r.file->size());
   if(!r.data)
-  {
-    qDebug() << "Cannot open file" << m_file;
-    m_impl = Handle{};
-    on_mediaChanged();
-  }
+    return false;
+
   r.wav.open_memory(r.data, r.file->size());
   if(!r.wav || r.wav.channels() == 0 || r.wav.sampleRate() == 0)
-  {
-    qDebug() << "Cannot open file" << m_file;
-    m_impl = Handle{};
-    on_mediaChanged();
-  }
+    return false;
 
   m_rms->load(
       m_file, r.wav.channels(), r.wav.sampleRate(),
@@ -52,7 +51,7 @@ void AudioFile::load_drwav()
     m_rms->decode(r.wav);
   }
 
-  QFileInfo fi{*r.file};
+  QFileInfo fi{m_file};
   m_fileName = fi.fileName();
   m_sampleRate = r.wav.sampleRate();
 
@@ -62,6 +61,7 @@ void AudioFile::load_drwav()
   on_mediaChanged();
   on_finishedDecoding();
   qDebug() << "AudioFileHandle::on_mediaChanged(): " << m_file;
+  return true;
 }
 
 std::optional<AudioInfo> probe_drwav(const QFileInfo& fi)
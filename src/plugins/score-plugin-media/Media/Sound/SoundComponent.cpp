@@ -354,6 +354,7 @@ SoundComponent::SoundComponent(
 
   if(auto& file = element.file())
   {
+    file->raiseDecodingPriority(Media::DecodePriority::Playback);
     file->on_finishedDecoding.connect<&SoundComponent::Recomputer::recompute>(
         m_recomputer);
   }
@@ -365,6 +366,7 @@ void SoundComponent::on_fileChanged()
 
   if(auto& file = process().file())
   {
+    file->raiseDecodingPriority(Media::DecodePriority::Playback);
     if(file->finishedDecoding())
     {
       recompute();
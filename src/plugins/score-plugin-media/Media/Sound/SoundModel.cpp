@@ -96,11 +96,19 @@ ProcessModel::ProcessModel(
   connect(&settings, &Audio::Settings::Model::RateChanged, this, &ProcessModel::reload);
 }
 
-ProcessModel::~ProcessModel() { }
+ProcessModel::~ProcessModel()
+{
+  if(m_file)
+  {
+    m_file->on_mediaChanged.disconnect<&ProcessModel::on_mediaChanged>(*this);
+    AudioFileManager::instance().release(m_file);
+  }
+}
 
 void ProcessModel::loadFile(const QString& file, int stream)
 {
   m_file->on_mediaChanged.disconnect<&ProcessModel::on_mediaChanged>(*this);
+  AudioFileManager::instance().release(m_file);
 
   m_userFilePath = file;
   auto& ctx = score::IDocument::documentContext(*this);
@@ -76,6 +76,7 @@ void LayerView::setData(const std::shared_ptr<AudioFile>& data)
   SCORE_ASSERT(data);
 
   m_data = data;
+  m_data->raiseDecodingPriority(DecodePriority::Visible);
   m_numChan = data->channels();
   if(m_data)
   {
@@ -0,0 +1,268 @@
+#include "ThumbnailCache.hpp"
+
+#include <ossia/detail/flicks.hpp>
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QStandardPaths>
+
+#include <algorithm>
+#include <cstring>
+
+namespace Video
+{
+// Bump when the layout of the cached files changes
+static constexpr uint32_t cache_version = 1;
+
+// The timeline never shows more than a few thumbnails per second
+static constexpr int64_t bucket_flicks = 100 * ossia::flicks_per_millisecond<int64_t>;
+
+// Bytes hashed at the beginning and at the end of the video
+static constexpr int64_t hashed_bytes = 64 * 1024;
+
+namespace
+{
+struct Header
+{
+  char magic[4]{'S', 'T', 'H', 'C'};
+  uint32_t version{cache_version};
+  uint32_t width{};
+  uint32_t height{};
+  int64_t bucket{bucket_flicks};
+};
+static_assert(sizeof(Header) == 24);
+}
+
+static QString cacheFolder()
+{
+  static const QString folder = []() -> QString {
+    const auto cache
+        = QStandardPaths::standardLocations(QStandardPaths::StandardLocation::CacheLocation);
+    if(cache.empty())
+      return {};
+
+    QDir dir{cache.first()};
+    if(!dir.mkpath("video-thumbnails") || !dir.cd("video-thumbnails"))
+      return {};
+    return dir.absolutePath();
+  }();
+  return folder;
+}
+
+static QString entry(
+    const QString& folder, const QString& absoluteFilePath, int width, int height,
+    bool exact)
+{
+  if(folder.isEmpty())
+    return {};
+
+  QFile f{absoluteFilePath};
+  if(!f.open(QIODevice::ReadOnly))
+    return {};
+
+  // Hashing the whole video would take longer than decoding its thumbnails:
+  // its size, and its first and last bytes where the containers put their
+  // headers and indexes, tell the files apart well enough.
+  const int64_t size = f.size();
+  QCryptographicHash h{QCryptographicHash::Sha1};
+  h.addData(QByteArray::number(size));
+  h.addData(f.read(hashed_bytes));
+  if(size > 2 * hashed_bytes && f.seek(size - hashed_bytes))
+    h.addData(f.read(hashed_bytes));
+
+  h.addData(QByteArray::number(width));
+  h.addData(QByteArray::number(height));
+  h.addData(QByteArray::number(int(exact)));
+  h.addData(QByteArray::number(cache_version));
+
+  return folder + QStringLiteral("/")
+         + QString::fromLatin1(h.result().toHex()) + QStringLiteral(".thumbs");
+}
+
+ThumbnailCache::ThumbnailCache(
+    const QString& absoluteFilePath, int width, int height, bool exact)
+    : ThumbnailCache{cacheFolder(), absoluteFilePath, width, height, exact}
+{
+}
+
+ThumbnailCache::ThumbnailCache(
+    const QString& folder, const QString& absoluteFilePath, int width, int height,
+    bool exact)
+    : m_width{width}
+    , m_height{height}
+{
+  if(width <= 0 || height <= 0)
+    return;
+
+  if(const auto e = entry(folder, absoluteFilePath, width, height, exact); !e.isEmpty())
+    open(folder, e);
+}
+
+ThumbnailCache::~ThumbnailCache() = default;
+
+int64_t ThumbnailCache::bucket(int64_t flicks) noexcept
+{
+  return std::max(int64_t(0), flicks) / bucket_flicks;
+}
+
+void ThumbnailCache::evict(const QString& folder, int64_t size, const QString& keep)
+{
+  const auto files = QDir{folder}.entryInfoList(
+      {QStringLiteral("*.thumbs")}, QDir::Files, QDir::Time | QDir::Reversed);
+
+  int64_t total = 0;
+  for(const auto& f : files)
+    total += f.size();
+
+  for(const auto& f : files)
+  {
+    if(total <= size)
+      break;
+    if(f.absoluteFilePath() == keep)
+      continue;
+
+    // Fails on Windows for the files currently opened by a thumbnailer: they are kept
+    if(QFile::remove(f.absoluteFilePath()))
+      total -= f.size();
+  }
+}
+
+void ThumbnailCache::open(const QString& folder, const QString& entry)
+{
+  const Header expected{.width = uint32_t(m_width), .height = uint32_t(m_height)};
+  const int64_t recordSize = sizeof(int64_t) + int64_t(m_width) * m_height * 3;
+
+  m_append.setFileName(entry);
+  if(!m_append.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Unbuffered))
+    return;
+  m_file.setFileName(entry);
+  if(!m_file.open(QIODevice::ReadOnly))
+    return;
+
+  int64_t size = m_file.size();
+  Header header;
+  if(size < int64_t(sizeof(Header))
+     || m_file.read(reinterpret_cast<char*>(&header), sizeof(Header)) != sizeof(Header)
+     || std::memcmp(&header, &expected, sizeof(Header)) != 0)
+  {
+    // New file, or written by another version of the cache
+    if(!m_append.resize(0)
+       || m_append.write(reinterpret_cast<const char*>(&expected), sizeof(Header))
+              != sizeof(Header))
+    {
+      qDebug() << "Cannot write the video thumbnail cache" << entry;
+      return;
+    }
+    size = sizeof(Header);
+  }
+
+  // A record cut by a crash or a full disk would shift all the ones after it
+  if(const int64_t extra = (size - int64_t(sizeof(Header))) % recordSize; extra != 0)
+  {
+    size -= extra;
+    if(!m_append.resize(size))
+      return;
+  }
+
+  m_recordSize = recordSize;
+
+  // The eviction goes by modification time: this file is now the most recent
+  m_append.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+  evict(folder, maxSize, QFileInfo{entry}.absoluteFilePath());
+
+  const int64_t count = (size - int64_t(sizeof(Header))) / recordSize;
+  if(count == 0)
+    return;
+
+  m_data = m_file.map(0, size);
+  if(!m_data)
+    return;
+  m_mappedSize = size;
+
+  m_index.reserve(count);
+  for(int64_t i = 0; i < count; i++)
+  {
+    const int64_t offset = sizeof(Header) + i * recordSize;
+    int64_t bucket{};
+    std::memcpy(&bucket, m_data + offset, sizeof(bucket));
+    m_index[bucket] = offset;
+  }
+}
+
+QImage ThumbnailCache::find(int64_t bucket)
+{
+  auto it = m_index.find(bucket);
+  if(it == m_index.end())
+    return {};
+
+  const int64_t offset = it->second;
+  const uchar* record{};
+  QByteArray buffer;
+  if(offset + m_recordSize <= m_mappedSize)
+  {
+    record = m_data + offset;
+  }
+  else
+  {
+    // Appended since the file was mapped
+    if(!m_file.seek(offset))
+      return {};
+    buffer = m_file.read(m_recordSize);
+    if(buffer.size() != m_recordSize)
+      return {};
+    record = reinterpret_cast<const uchar*>(buffer.constData());
+  }
+
+  // Another instance of score may have appended to the same file meanwhile
+  int64_t recordBucket{};
+  std::memcpy(&recordBucket, record, sizeof(recordBucket));
+  if(recordBucket != bucket)
+  {
+    m_index.erase(it);
+    return {};
+  }
+
+  // Copied, as the image outlives the mapping in the timeline
+  QImage img{m_width, m_height, QImage::Format_RGB888};
+  const int line = m_width * 3;
+  const uchar* pixels = record + sizeof(int64_t);
+  for(int y = 0; y < m_height; y++)
+    std::memcpy(img.scanLine(y), pixels + y * line, line);
+  return img;
+}
+
+void ThumbnailCache::store(int64_t bucket, const QImage& img)
+{
+  if(!isValid() || !m_append.isOpen() || m_index.contains(bucket))
+    return;
+  if(img.format() != QImage::Format_RGB888 || img.width() != m_width
+     || img.height() != m_height)
+    return;
+
+  QByteArray record(m_recordSize, Qt::Uninitialized);
+  auto data = reinterpret_cast<uchar*>(record.data());
+  std::memcpy(data, &bucket, sizeof(bucket));
+
+  const int line = m_width * 3;
+  uchar* pixels = data + sizeof(int64_t);
+  for(int y = 0; y < m_height; y++)
+    std::memcpy(pixels + y * line, img.constScanLine(y), line);
+
+  // A single unbuffered write, so that records appended at the same time
+  // by another instance of score do not get interleaved
+  const int64_t offset = m_append.size();
+  if(offset + m_recordSize > maxSize)
+    return;
+  if(m_append.write(record) != m_recordSize)
+  {
+    qDebug() << "Cannot write the video thumbnail cache" << m_append.fileName();
+    m_append.close();
+    return;
+  }
+
+  m_index[bucket] = offset;
+}
+}
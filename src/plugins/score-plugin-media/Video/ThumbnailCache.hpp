@@ -0,0 +1,76 @@
+#pragma once
+#include <ossia/detail/hash_map.hpp>
+
+#include <QFile>
+#include <QImage>
+#include <QString>
+
+#include <score_plugin_media_export.h>
+
+#include <cstdint>
+
+namespace Video
+{
+/**
+ * @brief On-disk cache of the timeline thumbnails of a video file.
+ *
+ * There is one file per video in the cache folder, keyed on a hash of the
+ * content of the video rather than on its path: the same video used in
+ * several projects, or copied elsewhere, shares its thumbnails.
+ * Thumbnails of another size, or decoded in exact mode, go in another file.
+ *
+ * The file is a header followed by fixed-size records: the timestamp bucket
+ * of the thumbnail, then its RGB888 pixels. It is memory-mapped when opened,
+ * and the thumbnails decoded afterwards are appended to it.
+ *
+ * The folder is bounded to maxSize: the files least recently opened or
+ * appended to are removed past it.
+ */
+class SCORE_PLUGIN_MEDIA_EXPORT ThumbnailCache
+{
+public:
+  static constexpr int64_t maxSize = 256 * 1024 * 1024;
+
+  //! Does nothing if there is no usable cache folder
+  ThumbnailCache(const QString& absoluteFilePath, int width, int height, bool exact);
+
+  //! With the cache files in the given folder
+  ThumbnailCache(
+      const QString& folder, const QString& absoluteFilePath, int width, int height,
+      bool exact);
+  ~ThumbnailCache();
+
+  ThumbnailCache(const ThumbnailCache&) = delete;
+  ThumbnailCache& operator=(const ThumbnailCache&) = delete;
+
+  bool isValid() const noexcept { return m_recordSize > 0; }
+
+  //! Thumbnails closer than one bucket in time are the same thumbnail
+  static int64_t bucket(int64_t flicks) noexcept;
+
+  //! Removes the least recently used files until the folder fits in `size`,
+  //! except `keep`.
+  static void evict(const QString& folder, int64_t size, const QString& keep = {});
+
+  //! A null image if the bucket is not in the cache
+  QImage find(int64_t bucket);
+
+  //! The image must be RGB888, of the size given to the constructor
+  void store(int64_t bucket, const QImage& img);
+
+private:
+  void open(const QString& folder, const QString& entry);
+
+  int m_width{};
+  int m_height{};
+  int64_t m_recordSize{};
+
+  QFile m_file;
+  QFile m_append;
+  const uchar* m_data{};
+  int64_t m_mappedSize{};
+
+  // Offset of the record of each bucket in the file
+  ossia::hash_map<int64_t, int64_t> m_index;
+};
+}
@@ -1,6 +1,7 @@
 #include <Media/Libav.hpp>
 #if SCORE_HAS_LIBAV
 
+#include <Video/ThumbnailCache.hpp>
 #include <Video/Thumbnailer.hpp>
 #include <Video/VideoDecoder.hpp>
 
@@ -21,11 +22,14 @@ extern "C" {
 
 #include <wobjectimpl.h>
 
+#include <cstring>
+
 W_OBJECT_IMPL(Video::VideoThumbnailer)
 namespace Video
 {
 
-VideoThumbnailer::VideoThumbnailer(QString path)
+VideoThumbnailer::VideoThumbnailer(QString path, bool exact)
+    : m_exact{exact}
 {
   connect(
       this, &VideoThumbnailer::requestThumbnails, this, &VideoThumbnailer::onRequest,
@@ -107,6 +111,11 @@ VideoThumbnailer::VideoThumbnailer(QString path)
 
       m_codecContext->pkt_timebase = stream->time_base;
       m_codecContext->codec_id = m_codec->id;
+
+      // Only the keyframes are decoded unless we want the exact frame
+      if(!m_exact)
+        m_codecContext->skip_frame = AVDISCARD_NONKEY;
+
       int err = avcodec_open2(m_codecContext, m_codec, nullptr);
       res = !(err < 0);
       if(!res)
@@ -145,6 +154,8 @@ VideoThumbnailer::VideoThumbnailer(QString path)
       av_frame_get_buffer(m_rgb, 0);
 
       fps = av_q2d(stream->avg_frame_rate);
+
+      m_cache = std::make_unique<ThumbnailCache>(path, smallWidth, smallHeight, m_exact);
     }
   }
 }
@@ -184,16 +195,48 @@ void VideoThumbnailer::onRequest(int64_t req, QVector<int64_t> flicks)
   if(!m_codecContext)
     return;
 
-  m_requests = std::move(flicks);
+  m_requests.clear();
   m_requestIndex = req;
   m_currentIndex = 0;
 
+  // What is already in the cache is sent right away, only the rest is decoded
+  for(int64_t f : flicks)
+  {
+    QImage img;
+    if(m_cache && m_cache->isValid())
+      img = m_cache->find(cacheBucket(f));
+
+    if(!img.isNull())
+      thumbnailReady(m_requestIndex, f, std::move(img));
+    else
+      m_requests.push_back(f);
+  }
+
   if(m_currentIndex < m_requests.size())
   {
     ossia::qt::run_async(this, [this] { processNext(); });
   }
 }
 
+int64_t VideoThumbnailer::cacheBucket(int64_t flicks) const noexcept
+{
+#if LIBAVFORMAT_VERSION_INT >= AV_VERSION_INT(58, 78, 100)
+  // All the times between two keyframes give the same thumbnail:
+  // when the container has an index, they share the entry of the keyframe.
+  if(!m_exact)
+  {
+    AVStream* stream = m_formatContext->streams[m_stream];
+    const int64_t ts = flicks * dts_per_flicks;
+    if(auto e = avformat_index_get_entry_from_timestamp(
+           stream, ts, AVSEEK_FLAG_BACKWARD))
+    {
+      return ThumbnailCache::bucket(e->timestamp * flicks_per_dts);
+    }
+  }
+#endif
+  return ThumbnailCache::bucket(flicks);
+}
+
 QImage VideoThumbnailer::process(int64_t flicks)
 {
   AVFramePointer res;
@@ -211,8 +254,12 @@ QImage VideoThumbnailer::process(int64_t flicks)
     AVFramePointer frame{av_frame_alloc()};
     AVPacket* packet = av_packet_alloc();
 
+    // In exact mode the whole group of pictures up to the target may be decoded
+    const int max_attempts = m_exact ? 1024 : 64;
+    const int64_t target_dts = flicks * dts_per_flicks;
+
     int attempts = 0;
-    while(av_read_frame(m_formatContext, packet) >= 0 && attempts < 64)
+    while(av_read_frame(m_formatContext, packet) >= 0 && attempts < max_attempts)
     {
       if(packet->stream_index != m_stream)
       {
@@ -220,6 +267,13 @@ QImage VideoThumbnailer::process(int64_t flicks)
         continue;
       }
 
+      // The decoder would discard them anyway, after parsing them
+      if(!m_exact && !(packet->flags & AV_PKT_FLAG_KEY))
+      {
+        av_packet_unref(packet);
+        continue;
+      }
+
       attempts++;
       int ret = avcodec_send_packet(m_codecContext, packet);
       av_packet_unref(packet);
@@ -229,12 +283,19 @@ QImage VideoThumbnailer::process(int64_t flicks)
       ret = avcodec_receive_frame(m_codecContext, frame.get());
       if(ret == 0)
       {
-        // For thumbnails, accept the first successfully decoded frame.
-        // It will be at or near the requested position (close enough
-        // for a 55px-high thumbnail).
+        // In keyframe mode, accept the first successfully decoded frame:
+        // close enough for a 55px-high thumbnail.
+        const int64_t ts = frame->best_effort_timestamp;
+        if(!m_exact || ts == AV_NOPTS_VALUE || ts >= target_dts)
+        {
+          res = std::move(frame);
+          m_last_dts = res->pkt_dts;
+          break;
+        }
+
+        // Keep the last frame before the target in case we reach the end
         res = std::move(frame);
-        m_last_dts = res->pkt_dts;
-        break;
+        frame.reset(av_frame_alloc());
       }
       else if(ret != AVERROR(EAGAIN))
       {
@@ -248,9 +309,14 @@ QImage VideoThumbnailer::process(int64_t flicks)
   }
 
   // 2. Resize
-  QImage img{QSize(m_rgb->linesize[0] / 3, smallHeight), QImage::Format_RGB888};
-  uint8_t* data[1] = {(uint8_t*)img.bits()};
-  sws_scale(m_rescale, res->data, res->linesize, 0, this->height, data, m_rgb->linesize);
+  sws_scale(
+      m_rescale, res->data, res->linesize, 0, this->height, m_rgb->data,
+      m_rgb->linesize);
+
+  QImage img{smallWidth, smallHeight, QImage::Format_RGB888};
+  for(int y = 0; y < smallHeight; y++)
+    std::memcpy(
+        img.scanLine(y), m_rgb->data[0] + y * m_rgb->linesize[0], smallWidth * 3);
 
   return img;
 }
@@ -265,7 +331,11 @@ void VideoThumbnailer::processNext()
   const auto flicks = m_requests[m_currentIndex];
 
   if(auto img = process(flicks); !img.isNull())
+  {
+    if(m_cache)
+      m_cache->store(cacheBucket(flicks), img);
     thumbnailReady(m_requestIndex, flicks, std::move(img));
+  }
 
   m_currentIndex++;
   if(m_currentIndex < m_requests.size())
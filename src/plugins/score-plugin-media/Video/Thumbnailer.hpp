@@ -15,17 +15,30 @@ extern "C" {
 #include <QObject>
 
 #include <cinttypes>
+#include <memory>
 #include <verdigris>
 
 namespace Video
 {
+class ThumbnailCache;
+
+/**
+ * @brief Decodes the thumbnails shown in the timeline for a video file.
+ *
+ * By default a thumbnail is the keyframe before the requested time, which
+ * only needs a single frame to be decoded. In exact mode, the decoding goes
+ * on from the keyframe up to the requested frame.
+ *
+ * The thumbnails are kept in a ThumbnailCache: the ones already in it are
+ * sent back immediately, before decoding the missing ones.
+ */
 class SCORE_PLUGIN_MEDIA_EXPORT VideoThumbnailer
     : public QObject
     , public VideoMetadata
 {
   W_OBJECT(VideoThumbnailer)
 public:
-  explicit VideoThumbnailer(QString filePath);
+  explicit VideoThumbnailer(QString filePath, bool exact = false);
   ~VideoThumbnailer();
 
   void requestThumbnails(int64_t req, QVector<int64_t> flicks)
@@ -42,6 +55,7 @@ public:
 private:
   void onRequest(int64_t req, QVector<int64_t> flicks);
   void processNext();
+  int64_t cacheBucket(int64_t flicks) const noexcept;
 
   QVector<int64_t> m_requests;
   int64_t m_requestIndex{};
@@ -56,6 +70,9 @@ private:
 
   int m_stream{-1};
   double m_aspect{1.};
+
+  std::unique_ptr<ThumbnailCache> m_cache;
+  bool m_exact{};
 };
 }
 
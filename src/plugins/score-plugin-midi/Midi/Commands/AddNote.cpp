@@ -7,7 +7,6 @@
 #include <Midi/MidiProcess.hpp>
 
 #include <score/model/path/PathSerialization.hpp>
-#include <score/tools/IdentifierGeneration.hpp>
 
 #include <ossia/detail/ssize.hpp>
 
@@ -16,7 +15,7 @@ namespace Midi
 
 AddNote::AddNote(const ProcessModel& model, const NoteData& n)
     : m_model{model}
-    , m_id{getStrongId(model.notes)}
+    , m_id{model.notes.newId()}
     , m_note{n}
 {
 }
@@ -28,8 +27,7 @@ void AddNote::undo(const score::DocumentContext& ctx) const
 
 void AddNote::redo(const score::DocumentContext& ctx) const
 {
-  auto& model = m_model.find(ctx);
-  model.notes.add(new Note{m_id, m_note, &model});
+  m_model.find(ctx).notes.add(m_id, m_note);
 }
 
 void AddNote::serializeImpl(DataStreamInput& s) const
@@ -44,16 +42,17 @@ void AddNote::deserializeImpl(DataStreamOutput& s)
 
 AddNotes::AddNotes(const ProcessModel& model, const std::vector<NoteData>& notes)
     : m_model{model}
-    , m_ids{getStrongIdRange<Note>(notes.size(), model.notes)}
+    , m_ids{model.notes.newIds(notes.size())}
     , m_notes(notes)
 {
 }
 
 void AddNotes::undo(const score::DocumentContext& ctx) const
 {
+  auto& model = m_model.find(ctx);
   for(int i = 0; i < std::ssize(m_ids); i++)
   {
-    m_model.find(ctx).notes.remove(m_ids[i]);
+    model.notes.remove(m_ids[i]);
   }
 }
 
@@ -62,7 +61,7 @@ void AddNotes::redo(const score::DocumentContext& ctx) const
   auto& model = m_model.find(ctx);
   for(int i = 0; i < std::ssize(m_ids); i++)
   {
-    model.notes.add(new Note{m_ids[i], m_notes[i], &model});
+    model.notes.add(m_ids[i], m_notes[i]);
   }
 }
 
@@ -87,12 +86,10 @@ ReplaceNotes::ReplaceNotes(
     , m_olddur{model.duration()}
     , m_newdur{d}
 {
-  for(Note& note : model.notes)
-  {
-    m_old.push_back({note.id(), note.noteData()});
-  }
+  m_old = model.notes.toVector();
 
   int i = 0;
+  m_new.reserve(n.size());
   for(auto& note : n)
     m_new.push_back({Id<Midi::Note>{i++}, note});
 }
@@ -100,13 +97,8 @@ ReplaceNotes::ReplaceNotes(
 void ReplaceNotes::undo(const score::DocumentContext& ctx) const
 {
   auto& model = m_model.find(ctx);
-  model.notes.clear();
   model.setDuration(m_olddur);
-
-  IdContainer<Note> new_notes;
-  for(auto& note : m_old)
-    new_notes.insert(new Note{note.first, note.second, &model});
-  model.notes.replace(std::move(new_notes));
+  model.notes.replace(m_old);
 
   model.setRange(m_oldmin, m_oldmax);
 }
@@ -114,13 +106,8 @@ void ReplaceNotes::undo(const score::DocumentContext& ctx) const
 void ReplaceNotes::redo(const score::DocumentContext& ctx) const
 {
   auto& model = m_model.find(ctx);
-  model.notes.clear();
   model.setDuration(m_newdur);
-
-  IdContainer<Note> new_notes;
-  for(auto& note : m_new)
-    new_notes.insert(new Note{note.first, note.second, &model});
-  model.notes.replace(std::move(new_notes));
+  model.notes.replace(m_new);
 
   model.setRange(m_newmin, m_newmax);
 }
@@ -14,17 +14,15 @@ MoveNotes::MoveNotes(
     double t_delta)
     : m_model{model}
 {
-  // TODO change to indices
   m_before.reserve(to_move.size());
   m_after.reserve(to_move.size());
   for(auto& note_id : to_move)
   {
-    auto& note = model.notes.at(note_id);
-    NoteData data = note.noteData();
-    m_before.push_back(std::make_pair(note.id(), data));
+    NoteData data = model.notes.at(note_id);
+    m_before.push_back(std::make_pair(note_id, data));
     data.m_pitch = qBound(0, data.m_pitch + note_delta, 127);
     data.m_start = std::max(data.m_start + t_delta, 0.);
-    m_after.push_back(std::make_pair(note.id(), data));
+    m_after.push_back(std::make_pair(note_id, data));
   }
 }
 
@@ -33,9 +31,10 @@ void MoveNotes::undo(const score::DocumentContext& ctx) const
   auto& model = m_model.find(ctx);
   for(const auto& note : m_before)
   {
-    auto& n = model.notes.at(note.first);
+    NoteData n = model.notes.at(note.first);
     n.setStart(note.second.start());
     n.setPitch(note.second.pitch());
+    model.notes.update(note.first, n);
   }
   model.notesNeedUpdate();
 }
@@ -45,9 +44,10 @@ void MoveNotes::redo(const score::DocumentContext& ctx) const
   auto& model = m_model.find(ctx);
   for(const auto& note : m_after)
   {
-    auto& n = model.notes.at(note.first);
+    NoteData n = model.notes.at(note.first);
     n.setStart(note.second.start());
     n.setPitch(note.second.pitch());
+    model.notes.update(note.first, n);
   }
   model.notesNeedUpdate();
 }
@@ -80,11 +80,10 @@ ChangeNotesVelocity::ChangeNotesVelocity(
   m_after.reserve(to_move.size());
   for(auto& note_id : to_move)
   {
-    auto& note = model.notes.at(note_id);
-    NoteData data = note.noteData();
-    m_before.push_back(std::make_pair(note.id(), data));
+    NoteData data = model.notes.at(note_id);
+    m_before.push_back(std::make_pair(note_id, data));
     data.m_velocity = qBound(0, int(data.m_velocity + vel_delta), 127);
-    m_after.push_back(std::make_pair(note.id(), data));
+    m_after.push_back(std::make_pair(note_id, data));
   }
 }
 
@@ -93,9 +92,11 @@ void ChangeNotesVelocity::undo(const score::DocumentContext& ctx) const
   auto& model = m_model.find(ctx);
   for(const auto& note : m_before)
   {
-    auto& n = model.notes.at(note.first);
+    NoteData n = model.notes.at(note.first);
     n.setVelocity(note.second.velocity());
+    model.notes.update(note.first, n);
   }
+  model.notesNeedUpdate();
 }
 
 void ChangeNotesVelocity::redo(const score::DocumentContext& ctx) const
@@ -103,9 +104,11 @@ void ChangeNotesVelocity::redo(const score::DocumentContext& ctx) const
   auto& model = m_model.find(ctx);
   for(const auto& note : m_after)
   {
-    auto& n = model.notes.at(note.first);
+    NoteData n = model.notes.at(note.first);
     n.setVelocity(note.second.velocity());
+    model.notes.update(note.first, n);
   }
+  model.notesNeedUpdate();
 }
 
 void ChangeNotesVelocity::update(unused_t, unused_t, double vel_delta)
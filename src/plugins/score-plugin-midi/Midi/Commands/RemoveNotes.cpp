@@ -12,11 +12,10 @@ namespace Midi
 RemoveNotes::RemoveNotes(const ProcessModel& model, const std::vector<Id<Note>>& notes)
     : m_model{model}
 {
+  m_notes.reserve(notes.size());
   for(auto id : notes)
   {
-    auto& note = model.notes.at(id);
-    m_notes.push_back(std::make_pair(
-        id, NoteData{note.start(), note.duration(), note.pitch(), note.velocity()}));
+    m_notes.push_back(std::make_pair(id, model.notes.at(id)));
   }
 }
 
@@ -25,7 +24,7 @@ void RemoveNotes::undo(const score::DocumentContext& ctx) const
   auto& model = m_model.find(ctx);
   for(auto& note : m_notes)
   {
-    model.notes.add(new Note{note.first, note.second, &model});
+    model.notes.add(note.first, note.second);
   }
 }
 
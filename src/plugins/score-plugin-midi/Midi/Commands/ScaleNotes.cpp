@@ -21,9 +21,11 @@ void ScaleNotes::undo(const score::DocumentContext& ctx) const
   auto& model = m_model.find(ctx);
   for(auto& note : m_toScale)
   {
-    auto& n = model.notes.at(note);
+    NoteData n = model.notes.at(note);
     n.setDuration(n.duration() - m_delta);
+    model.notes.update(note, n);
   }
+  model.notesNeedUpdate();
 }
 
 void ScaleNotes::redo(const score::DocumentContext& ctx) const
@@ -31,8 +33,9 @@ void ScaleNotes::redo(const score::DocumentContext& ctx) const
   auto& model = m_model.find(ctx);
   for(auto& note : m_toScale)
   {
-    auto& n = model.notes.at(note);
+    NoteData n = model.notes.at(note);
     n.setDuration(std::max(n.duration() + m_delta, 0.001));
+    model.notes.update(note, n);
   }
   model.notesNeedUpdate();
 }
@@ -51,30 +54,21 @@ RescaleMidi::RescaleMidi(const ProcessModel& model, double delta)
     : m_model{model}
     , m_delta{delta}
 {
-  m_old.reserve(model.notes.size());
-  for(auto& note : model.notes)
-    m_old.push_back({note.id(), note.noteData()});
+  m_old = model.notes.toVector();
 }
 
 void RescaleMidi::undo(const score::DocumentContext& ctx) const
 {
   auto& model = m_model.find(ctx);
-  model.notes.clear();
-  for(auto& note : m_old)
-  {
-    model.notes.add(new Note{note.first, note.second, &model});
-  }
+  model.notes.replace(m_old);
 }
 
 void RescaleMidi::redo(const score::DocumentContext& ctx) const
 {
   auto& model = m_model.find(ctx);
-  for(auto& note : model.notes)
-  {
-    note.setStart(note.start() * m_delta);
-    note.setDuration(note.duration() * m_delta);
-  }
-  model.notesNeedUpdate();
+  // The executor reloads all the notes on notesChanged
+  model.notes.scale(m_delta);
+  model.notesChanged();
 }
 
 void RescaleMidi::serializeImpl(DataStreamInput& s) const
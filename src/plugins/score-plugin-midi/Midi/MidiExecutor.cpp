@@ -16,9 +16,9 @@ static midi_node::note_set to_ossia(Component& c)
   midi_node::note_set notes;
   auto& element = c.process();
   notes.reserve(element.notes.size());
-  for(const auto& n : element.notes)
+  for(std::size_t i = 0; i < element.notes.size(); i++)
   {
-    auto data = n.noteData();
+    auto data = element.notes.data(i);
     if(data.start() < 0 && data.end() > 0)
     {
       data.setStart(0.);
@@ -44,42 +44,34 @@ Component::Component(
 
   element.notes.added.connect<&Component::on_noteAdded>(this);
   element.notes.removing.connect<&Component::on_noteRemoved>(this);
+  element.notes.changed.connect<&Component::on_noteChanged>(this);
   element.notes.replaced.connect<&Component::on_notesReplaced>(this);
 
-  for(auto& note : element.notes)
-  {
-    QObject::connect(
-        &note, &Note::noteChanged, this,
-        [&, midi, cur = to_note(note.noteData())]() mutable {
-      auto old = cur;
-      cur = to_note(note.noteData());
-      in_exec([old, cur, midi] { midi->update_note(old, cur); });
-        });
-  }
-
   QObject::connect(
       &element, &Midi::ProcessModel::notesChanged, this, &Component::on_notesReplaced);
 }
 
 Component::~Component() { }
 
-void Component::on_noteAdded(const Note& n)
+void Component::on_noteAdded(const Id<Note>&, const NoteData& n)
 {
   auto midi = std::dynamic_pointer_cast<midi_node>(node);
-  in_exec([nd = to_note(n.noteData()), midi] { midi->add_note(nd); });
+  in_exec([nd = to_note(n), midi] { midi->add_note(nd); });
+}
 
-  QObject::connect(
-      &n, &Note::noteChanged, this, [&, midi, cur = to_note(n.noteData())]() mutable {
-        auto old = cur;
-        cur = to_note(n.noteData());
-        in_exec([old, cur, midi] { midi->update_note(old, cur); });
-      });
+void Component::on_noteRemoved(const Id<Note>&, const NoteData& n)
+{
+  auto midi = std::dynamic_pointer_cast<midi_node>(node);
+  in_exec([nd = to_note(n), midi] { midi->remove_note(nd); });
 }
 
-void Component::on_noteRemoved(const Note& n)
+void Component::on_noteChanged(
+    const Id<Note>&, const NoteData& old, const NoteData& cur)
 {
   auto midi = std::dynamic_pointer_cast<midi_node>(node);
-  in_exec([nd = to_note(n.noteData()), midi] { midi->remove_note(nd); });
+  in_exec([old = to_note(old), cur = to_note(cur), midi] {
+    midi->update_note(old, cur);
+  });
 }
 
 void Component::on_notesReplaced()
@@ -31,8 +31,9 @@ public:
   Component(Midi::ProcessModel& element, const Execution::Context& ctx, QObject* parent);
   ~Component() override;
 
-  void on_noteAdded(const Midi::Note&);
-  void on_noteRemoved(const Midi::Note&);
+  void on_noteAdded(const Id<Midi::Note>&, const NoteData&);
+  void on_noteRemoved(const Id<Midi::Note>&, const NoteData&);
+  void on_noteChanged(const Id<Midi::Note>&, const NoteData& old, const NoteData& cur);
   void on_notesReplaced();
 
   ossia::nodes::note_data to_note(const NoteData& n);
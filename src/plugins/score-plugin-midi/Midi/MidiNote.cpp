@@ -2,84 +2,41 @@
 // it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
 #include "MidiNote.hpp"
 
+#include <Midi/MidiProcess.hpp>
+
+#include <algorithm>
+
 #include <wobjectimpl.h>
-W_OBJECT_IMPL(Midi::Note)
+W_OBJECT_IMPL(Midi::NoteSelection)
 
 namespace Midi
 {
 
-Note::Note(const Id<Note>& id, QObject* parent)
-    : IdentifiedObject<Note>(id, QStringLiteral("Note"), parent)
+NoteSelection::NoteSelection(ProcessModel& parent)
+    : IdentifiedObject<NoteSelection>{
+        Id<NoteSelection>{0}, QStringLiteral("NoteSelection"), &parent}
 {
 }
 
-Note::Note(const Id<Note>& id, NoteData n, QObject* parent)
-    : IdentifiedObject<Note>(id, QStringLiteral("Note"), parent)
-    , m_start{n.m_start}
-    , m_duration{n.m_duration}
-    , m_pitch{n.m_pitch}
-    , m_velocity{n.m_velocity}
-{
-}
+NoteSelection::~NoteSelection() { }
 
-void Note::scale(double s) noexcept
+const ProcessModel& NoteSelection::process() const noexcept
 {
-  if(s != 1.)
-  {
-    m_start *= s;
-    m_duration *= s;
-    noteChanged();
-  }
+  return *static_cast<const ProcessModel*>(parent());
 }
 
-void Note::setStart(double s) noexcept
+bool NoteSelection::contains(const Id<Note>& id) const noexcept
 {
-  if(m_start != s)
-  {
-    m_start = s;
-    noteChanged();
-  }
-}
-
-void Note::setDuration(double s) noexcept
-{
-  if(m_duration != s)
-  {
-    m_duration = s;
-    noteChanged();
-  }
+  return std::binary_search(m_notes.begin(), m_notes.end(), id);
 }
 
-void Note::setPitch(midi_size_t s) noexcept
+void NoteSelection::setNotes(std::vector<Id<Note>> notes)
 {
-  if(m_pitch != s)
+  std::sort(notes.begin(), notes.end());
+  if(notes != m_notes)
   {
-    m_pitch = s;
-    noteChanged();
+    m_notes = std::move(notes);
+    notesChanged();
   }
 }
-
-void Note::setVelocity(midi_size_t s) noexcept
-{
-  if(m_velocity != s)
-  {
-    m_velocity = s;
-    noteChanged();
-  }
-}
-
-NoteData Note::noteData() const noexcept
-{
-  return NoteData{m_start, m_duration, m_pitch, m_velocity};
-}
-
-void Note::setData(NoteData d) noexcept
-{
-  m_start = d.m_start;
-  m_duration = d.m_duration;
-  m_pitch = d.m_pitch;
-  m_velocity = d.m_velocity;
-
-  noteChanged();
-}
 }
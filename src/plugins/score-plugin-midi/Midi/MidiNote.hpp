@@ -2,8 +2,12 @@
 #include <score/model/IdentifiedObject.hpp>
 #include <score/selection/Selectable.hpp>
 
+#include <score_plugin_midi_export.h>
+
 #include <verdigris>
 
+#include <vector>
+
 namespace Midi
 {
 using midi_size_t = uint8_t;
@@ -46,67 +50,39 @@ struct NoteComparator
   bool operator()(const NoteData& lhs, double rhs) const { return lhs.m_start < rhs; }
 };
 
+//! Tag of the ids of the notes, which are stored in a NoteContainer
+class Note;
+
+class ProcessModel;
+
 /**
- * @brief The Note class
+ * @brief The selected notes of a ProcessModel.
  *
- * TODO rethink the object model.
- * Add a virtual findChild method to Entity.
- * Remove all uses of NamedObject and add IDs everywhere.
- * Allocate the Notes on a vector<Note> and allow them to be copied.
- * Don't allow signals in some way.
+ * Notes are not objects by themselves: this is what stands for them in
+ * the selection of the document, e.g. when copying or removing them.
+ * There is one per process.
  */
-class Note final : public IdentifiedObject<Note>
+class SCORE_PLUGIN_MIDI_EXPORT NoteSelection final
+    : public IdentifiedObject<NoteSelection>
 {
-  W_OBJECT(Note)
-  SCORE_SERIALIZE_FRIENDS
+  W_OBJECT(NoteSelection)
 
 public:
   Selectable selection{this};
 
-  Note(const Id<Note>& id, QObject* parent);
-  Note(const Id<Note>& id, NoteData n, QObject* parent);
-
-  template <IsDeserializer DeserializerVisitor>
-  Note(DeserializerVisitor&& vis, QObject* parent)
-      : IdentifiedObject<Note>{vis, parent}
-  {
-    vis.writeTo(*this);
-  }
-
-  // Both are between 0 - 1, 1 being the process duration.
-
-  double start() const noexcept { return m_start; }
-
-  double duration() const noexcept { return m_duration; }
-
-  double end() const noexcept { return m_start + m_duration; }
-
-  midi_size_t pitch() const noexcept { return m_pitch; }
+  explicit NoteSelection(ProcessModel& parent);
+  ~NoteSelection() override;
 
-  midi_size_t velocity() const noexcept { return m_velocity; }
+  const ProcessModel& process() const noexcept;
 
-  void scale(double s) noexcept;
+  //! Sorted by id
+  const std::vector<Id<Note>>& notes() const noexcept { return m_notes; }
+  bool contains(const Id<Note>& id) const noexcept;
+  void setNotes(std::vector<Id<Note>> notes);
 
-  void setStart(double s) noexcept;
-
-  void setDuration(double s) noexcept;
-
-  void setPitch(midi_size_t s) noexcept;
-
-  void setVelocity(midi_size_t s) noexcept;
-
-  NoteData noteData() const noexcept;
-
-  void setData(NoteData d) noexcept;
-
-public:
-  void noteChanged() W_SIGNAL(noteChanged);
+  void notesChanged() W_SIGNAL(notesChanged);
 
 private:
-  double m_start{};
-  double m_duration{};
-
-  midi_size_t m_pitch{};
-  midi_size_t m_velocity{64};
+  std::vector<Id<Note>> m_notes;
 };
 }
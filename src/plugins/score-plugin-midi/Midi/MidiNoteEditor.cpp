@@ -25,9 +25,11 @@ bool NoteEditor::copy(
     std::vector<Midi::NoteData> noteDataList;
     for(auto item : s)
     {
-      if(auto model = qobject_cast<const Midi::Note*>(item.data()))
+      if(auto sel = qobject_cast<const Midi::NoteSelection*>(item.data()))
       {
-        noteDataList.push_back(model->noteData());
+        const auto& notes = sel->process().notes;
+        for(const auto& id : sel->notes())
+          noteDataList.push_back(notes.at(id));
       }
     }
     if(!noteDataList.empty())
@@ -105,28 +107,18 @@ bool NoteEditor::remove(const Selection& s, const score::DocumentContext& ctx)
 {
   if(!s.empty())
   {
-    std::vector<Id<Note>> noteIdList;
+    const Midi::NoteSelection* sel{};
     for(const auto& item : s)
     {
-      if(auto model = qobject_cast<const Midi::Note*>(item.data()))
-      {
-        if([[maybe_unused]] auto parent
-           = qobject_cast<const Midi::ProcessModel*>(model->parent()))
-        {
-          noteIdList.push_back(model->id());
-        }
-      }
-      else
-      {
+      sel = qobject_cast<const Midi::NoteSelection*>(item.data());
+      if(!sel)
         return false;
-      }
     }
 
-    if(!noteIdList.empty())
+    if(!sel->notes().empty())
     {
-      auto parent = qobject_cast<const Midi::ProcessModel*>(s.begin()->data()->parent());
       CommandDispatcher<>{ctx.commandStack}.submit<Midi::RemoveNotes>(
-          *parent, noteIdList);
+          sel->process(), sel->notes());
       return true;
     }
   }
@@ -8,7 +8,6 @@
 #include <Midi/Commands/RemoveNotes.hpp>
 #include <Midi/Commands/ScaleNotes.hpp>
 #include <Midi/MidiDrop.hpp>
-#include <Midi/MidiNoteView.hpp>
 #include <Midi/MidiPresenter.hpp>
 #include <Midi/MidiProcess.hpp>
 #include <Midi/MidiView.hpp>
@@ -25,10 +24,6 @@
 #include <ossia/detail/algorithms.hpp>
 #include <ossia/detail/math.hpp>
 
-#include <boost/range/adaptor/filtered.hpp>
-#include <boost/range/adaptor/transformed.hpp>
-#include <boost/range/algorithm/copy.hpp>
-
 #include <QAction>
 #include <QApplication>
 #include <QInputDialog>
@@ -53,51 +48,45 @@ Presenter::Presenter(
   auto& model = layer;
 
   con(
-      model, &ProcessModel::durationChanged, this,
-      [&] {
-    for(auto note : m_notes)
-      updateNote(*note);
-      },
+      model, &ProcessModel::durationChanged, this, [this] { m_view->update(); },
       Qt::QueuedConnection);
-  con(model, &ProcessModel::notesNeedUpdate, this, [&] {
-    for(auto note : m_notes)
-      updateNote(*note);
-  });
-
-  con(model, &ProcessModel::notesChanged, this, [&] {
-    for(auto note : m_notes)
-    {
-      delete note;
-    }
-
-    m_notes.clear();
-    m_selectedNotes.clear();
+  con(model, &ProcessModel::notesNeedUpdate, this, [this] { m_view->update(); });
+  con(model, &ProcessModel::notesChanged, this, [this] { m_view->update(); });
 
-    for(auto& note : model.notes)
-    {
-      on_noteAdded(note);
-    }
-  });
-
-  con(model, &ProcessModel::rangeChanged, this, [this](int min, int max) {
-    m_view->setRange(min, max);
-    for(auto note : m_notes)
-      updateNote(*note);
-  });
+  con(model, &ProcessModel::rangeChanged, this,
+      [this](int min, int max) { m_view->setRange(min, max); });
   m_view->setRange(model.range().first, model.range().second);
+  m_view->setNotes(model.notes, *model.noteSelection);
+
   model.notes.added.connect<&Presenter::on_noteAdded>(this);
   model.notes.removing.connect<&Presenter::on_noteRemoving>(this);
+  model.notes.changed.connect<&Presenter::on_noteChanged>(this);
   model.notes.replaced.connect<&Presenter::on_notesReplaced>(this);
 
+  auto& sel = *model.noteSelection;
+  con(sel, &NoteSelection::notesChanged, this, [this] { m_view->update(); });
+  con(sel.selection, &Selectable::changed, this, [&sel](bool ok) {
+    // Something else got selected in the document
+    if(!ok)
+      sel.setNotes({});
+  });
+
   connect(m_view, &View::doubleClicked, this, [&](QPointF pos) {
     CommandDispatcher<>{context().context.commandStack}.submit(
         new AddNote{layer, m_view->noteAtPos(pos)});
   });
 
-  connect(m_view, &View::pressed, this, [&] {
-    for(NoteView* n : m_notes)
-      n->setSelected(false);
-  });
+  connect(m_view, &View::pressed, this, &Presenter::on_deselectOtherNotes);
+  connect(m_view, &View::notePressed, this, &Presenter::on_notePressed);
+  connect(m_view, &View::noteMoved, this, &Presenter::on_noteMoved);
+  connect(m_view, &View::noteMoveFinished, this, &Presenter::on_noteMoveFinished);
+  connect(m_view, &View::noteScaled, this, &Presenter::on_noteScaled);
+  connect(
+      m_view, &View::noteVelocityChanged, this, &Presenter::on_requestVelocityChange);
+  connect(
+      m_view, &View::noteVelocityChangeFinished, this,
+      &Presenter::on_velocityChangeFinished);
+  connect(m_view, &View::selectionAreaChanged, this, &Presenter::selectNotes);
 
   connect(m_view, &View::dropReceived, this, &Presenter::on_drop);
 
@@ -105,11 +94,6 @@ Presenter::Presenter(
     CommandDispatcher<>{context().context.commandStack}.submit(
         new RemoveNotes{this->model(), selectedNotes()});
   });
-
-  for(auto& note : model.notes)
-  {
-    on_noteAdded(note);
-  }
 }
 
 Presenter::~Presenter() { }
@@ -155,15 +139,11 @@ void Presenter::setWidth(qreal val, qreal defaultWidth)
 {
   m_view->setWidth(val);
   m_view->setDefaultWidth(defaultWidth);
-  for(auto note : m_notes)
-    updateNote(*note);
 }
 
 void Presenter::setHeight(qreal val)
 {
   m_view->setHeight(val);
-  for(auto note : m_notes)
-    updateNote(*note);
 }
 
 void Presenter::putToFront()
@@ -180,8 +160,6 @@ void Presenter::on_zoomRatioChanged(ZoomRatio zr)
 {
   m_zr = zr;
   m_view->setDefaultWidth(model().duration().toPixels(m_zr));
-  for(auto note : m_notes)
-    updateNote(*note);
 }
 
 void Presenter::parentGeometryChanged() { }
@@ -198,152 +176,98 @@ const Midi::View& Presenter::view() const noexcept
 
 void Presenter::on_deselectOtherNotes()
 {
-  for(NoteView* n : m_notes)
-    n->setSelected(false);
+  if(!selectedNotes().empty())
+    selectNotes({});
 }
 
-void Presenter::on_noteChanged(NoteView& v)
+void Presenter::on_notePressed(const Id<Note>& note, bool keepSelection)
 {
-  if(!m_origMovePitch)
-  {
-    m_origMovePitch = v.note.pitch();
-    m_origMoveStart = v.note.start();
-  }
+  context().context.focusDispatcher.focus(this);
 
-  const auto [min, max] = this->model().range();
-  auto newPos = v.pos();
-  auto rect = m_view->boundingRect();
-  auto height = rect.height();
-
-  // Snap to grid : we round y to the closest multiple of 127
-  int note = ossia::clamp(
-      int(max
-          - (qMin(rect.bottom(), qMax(newPos.y(), rect.top())) / height)
-                * this->m_view->visibleCount()),
-      min, max);
-
-  auto notes = selectedNotes();
-  auto it = ossia::find(notes, v.note.id());
-  if(it == notes.end())
-  {
-    notes = {v.note.id()};
-  }
+  auto& sel = *model().noteSelection;
+  if(sel.contains(note))
+    return;
 
-  m_moveDispatcher.submit(
-      model(), notes, note - *m_origMovePitch,
-      newPos.x() / m_view->defaultWidth() - *m_origMoveStart);
+  std::vector<Id<Note>> notes;
+  if(keepSelection)
+    notes = sel.notes();
+  notes.push_back(note);
+  selectNotes(std::move(notes));
 }
 
-void Presenter::on_noteChangeFinished(NoteView& v)
+void Presenter::on_noteMoved(const Id<Note>& note, int pitchDelta, double startDelta)
 {
-  on_noteChanged(v);
-  m_moveDispatcher.commit();
-
-  m_origMovePitch = std::nullopt;
-  m_origMoveStart = std::nullopt;
+  m_moveDispatcher.submit(model(), notesToEdit(note), pitchDelta, startDelta);
 }
 
-void Presenter::on_noteScaled(const Note& note, double newScale)
+void Presenter::on_noteMoveFinished()
 {
-  auto notes = selectedNotes();
-  auto it = ossia::find(notes, note.id());
-  if(it == notes.end())
-  {
-    notes = {note.id()};
-  }
+  m_moveDispatcher.commit();
+}
 
-  auto dt = newScale - note.duration();
+void Presenter::on_noteScaled(const Id<Note>& note, double newDuration)
+{
+  auto dt = newDuration - model().notes.at(note).duration();
   CommandDispatcher<>{context().context.commandStack}.submit(
-      new ScaleNotes{model(), notes, dt});
+      new ScaleNotes{model(), notesToEdit(note), dt});
 }
 
-void Presenter::on_requestVelocityChange(const Note& note, double velocityDelta)
+void Presenter::on_requestVelocityChange(const Id<Note>& note, double velocityDelta)
 {
-  auto notes = selectedNotes();
-  auto it = ossia::find(notes, note.id());
-  if(it == notes.end())
-  {
-    notes = {note.id()};
-  }
-
-  m_velocityDispatcher.submit(model(), notes, velocityDelta / 5.);
+  m_velocityDispatcher.submit(model(), notesToEdit(note), velocityDelta / 5.);
 }
 
-void Presenter::on_duplicate() { }
-
 void Presenter::on_velocityChangeFinished()
 {
   m_velocityDispatcher.commit();
 }
 
-void Presenter::on_noteSelectionChanged(NoteView* v, bool ok)
+void Presenter::selectNotes(std::vector<Id<Note>> notes)
 {
-  if(ok)
-    m_selectedNotes.push_back(v);
-  else
-    ossia::remove_erase(m_selectedNotes, v);
+  auto& sel = *model().noteSelection;
+  std::sort(notes.begin(), notes.end());
+  if(notes == sel.notes())
+    return;
 
-  Selection s;
-  for(auto n : m_selectedNotes)
-    s.append(&n->note);
+  sel.setNotes(std::move(notes));
 
+  Selection s;
+  if(!sel.notes().empty())
+    s.append(&sel);
   context().context.selectionStack.pushNewSelection(s);
 }
 
-void Presenter::updateNote(NoteView& v)
+const std::vector<Id<Note>>& Presenter::selectedNotes() const
 {
-  const auto noteRect = v.computeRect();
-  const auto newPos = noteRect.topLeft();
-  if(newPos != v.pos())
-  {
-    v.setPos(newPos);
-  }
-
-  v.setWidth(noteRect.width());
-  v.setHeight(noteRect.height());
+  return model().noteSelection->notes();
 }
 
-void Presenter::on_noteAdded(const Note& n)
+std::vector<Id<Note>> Presenter::notesToEdit(const Id<Note>& note) const
 {
-  auto v = new NoteView{n, *this, m_view};
-  updateNote(*v);
-  m_notes.push_back(v);
+  auto& sel = *model().noteSelection;
+  if(sel.contains(note))
+    return sel.notes();
+  return {note};
 }
 
-void Presenter::on_noteRemoving(const Note& n)
+void Presenter::on_noteAdded(const Id<Note>&, const NoteData&)
 {
-  {
-    auto it = ossia::find_if(
-        m_selectedNotes, [&](const auto& other) { return &other->note == &n; });
+  m_view->update();
+}
 
-    if(it != m_selectedNotes.end())
-    {
-      m_selectedNotes.erase(it);
-    }
-  }
-  {
-    auto it
-        = ossia::find_if(m_notes, [&](const auto& other) { return &other->note == &n; });
+void Presenter::on_noteRemoving(const Id<Note>&, const NoteData&)
+{
+  m_view->update();
+}
 
-    if(it != m_notes.end())
-    {
-      delete *it;
-      m_notes.erase(it);
-    }
-  }
+void Presenter::on_noteChanged(const Id<Note>&, const NoteData&, const NoteData&)
+{
+  m_view->update();
 }
 
 void Presenter::on_notesReplaced()
 {
-  m_selectedNotes.clear();
-  for(auto& n : m_notes)
-    delete n;
-  m_notes.clear();
-
-  for(auto& note : this->model().notes)
-  {
-    on_noteAdded(note);
-  }
+  m_view->update();
 }
 
 void Presenter::on_drop(const QPointF& pos, const QMimeData& md)
@@ -369,16 +293,4 @@ void Presenter::on_drop(const QPointF& pos, const QMimeData& md)
   disp.submit<Midi::ReplaceNotes>(
       model(), track.notes, track.min, track.max, model().duration());
 }
-
-std::vector<Id<Note>> Presenter::selectedNotes() const
-{
-  using namespace boost::adaptors;
-
-  std::vector<Id<Note>> res;
-  boost::copy(
-      m_notes | filtered([](NoteView* v) { return v->isSelected(); })
-          | transformed([](NoteView* v) { return v->note.id(); }),
-      std::back_inserter(res));
-  return res;
-}
 }
@@ -10,7 +10,6 @@
 class QMimeData;
 namespace Midi
 {
-class NoteView;
 class View;
 class Note;
 class Presenter final
@@ -38,33 +37,31 @@ public:
   const Midi::View& view() const noexcept;
 
   void on_deselectOtherNotes();
-  void on_duplicate();
-  void on_noteChanged(NoteView& v);
-  void on_noteChangeFinished(NoteView& v);
-  void on_noteScaled(const Note& note, double newScale);
-  void on_requestVelocityChange(const Note& note, double velocityDelta);
+  void on_notePressed(const Id<Note>& note, bool keepSelection);
+  void on_noteMoved(const Id<Note>& note, int pitchDelta, double startDelta);
+  void on_noteMoveFinished();
+  void on_noteScaled(const Id<Note>& note, double newDuration);
+  void on_requestVelocityChange(const Id<Note>& note, double velocityDelta);
   void on_velocityChangeFinished();
-  void on_noteSelectionChanged(NoteView*, bool ok);
 
 private:
-  void updateNote(NoteView&);
-  void on_noteAdded(const Note&);
-  void on_noteRemoving(const Note&);
+  void on_noteAdded(const Id<Note>&, const NoteData&);
+  void on_noteRemoving(const Id<Note>&, const NoteData&);
+  void on_noteChanged(const Id<Note>&, const NoteData&, const NoteData&);
   void on_notesReplaced();
   void on_drop(const QPointF& pos, const QMimeData&);
 
-  std::vector<Id<Note>> selectedNotes() const;
+  void selectNotes(std::vector<Id<Note>> notes);
+  const std::vector<Id<Note>>& selectedNotes() const;
+
+  //! The selected notes if the note is one of them, else only the note
+  std::vector<Id<Note>> notesToEdit(const Id<Note>& note) const;
 
   View* m_view{};
-  std::vector<NoteView*> m_notes;
-  std::vector<NoteView*> m_selectedNotes;
 
   SingleOngoingCommandDispatcher<MoveNotes> m_moveDispatcher;
   SingleOngoingCommandDispatcher<ChangeNotesVelocity> m_velocityDispatcher;
 
-  std::optional<int> m_origMovePitch{};
-  std::optional<double> m_origMoveStart{};
-
   ZoomRatio m_zr{};
   void fillContextMenu(
       QMenu& menu, QPoint pos, QPointF scenepos,
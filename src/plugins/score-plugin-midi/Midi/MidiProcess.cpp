@@ -5,7 +5,10 @@
 
 #include <Midi/MidiProcess.hpp>
 
-#include <score/model/EntityMapSerialization.hpp>
+#include <score/serialization/DataStreamVisitor.hpp>
+#include <score/serialization/JSONVisitor.hpp>
+
+#include <ossia/detail/algorithms.hpp>
 
 #include <cmath>
 #include <wobjectimpl.h>
@@ -30,10 +33,30 @@ ProcessModel::ProcessModel(
 void ProcessModel::init()
 {
   m_outlets.push_back(outlet.get());
+  noteSelection = new NoteSelection{*this};
+
+  // Notes which are not there anymore cannot stay selected
+  notes.removing.connect<&ProcessModel::on_noteRemoving>(this);
+  notes.replaced.connect<&ProcessModel::on_notesReplaced>(this);
 }
 
 ProcessModel::~ProcessModel() { }
 
+void ProcessModel::on_noteRemoving(const Id<Note>& id, const NoteData&)
+{
+  if(noteSelection->contains(id))
+  {
+    auto sel = noteSelection->notes();
+    ossia::remove_erase(sel, id);
+    noteSelection->setNotes(std::move(sel));
+  }
+}
+
+void ProcessModel::on_notesReplaced()
+{
+  noteSelection->setNotes({});
+}
+
 void ProcessModel::setChannel(int n)
 {
   n = std::clamp(n, 1, 16);
@@ -56,12 +79,12 @@ void ProcessModel::setRange(int min, int max)
     min = 127;
     max = 0;
 
-    for(auto& note : notes)
+    for(midi_size_t pitch : notes.pitches())
     {
-      if(note.pitch() < min)
-        min = note.pitch();
-      if(note.pitch() > max)
-        max = note.pitch();
+      if(pitch < min)
+        min = pitch;
+      if(pitch > max)
+        max = pitch;
     }
   }
   else
@@ -97,8 +120,7 @@ void ProcessModel::setDurationAndGrow(const TimeVal& newDuration) noexcept
     return;
   auto ratio = double(duration().impl) / newDuration.impl;
 
-  for(auto& note : notes)
-    note.scale(ratio);
+  notes.scale(ratio);
 
   notesChanged();
   setDuration(newDuration);
@@ -113,8 +135,7 @@ void ProcessModel::setDurationAndShrink(const TimeVal& newDuration) noexcept
 
   auto ratio = double(duration().impl) / newDuration.impl;
 
-  for(Note& n : notes)
-    n.scale(ratio);
+  notes.scale(ratio);
 
   notesChanged();
   setDuration(newDuration);
@@ -123,9 +144,9 @@ void ProcessModel::setDurationAndShrink(const TimeVal& newDuration) noexcept
 TimeVal ProcessModel::contentDuration() const noexcept
 {
   double end_max{0.};
-  for(const Note& n : notes)
+  for(std::size_t i = 0; i < notes.size(); i++)
   {
-    if(double n_end = n.start() + n.duration(); n_end > end_max)
+    if(double n_end = notes.end(i); n_end > end_max)
     {
       end_max = n_end;
     }
@@ -168,56 +189,26 @@ void JSONWriter::write(Midi::NoteData& n)
   n.m_velocity = arr[3].GetInt();
 }
 
-template <>
-void DataStreamReader::read(const Midi::Note& n)
-{
-  m_stream << n.noteData();
-  insertDelimiter();
-}
-
-template <>
-void DataStreamWriter::write(Midi::Note& n)
-{
-  Midi::NoteData d;
-  m_stream >> d;
-  n.setData(d);
-  checkDelimiter();
-}
-
-template <>
-void JSONReader::read(const Midi::Note& n)
-{
-  stream.Key("Note");
-  stream.StartArray();
-  stream.Double(n.m_start);
-  stream.Double(n.m_duration);
-  stream.Int(n.m_pitch);
-  stream.Int(n.m_velocity);
-  stream.EndArray();
-}
-
-template <>
-void JSONWriter::write(Midi::Note& n)
-{
-  const auto& arr = obj["Note"].toArray();
-  n.m_start = arr[0].GetDouble();
-  n.m_duration = arr[1].GetDouble();
-  n.m_pitch = arr[2].GetInt();
-  n.m_velocity = arr[3].GetInt();
-}
-
 template <>
 void DataStreamReader::read(const Midi::ProcessModel& proc)
 {
   m_stream << *proc.outlet << proc.channel() << proc.m_range.first
            << proc.m_range.second;
 
+  // Same layout as when the notes were identified objects
   const auto& notes = proc.notes;
+  const QString name = QStringLiteral("Note");
 
   m_stream << (int32_t)notes.size();
-  for(const auto& n : notes)
+  for(std::size_t i = 0; i < notes.size(); i++)
   {
-    readFrom(n);
+    SCORE_DEBUG_INSERT_DELIMITER2(*this);
+    m_stream << name;
+    SCORE_DEBUG_INSERT_DELIMITER2(*this);
+    readFrom(notes.id(i));
+    SCORE_DEBUG_INSERT_DELIMITER2(*this);
+    m_stream << notes.data(i);
+    insertDelimiter();
   }
 
   insertDelimiter();
@@ -230,10 +221,24 @@ void DataStreamWriter::write(Midi::ProcessModel& proc)
   m_stream >> proc.m_channel >> proc.m_range.first >> proc.m_range.second;
   int n;
   m_stream >> n;
+
+  std::vector<std::pair<Id<Midi::Note>, Midi::NoteData>> notes;
+  notes.reserve(std::max(0, n));
   for(int i = 0; i < n; i++)
   {
-    proc.notes.add(new Midi::Note{*this, &proc});
+    QString name;
+    Id<Midi::Note> id;
+    Midi::NoteData data;
+    SCORE_DEBUG_CHECK_DELIMITER2(*this);
+    m_stream >> name;
+    SCORE_DEBUG_CHECK_DELIMITER2(*this);
+    writeTo(id);
+    SCORE_DEBUG_CHECK_DELIMITER2(*this);
+    m_stream >> data;
+    checkDelimiter();
+    notes.emplace_back(std::move(id), data);
   }
+  proc.notes.replace(notes);
   checkDelimiter();
 }
 
@@ -244,7 +249,20 @@ void JSONReader::read(const Midi::ProcessModel& proc)
   obj["Channel"] = proc.channel();
   obj["Min"] = proc.range().first;
   obj["Max"] = proc.range().second;
-  obj["Notes"] = proc.notes;
+
+  // Same layout as when the notes were identified objects
+  const auto& notes = proc.notes;
+  stream.Key("Notes");
+  stream.StartArray();
+  for(std::size_t i = 0; i < notes.size(); i++)
+  {
+    stream.StartObject();
+    obj[strings.ObjectName] = QStringLiteral("Note");
+    obj[strings.id] = notes.id(i).val();
+    obj["Note"] = notes.data(i);
+    stream.EndObject();
+  }
+  stream.EndArray();
 }
 
 template <>
@@ -255,10 +273,17 @@ void JSONWriter::write(Midi::ProcessModel& proc)
     proc.outlet = Process::load_midi_outlet(writer, &proc);
   }
 
-  for(const auto& json_vref : obj["Notes"].toArray())
   {
-    auto note = new Midi::Note{JSONObject::Deserializer{json_vref}, &proc};
-    proc.notes.add(note);
+    const auto& arr = obj["Notes"].toArray();
+    std::vector<std::pair<Id<Midi::Note>, Midi::NoteData>> notes;
+    notes.reserve(arr.Size());
+    for(const auto& json_vref : arr)
+    {
+      Midi::NoteData data;
+      JSONWriter{json_vref["Note"]}.writeTo(data);
+      notes.emplace_back(Id<Midi::Note>{json_vref["id"].GetInt()}, data);
+    }
+    proc.notes.replace(notes);
   }
 
   proc.setChannel(obj["Channel"].toInt());
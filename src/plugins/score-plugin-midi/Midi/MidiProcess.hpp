@@ -3,6 +3,7 @@
 
 #include <Midi/MidiNote.hpp>
 #include <Midi/MidiProcessMetadata.hpp>
+#include <Midi/NoteContainer.hpp>
 
 #include <score/tools/Clamp.hpp>
 
@@ -11,7 +12,9 @@
 namespace Midi
 {
 
-class SCORE_PLUGIN_MIDI_EXPORT ProcessModel final : public Process::ProcessModel
+class SCORE_PLUGIN_MIDI_EXPORT ProcessModel final
+    : public Process::ProcessModel
+    , public Nano::Observer
 {
   SCORE_SERIALIZE_FRIENDS
   W_OBJECT(ProcessModel)
@@ -33,7 +36,10 @@ public:
 
   ~ProcessModel() override;
 
-  score::EntityMap<Note> notes;
+  NoteContainer notes;
+
+  //! Owned by the process
+  NoteSelection* noteSelection{};
 
   void setChannel(int n);
   int channel() const;
@@ -54,6 +60,9 @@ public:
   void rangeChanged(int arg_1, int arg_2) W_SIGNAL(rangeChanged, arg_1, arg_2);
 
 private:
+  void on_noteRemoving(const Id<Note>& id, const NoteData&);
+  void on_notesReplaced();
+
   TimeVal contentDuration() const noexcept override;
   void setDurationAndScale(const TimeVal& newDuration) noexcept override;
   void setDurationAndGrow(const TimeVal& newDuration) noexcept override;
@@ -6,14 +6,20 @@
 
 #include <score/graphics/GraphicsItem.hpp>
 
+#include <score/model/Skin.hpp>
+
 #include <QApplication>
 #include <QGraphicsScene>
 #include <QGraphicsSceneContextMenuEvent>
+#include <QGraphicsSceneHoverEvent>
 #include <QGraphicsSceneMouseEvent>
 #include <QGraphicsView>
 #include <QKeyEvent>
 #include <QPainter>
 
+#include <algorithm>
+#include <cmath>
+
 #include <wobjectimpl.h>
 W_OBJECT_IMPL(Midi::View)
 namespace Midi
@@ -33,6 +39,13 @@ View::View(QGraphicsItem* parent)
 
 View::~View() { }
 
+void View::setNotes(const NoteContainer& notes, const NoteSelection& selection)
+{
+  m_notes = &notes;
+  m_selection = &selection;
+  update();
+}
+
 void View::heightChanged(qreal h)
 {
   updateBackground(h);
@@ -154,9 +167,6 @@ void View::setDefaultWidth(double w)
 {
   m_defaultW = w;
   update();
-  const auto& children = childItems();
-  for(auto cld : children)
-    cld->update();
 }
 
 void View::setRange(int min, int max)
@@ -220,6 +230,8 @@ void View::paint_impl(QPainter* p) const
       }
     }
   }
+  paintNotes(*p);
+
   if(!m_selectArea.isEmpty())
   {
     p->setBrush(style.transparentBrush);
@@ -230,9 +242,28 @@ void View::paint_impl(QPainter* p) const
 
 void View::mousePressEvent(QGraphicsSceneMouseEvent* ev)
 {
+  m_action = None;
   if(canEdit())
   {
-    pressed(ev->scenePos());
+    if(const auto i = noteAt(ev->pos()); i != -1)
+    {
+      const auto mods = ev->modifiers();
+      m_pressedNote = m_notes->id(i);
+      m_pressedRect = noteRect(i);
+      notePressed(m_pressedNote, bool(mods & Qt::ControlModifier));
+
+      if(ev->pos().x() >= m_pressedRect.right() - 2)
+        m_action = Scale;
+      else if(mods & Qt::ShiftModifier)
+        m_action = ChangeVelocity;
+      else
+        m_action = Move;
+    }
+    else
+    {
+      m_action = Select;
+      pressed(ev->scenePos());
+    }
   }
   ev->accept();
 }
@@ -241,12 +272,40 @@ void View::mouseMoveEvent(QGraphicsSceneMouseEvent* ev)
 {
   if(canEdit())
   {
-    QPainterPath p;
-    p.addRect(QRectF{ev->buttonDownPos(Qt::LeftButton), ev->pos()});
-    this->scene()->setSelectionArea(mapToScene(p));
-
-    m_selectArea = p;
-    update();
+    const auto delta = ev->scenePos() - ev->buttonDownScenePos(Qt::LeftButton);
+    switch(m_action)
+    {
+      case Select: {
+        QPainterPath p;
+        p.addRect(QRectF{ev->buttonDownPos(Qt::LeftButton), ev->pos()});
+        m_selectArea = p;
+
+        const auto area = p.boundingRect();
+        std::vector<Id<Note>> notes;
+        for(std::size_t i = 0; i < m_notes->size(); i++)
+          if(noteRect(i).intersects(area))
+            notes.push_back(m_notes->id(i));
+        selectionAreaChanged(std::move(notes));
+
+        update();
+        break;
+      }
+      case Move: {
+        const double y = m_pressedRect.center().y();
+        noteMoved(
+            m_pressedNote, pitchAt(y + delta.y()) - pitchAt(y), delta.x() / m_defaultW);
+        break;
+      }
+      case Scale:
+        m_scaledWidth = std::max(2., ev->pos().x() - m_pressedRect.left());
+        update();
+        break;
+      case ChangeVelocity:
+        noteVelocityChanged(m_pressedNote, -delta.y());
+        break;
+      case None:
+        break;
+    }
   }
   ev->accept();
 }
@@ -255,9 +314,42 @@ void View::mouseReleaseEvent(QGraphicsSceneMouseEvent* ev)
 {
   if(canEdit())
   {
-    m_selectArea = {};
-    update();
+    const auto delta = ev->scenePos() - ev->buttonDownScenePos(Qt::LeftButton);
+    switch(m_action)
+    {
+      case Select:
+        m_selectArea = {};
+        update();
+        break;
+      case Move:
+        if(delta != QPointF{})
+        {
+          const double y = m_pressedRect.center().y();
+          noteMoved(
+              m_pressedNote, pitchAt(y + delta.y()) - pitchAt(y),
+              delta.x() / m_defaultW);
+        }
+        noteMoveFinished();
+        break;
+      case Scale:
+        if(delta != QPointF{})
+        {
+          noteScaled(
+              m_pressedNote,
+              std::max(2., ev->pos().x() - m_pressedRect.left()) / m_defaultW);
+        }
+        m_scaledWidth = -1.;
+        update();
+        break;
+      case ChangeVelocity:
+        noteVelocityChanged(m_pressedNote, -delta.y());
+        noteVelocityChangeFinished();
+        break;
+      case None:
+        break;
+    }
   }
+  m_action = None;
   ev->accept();
 }
 
@@ -270,6 +362,28 @@ void View::mouseDoubleClickEvent(QGraphicsSceneMouseEvent* ev)
   ev->accept();
 }
 
+void View::hoverMoveEvent(QGraphicsSceneHoverEvent* ev)
+{
+  auto& skin = score::Skin::instance();
+  const auto i = canEdit() ? noteAt(ev->pos()) : -1;
+  if(i == -1)
+    unsetCursor();
+  else if(ev->pos().x() >= noteRect(i).right() - 2)
+    setCursor(skin.CursorScaleH);
+  else if(ev->modifiers() == Qt::ShiftModifier)
+    setCursor(skin.CursorSpin);
+  else
+    setCursor(Qt::ArrowCursor);
+
+  Process::LayerView::hoverMoveEvent(ev);
+}
+
+void View::hoverLeaveEvent(QGraphicsSceneHoverEvent* ev)
+{
+  unsetCursor();
+  Process::LayerView::hoverLeaveEvent(ev);
+}
+
 void View::keyPressEvent(QKeyEvent* ev)
 {
   ev->accept();
@@ -283,26 +397,241 @@ void View::dropEvent(QGraphicsSceneDragDropEvent* event)
 
 NoteData View::noteAtPos(QPointF point) const
 {
-  const auto rect = boundingRect();
-
   NoteData n;
   n.m_start = std::max(0., point.x() / m_defaultW);
   n.m_duration = 0.1;
-  n.m_pitch = qBound(
+  n.m_pitch = pitchAt(point.y());
+
+  n.m_velocity = 127.;
+  return n;
+}
+
+int View::visibleCount() const
+{
+  return m_max - m_min + 1;
+}
+
+int View::pitchAt(double y) const noexcept
+{
+  const auto rect = boundingRect();
+  return qBound(
       m_min,
       1
           + int(
               m_max
-              - (qMin(rect.bottom(), qMax(point.y(), rect.top())) / rect.height())
+              - (qMin(rect.bottom(), qMax(y, rect.top())) / rect.height())
                     * visibleCount()),
       m_max);
+}
 
-  n.m_velocity = 127.;
-  return n;
+double View::noteHeight() const noexcept
+{
+  return height() / visibleCount();
 }
 
-int View::visibleCount() const
+QRectF View::noteRect(std::size_t i) const noexcept
 {
-  return m_max - m_min + 1;
+  const auto h = height();
+  const auto note_height = noteHeight();
+  return {
+      m_notes->start(i) * m_defaultW,
+      h - std::ceil((m_notes->pitch(i) - m_min + 1) * note_height),
+      m_notes->duration(i) * m_defaultW, note_height};
+}
+
+int64_t View::noteAt(QPointF pos) const noexcept
+{
+  if(!m_notes)
+    return -1;
+
+  // Thin notes are drawn as lines, but can still be grabbed
+  const auto hit = [&](std::size_t i) {
+    auto r = noteRect(i);
+    r.setWidth(std::max(r.width(), 3.));
+    return r.contains(pos);
+  };
+
+  // The selected notes are drawn on top of the others
+  for(const auto& id : m_selection->notes())
+    if(const auto i = m_notes->index(id); i != -1 && hit(i))
+      return i;
+
+  for(int64_t i = int64_t(m_notes->size()) - 1; i >= 0; i--)
+    if(hit(i))
+      return i;
+  return -1;
+}
+
+std::pair<double, double> View::visibleRange() const noexcept
+{
+  double left = 0.;
+  double right = width();
+  if(auto v = getView(*this))
+  {
+    left = std::max(left, mapFromScene(v->mapToScene(0, 0)).x());
+    right = std::min(right, mapFromScene(v->mapToScene(v->width(), 0)).x());
+  }
+  return {left, right};
+}
+
+void View::paintNotes(QPainter& p) const
+{
+  if(!m_notes || m_notes->empty())
+    return;
+
+  const auto [left, right] = visibleRange();
+  if(right <= left)
+    return;
+
+  const auto starts = m_notes->starts();
+  const auto durations = m_notes->durations();
+  const auto pitches = m_notes->pitches();
+  const auto velocities = m_notes->velocities();
+  const double w = m_defaultW;
+  const bool hasSelection = !m_selection->notes().empty();
+
+  // When there are more notes than pixels, individual rectangles
+  // are indistinguishable anyways: draw how dense each pitch is instead.
+  std::size_t visible = 0;
+  for(std::size_t i = 0; i < starts.size(); i++)
+  {
+    if((starts[i] + durations[i]) * w >= left && starts[i] * w <= right
+       && pitches[i] >= m_min && pitches[i] <= m_max)
+      visible++;
+  }
+  if(visible == 0)
+    return;
+
+  if(visible > 2 * (right - left))
+  {
+    paintDensity(p, left, right);
+    return;
+  }
+
+  p.setRenderHint(QPainter::Antialiasing, false);
+
+  const double h = height();
+  const double note_height = noteHeight();
+  for(auto& rects : m_noteRects)
+    rects.clear();
+  m_noteLines.clear();
+
+  for(std::size_t i = 0; i < starts.size(); i++)
+  {
+    const double x0 = starts[i] * w;
+    const double x1 = x0 + durations[i] * w;
+    if(x1 < left || x0 > right || pitches[i] < m_min || pitches[i] > m_max)
+      continue;
+    if(hasSelection && m_selection->contains(m_notes->id(i)))
+      continue;
+
+    const double y = h - std::ceil((pitches[i] - m_min + 1) * note_height);
+    if(x1 - x0 <= 1.2)
+      m_noteLines.emplace_back(x0, y, x0, y + note_height - 1.5);
+    else
+      m_noteRects[velocities[i]].emplace_back(x0, y, x1 - x0, note_height);
+  }
+
+  p.setPen(Qt::NoPen);
+  for(std::size_t v = 0; v < m_noteRects.size(); v++)
+  {
+    if(const auto& rects = m_noteRects[v]; !rects.empty())
+    {
+      p.setBrush(style.paintedNoteBrush[v]);
+      p.drawRects(rects.data(), int(rects.size()));
+    }
+  }
+
+  if(!m_noteLines.empty())
+  {
+    p.setPen(style.noteBasePen);
+    p.drawLines(m_noteLines.data(), int(m_noteLines.size()));
+  }
+
+  // Selected notes, on top of the others
+  p.setPen(style.noteSelectedBasePen);
+  for(const auto& id : m_selection->notes())
+  {
+    const auto i = m_notes->index(id);
+    if(i == -1)
+      continue;
+
+    auto rect = noteRect(i);
+    if(m_action == Scale && m_scaledWidth >= 0. && id == m_pressedNote)
+      rect.setWidth(m_scaledWidth);
+
+    if(rect.right() < left || rect.left() > right)
+      continue;
+
+    if(rect.width() <= 1.2)
+    {
+      p.drawLine(QLineF{rect.left(), rect.top(), rect.left(), rect.bottom() - 1.5});
+    }
+    else
+    {
+      p.setBrush(style.paintedNoteBrush[velocities[i]]);
+      p.drawRect(rect);
+    }
+  }
+}
+
+void View::paintDensity(QPainter& p, double left, double right) const
+{
+  // One cell per pixel column and pitch, holding the loudest note in it
+  const int cols = std::ceil(right - left);
+  const int rows = visibleCount();
+  m_densityCells.assign(std::size_t(cols) * rows, 0);
+
+  // 0 for no note, velocity + 1 otherwise, 255 for a selected note
+  static constexpr uint8_t selected_cell = 255;
+  const auto starts = m_notes->starts();
+  const auto durations = m_notes->durations();
+  const auto pitches = m_notes->pitches();
+  const auto velocities = m_notes->velocities();
+  const bool hasSelection = !m_selection->notes().empty();
+  const double w = m_defaultW;
+
+  for(std::size_t i = 0; i < starts.size(); i++)
+  {
+    const double x0 = starts[i] * w - left;
+    const double x1 = x0 + durations[i] * w;
+    if(x1 < 0. || x0 > cols || pitches[i] < m_min || pitches[i] > m_max)
+      continue;
+
+    const int c0 = std::clamp(int(x0), 0, cols - 1);
+    const int c1 = std::clamp(int(std::ceil(x1)), c0 + 1, cols);
+    const uint8_t cell = hasSelection && m_selection->contains(m_notes->id(i))
+                             ? selected_cell
+                             : uint8_t(velocities[i] + 1);
+
+    uint8_t* row = m_densityCells.data() + std::size_t(m_max - pitches[i]) * cols;
+    for(int c = c0; c < c1; c++)
+      row[c] = std::max(row[c], cell);
+  }
+
+  static const auto palette = [] {
+    std::array<QRgb, 256> colors{};
+    for(std::size_t v = 0; v < 128; v++)
+      colors[v + 1] = style.paintedNoteBrush[v].color().rgba();
+    colors[selected_cell] = style.noteSelectedBasePen.color().rgba();
+    return colors;
+  }();
+
+  if(m_density.width() != cols || m_density.height() != rows)
+    m_density = QImage{cols, rows, QImage::Format_ARGB32_Premultiplied};
+
+  for(int r = 0; r < rows; r++)
+  {
+    auto line = reinterpret_cast<QRgb*>(m_density.scanLine(r));
+    const uint8_t* cells = m_densityCells.data() + std::size_t(r) * cols;
+    for(int c = 0; c < cols; c++)
+      line[c] = palette[cells[c]];
+  }
+
+  // Same vertical layout as the rectangles of the detailed mode
+  const double h = height();
+  const double note_height = noteHeight();
+  const double top = h - std::ceil(rows * note_height);
+  p.drawImage(QRectF{left, top, double(cols), h - top}, m_density);
 }
 }
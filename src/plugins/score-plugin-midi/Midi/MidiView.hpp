@@ -3,14 +3,25 @@
 
 #include <Midi/MidiProcess.hpp>
 
+#include <QImage>
 #include <QPainter>
 #include <QPainterPath>
 
 #include <verdigris>
 
+#include <array>
+
+W_REGISTER_ARGTYPE(Id<Midi::Note>)
+W_REGISTER_ARGTYPE(std::vector<Id<Midi::Note>>)
+
 namespace Midi
 {
-class NoteView;
+/**
+ * @brief The piano roll.
+ *
+ * The notes are not items by themselves: they are drawn, hit-tested and
+ * dragged by the view, straight from the arrays of the NoteContainer.
+ */
 class View final : public Process::LayerView
 {
   W_OBJECT(View)
@@ -21,6 +32,8 @@ public:
   double defaultWidth() const noexcept { return m_defaultW; }
   void setDefaultWidth(double w);
 
+  void setNotes(const NoteContainer& notes, const NoteSelection& selection);
+
   void setRange(int, int);
   std::pair<int, int> range() const { return {m_min, m_max}; }
   NoteData noteAtPos(QPointF point) const;
@@ -29,6 +42,19 @@ public:
 public:
   void deleteRequested() W_SIGNAL(deleteRequested);
 
+  void notePressed(Id<Midi::Note> id, bool keepSelection)
+      W_SIGNAL(notePressed, id, keepSelection);
+  void noteMoved(Id<Midi::Note> id, int pitchDelta, double startDelta)
+      W_SIGNAL(noteMoved, id, pitchDelta, startDelta);
+  void noteMoveFinished() W_SIGNAL(noteMoveFinished);
+  void noteScaled(Id<Midi::Note> id, double newDuration)
+      W_SIGNAL(noteScaled, id, newDuration);
+  void noteVelocityChanged(Id<Midi::Note> id, double velocityDelta)
+      W_SIGNAL(noteVelocityChanged, id, velocityDelta);
+  void noteVelocityChangeFinished() W_SIGNAL(noteVelocityChangeFinished);
+  void selectionAreaChanged(std::vector<Id<Midi::Note>> notes)
+      W_SIGNAL(selectionAreaChanged, notes);
+
 private:
   bool canEdit() const;
   void paint_impl(QPainter*) const override;
@@ -38,11 +64,38 @@ private:
   void mouseMoveEvent(QGraphicsSceneMouseEvent*) override;
   void mouseReleaseEvent(QGraphicsSceneMouseEvent*) override;
   void mouseDoubleClickEvent(QGraphicsSceneMouseEvent*) override;
+  void hoverMoveEvent(QGraphicsSceneHoverEvent*) override;
+  void hoverLeaveEvent(QGraphicsSceneHoverEvent*) override;
   void keyPressEvent(QKeyEvent*) override;
   void dropEvent(QGraphicsSceneDragDropEvent* event) override;
 
   void updateBackground(double height);
 
+  double noteHeight() const noexcept;
+  QRectF noteRect(std::size_t i) const noexcept;
+  //! Index of the topmost note under the point, -1 if none
+  int64_t noteAt(QPointF pos) const noexcept;
+  int pitchAt(double y) const noexcept;
+  std::pair<double, double> visibleRange() const noexcept;
+
+  void paintNotes(QPainter& p) const;
+  void paintDensity(QPainter& p, double left, double right) const;
+
+  const NoteContainer* m_notes{};
+  const NoteSelection* m_selection{};
+
+  enum Action
+  {
+    None,
+    Select,
+    Move,
+    Scale,
+    ChangeVelocity
+  } m_action{};
+  Id<Note> m_pressedNote;
+  QRectF m_pressedRect;
+  double m_scaledWidth{-1.};
+
   QPainterPath m_selectArea;
   double m_defaultW; // Covers the [ 0; 1 ] area
   int m_min{0}, m_max{127};
@@ -51,5 +104,11 @@ private:
   QPixmap m_bgCache;
 
   mutable std::vector<QPainter::PixmapFragment> m_fragmentCache;
+
+  // Reused across paints: one batch of rectangles per velocity brush
+  mutable std::array<std::vector<QRectF>, 128> m_noteRects;
+  mutable std::vector<QLineF> m_noteLines;
+  mutable std::vector<uint8_t> m_densityCells;
+  mutable QImage m_density;
 };
 }
@@ -0,0 +1,154 @@
+#include "NoteContainer.hpp"
+
+#include <score/tools/Debug.hpp>
+
+#include <algorithm>
+
+namespace Midi
+{
+int64_t NoteContainer::index(const id_type& id) const noexcept
+{
+  if(auto it = m_index.find(id.val()); it != m_index.end())
+    return it->second;
+  return -1;
+}
+
+NoteData NoteContainer::at(const id_type& id) const noexcept
+{
+  const auto i = index(id);
+  SCORE_ASSERT(i != -1);
+  return data(i);
+}
+
+NoteContainer::id_type NoteContainer::newId() const noexcept
+{
+  return id_type{m_maxId + 1};
+}
+
+std::vector<NoteContainer::id_type> NoteContainer::newIds(std::size_t count) const
+{
+  std::vector<id_type> ids;
+  ids.reserve(count);
+  for(std::size_t i = 0; i < count; i++)
+    ids.emplace_back(m_maxId + 1 + int32_t(i));
+  return ids;
+}
+
+void NoteContainer::reserve(std::size_t n)
+{
+  m_ids.reserve(n);
+  m_start.reserve(n);
+  m_duration.reserve(n);
+  m_pitch.reserve(n);
+  m_velocity.reserve(n);
+  m_index.reserve(n);
+}
+
+void NoteContainer::push(const id_type& id, const NoteData& n)
+{
+  const int32_t v = id.val();
+  SCORE_ASSERT(m_index.find(v) == m_index.end());
+
+  m_index[v] = int32_t(m_ids.size());
+  m_ids.push_back(v);
+  m_start.push_back(n.m_start);
+  m_duration.push_back(n.m_duration);
+  m_pitch.push_back(n.m_pitch);
+  m_velocity.push_back(n.m_velocity);
+  m_maxId = std::max(m_maxId, v);
+}
+
+void NoteContainer::add(const id_type& id, const NoteData& n)
+{
+  push(id, n);
+  added(id, n);
+}
+
+void NoteContainer::remove(const id_type& id)
+{
+  const auto i = index(id);
+  if(i == -1)
+    return;
+
+  removing(id, data(i));
+
+  // The last note takes the place of the removed one
+  const auto last = int64_t(m_ids.size()) - 1;
+  if(i != last)
+  {
+    m_ids[i] = m_ids[last];
+    m_start[i] = m_start[last];
+    m_duration[i] = m_duration[last];
+    m_pitch[i] = m_pitch[last];
+    m_velocity[i] = m_velocity[last];
+    m_index[m_ids[i]] = int32_t(i);
+  }
+
+  m_ids.pop_back();
+  m_start.pop_back();
+  m_duration.pop_back();
+  m_pitch.pop_back();
+  m_velocity.pop_back();
+  m_index.erase(id.val());
+}
+
+void NoteContainer::update(const id_type& id, const NoteData& n)
+{
+  const auto i = index(id);
+  if(i == -1)
+    return;
+
+  const NoteData old = data(i);
+  if(old.m_start == n.m_start && old.m_duration == n.m_duration
+     && old.m_pitch == n.m_pitch && old.m_velocity == n.m_velocity)
+    return;
+
+  m_start[i] = n.m_start;
+  m_duration[i] = n.m_duration;
+  m_pitch[i] = n.m_pitch;
+  m_velocity[i] = n.m_velocity;
+  changed(id, old, n);
+}
+
+void NoteContainer::scale(double ratio) noexcept
+{
+  if(ratio == 1.)
+    return;
+
+  for(auto& s : m_start)
+    s *= ratio;
+  for(auto& d : m_duration)
+    d *= ratio;
+}
+
+void NoteContainer::replace(const std::vector<std::pair<id_type, NoteData>>& notes)
+{
+  m_ids.clear();
+  m_start.clear();
+  m_duration.clear();
+  m_pitch.clear();
+  m_velocity.clear();
+  m_index.clear();
+  m_maxId = 0;
+
+  reserve(notes.size());
+  for(const auto& [id, n] : notes)
+    push(id, n);
+
+  replaced();
+}
+
+void NoteContainer::clear()
+{
+  replace({});
+}
+
+std::vector<std::pair<NoteContainer::id_type, NoteData>> NoteContainer::toVector() const
+{
+  std::vector<std::pair<id_type, NoteData>> res;
+  res.reserve(size());
+  for(std::size_t i = 0; i < size(); i++)
+    res.emplace_back(id(i), data(i));
+  return res;
+}
+}
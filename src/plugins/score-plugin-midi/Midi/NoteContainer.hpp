@@ -0,0 +1,98 @@
+#pragma once
+#include <Midi/MidiNote.hpp>
+
+#include <ossia/detail/hash_map.hpp>
+
+#include <nano_signal_slot.hpp>
+#include <score_plugin_midi_export.h>
+
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace Midi
+{
+/**
+ * @brief The notes of a ProcessModel, as a structure of arrays.
+ *
+ * Each field of the notes is stored contiguously, so that e.g. the
+ * piano roll can cull the notes out of the view by only going through
+ * their start and duration, and notes are cheap to store by the thousands.
+ *
+ * A note is referred to by its index for iteration, and by its id
+ * everywhere else (commands, selection): the ids are stable, the
+ * indices change when a note is removed.
+ */
+class SCORE_PLUGIN_MIDI_EXPORT NoteContainer
+{
+public:
+  using id_type = Id<Note>;
+
+  std::size_t size() const noexcept { return m_ids.size(); }
+  bool empty() const noexcept { return m_ids.empty(); }
+
+  id_type id(std::size_t i) const noexcept { return id_type{m_ids[i]}; }
+  double start(std::size_t i) const noexcept { return m_start[i]; }
+  double duration(std::size_t i) const noexcept { return m_duration[i]; }
+  double end(std::size_t i) const noexcept { return m_start[i] + m_duration[i]; }
+  midi_size_t pitch(std::size_t i) const noexcept { return m_pitch[i]; }
+  midi_size_t velocity(std::size_t i) const noexcept { return m_velocity[i]; }
+  NoteData data(std::size_t i) const noexcept
+  {
+    return NoteData{m_start[i], m_duration[i], m_pitch[i], m_velocity[i]};
+  }
+
+  std::span<const double> starts() const noexcept { return m_start; }
+  std::span<const double> durations() const noexcept { return m_duration; }
+  std::span<const midi_size_t> pitches() const noexcept { return m_pitch; }
+  std::span<const midi_size_t> velocities() const noexcept { return m_velocity; }
+
+  //! -1 if there is no such note
+  int64_t index(const id_type& id) const noexcept;
+  bool contains(const id_type& id) const noexcept { return index(id) != -1; }
+
+  //! The note must exist
+  NoteData at(const id_type& id) const noexcept;
+
+  //! Ids which are not in the container yet
+  id_type newId() const noexcept;
+  std::vector<id_type> newIds(std::size_t count) const;
+
+  void reserve(std::size_t n);
+
+  void add(const id_type& id, const NoteData& n);
+  void remove(const id_type& id);
+
+  //! Does nothing if the data did not change
+  void update(const id_type& id, const NoteData& n);
+
+  //! Without notification: the callers tell when they are done, see ProcessModel
+  void scale(double ratio) noexcept;
+
+  void replace(const std::vector<std::pair<id_type, NoteData>>& notes);
+  void clear();
+
+  std::vector<std::pair<id_type, NoteData>> toVector() const;
+
+  mutable Nano::Signal<void(const id_type&, const NoteData&)> added;
+  mutable Nano::Signal<void(const id_type&, const NoteData&)> removing;
+
+  //! Old data, then new data
+  mutable Nano::Signal<void(const id_type&, const NoteData&, const NoteData&)> changed;
+  mutable Nano::Signal<void()> replaced;
+
+private:
+  void push(const id_type& id, const NoteData& n);
+
+  // Not Id<Note>, which also carries a pointer
+  std::vector<int32_t> m_ids;
+  std::vector<double> m_start;
+  std::vector<double> m_duration;
+  std::vector<midi_size_t> m_pitch;
+  std::vector<midi_size_t> m_velocity;
+
+  ossia::hash_map<int32_t, int32_t> m_index;
+  int32_t m_maxId{};
+};
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <vector>
+
+namespace Pd
+{
+/**
+ * @brief Planar multi-channel FIFO of samples.
+ *
+ * Adapts the buffers requested by the graph to the fixed block size of Pd.
+ * Sized with reset() before running: the audio thread then only writes and
+ * reads by whole blocks, which become at most two copies per channel.
+ */
+class BlockRing
+{
+public:
+  void reset(std::size_t channels, std::size_t capacity)
+  {
+    m_channels = channels;
+    m_capacity = std::bit_ceil(std::max(capacity, std::size_t(1)));
+    m_data.assign(m_channels * m_capacity, 0.f);
+    m_read = 0;
+    m_size = 0;
+  }
+
+  std::size_t channels() const noexcept { return m_channels; }
+  std::size_t size() const noexcept { return m_size; }
+  std::size_t capacity() const noexcept { return m_capacity; }
+
+  //! Copies after the last committed frame of a channel.
+  template <typename T>
+  void write(std::size_t chan, const T* src, std::size_t frames) noexcept
+  {
+    write_at(chan, m_size, frames, [&src](float* dst, std::size_t n) {
+      std::copy_n(src, n, dst);
+      src += n;
+    });
+  }
+
+  //! Same as write, with a constant value.
+  void fill(std::size_t chan, std::size_t offset, std::size_t frames, float v) noexcept
+  {
+    write_at(chan, m_size + offset, frames, [v](float* dst, std::size_t n) {
+      std::fill_n(dst, n, v);
+    });
+  }
+
+  //! Makes the frames written in each channel readable.
+  void commit(std::size_t frames) noexcept { m_size += frames; }
+
+  //! Inserts silence before the first readable frame.
+  void prepend_silence(std::size_t frames) noexcept
+  {
+    m_read = (m_read - frames) & (m_capacity - 1);
+    m_size += frames;
+    for(std::size_t c = 0; c < m_channels; c++)
+      write_at(c, 0, frames, [](float* dst, std::size_t n) { std::fill_n(dst, n, 0.f); });
+  }
+
+  template <typename T>
+  void read(std::size_t chan, T* dst, std::size_t frames) const noexcept
+  {
+    const float* data = m_data.data() + chan * m_capacity;
+    const std::size_t first = std::min(frames, m_capacity - m_read);
+    std::copy_n(data + m_read, first, dst);
+    std::copy_n(data, frames - first, dst + first);
+  }
+
+  void consume(std::size_t frames) noexcept
+  {
+    m_read = (m_read + frames) & (m_capacity - 1);
+    m_size -= frames;
+  }
+
+private:
+  template <typename F>
+  void write_at(std::size_t chan, std::size_t pos, std::size_t frames, F&& f) noexcept
+  {
+    float* data = m_data.data() + chan * m_capacity;
+    const std::size_t start = (m_read + pos) & (m_capacity - 1);
+    const std::size_t first = std::min(frames, m_capacity - start);
+    f(data + start, first);
+    f(data, frames - first);
+  }
+
+  std::vector<float> m_data;
+  std::size_t m_channels{};
+  std::size_t m_capacity{1};
+  std::size_t m_read{};
+  std::size_t m_size{};
+};
+}
@@ -180,9 +180,13 @@ PdGraphNode::PdGraphNode(
   const std::size_t bs = libpd_blocksize();
   m_inbuf.resize(m_audioIns * bs);
   m_outbuf.resize(m_audioOuts * bs);
-  m_prev_outbuf.resize(m_audioOuts);
-  for(auto& circ : m_prev_outbuf)
-    circ.set_capacity(8192);
+
+  // Sized once for the largest request of the engine, so that the audio thread
+  // never allocates: the inputs keep less than a block between two requests,
+  // the outputs up to one block plus the latency and the block being computed.
+  const std::size_t max_frames = std::max<int64_t>(ctx.execState->bufferSize, 1);
+  m_inRing.reset(m_audioIns, max_frames + bs);
+  m_outRing.reset(m_audioOuts, max_frames + 4 * bs);
 
   // Create instance
   libpd_set_instance(m_instance->instance);
@@ -464,74 +468,66 @@ void PdGraphNode::run(const ossia::token_request& t, ossia::exec_state_facade e)
   {
     libpd_process_raw(m_inbuf.data(), m_outbuf.data());
   }
-  else if(int64_t prev_out_size = m_prev_outbuf[0].size(); req_samples > prev_out_size)
+  else
   {
-    int64_t additional_samples = std::max(int64_t(bs), req_samples - prev_out_size);
-    while(additional_samples > 0)
+    const auto process_block = [&] {
+      libpd_process_raw(m_inbuf.data(), m_outbuf.data());
+      for(std::size_t i = 0; i < m_audioOuts; ++i)
+        m_outRing.write(i, m_outbuf.data() + i * bs, bs);
+      m_outRing.commit(bs);
+    };
+
+    SCORE_ASSERT(m_outRing.size() + req_samples + 2 * bs <= m_outRing.capacity());
+    if(m_audioIns > 0)
     {
-      std::size_t offset = m_prev_outbuf[0].size();
-      // Copy audio inputs
-      if(m_audioIns > 0)
+      // Queue the inputs of this tick, starting from the start of the request.
+      SCORE_ASSERT(m_inRing.size() + req_samples <= m_inRing.capacity());
+      for(std::size_t i = 0U; i < m_audioIns; i++)
       {
-        for(std::size_t i = 0U; i < input_channels; i++)
+        int64_t available_input_samples = 0;
+        if(i < input_channels)
         {
           auto& channel = m_audio_inlet->channel(i);
-          int64_t available_input_samples = channel.size();
-          available_input_samples -= offset;
-
+          available_input_samples = std::clamp(
+              int64_t(channel.size()) - start_sample, int64_t(0), req_samples);
           if(available_input_samples > 0)
-          {
-            int64_t samples_to_copy = std::min(int64_t(bs), additional_samples);
-            if(samples_to_copy < available_input_samples)
-            {
-              SCORE_ASSERT(offset + samples_to_copy <= channel.size());
-              SCORE_ASSERT(i * bs + samples_to_copy <= m_inbuf.size());
-              std::copy_n(
-                  channel.begin() + offset, samples_to_copy, m_inbuf.begin() + i * bs);
-            }
-            else
-            {
-              SCORE_ASSERT(offset + available_input_samples <= channel.size());
-              SCORE_ASSERT(i * bs + available_input_samples <= m_inbuf.size());
-              std::copy_n(
-                  channel.begin() + offset, available_input_samples,
-                  m_inbuf.begin() + i * bs);
-              std::fill_n(
-                  m_inbuf.begin() + i * bs + available_input_samples,
-                  bs - available_input_samples, 0.f);
-            }
-          }
-          else
-          {
-            std::fill_n(m_inbuf.begin() + i * bs, bs, 0.f);
-          }
+            m_inRing.write(i, channel.data() + start_sample, available_input_samples);
         }
+        m_inRing.fill(
+            i, available_input_samples, req_samples - available_input_samples, 0.f);
       }
+      m_inRing.commit(req_samples);
 
-      // Process
-      libpd_process_raw(m_inbuf.data(), m_outbuf.data());
+      // Process all the complete blocks
+      while(m_inRing.size() >= bs)
+      {
+        for(std::size_t i = 0U; i < m_audioIns; i++)
+          m_inRing.read(i, m_inbuf.data() + i * bs, bs);
+        m_inRing.consume(bs);
+        process_block();
+      }
 
-      // Put the outputs back in the ring buffer
-      for(std::size_t i = 0; i < m_audioOuts; ++i)
+      // Requests which are not a multiple of the Pd block size leave some
+      // input in the ring: the first time this happens, the output gets
+      // delayed by enough samples to never have to wait for these inputs.
+      if(int64_t(m_outRing.size()) < req_samples)
       {
-        for(std::size_t j = 0; j < bs; j++)
-        {
-          m_prev_outbuf[i].push_back(m_outbuf[i * bs + j]);
-        }
+        SCORE_ASSERT(m_latency < bs - 1);
+        m_outRing.prepend_silence(bs - 1 - m_latency);
+        m_latency = bs - 1;
       }
-      additional_samples -= bs;
+    }
+    else
+    {
+      while(int64_t(m_outRing.size()) < req_samples)
+        process_block();
     }
   }
 
   if(m_audioOuts > 0)
   {
     // Copy audio outputs. Message inputs are copied in callbacks.
-    // Note: due to Pd processing samples 64 by 64 this is not sample-accurate.
-    // i.e. we always start copying from the beginning of the latest buffer
-    // computed by pd. The solution is to store the last N samples computed and
-    // read them if necessary, but then this causes problems if messages &
-    // parameters changed in between.
-
+    // Messages are only taken into account at the next Pd block.
     m_audio_outlet->set_channels(m_audioOuts);
 
     if(req_samples > 0)
@@ -539,16 +535,14 @@ void PdGraphNode::run(const ossia::token_request& t, ossia::exec_state_facade e)
       for(std::size_t i = 0U; i < m_audioOuts; ++i)
       {
         auto& channel = m_audio_outlet->channel(i);
-        auto& circbuf = m_prev_outbuf[i];
         const auto silence_samples = std::max(
             uint64_t(channel.size()), uint64_t(t.physical_start(e.modelToSamples())));
         const auto total_samples = silence_samples + req_samples;
-        channel.reserve(total_samples);
-        channel.resize(silence_samples);
+        channel.resize(total_samples);
 
-        channel.insert(channel.end(), circbuf.begin(), circbuf.begin() + req_samples);
-        circbuf.erase_begin(req_samples);
+        m_outRing.read(i, channel.data() + silence_samples, req_samples);
       }
+      m_outRing.consume(req_samples);
     }
   }
 
@@ -4,6 +4,7 @@
 
 #include <Explorer/DeviceList.hpp>
 
+#include <Pd/Executor/PdBlockRing.hpp>
 #include <Pd/PdInstance.hpp>
 #include <Pd/PdProcess.hpp>
 
@@ -15,8 +16,6 @@
 #include <ossia/editor/scenario/time_process.hpp>
 #include <ossia/editor/scenario/time_value.hpp>
 
-#include <boost/circular_buffer.hpp>
-
 #include <QString>
 
 #include <memory>
@@ -59,7 +58,8 @@ public:
   std::vector<std::string> m_inmess, m_outmess;
 
   std::vector<float> m_inbuf, m_outbuf;
-  std::vector<boost::circular_buffer<float>> m_prev_outbuf;
+  BlockRing m_inRing, m_outRing;
+  std::size_t m_latency{};
   std::size_t m_firstInMessage{}, m_firstOutMessage{};
   ossia::audio_port* m_audio_inlet{};
   ossia::audio_port* m_audio_outlet{};
@@ -19,13 +19,15 @@ SETTINGS_PARAMETER_IMPL(WebUiPath){QStringLiteral("RemoteControl/WebUiPath"), ""
 SETTINGS_PARAMETER_IMPL(ServerAddress){QStringLiteral("RemoteControl/ServerAddress"), "0.0.0.0"};
 SETTINGS_PARAMETER_IMPL(ServerPort){QStringLiteral("RemoteControl/ServerPort"), 10111};
 SETTINGS_PARAMETER_IMPL(ServerEnabled){QStringLiteral("RemoteControl/ServerEnabled"), false};
+SETTINGS_PARAMETER_IMPL(UpdateInterval){QStringLiteral("RemoteControl/UpdateInterval"), 100};
 static auto list()
 {
   return std::tie(Enabled
                   , WebUiPath
                   , ServerAddress
                   , ServerPort
-                  , ServerEnabled);
+                  , ServerEnabled
+                  , UpdateInterval);
 }
 }
 
@@ -53,5 +55,6 @@ SCORE_SETTINGS_PARAMETER_CPP(QString, Model, WebUiPath)
 SCORE_SETTINGS_PARAMETER_CPP(QString, Model, ServerAddress)
 SCORE_SETTINGS_PARAMETER_CPP(unsigned short, Model, ServerPort)
 SCORE_SETTINGS_PARAMETER_CPP(bool, Model, ServerEnabled)
+SCORE_SETTINGS_PARAMETER_CPP(int, Model, UpdateInterval)
 }
 }
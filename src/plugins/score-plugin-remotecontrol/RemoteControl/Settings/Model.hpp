@@ -15,6 +15,7 @@ class SCORE_PLUGIN_REMOTECONTROL_EXPORT Model : public score::SettingsDelegateMo
   QString m_WebUiPath{};
   QString m_ServerAddress{"0.0.0.0"};
   unsigned short m_ServerPort{8080};
+  int m_UpdateInterval{100};
 
 public:
   Model(
@@ -26,6 +27,7 @@ public:
   SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_REMOTECONTROL_EXPORT, QString, ServerAddress)
   SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_REMOTECONTROL_EXPORT, unsigned short, ServerPort)
   SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_REMOTECONTROL_EXPORT, bool, ServerEnabled)
+  SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_REMOTECONTROL_EXPORT, int, UpdateInterval)
 };
 
 SCORE_SETTINGS_PARAMETER(Model, Enabled)
@@ -33,5 +35,6 @@ SCORE_SETTINGS_PARAMETER(Model, WebUiPath)
 SCORE_SETTINGS_PARAMETER(Model, ServerAddress)
 SCORE_SETTINGS_PARAMETER(Model, ServerPort)
 SCORE_SETTINGS_PARAMETER(Model, ServerEnabled)
+SCORE_SETTINGS_PARAMETER(Model, UpdateInterval)
 }
 }
@@ -55,12 +55,20 @@ Presenter::Presenter(Model& m, View& v, QObject* parent)
       }
     });
 
+    con(v, &View::updateIntervalChanged, this, [&](auto val) {
+      if(val != m.getUpdateInterval())
+      {
+        m_disp.submit<SetModelUpdateInterval>(this->model(this), val);
+      }
+    });
+
     // model -> view
     con(m, &Model::EnabledChanged, &v, &View::setEnabled);
     con(m, &Model::WebUiPathChanged, &v, &View::setWebUiPath);
     con(m, &Model::ServerAddressChanged, &v, &View::setServerAddress);
     con(m, &Model::ServerPortChanged, &v, &View::setServerPort);
     con(m, &Model::ServerEnabledChanged, &v, &View::setServerEnabled);
+    con(m, &Model::UpdateIntervalChanged, &v, &View::setUpdateInterval);
 
     // initial value
     v.setEnabled(m.getEnabled());
@@ -68,6 +76,7 @@ Presenter::Presenter(Model& m, View& v, QObject* parent)
     v.setServerAddress(m.getServerAddress());
     v.setServerPort(m.getServerPort());
     v.setServerEnabled(m.getServerEnabled());
+    v.setUpdateInterval(m.getUpdateInterval());
   }
 }
 
@@ -47,6 +47,21 @@ View::View()
     lay->addRow(m_enabled);
   }
 
+  {
+    m_update_interval = new QSpinBox{};
+    m_update_interval->setRange(10, 10000);
+    m_update_interval->setSuffix(tr(" ms"));
+    m_update_interval->setMaximumWidth(100);
+
+    connect(m_update_interval
+            , SignalUtils::QSpinBox_valueChanged_int()
+            , this
+            , [&](int t)
+    { updateIntervalChanged(t); });
+
+    lay->addRow(tr("Interval updates every"), m_update_interval);
+  }
+
   {
     m_web_ui = new score::FormWidget{tr("Web UI")};
     auto web_lay = m_web_ui->layout();
@@ -169,6 +184,12 @@ void View::setServerEnabled(bool val)
   }
 }
 
+void View::setUpdateInterval(int val)
+{
+  if (val != m_update_interval->value())
+    m_update_interval->setValue(val);
+}
+
 QWidget* View::getWidget()
 {
   return m_widg;
@@ -25,18 +25,21 @@ public:
   void setServerAddress(const QString&);
   void setServerPort(unsigned short);
   void setServerEnabled(bool);
+  void setUpdateInterval(int);
 
   void enabledChanged(bool b) W_SIGNAL(enabledChanged, b);
   void webUiPathChanged(QString s) W_SIGNAL(webUiPathChanged, s);
   void serverAddressChanged(QString s) W_SIGNAL(serverAddressChanged, s);
   void serverPortChanged(unsigned short s) W_SIGNAL(serverPortChanged, s);
   void serverEnabledChanged(bool b) W_SIGNAL(serverEnabledChanged, b);
+  void updateIntervalChanged(int ms) W_SIGNAL(updateIntervalChanged, ms);
 
 private:
   QWidget* getWidget() override;
   score::FormWidget* m_widg{};
 
   QCheckBox* m_enabled{};
+  QSpinBox* m_update_interval{};
 
   score::FormWidget* m_web_ui{};
   QLineEdit* m_web_ui_path{};
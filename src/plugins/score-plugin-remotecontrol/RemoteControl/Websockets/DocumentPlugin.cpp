@@ -14,10 +14,13 @@
 #include <score/model/tree/TreeNodeSerialization.hpp>
 #include <score/serialization/VisitorCommon.hpp>
 #include <score/tools/Bind.hpp>
+#include <score/tools/ThreadPool.hpp>
 
 #include <core/document/Document.hpp>
 #include <core/document/DocumentModel.hpp>
 
+#include <ossia-qt/invoke.hpp>
+
 #include <QBuffer>
 #include <QJSEngine>
 
@@ -31,6 +34,7 @@ using namespace std::literals;
 DocumentPlugin::DocumentPlugin(const score::DocumentContext& doc, QObject* parent)
     : score::DocumentPlugin{doc, "RemoteControl::WS::DocumentPlugin", parent}
     , receiver{doc, 10212}
+    , m_stream{new IntervalStream}
 {
   auto& set = m_context.app.settings<Settings::Model>();
   if(set.getEnabled())
@@ -48,56 +52,156 @@ DocumentPlugin::DocumentPlugin(const score::DocumentContext& doc, QObject* paren
       },
       Qt::QueuedConnection);
 
-  // TODO put this as a setting instead
-  startTimer(100);
+  // The interval updates are encoded in another thread
+  m_stream->moveToThread(score::ThreadPool::instance().acquireThread());
+  connect(
+      m_stream, &IntervalStream::ready, this, &DocumentPlugin::on_intervalsEncoded,
+      Qt::QueuedConnection);
+
+  {
+    Handler h;
+    h.answers["IntervalsSubscribe"]
+        = [this](const rapidjson::Value&, const WSClient& c) {
+      m_subscriptions[c.socket] = Subscription::Requested;
+    };
+    h.answers["IntervalsUnsubscribe"]
+        = [this](const rapidjson::Value&, const WSClient& c) {
+      m_subscriptions[c.socket] = Subscription::None;
+    };
+    h.onClientDisconnection
+        = [this](const WSClient& c) { m_subscriptions.erase(c.socket); };
+    receiver.addHandler(this, std::move(h));
+  }
+
+  m_timer = startTimer(set.getUpdateInterval());
+  con(set, &Settings::Model::UpdateIntervalChanged, this, [this](int ms) {
+    killTimer(m_timer);
+    m_timer = startTimer(ms);
+  });
 }
 
-DocumentPlugin::~DocumentPlugin() { }
+DocumentPlugin::~DocumentPlugin()
+{
+  receiver.removeHandler(this);
+
+  ossia::qt::run_async(m_stream, &QObject::deleteLater);
+  m_stream = nullptr;
+
+  score::ThreadPool::instance().releaseThread();
+}
 
 void DocumentPlugin::timerEvent(QTimerEvent* event)
 {
+  // The previous update is still being encoded
+  if(m_encoding)
+    return;
+
   if(receiver.clients().size() == 0)
     return;
 
-  JSONReader r;
-  r.stream.StartObject();
+  IntervalUpdate update;
+  update.added = std::move(m_addedIntervals);
+  update.removed = std::move(m_removedIntervals);
+  m_addedIntervals.clear();
+  m_removedIntervals.clear();
 
-  r.stream.Key("Intervals");
-  r.stream.StartArray();
-  for(auto& it : this->m_intervals)
+  for(auto& clt : receiver.clients())
   {
-    if(*it.second.progress > 0.)
+    if(auto it = m_subscriptions.find(clt.socket); it != m_subscriptions.end())
     {
-      r.stream.StartObject();
+      if(it->second == Subscription::Requested)
+      {
+        m_newSubscribers.push_back(clt.socket);
+        update.full = true;
+      }
+    }
+    else
+    {
+      update.json = true;
+    }
+  }
 
-      r.obj[score::StringConstant().Path] = it.second.p;
+  for(auto& [model, itv] : this->m_intervals)
+  {
+    if(*itv.progress > 0.)
+    {
+      update.running.push_back(IntervalState{
+          .id = itv.id,
+          .progress = *itv.progress,
+          .speed = model->duration.speed(),
+          .gain = model->outlet->gain()});
+    }
+  }
 
-      r.stream.Key("Progress");
-      r.stream.Double(*it.second.progress);
+  m_encoding = true;
+  ossia::qt::run_async(m_stream, [s = m_stream, u = std::move(update)]() mutable {
+    s->process(std::move(u));
+  });
+}
 
-      r.stream.Key("Speed");
-      r.stream.Double(it.second.model->duration.speed());
+void DocumentPlugin::on_intervalsEncoded(const IntervalMessages& msgs)
+{
+  m_encoding = false;
 
-      r.stream.Key("Gain");
-      r.stream.Double(it.second.model->outlet->gain());
+  // The clients may have changed while the update was being encoded
+  for(auto& clt : receiver.clients())
+  {
+    auto socket = clt.socket;
+    auto it = m_subscriptions.find(socket);
+    if(it == m_subscriptions.end())
+    {
+      if(!msgs.json.isEmpty())
+        socket->sendTextMessage(msgs.json);
+      continue;
+    }
 
-      r.stream.EndObject();
+    switch(it->second)
+    {
+      case Subscription::Requested:
+        if(ossia::contains(m_newSubscribers, socket))
+        {
+          socket->sendTextMessage(msgs.allIdentifiers);
+          socket->sendBinaryMessage(msgs.full);
+          it->second = Subscription::Binary;
+        }
+        break;
+      case Subscription::Binary:
+        if(!msgs.identifiers.isEmpty())
+          socket->sendTextMessage(msgs.identifiers);
+        if(!msgs.delta.isEmpty())
+          socket->sendBinaryMessage(msgs.delta);
+        break;
+      case Subscription::None:
+        break;
     }
   }
-  r.stream.EndArray();
-  r.stream.EndObject();
 
-  receiver.sendMessage(r.toString());
+  m_newSubscribers.clear();
 }
 
 void DocumentPlugin::registerInterval(Scenario::IntervalModel& m)
 {
-  m_intervals[m.id().val()] = IntervalData{&m, &m.duration.playPercentage(), m};
+  const uint32_t id = ++m_lastIntervalId;
+  m_intervals[&m] = IntervalData{&m, &m.duration.playPercentage(), id};
+  m_addedIntervals.emplace_back(id, toJson(Path<Scenario::IntervalModel>{m}));
 }
 
 void DocumentPlugin::unregisterInterval(Scenario::IntervalModel& m)
 {
-  m_intervals.erase(m.id().val());
+  auto it = m_intervals.find(&m);
+  if(it == m_intervals.end())
+    return;
+
+  const uint32_t id = it->second.id;
+  m_intervals.erase(it);
+
+  // No need to tell the clients about an interval they never heard of
+  auto added = ossia::find_if(
+      m_addedIntervals, [id](const auto& p) { return p.first == id; });
+  if(added != m_addedIntervals.end())
+    m_addedIntervals.erase(added);
+  else
+    m_removedIntervals.push_back(id);
 }
 
 void DocumentPlugin::on_documentClosing()
@@ -10,6 +10,8 @@
 #include <QtWebSockets/QWebSocket>
 #include <QtWebSockets/QWebSocketServer>
 
+#include <RemoteControl/Websockets/IntervalStream.hpp>
+
 #include <nano_observer.hpp>
 #include <score_plugin_remotecontrol_export.h>
 template <typename T>
@@ -140,14 +142,37 @@ private:
   void create();
   void cleanup();
 
+  void on_intervalsEncoded(const IntervalMessages& msgs);
+
   struct IntervalData
   {
     Scenario::IntervalModel* model;
     const double* progress;
-    Path<Scenario::IntervalModel> p;
+    uint32_t id;
+  };
+
+  ossia::hash_map<const Scenario::IntervalModel*, IntervalData> m_intervals;
+  uint32_t m_lastIntervalId{};
+
+  // Not yet sent to the IntervalStream
+  std::vector<std::pair<uint32_t, QByteArray>> m_addedIntervals;
+  std::vector<uint32_t> m_removedIntervals;
+
+  //! Clients which are not in there get the JSON document of the running intervals
+  enum class Subscription
+  {
+    Requested,
+    Binary,
+    None
   };
+  ossia::hash_map<QWebSocket*, Subscription> m_subscriptions;
+
+  //! Clients which requested a subscription before the update being encoded
+  std::vector<QWebSocket*> m_newSubscribers;
 
-  ossia::hash_map<int64_t, IntervalData> m_intervals;
+  IntervalStream* m_stream{};
+  bool m_encoding{};
+  int m_timer{};
 
   Interval* m_root{};
 };
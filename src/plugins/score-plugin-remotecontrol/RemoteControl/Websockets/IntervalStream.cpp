@@ -0,0 +1,222 @@
+#include "IntervalStream.hpp"
+
+#include <score/serialization/JSONVisitor.hpp>
+
+#include <QtEndian>
+
+#include <bit>
+#include <cstring>
+
+#include <wobjectimpl.h>
+W_OBJECT_IMPL(RemoteControl::WS::IntervalStream)
+
+namespace RemoteControl::WS
+{
+namespace
+{
+enum Fields : uint8_t
+{
+  Progress = 1,
+  Speed = 2,
+  Gain = 4,
+  Stopped = 8,
+  AllFields = Progress | Speed | Gain
+};
+
+constexpr uint8_t intervals_frame = 1;
+
+void writeU8(QByteArray& buf, uint8_t v)
+{
+  buf.append(char(v));
+}
+
+void writeU32(QByteArray& buf, uint32_t v)
+{
+  v = qToLittleEndian(v);
+  buf.append(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+void writeFloat(QByteArray& buf, double v)
+{
+  writeU32(buf, std::bit_cast<uint32_t>(float(v)));
+}
+
+struct FrameWriter
+{
+  QByteArray buf;
+  uint32_t count{};
+
+  explicit FrameWriter(bool full)
+  {
+    writeU8(buf, intervals_frame);
+    writeU8(buf, full ? 1 : 0);
+
+    // Count, set at the end
+    writeU32(buf, 0);
+  }
+
+  void write(const IntervalState& s, uint8_t fields)
+  {
+    writeU32(buf, s.id);
+    writeU8(buf, fields);
+    if(fields & Progress)
+      writeFloat(buf, s.progress);
+    if(fields & Speed)
+      writeFloat(buf, s.speed);
+    if(fields & Gain)
+      writeFloat(buf, s.gain);
+    count++;
+  }
+
+  QByteArray finish() &&
+  {
+    const uint32_t c = qToLittleEndian(count);
+    std::memcpy(buf.data() + 2, &c, sizeof(c));
+    return std::move(buf);
+  }
+};
+
+// The clients only see the float32 values: smaller changes are not sent
+bool changed(double prev, double cur) noexcept
+{
+  return float(prev) != float(cur);
+}
+
+template <typename Added>
+QString identifiersMessage(const Added& added, const std::vector<uint32_t>& removed)
+{
+  using namespace std::literals;
+  JSONReader r;
+  r.stream.StartObject();
+  r.obj[score::StringConstant().Message] = "IntervalIds"sv;
+
+  r.stream.Key("Added");
+  r.stream.StartArray();
+  for(const auto& [id, path] : added)
+  {
+    r.stream.StartObject();
+    r.stream.Key("Id");
+    r.stream.Uint(id);
+    r.stream.Key("Path");
+    r.stream.RawValue(path.constData(), path.size(), rapidjson::kArrayType);
+    r.stream.EndObject();
+  }
+  r.stream.EndArray();
+
+  r.stream.Key("Removed");
+  r.stream.StartArray();
+  for(uint32_t id : removed)
+    r.stream.Uint(id);
+  r.stream.EndArray();
+
+  r.stream.EndObject();
+  return r.toString();
+}
+}
+
+IntervalStream::IntervalStream() { }
+
+IntervalStream::~IntervalStream() { }
+
+void IntervalStream::process(IntervalUpdate&& update)
+{
+  IntervalMessages res;
+
+  for(uint32_t id : update.removed)
+    m_paths.erase(id);
+  for(auto& [id, path] : update.added)
+    m_paths[id] = path;
+
+  if(!update.added.empty() || !update.removed.empty())
+    res.identifiers = identifiersMessage(update.added, update.removed);
+  if(update.full)
+    res.allIdentifiers = identifiersMessage(m_paths, {});
+
+  // Only what changed since the previous update
+  FrameWriter delta{false};
+  ossia::hash_map<uint32_t, IntervalState> current;
+  current.reserve(update.running.size());
+  for(const auto& s : update.running)
+  {
+    uint8_t fields = 0;
+    if(auto it = m_previous.find(s.id); it != m_previous.end())
+    {
+      const auto& prev = it->second;
+      if(changed(prev.progress, s.progress))
+        fields |= Progress;
+      if(changed(prev.speed, s.speed))
+        fields |= Speed;
+      if(changed(prev.gain, s.gain))
+        fields |= Gain;
+    }
+    else
+    {
+      fields = AllFields;
+    }
+
+    if(fields != 0)
+      delta.write(s, fields);
+    current[s.id] = s;
+  }
+
+  for(const auto& [id, prev] : m_previous)
+  {
+    if(current.find(id) == current.end())
+      delta.write(IntervalState{.id = id}, Stopped);
+  }
+
+  const bool has_changes = delta.count > 0;
+  if(has_changes)
+    res.delta = std::move(delta).finish();
+
+  if(update.full)
+  {
+    FrameWriter full{true};
+    for(const auto& s : update.running)
+      full.write(s, AllFields);
+    res.full = std::move(full).finish();
+  }
+
+  if(update.json && has_changes)
+    res.json = jsonDocument(update.running);
+
+  m_previous = std::move(current);
+
+  ready(std::move(res));
+}
+
+QString IntervalStream::jsonDocument(const std::vector<IntervalState>& running) const
+{
+  JSONReader r;
+  r.stream.StartObject();
+
+  r.stream.Key("Intervals");
+  r.stream.StartArray();
+  for(const auto& s : running)
+  {
+    auto it = m_paths.find(s.id);
+    if(it == m_paths.end())
+      continue;
+
+    r.stream.StartObject();
+
+    r.stream.Key("Path");
+    r.stream.RawValue(it->second.constData(), it->second.size(), rapidjson::kArrayType);
+
+    r.stream.Key("Progress");
+    r.stream.Double(s.progress);
+
+    r.stream.Key("Speed");
+    r.stream.Double(s.speed);
+
+    r.stream.Key("Gain");
+    r.stream.Double(s.gain);
+
+    r.stream.EndObject();
+  }
+  r.stream.EndArray();
+  r.stream.EndObject();
+
+  return r.toString();
+}
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include <ossia/detail/hash_map.hpp>
+
+#include <QByteArray>
+#include <QObject>
+#include <QString>
+
+#include <score_plugin_remotecontrol_export.h>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <verdigris>
+
+namespace RemoteControl::WS
+{
+//! State of a running interval, as seen by the remote clients
+struct IntervalState
+{
+  uint32_t id{};
+  double progress{};
+  double speed{};
+  double gain{};
+};
+
+//! What changed since the previous update, gathered on the UI thread
+struct IntervalUpdate
+{
+  std::vector<IntervalState> running;
+
+  //! Serialized paths of the intervals which got an id since the previous update
+  std::vector<std::pair<uint32_t, QByteArray>> added;
+  std::vector<uint32_t> removed;
+
+  //! Some clients just subscribed and need the whole state
+  bool full{};
+
+  //! Some clients did not subscribe and get the JSON document of the running intervals
+  bool json{};
+};
+
+//! Messages to send to the clients. Empty when there is nothing to send.
+struct IntervalMessages
+{
+  //! Ids added and removed since the previous update, for the subscribed clients
+  QString identifiers;
+
+  //! Every id, for the new subscribers
+  QString allIdentifiers;
+
+  //! Fields which changed since the previous update
+  QByteArray delta;
+
+  //! Every running interval, for the new subscribers
+  QByteArray full;
+
+  QString json;
+};
+
+/**
+ * @brief Encodes the state of the running intervals for the remote clients.
+ *
+ * Lives in a thread of the score::ThreadPool. The document plugin gathers
+ * the running intervals at each update, and this encodes the messages
+ * to send to the clients.
+ *
+ * A client sends {"Message": "IntervalsSubscribe"} to get the binary stream.
+ * Each interval is identified by a number, given in text messages:
+ *
+ *     {"Message": "IntervalIds", "Added": [{"Id": 1, "Path": [...]}], "Removed": [2]}
+ *
+ * The binary frames are little-endian:
+ *
+ *     uint8  type: 1 for the intervals
+ *     uint8  1 if the frame contains all the running intervals,
+ *            0 if it only contains what changed since the previous frame
+ *     uint32 count
+ *     count times:
+ *       uint32 id
+ *       uint8  fields: 1 progress, 2 speed, 4 gain, 8 the interval stopped
+ *       float32 for each field set in progress, speed, gain order
+ */
+class SCORE_PLUGIN_REMOTECONTROL_EXPORT IntervalStream final : public QObject
+{
+  W_OBJECT(IntervalStream)
+public:
+  IntervalStream();
+  ~IntervalStream();
+
+  void process(IntervalUpdate&& update);
+
+  void ready(IntervalMessages msgs)
+      E_SIGNAL(SCORE_PLUGIN_REMOTECONTROL_EXPORT, ready, msgs);
+
+private:
+  QString jsonDocument(const std::vector<IntervalState>& running) const;
+
+  ossia::hash_map<uint32_t, IntervalState> m_previous;
+  ossia::hash_map<uint32_t, QByteArray> m_paths;
+};
+}
+
+Q_DECLARE_METATYPE(RemoteControl::WS::IntervalMessages)
+W_REGISTER_ARGTYPE(RemoteControl::WS::IntervalMessages)
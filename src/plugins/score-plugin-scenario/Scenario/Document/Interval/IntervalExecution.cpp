@@ -10,8 +10,11 @@
 #include <Scenario/Document/Interval/IntervalExecution.hpp>
 #include <Scenario/Document/Interval/IntervalExecutionHelpers.hpp>
 #include <Scenario/Document/Interval/IntervalModel.hpp>
+#include <Scenario/Document/Interval/LookAhead.hpp>
 #include <Scenario/Document/ScenarioDocument/ScenarioDocumentModel.hpp>
 #include <Scenario/Execution/score2OSSIA.hpp>
+#include <Scenario/Process/Algorithms/Accessors.hpp>
+#include <Scenario/Process/ScenarioExecution.hpp>
 #include <Scenario/Process/ScenarioModel.hpp>
 
 #include <score/application/GUIApplicationContext.hpp>
@@ -27,6 +30,8 @@
 #include <ossia/dataflow/graph/graph_interface.hpp>
 #include <ossia/dataflow/graph_edge.hpp>
 #include <ossia/dataflow/nodes/forward_node.hpp>
+#include <ossia/detail/flat_set.hpp>
+#include <ossia/detail/hash_map.hpp>
 #include <ossia/editor/scenario/scenario.hpp>
 #include <ossia/editor/scenario/time_interval.hpp>
 #include <ossia/editor/scenario/time_value.hpp>
@@ -69,6 +74,39 @@ portsToRegister(const Scenario::IntervalModel& itv)
 
   return {std::move(inputs), std::move(outputs)};
 }
+
+//! The cables of the processes of an interval, and of everything below them
+static void collectCables(
+    const Scenario::IntervalModel& itv, const score::DocumentContext& doc,
+    ossia::flat_set<Process::Cable*>& cables)
+{
+  auto add = [&](const Process::Port& port) {
+    for(const auto& path : port.cables())
+      if(auto cable = path.try_find(doc))
+        cables.insert(cable);
+  };
+
+  for(const Process::ProcessModel& proc : itv.processes)
+  {
+    for(auto inlet : proc.inlets())
+      add(*inlet);
+    for(auto outlet : proc.outlets())
+      add(*outlet);
+
+    if(auto scenar = dynamic_cast<const Scenario::ScenarioInterface*>(&proc))
+    {
+      for(const Scenario::IntervalModel& sub : scenar->getIntervals())
+      {
+        auto [inlets, outlets] = portsToRegister(sub);
+        for(auto inlet : inlets)
+          add(*inlet);
+        for(auto outlet : outlets)
+          add(*outlet);
+        collectCables(sub, doc, cables);
+      }
+    }
+  }
+}
 }
 
 IntervalComponentBase::IntervalComponentBase(
@@ -239,7 +277,13 @@ void IntervalComponent::init()
       ((ossia::nodes::forward_node*)m_ossia_interval->node.get())
           ->audio_in.sources.reserve(safe_ins);
     }
-    init_hierarchy();
+
+    // With a look-ahead, the processes are created by updateLookAhead
+    if(m_executionRoot || interval().graphal()
+       || system().setup.lookAhead <= TimeVal::zero())
+      init_hierarchy();
+    else
+      m_deferred = true;
 
     /* TODO put the include at the right place
     if (context().doc.app.settings<Settings::Model>().getScoreOrder())
@@ -358,6 +402,7 @@ void IntervalComponent::onSetup(
 {
   OSSIA_ENSURE_CURRENT_THREAD_KIND(ossia::thread_type::Ui);
   m_ossia_interval = ossia_cst;
+  m_executionRoot = root;
   Transaction t{context()};
 
 #if defined(OSSIA_EXECUTION_LOG)
@@ -464,11 +509,21 @@ void IntervalComponent::slot_callback(bool running, ossia::time_value date)
   auto& cstdur = interval().duration;
   if(m_ossia_interval)
   {
+    // Started before the look-ahead saw it coming, e.g. by a trigger
+    if(running && m_deferred)
+    {
+      instantiate();
+
+      // Its sub-intervals due now must not wait for the next look-ahead update
+      updateLookAhead(TimeVal::zero(), this->context().reverseTime(date));
+    }
+
     if(running)
     {
       const auto& maxdur = cstdur.maxDuration();
 
       auto currentTime = this->context().reverseTime(date);
+      m_currentTime = currentTime;
       if(!maxdur.infinite())
       {
         if(maxdur > TimeVal::zero())
@@ -488,6 +543,113 @@ void IntervalComponent::slot_callback(bool running, ossia::time_value date)
   }
 }
 
+void IntervalComponent::updateLookAhead(TimeVal start, TimeVal now)
+{
+  OSSIA_ENSURE_CURRENT_THREAD_KIND(ossia::thread_type::Ui);
+  const auto lookAhead = system().setup.lookAhead;
+  if(!m_interval || !m_ossia_interval || lookAhead <= TimeVal::zero())
+    return;
+
+  if(m_deferred)
+    return;
+
+  for(auto& [id, proc] : m_processes)
+  {
+    auto scenar = dynamic_cast<ScenarioComponentBase*>(proc.get());
+    if(!scenar)
+      continue;
+
+    // The dates in the score are not those of the execution once a trigger
+    // waited: they are estimated from what the execution went through.
+    const auto& scenario = scenar->process();
+    std::vector<LookAheadSync> syncs;
+    ossia::hash_map<Id<Scenario::TimeSyncModel>, int> syncIndex;
+    syncs.reserve(scenario.timeSyncs.size());
+    for(const auto& ts : scenario.timeSyncs)
+    {
+      bool happened = false;
+      for(const auto& ev : ts.events())
+      {
+        const auto status = scenario.event(ev).status();
+        happened |= status == Scenario::ExecutionStatus::Happened
+                    || status == Scenario::ExecutionStatus::Disposed;
+      }
+      syncIndex[ts.id()] = std::ssize(syncs);
+      syncs.push_back({ts.date(), ts.active(), happened});
+    }
+
+    std::vector<LookAheadInterval> intervals;
+    std::vector<IntervalComponent*> components;
+    intervals.reserve(scenar->intervals().size());
+    components.reserve(scenar->intervals().size());
+    for(auto& [sub_id, sub] : scenar->intervals())
+    {
+      const auto& itv = sub->interval();
+      const auto& startEv = Scenario::startEvent(itv, scenario);
+      intervals.push_back(
+          {syncIndex[startEv.timeSync()],
+           syncIndex[Scenario::endTimeSync(itv, scenario).id()],
+           itv.duration.minDuration(), itv.duration.defaultDuration(),
+           itv.executing(), sub->currentTime(),
+           startEv.status() == Scenario::ExecutionStatus::Disposed});
+      components.push_back(sub.get());
+    }
+
+    const auto dates = estimateSyncDates(syncs, intervals, start, now);
+    for(std::size_t i = 0; i < intervals.size(); i++)
+    {
+      auto& sub = *components[i];
+      if(!sub.m_executionRoot && !sub.interval().graphal())
+      {
+        const bool wanted
+            = lookAheadWanted(intervals[i], syncs, dates, now, lookAhead);
+        if(sub.m_deferred && wanted)
+          sub.instantiate();
+        else if(!sub.m_deferred && !wanted)
+          sub.release();
+      }
+
+      sub.updateLookAhead(dates[intervals[i].startSync], now);
+    }
+  }
+}
+
+void IntervalComponent::instantiate()
+{
+  OSSIA_ENSURE_CURRENT_THREAD_KIND(ossia::thread_type::Ui);
+  m_deferred = false;
+  init_hierarchy();
+
+  // The cables of the new processes could not be connected without their ports
+  auto& setup = system().setup;
+  ossia::flat_set<Process::Cable*> cables;
+  collectCables(interval(), system().doc, cables);
+
+  Transaction t{system()};
+  for(auto cable : cables)
+  {
+    if(setup.m_cables.find(cable->id()) == setup.m_cables.end())
+      setup.connectCable(*cable, t);
+  }
+  t.run_all();
+}
+
+void IntervalComponent::release()
+{
+  OSSIA_ENSURE_CURRENT_THREAD_KIND(ossia::thread_type::Ui);
+  ossia::flat_set<Process::Cable*> cables;
+  collectCables(interval(), system().doc, cables);
+
+  clear_hierarchy();
+  m_deferred = true;
+
+  // Their edges were removed from the graph along with the nodes,
+  // they will be connected again if the interval comes back
+  auto& setup = system().setup;
+  for(auto cable : cables)
+    setup.m_cables.erase(cable->id());
+}
+
 const std::shared_ptr<ossia::time_interval>& IntervalComponentBase::OSSIAInterval() const
 {
   return m_ossia_interval;
@@ -533,6 +695,7 @@ void IntervalComponentBase::executionStarted()
     proc.setExecuting(true);
     proc.startExecution();
     proc.benchmark(-1.);
+    proc.renderBenchmark(-1.);
   }
 }
 
@@ -547,6 +710,7 @@ void IntervalComponentBase::executionStopped()
       proc.setExecuting(false);
       proc.stopExecution();
       proc.benchmark(-1.);
+      proc.renderBenchmark(-1.);
     }
   }
 }
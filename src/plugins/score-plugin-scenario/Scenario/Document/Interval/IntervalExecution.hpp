@@ -165,10 +165,35 @@ public:
       std::shared_ptr<ossia::time_interval> ossia_cst, interval_duration_data dur,
       bool executionRoot = false);
 
+  /**
+   * @brief Creates or removes the processes of the sub-intervals of the interval.
+   *
+   * Only used when SetupContext::lookAhead is set: the processes of an interval
+   * are created when its estimated start gets within the look-ahead of the
+   * playhead, and removed once it has finished. The interval itself is always
+   * there, so that the scenarios can still go through it.
+   *
+   * @param start Date of the start of the interval from the start of the execution.
+   * @param now Current date of the execution.
+   * @see estimateSyncDates
+   */
+  void updateLookAhead(TimeVal start, TimeVal now);
+
+  //! Time elapsed in the interval, as of the last tick seen by the UI thread
+  TimeVal currentTime() const noexcept { return m_currentTime; }
+
 public:
   void slot_callback(bool running, ossia::time_value date);
   W_SLOT(slot_callback);
   void graph_slot_callback(bool running, ossia::time_value date);
   W_SLOT(graph_slot_callback);
+
+private:
+  void instantiate();
+  void release();
+
+  TimeVal m_currentTime{};
+  bool m_executionRoot{};
+  bool m_deferred{};
 };
 }
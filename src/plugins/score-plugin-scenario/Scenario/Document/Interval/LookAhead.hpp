@@ -0,0 +1,134 @@
+#pragma once
+#include <Process/TimeValue.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace Execution
+{
+//! A time sync of a scenario, as seen by the look-ahead
+struct LookAheadSync
+{
+  //! Date in the score, from the start of the scenario
+  TimeVal date;
+
+  //! Waits for a trigger once its previous intervals reached their minimum
+  bool interactive{};
+
+  //! The execution went through it
+  bool happened{};
+};
+
+//! An interval of a scenario, as seen by the look-ahead
+struct LookAheadInterval
+{
+  //! Indices in the time syncs
+  int startSync{};
+  int endSync{};
+
+  TimeVal minDuration;
+  TimeVal defaultDuration;
+
+  bool executing{};
+
+  //! Time elapsed in the interval when it is executing
+  TimeVal elapsed;
+
+  //! Its start event will not happen, e.g. because of a false condition
+  bool disposed{};
+};
+
+/**
+ * @brief Estimates the dates at which the time syncs of a scenario execute.
+ *
+ * The dates in the score stop being those of the execution once a trigger
+ * waited or a flexible interval ran past its default duration: every time
+ * sync after it executes later. A time sync which is waited for, that is
+ * which has not happened while one of its previous intervals started,
+ * cannot happen before now: it is pushed to now at least, and the ones
+ * which follow it are pushed as much. The ones after a trigger are assumed
+ * to come as soon as the trigger can be triggered, that is once the
+ * intervals before it reached their minimum duration.
+ *
+ * A time sync which happened is dated from the intervals which it started and
+ * are still executing. The time syncs which nothing led to keep their date
+ * in the score: they are either ahead, or were skipped by starting the
+ * execution after them.
+ *
+ * @param start Date of the start of the scenario from the start of the execution.
+ * @param now Current date of the execution.
+ * @return The dates from the start of the execution, in the order of syncs.
+ */
+inline std::vector<TimeVal> estimateSyncDates(
+    const std::vector<LookAheadSync>& syncs,
+    const std::vector<LookAheadInterval>& intervals, TimeVal start, TimeVal now)
+{
+  const int n = std::ssize(syncs);
+
+  // An interval always ends after it starts: going through the time syncs in
+  // the order of their dates in the score visits an interval's start first.
+  std::vector<int> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](int lhs, int rhs) {
+    return syncs[lhs].date < syncs[rhs].date;
+  });
+
+  std::vector<std::vector<const LookAheadInterval*>> previous(n), next(n);
+  for(const auto& itv : intervals)
+  {
+    previous[itv.endSync].push_back(&itv);
+    next[itv.startSync].push_back(&itv);
+  }
+
+  std::vector<TimeVal> dates(n);
+  for(int i : order)
+  {
+    const auto& sync = syncs[i];
+
+    TimeVal date = start + sync.date;
+    bool waited = false;
+    if(!previous[i].empty())
+    {
+      date = TimeVal::zero();
+      for(auto itv : previous[i])
+      {
+        const auto& dur = sync.interactive ? itv->minDuration : itv->defaultDuration;
+        date = std::max(date, dates[itv->startSync] + dur);
+        waited |= syncs[itv->startSync].happened;
+      }
+    }
+
+    if(sync.happened)
+    {
+      date = std::min(date, now);
+      for(auto itv : next[i])
+        if(itv->executing)
+          date = now - itv->elapsed;
+      dates[i] = date;
+    }
+    else if(waited)
+      dates[i] = std::max(date, now);
+    else
+      dates[i] = date;
+  }
+  return dates;
+}
+
+/**
+ * @brief Whether the processes of an interval must exist.
+ *
+ * An interval is wanted from the moment its estimated start gets within the
+ * look-ahead of now, until it has finished.
+ */
+inline bool lookAheadWanted(
+    const LookAheadInterval& itv, const std::vector<LookAheadSync>& syncs,
+    const std::vector<TimeVal>& dates, TimeVal now, TimeVal lookAhead)
+{
+  if(itv.executing)
+    return true;
+  if(itv.disposed || syncs[itv.endSync].happened)
+    return false;
+  return dates[itv.startSync] <= now + lookAhead && now <= dates[itv.endSync];
+}
+}
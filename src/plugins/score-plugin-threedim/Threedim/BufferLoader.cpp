@@ -11,7 +11,16 @@ void SplatLoader::update(
   if(m_splat_data.splatCount <= 0 || !m_changed)
     return;
 
-  const auto splats_byte_size = m_splat_data.buffer.size() * sizeof(float);
+  // A new model was loaded
+  if(!m_splat_data.buffer.empty())
+  {
+    m_cpu_splats = std::make_shared<const float_vec>(std::move(m_splat_data.buffer));
+    m_splat_data.buffer = {};
+  }
+  if(!m_cpu_splats)
+    return;
+
+  const auto splats_byte_size = m_cpu_splats->size() * sizeof(float);
   qDebug() << splats_byte_size << (std::pow(2, 31) - 1);
   if(splats_byte_size >= std::numeric_limits<uint32_t>::max())
   {
@@ -20,10 +29,13 @@ void SplatLoader::update(
   }
   if(!m_last_buffer)
   {
+    // Without compute, the splat renderer sorts m_cpu_splats on the CPU
+    QRhiBuffer::UsageFlags usage = QRhiBuffer::UsageFlag::VertexBuffer;
+    if(renderer.state.rhi->isFeatureSupported(QRhi::Compute))
+      usage |= QRhiBuffer::UsageFlag::StorageBuffer;
+
     m_last_buffer = renderer.state.rhi->newBuffer(
-        QRhiBuffer::Immutable,
-        QRhiBuffer::UsageFlag::VertexBuffer | QRhiBuffer::UsageFlag::StorageBuffer,
-        splats_byte_size);
+        QRhiBuffer::Immutable, usage, splats_byte_size);
     if(!m_last_buffer->create())
     {
       release(renderer);
@@ -41,9 +53,11 @@ void SplatLoader::update(
     }
   }
 
+  setCpuSplats(m_last_buffer, m_cpu_splats);
+
   res.uploadStaticBuffer(
       m_last_buffer,
-      QByteArray::fromRawData((char*)m_splat_data.buffer.data(), splats_byte_size));
+      QByteArray::fromRawData((const char*)m_cpu_splats->data(), splats_byte_size));
 
   outputs.buffer.buffer.handle = m_last_buffer;
   outputs.buffer.buffer.byte_size = m_last_buffer->size();
@@ -53,6 +67,8 @@ void SplatLoader::update(
 
 void SplatLoader::release(score::gfx::RenderList& r)
 {
+  if(m_last_buffer)
+    setCpuSplats(m_last_buffer, {});
   r.releaseBuffer(m_last_buffer);
   m_last_buffer = nullptr;
   outputs.buffer.buffer.handle = nullptr;
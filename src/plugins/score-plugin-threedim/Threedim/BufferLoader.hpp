@@ -7,6 +7,7 @@
 #include <ossia/detail/pod_vector.hpp>
 
 #include <Threedim/Ply.hpp>
+#include <Threedim/Splat/CpuSplatData.hpp>
 #include <Threedim/TinyObj.hpp>
 #include <halp/buffer.hpp>
 #include <halp/controls.hpp>
@@ -66,6 +67,9 @@ public:
   void operator()();
   QRhiBuffer* m_last_buffer{};
   GaussianSplatData m_splat_data;
+
+  // What is in m_last_buffer, kept for the renderers which sort on the CPU
+  CpuSplats m_cpu_splats;
   bool m_changed{};
 };
 
@@ -0,0 +1,43 @@
+#include "CpuSplatData.hpp"
+
+#include <ossia/detail/hash_map.hpp>
+
+#include <mutex>
+
+namespace Threedim
+{
+namespace
+{
+// Loaders and renderers may live in the render threads of different outputs
+struct CpuSplatRegistry
+{
+  std::mutex mutex;
+  ossia::hash_map<const QRhiBuffer*, CpuSplats> splats;
+};
+
+CpuSplatRegistry& registry()
+{
+  static CpuSplatRegistry r;
+  return r;
+}
+}
+
+void setCpuSplats(const QRhiBuffer* buffer, CpuSplats data)
+{
+  auto& r = registry();
+  std::lock_guard lock{r.mutex};
+  if(data)
+    r.splats[buffer] = std::move(data);
+  else
+    r.splats.erase(buffer);
+}
+
+CpuSplats cpuSplats(const QRhiBuffer* buffer)
+{
+  auto& r = registry();
+  std::lock_guard lock{r.mutex};
+  if(auto it = r.splats.find(buffer); it != r.splats.end())
+    return it->second;
+  return {};
+}
+}
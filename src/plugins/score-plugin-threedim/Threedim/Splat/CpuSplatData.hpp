@@ -0,0 +1,22 @@
+#pragma once
+#include <Threedim/TinyObj.hpp>
+
+#include <memory>
+
+class QRhiBuffer;
+namespace Threedim
+{
+using CpuSplats = std::shared_ptr<const float_vec>;
+
+/**
+ * CPU copy of the raw splats uploaded in a buffer by a SplatLoader.
+ *
+ * Without compute shaders, the splat renderer looks up the buffer it gets
+ * on its input here and sorts this copy on the CPU: reading the buffer back
+ * is not supported by every backend, e.g. GLES2.
+ *
+ * Passing null data removes the entry of the buffer.
+ */
+void setCpuSplats(const QRhiBuffer* buffer, CpuSplats data);
+CpuSplats cpuSplats(const QRhiBuffer* buffer);
+}
@@ -0,0 +1,476 @@
+#include "CpuSplatSort.hpp"
+
+#include <ossia/detail/thread.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace score::gfx
+{
+namespace
+{
+// Same constants as the preprocess compute shader
+constexpr float SH_C0 = 0.28209479177387814f;
+constexpr float SH_C1 = 0.4886025119029199f;
+constexpr float SH_C2[5]
+    = {1.0925484305920792f, -1.0925484305920792f, 0.31539156525252005f,
+       -1.0925484305920792f, 0.5462742152960396f};
+constexpr float SH_C3[7]
+    = {-0.5900435899266435f, 2.890611442640554f, -0.4570457994644658f,
+       0.3731763325901154f,  -0.4570457994644658f, 1.445305721320277f,
+       -0.5900435899266435f};
+
+constexpr int key_buckets = 65536;
+
+// About 0.1 degree of camera rotation
+constexpr float rotation_threshold = 0.002f;
+// Relative to the distance between the camera and the origin of the model
+constexpr float position_threshold = 0.001f;
+
+// raw: 64 floats (see GaussianSplatData), out: 16 floats (RenderSplat)
+void preprocessSplat(
+    const float* raw, float* out, const CpuSplatSorter::Camera& cam) noexcept
+{
+  const float px = raw[0], py = raw[1], pz = raw[2];
+
+  // View direction for the SH evaluation: from the camera towards the splat
+  float x = px - cam.position[0];
+  float y = py - cam.position[1];
+  float z = pz - cam.position[2];
+  const float len = std::sqrt(x * x + y * y + z * z);
+  if(len > 0.f)
+  {
+    x /= len;
+    y /= len;
+    z /= len;
+  }
+
+  const float* r = raw + 9; // f_rest: 15 coefficients per channel, R then G then B
+  float color[3];
+  for(int c = 0; c < 3; c++)
+  {
+    const float* k = r + 15 * c;
+    float v = SH_C0 * raw[6 + c];
+    if(cam.shDegree >= 1)
+    {
+      v += SH_C1 * (-y * k[0] + z * k[1] - x * k[2]);
+    }
+    if(cam.shDegree >= 2)
+    {
+      const float xx = x * x, yy = y * y, zz = z * z;
+      const float xy = x * y, yz = y * z, xz = x * z;
+      v += SH_C2[0] * xy * k[3];
+      v += SH_C2[1] * yz * k[4];
+      v += SH_C2[2] * (2.f * zz - xx - yy) * k[5];
+      v += SH_C2[3] * xz * k[6];
+      v += SH_C2[4] * (xx - yy) * k[7];
+
+      if(cam.shDegree >= 3)
+      {
+        v += SH_C3[0] * y * (3.f * xx - yy) * k[8];
+        v += SH_C3[1] * xy * z * k[9];
+        v += SH_C3[2] * y * (4.f * zz - xx - yy) * k[10];
+        v += SH_C3[3] * z * (2.f * zz - 3.f * xx - 3.f * yy) * k[11];
+        v += SH_C3[4] * x * (4.f * zz - xx - yy) * k[12];
+        v += SH_C3[5] * z * (xx - yy) * k[13];
+        v += SH_C3[6] * x * (xx - 3.f * yy) * k[14];
+      }
+    }
+    color[c] = std::clamp(v + 0.5f, 0.f, 1.f);
+  }
+
+  // Rotation: stored as (w,x,y,z), rendered as normalized (x,y,z,w)
+  const float qw = raw[58], qx = raw[59], qy = raw[60], qz = raw[61];
+  const float qlen = std::sqrt(qw * qw + qx * qx + qy * qy + qz * qz);
+  const float qinv = qlen > 0.f ? 1.f / qlen : 0.f;
+
+  out[0] = px;
+  out[1] = py;
+  out[2] = pz;
+  out[3] = 0.f;
+  out[4] = std::exp(raw[55]) * cam.scaleMod;
+  out[5] = std::exp(raw[56]) * cam.scaleMod;
+  out[6] = std::exp(raw[57]) * cam.scaleMod;
+  out[7] = 0.f;
+  out[8] = qx * qinv;
+  out[9] = qy * qinv;
+  out[10] = qz * qinv;
+  out[11] = qw * qinv;
+  out[12] = color[0];
+  out[13] = color[1];
+  out[14] = color[2];
+  out[15] = 1.f / (1.f + std::exp(-raw[54]));
+}
+
+// Same quad as the render vertex shader
+constexpr float quad_corners[CpuSplatSorter::verticesPerSplat][2]
+    = {{-1.f, -1.f}, {1.f, -1.f}, {1.f, 1.f}, {-1.f, -1.f}, {1.f, 1.f}, {-1.f, 1.f}};
+
+// The same two triangles, indexed
+constexpr float indexed_corners[CpuSplatSorter::indexedVerticesPerSplat][2]
+    = {{-1.f, -1.f}, {1.f, -1.f}, {1.f, 1.f}, {-1.f, 1.f}};
+constexpr uint32_t quad_indices[CpuSplatSorter::indicesPerSplat] = {0, 1, 2, 0, 2, 3};
+
+// out: 4 vertices of floatsPerIndexedVertex floats
+void writeGeometry(const float* splat, float* out) noexcept
+{
+  for(const auto& corner : indexed_corners)
+  {
+    std::copy_n(splat, 3, out);
+    out[3] = splat[15];
+    std::copy_n(splat + 4, 8, out + 4);
+    out[12] = corner[0];
+    out[13] = corner[1];
+    out += CpuSplatSorter::floatsPerIndexedVertex;
+  }
+}
+
+uint32_t packColor(const float* splat) noexcept
+{
+  // In memory order for a UNormByte4 attribute: r, g, b, a
+  const auto byte = [](float v) { return uint32_t(v * 255.f + 0.5f); };
+  return byte(splat[12]) | (byte(splat[13]) << 8) | (byte(splat[14]) << 16)
+         | (0xFFu << 24);
+}
+}
+
+CpuSplatSorter::CpuSplatSorter(Layout layout)
+    : m_layout{layout}
+    , m_maxSlices{std::clamp(int(std::thread::hardware_concurrency()) / 2, 1, 8)}
+{
+  m_thread = std::thread{[this] {
+    ossia::set_thread_name("ossia splat sort");
+    run();
+  }};
+
+  // The sort thread handles the first slice
+  for(int t = 1; t < m_maxSlices; t++)
+  {
+    m_helpers.emplace_back([this, t] {
+      ossia::set_thread_name("ossia splat sort");
+      runHelper(t);
+    });
+  }
+}
+
+CpuSplatSorter::~CpuSplatSorter()
+{
+  {
+    std::lock_guard lock{m_mutex};
+    m_running = false;
+  }
+  m_cv.notify_one();
+  m_thread.join();
+
+  {
+    std::lock_guard lock{m_sliceMutex};
+    m_helpersRunning = false;
+  }
+  m_sliceStart.notify_all();
+  for(auto& t : m_helpers)
+    t.join();
+}
+
+void CpuSplatSorter::setSplats(Threedim::CpuSplats raw)
+{
+  {
+    std::lock_guard lock{m_mutex};
+    m_raw = std::move(raw);
+    m_hasSorted = false;
+    m_request = true;
+  }
+  m_cv.notify_one();
+}
+
+void CpuSplatSorter::setCamera(const Camera& cam)
+{
+  {
+    std::lock_guard lock{m_mutex};
+    m_camera = cam;
+    if(!m_raw || m_raw->empty() || m_request)
+      return;
+    if(m_hasSorted && !moved(m_sortedCamera, cam))
+      return;
+    m_request = true;
+  }
+  m_cv.notify_one();
+}
+
+std::optional<CpuSplatSorter::Result> CpuSplatSorter::takeResult()
+{
+  std::lock_guard lock{m_mutex};
+  if(!m_resultReady)
+    return std::nullopt;
+  m_resultReady = false;
+
+  Result res;
+  res.splats = m_ready.splats;
+  if(m_ready.verticesChanged)
+  {
+    std::swap(m_front.vertices, m_ready.vertices);
+    m_ready.verticesChanged = false;
+    res.vertices = &m_front.vertices;
+  }
+  if(m_ready.colorsChanged)
+  {
+    std::swap(m_front.colors, m_ready.colors);
+    m_ready.colorsChanged = false;
+    res.colors = &m_front.colors;
+  }
+  std::swap(m_front.indices, m_ready.indices);
+  res.indices = &m_front.indices;
+  return res;
+}
+
+bool CpuSplatSorter::moved(const Camera& prev, const Camera& cur) noexcept
+{
+  if(prev.shDegree != cur.shDegree || prev.scaleMod != cur.scaleMod
+     || prev.nearPlane != cur.nearPlane || prev.farPlane != cur.farPlane
+     || prev.sort != cur.sort)
+    return true;
+
+  // Rotation part of the (column-major) model-view matrix
+  for(int c = 0; c < 3; c++)
+    for(int r = 0; r < 3; r++)
+      if(std::abs(prev.modelView[c * 4 + r] - cur.modelView[c * 4 + r])
+         > rotation_threshold)
+        return true;
+
+  float dist2 = 0.f, norm2 = 0.f;
+  for(int i = 0; i < 3; i++)
+  {
+    const float d = cur.position[i] - prev.position[i];
+    dist2 += d * d;
+    norm2 += cur.position[i] * cur.position[i];
+  }
+  const float threshold = position_threshold * std::max(1.f, std::sqrt(norm2));
+  return dist2 > threshold * threshold;
+}
+
+void CpuSplatSorter::run()
+{
+  for(;;)
+  {
+    Threedim::CpuSplats raw;
+    Camera cam;
+    {
+      std::unique_lock lock{m_mutex};
+      m_cv.wait(lock, [this] { return m_request || !m_running; });
+      if(!m_running)
+        return;
+
+      raw = m_raw;
+      cam = m_camera;
+      m_sortedCamera = cam;
+      m_hasSorted = true;
+      m_request = false;
+    }
+
+    sort(raw, cam);
+
+    // What did not change stays in the previous result, taken or not
+    std::lock_guard lock{m_mutex};
+    if(m_back.verticesChanged)
+    {
+      std::swap(m_back.vertices, m_ready.vertices);
+      m_ready.verticesChanged = true;
+    }
+    if(m_back.colorsChanged)
+    {
+      std::swap(m_back.colors, m_ready.colors);
+      m_ready.colorsChanged = true;
+    }
+    std::swap(m_back.indices, m_ready.indices);
+    m_ready.splats = m_back.splats;
+    m_resultReady = true;
+  }
+}
+
+void CpuSplatSorter::runHelper(int slice)
+{
+  uint64_t generation = 0;
+  for(;;)
+  {
+    const SliceFunction* f{};
+    std::size_t count{};
+    int slices{};
+    {
+      std::unique_lock lock{m_sliceMutex};
+      m_sliceStart.wait(lock, [&] {
+        return m_sliceGeneration != generation || !m_helpersRunning;
+      });
+      if(!m_helpersRunning)
+        return;
+
+      generation = m_sliceGeneration;
+      if(slice >= m_slices)
+        continue;
+      f = m_sliceFunction;
+      count = m_sliceCount;
+      slices = m_slices;
+    }
+
+    (*f)(slice, count * slice / slices, count * (slice + 1) / slices);
+
+    std::lock_guard lock{m_sliceMutex};
+    if(--m_slicesPending == 0)
+      m_sliceDone.notify_one();
+  }
+}
+
+// Calls f(slice, begin, end) on `slices` threads, the first one being the caller
+void CpuSplatSorter::parallelSlices(int slices, std::size_t count, const SliceFunction& f)
+{
+  if(slices > 1)
+  {
+    {
+      std::lock_guard lock{m_sliceMutex};
+      m_sliceFunction = &f;
+      m_sliceCount = count;
+      m_slices = slices;
+      m_slicesPending = slices - 1;
+      m_sliceGeneration++;
+    }
+    m_sliceStart.notify_all();
+  }
+
+  f(0, 0, count / slices);
+
+  if(slices > 1)
+  {
+    std::unique_lock lock{m_sliceMutex};
+    m_sliceDone.wait(lock, [this] { return m_slicesPending == 0; });
+    m_sliceFunction = nullptr;
+  }
+}
+
+void CpuSplatSorter::sort(const Threedim::CpuSplats& raw, const Camera& cam)
+{
+  auto& out = m_back;
+  const std::size_t N = raw ? raw->size() / floatsPerRawSplat : 0;
+  const float* data = raw ? raw->data() : nullptr;
+  const bool indexed = m_layout == Layout::Indexed;
+
+  // The expanded vertices are in draw order: they are always written again
+  const bool geometry
+      = !indexed || raw != m_geometrySplats || cam.scaleMod != m_geometryScale;
+  const bool colors
+      = indexed && (geometry || cam.shDegree > 0 || cam.shDegree != m_colorsDegree);
+  const bool preprocess = geometry || colors;
+
+  out.verticesChanged = geometry;
+  out.colorsChanged = colors;
+  out.splats = N;
+  m_geometrySplats = raw;
+  m_geometryScale = cam.scaleMod;
+  m_colorsDegree = cam.shDegree;
+
+  if(geometry)
+    out.vertices.resize(
+        N
+        * (indexed ? indexedVerticesPerSplat * floatsPerIndexedVertex
+                   : verticesPerSplat * floatsPerExpandedVertex));
+  if(colors)
+    out.colors.resize(N * indexedVerticesPerSplat);
+  out.indices.resize(indexed ? N * indicesPerSplat : 0);
+  if(N == 0)
+    return;
+
+  if(preprocess)
+    m_splats.resize(N * floatsPerRenderSplat);
+  m_keys.resize(N);
+
+  // Small models are not worth the threads
+  const int slices = N < 65536 ? 1 : m_maxSlices;
+  m_histograms.assign(std::size_t(slices) * key_buckets, 0);
+
+  // Depth key: same as depth_key_shader, without the index in the low bits
+  // since the sort is stable.
+  const float* mv = cam.modelView;
+  const float nearPlane = std::max(cam.nearPlane, 1e-6f);
+  const float invLogRange = 1.f / std::log2(std::max(cam.farPlane / nearPlane, 1.0001f));
+
+  // 1. Preprocess, keys and histogram of each slice
+  parallelSlices(slices, N, [&](int t, std::size_t begin, std::size_t end) {
+    uint32_t* hist = m_histograms.data() + std::size_t(t) * key_buckets;
+    for(std::size_t i = begin; i < end; i++)
+    {
+      // The position is the same in the raw and preprocessed splats
+      const float* src = data + i * floatsPerRawSplat;
+      if(preprocess)
+      {
+        float* splat = m_splats.data() + i * floatsPerRenderSplat;
+        preprocessSplat(src, splat, cam);
+        if(indexed && geometry)
+          writeGeometry(
+              splat,
+              out.vertices.data() + i * indexedVerticesPerSplat * floatsPerIndexedVertex);
+        if(colors)
+          std::fill_n(
+              out.colors.data() + i * indexedVerticesPerSplat, indexedVerticesPerSplat,
+              packColor(splat));
+      }
+
+      uint16_t key = 0;
+      if(cam.sort)
+      {
+        const float depth = -(mv[2] * src[0] + mv[6] * src[1] + mv[10] * src[2] + mv[14]);
+        if(depth <= nearPlane)
+        {
+          key = 0xFFFF;
+        }
+        else
+        {
+          const float k = std::clamp(std::log2(depth / nearPlane) * invLogRange, 0.f, 1.f);
+          key = uint16_t(k * 65535.f);
+        }
+      }
+      m_keys[i] = key;
+      hist[key]++;
+    }
+  });
+
+  // 2. Offsets: the splats of a slice go after the ones with the same key
+  // in the previous slices, which keeps the sort stable.
+  uint32_t running = 0;
+  for(int k = 0; k < key_buckets; k++)
+  {
+    for(int t = 0; t < slices; t++)
+    {
+      auto& h = m_histograms[std::size_t(t) * key_buckets + k];
+      const uint32_t count = h;
+      h = running;
+      running += count;
+    }
+  }
+
+  // 3. Scatter in draw order
+  parallelSlices(slices, N, [&](int t, std::size_t begin, std::size_t end) {
+    uint32_t* offsets = m_histograms.data() + std::size_t(t) * key_buckets;
+    for(std::size_t i = begin; i < end; i++)
+    {
+      const uint32_t pos = offsets[m_keys[i]]++;
+      if(indexed)
+      {
+        const auto first = uint32_t(i * indexedVerticesPerSplat);
+        uint32_t* dst = out.indices.data() + std::size_t(pos) * indicesPerSplat;
+        for(int k = 0; k < indicesPerSplat; k++)
+          dst[k] = first + quad_indices[k];
+      }
+      else
+      {
+        const float* splat = m_splats.data() + i * floatsPerRenderSplat;
+        float* dst = out.vertices.data()
+                     + std::size_t(pos) * verticesPerSplat * floatsPerExpandedVertex;
+        for(const auto& corner : quad_corners)
+        {
+          std::copy_n(splat, floatsPerRenderSplat, dst);
+          dst[floatsPerRenderSplat] = corner[0];
+          dst[floatsPerRenderSplat + 1] = corner[1];
+          dst += floatsPerExpandedVertex;
+        }
+      }
+    }
+  });
+}
+}
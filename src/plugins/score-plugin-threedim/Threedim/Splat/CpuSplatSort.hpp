@@ -0,0 +1,157 @@
+#pragma once
+#include <Threedim/Splat/CpuSplatData.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace score::gfx
+{
+/**
+ * @brief CPU version of the splat preprocess and depth sort.
+ *
+ * Used when the graphics backend has no compute shaders.
+ * A worker thread evaluates the splats for the current camera and sorts them
+ * front-to-back on the same 16-bit log-depth keys as the GPU radix sort,
+ * in a single stable 16-bit pass split across a few helper threads,
+ * which are started once with the sorter.
+ *
+ * The result is directly usable as vertex data. With the indexed layout,
+ * the geometry of the four corners of each splat stays in the order of the
+ * input and is only produced again when the splats or their scale change;
+ * a sort gives the indices of the quads in draw order. The colors depend
+ * on the view direction past the spherical harmonics of degree 0: they are
+ * a separate stream of 8-bit colors, produced again when they change.
+ * Without 32-bit indices, each sort writes the six vertices of the quad of
+ * each splat in draw order.
+ *
+ * A new sort is only started when the camera moved past a small threshold
+ * since the previous one.
+ */
+class CpuSplatSorter
+{
+public:
+  enum class Layout
+  {
+    Indexed, //!< Four vertices per splat in input order, indices in draw order
+    Expanded //!< Six vertices per splat in draw order: RenderSplat then the corner
+  };
+
+  struct Camera
+  {
+    float modelView[16]{};
+    float position[3]{}; //!< In model space, for the spherical harmonics
+    float nearPlane{};
+    float farPlane{};
+    float scaleMod{1.f};
+    uint32_t shDegree{};
+    bool sort{true};
+  };
+
+  //! Buffers of a finished sort. The ones which did not change are null.
+  struct Result
+  {
+    //! Indexed: geometry of each vertex. Expanded: the vertices in draw order.
+    const std::vector<float>* vertices{};
+
+    //! Indexed: RGBA8 color of each vertex
+    const std::vector<uint32_t>* colors{};
+
+    //! Indexed: the indices of the quads, in draw order
+    const std::vector<uint32_t>* indices{};
+
+    std::size_t splats{};
+  };
+
+  static constexpr int floatsPerRawSplat = 64;
+  static constexpr int floatsPerRenderSplat = 16;
+  static constexpr int floatsPerExpandedVertex = floatsPerRenderSplat + 2;
+  static constexpr int verticesPerSplat = 6;
+
+  //! Position and opacity, scale, rotation, corner
+  static constexpr int floatsPerIndexedVertex = 14;
+  static constexpr int indexedVerticesPerSplat = 4;
+  static constexpr int indicesPerSplat = 6;
+
+  explicit CpuSplatSorter(Layout layout);
+  ~CpuSplatSorter();
+
+  Layout layout() const noexcept { return m_layout; }
+
+  //! Raw splats, in the layout of GaussianSplatData
+  void setSplats(Threedim::CpuSplats raw);
+  void setCamera(const Camera& cam);
+
+  /**
+   * Latest finished sort, or nothing if there is nothing new since the last call.
+   * The vectors stay valid until the next call.
+   */
+  std::optional<Result> takeResult();
+
+private:
+  using SliceFunction = std::function<void(int, std::size_t, std::size_t)>;
+
+  struct Buffers
+  {
+    std::vector<float> vertices;
+    std::vector<uint32_t> colors;
+    std::vector<uint32_t> indices;
+    std::size_t splats{};
+    bool verticesChanged{};
+    bool colorsChanged{};
+  };
+
+  void run();
+  void runHelper(int slice);
+  void sort(const Threedim::CpuSplats& raw, const Camera& cam);
+  void parallelSlices(int slices, std::size_t count, const SliceFunction& f);
+  static bool moved(const Camera& prev, const Camera& cur) noexcept;
+
+  const Layout m_layout;
+  const int m_maxSlices;
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+
+  // Protected by m_mutex
+  Threedim::CpuSplats m_raw;
+  Camera m_camera{};
+  Camera m_sortedCamera{};
+  Buffers m_ready;
+  bool m_request{};
+  bool m_hasSorted{};
+  bool m_resultReady{};
+  bool m_running{true};
+
+  // Render thread
+  Buffers m_front;
+
+  // Worker thread
+  Buffers m_back;
+  std::vector<float> m_splats;
+  // What the last geometry and colors produced were computed from
+  Threedim::CpuSplats m_geometrySplats;
+  float m_geometryScale{};
+  uint32_t m_colorsDegree{};
+  std::vector<uint16_t> m_keys;
+  std::vector<uint32_t> m_histograms;
+
+  // Slices of the sort given to the helper threads, protected by m_sliceMutex
+  std::mutex m_sliceMutex;
+  std::condition_variable m_sliceStart;
+  std::condition_variable m_sliceDone;
+  const SliceFunction* m_sliceFunction{};
+  std::size_t m_sliceCount{};
+  int m_slices{};
+  int m_slicesPending{};
+  uint64_t m_sliceGeneration{};
+  bool m_helpersRunning{true};
+
+  std::thread m_thread;
+  std::vector<std::thread> m_helpers;
+};
+}
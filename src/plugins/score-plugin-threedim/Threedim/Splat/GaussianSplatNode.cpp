@@ -8,6 +8,8 @@
 
 #include <QDebug>
 
+#include <utility>
+
 #if defined(near)
 #undef near
 #undef far
@@ -424,7 +426,8 @@ void GaussianSplatRenderer::createRenderPipeline(RenderList& renderer)
            << "sortIndicesBuf=" << (void*)m_sortIndicesBuffer
            << "enableSorting=" << m_node.enableSorting;
 
-  if(!m_renderSplatBuffer)
+  const bool cpuPath = m_cpuSorter != nullptr;
+  if(!cpuPath && !m_renderSplatBuffer)
   {
     qWarning() << "[GaussianSplat] No renderSplatBuffer, cannot create render pipeline";
     return;
@@ -437,34 +440,54 @@ void GaussianSplatRenderer::createRenderPipeline(RenderList& renderer)
 
   auto& rhi = *renderer.state.rhi;
 
+  const bool indexed = cpuPath && m_cpuIndexed;
+  const bool expanded = cpuPath && !m_cpuIndexed;
+  const QString vertexShader
+      = QString(GaussianSplatShaders::vertex_shader_header)
+        + (indexed    ? GaussianSplatShaders::vertex_shader_indexed_fetch
+           : expanded ? GaussianSplatShaders::vertex_shader_attribute_fetch
+                      : GaussianSplatShaders::vertex_shader_storage_fetch)
+        + (cpuPath ? GaussianSplatShaders::vertex_shader_attribute_corner
+                   : GaussianSplatShaders::vertex_shader_index_corner)
+        + GaussianSplatShaders::vertex_shader_main;
+
   auto [vertex, fragment] = score::gfx::makeShaders(
-      renderer.state, GaussianSplatShaders::vertex_shader,
-      GaussianSplatShaders::fragment_shader);
+      renderer.state, vertexShader, GaussianSplatShaders::fragment_shader);
 
   if(!vertex.isValid())
     qWarning() << "[GaussianSplat] vertex_shader compilation FAILED";
   if(!fragment.isValid())
     qWarning() << "[GaussianSplat] fragment_shader compilation FAILED";
 
-  // All 3 bindings must always be present (the shader declares them all).
-  QRhiBuffer* indicesBuf = (m_sortIndicesBuffer && m_node.enableSorting)
-                               ? m_sortIndicesBuffer
-                               : m_dummyStorageBuffer;
-
-  qDebug() << "[GaussianSplat] Render bindings: b0=renderSplat("
-           << m_renderSplatBuffer->size() << ") b1=indices("
-           << indicesBuf->size() << ") b2=uniform("
-           << m_uniformBuffer->size() << ")";
-
   m_bindings = rhi.newShaderResourceBindings();
-  m_bindings->setBindings({
-      QRhiShaderResourceBinding::bufferLoad(
-          0, QRhiShaderResourceBinding::VertexStage, m_renderSplatBuffer),
-      QRhiShaderResourceBinding::bufferLoad(
-          1, QRhiShaderResourceBinding::VertexStage, indicesBuf),
-      QRhiShaderResourceBinding::uniformBuffer(
-          2, QRhiShaderResourceBinding::VertexStage, m_uniformBuffer),
-  });
+  if(cpuPath)
+  {
+    m_bindings->setBindings({
+        QRhiShaderResourceBinding::uniformBuffer(
+            2, QRhiShaderResourceBinding::VertexStage, m_uniformBuffer),
+    });
+  }
+  else
+  {
+    // All 3 bindings must always be present (the shader declares them all).
+    QRhiBuffer* indicesBuf = (m_sortIndicesBuffer && m_node.enableSorting)
+                                 ? m_sortIndicesBuffer
+                                 : m_dummyStorageBuffer;
+
+    qDebug() << "[GaussianSplat] Render bindings: b0=renderSplat("
+             << m_renderSplatBuffer->size() << ") b1=indices("
+             << indicesBuf->size() << ") b2=uniform("
+             << m_uniformBuffer->size() << ")";
+
+    m_bindings->setBindings({
+        QRhiShaderResourceBinding::bufferLoad(
+            0, QRhiShaderResourceBinding::VertexStage, m_renderSplatBuffer),
+        QRhiShaderResourceBinding::bufferLoad(
+            1, QRhiShaderResourceBinding::VertexStage, indicesBuf),
+        QRhiShaderResourceBinding::uniformBuffer(
+            2, QRhiShaderResourceBinding::VertexStage, m_uniformBuffer),
+    });
+  }
   if(!m_bindings->create())
   {
     qWarning() << "[GaussianSplat] Render SRB creation FAILED";
@@ -478,8 +501,37 @@ void GaussianSplatRenderer::createRenderPipeline(RenderList& renderer)
       {{QRhiShaderStage::Vertex, vertex},
        {QRhiShaderStage::Fragment, fragment}});
 
-  // No vertex input — quad vertices generated in shader
+  // Quad vertices are generated in the shader.
+  // In the indexed CPU path, each of the four vertices of a splat reads its
+  // geometry and corner, and its color from a second stream.
+  // Otherwise, each of the six vertices of a sorted splat reads the RenderSplat
+  // followed by its corner.
   QRhiVertexInputLayout inputLayout;
+  if(indexed)
+  {
+    inputLayout.setBindings(
+        {{quint32(CpuSplatSorter::floatsPerIndexedVertex * sizeof(float)),
+          QRhiVertexInputBinding::PerVertex},
+         {quint32(sizeof(uint32_t)), QRhiVertexInputBinding::PerVertex}});
+    inputLayout.setAttributes(
+        {{0, 0, QRhiVertexInputAttribute::Float4, 0},
+         {0, 1, QRhiVertexInputAttribute::Float4, 16},
+         {0, 2, QRhiVertexInputAttribute::Float4, 32},
+         {1, 3, QRhiVertexInputAttribute::UNormByte4, 0},
+         {0, 4, QRhiVertexInputAttribute::Float2, 48}});
+  }
+  else if(expanded)
+  {
+    inputLayout.setBindings(
+        {{quint32(CpuSplatSorter::floatsPerExpandedVertex * sizeof(float)),
+          QRhiVertexInputBinding::PerVertex}});
+    inputLayout.setAttributes(
+        {{0, 0, QRhiVertexInputAttribute::Float4, 0},
+         {0, 1, QRhiVertexInputAttribute::Float4, 16},
+         {0, 2, QRhiVertexInputAttribute::Float4, 32},
+         {0, 3, QRhiVertexInputAttribute::Float4, 48},
+         {0, 4, QRhiVertexInputAttribute::Float2, 64}});
+  }
   m_pipeline->setVertexInputLayout(inputLayout);
 
   m_pipeline->setTopology(QRhiGraphicsPipeline::Triangles);
@@ -574,9 +626,12 @@ void GaussianSplatRenderer::init(RenderList& renderer, QRhiResourceUpdateBatch&
   m_uniformBuffer->create();
 
   // Dummy storage buffer
-  m_dummyStorageBuffer
-      = rhi.newBuffer(QRhiBuffer::Immutable, QRhiBuffer::StorageBuffer, 16);
-  m_dummyStorageBuffer->create();
+  if(rhi.isFeatureSupported(QRhi::Compute))
+  {
+    m_dummyStorageBuffer
+        = rhi.newBuffer(QRhiBuffer::Immutable, QRhiBuffer::StorageBuffer, 16);
+    m_dummyStorageBuffer->create();
+  }
 
   // Default mesh (required by base class)
   const auto& mesh = renderer.defaultQuad();
@@ -665,9 +720,20 @@ void GaussianSplatRenderer::update(
 
     if(m_rawSplatBuffer && splatCount > 0)
     {
-      createPreprocessPipeline(renderer);
-      if(m_node.enableSorting)
-        createSortPipelines(renderer);
+      if(renderer.state.rhi->isFeatureSupported(QRhi::Compute))
+      {
+        createPreprocessPipeline(renderer);
+        if(m_node.enableSorting)
+          createSortPipelines(renderer);
+      }
+      else if(!m_cpuSorter)
+      {
+        auto& rhi = *renderer.state.rhi;
+        m_cpuIndexed = rhi.isFeatureSupported(QRhi::ElementIndexUint);
+        m_cpuSorter = std::make_unique<CpuSplatSorter>(
+            m_cpuIndexed ? CpuSplatSorter::Layout::Indexed
+                         : CpuSplatSorter::Layout::Expanded);
+      }
       createRenderPipeline(renderer);
     }
     else
@@ -709,13 +775,13 @@ void GaussianSplatRenderer::update(
   {
     float viewport[2];
     float _pad0;
-    uint32_t useSorting;
+    int32_t useSorting;
   } tail;
 
   tail.viewport[0] = float(state.renderSize.width());
   tail.viewport[1] = float(state.renderSize.height());
   tail._pad0 = 0.f;
-  tail.useSorting = m_node.enableSorting && m_sortResourcesCreated ? 1u : 0u;
+  tail.useSorting = m_node.enableSorting && m_sortResourcesCreated ? 1 : 0;
 
   char buf[3 * 64 + 16];
   memcpy(buf, modelView.constData(), 64);
@@ -725,6 +791,16 @@ void GaussianSplatRenderer::update(
 
   res.updateDynamicBuffer(m_uniformBuffer, 0, sizeof(buf), buf);
 
+  // Camera position in model space for SH evaluation
+  const QVector3D worldCamPos{m_node.position[0], m_node.position[1], m_node.position[2]};
+  const QVector3D modelCamPos = model.inverted().map(worldCamPos);
+
+  if(m_cpuSorter)
+  {
+    updateCpuSplats(renderer, res, modelView, modelCamPos);
+    return;
+  }
+
   // Update preprocess uniforms
   if(m_preprocessUniformBuffer && m_rawSplatBuffer)
   {
@@ -741,9 +817,6 @@ void GaussianSplatRenderer::update(
 
     memcpy(ppUniforms.viewMatrix, modelView.constData(), 64);
 
-    // Camera position in model space for SH evaluation
-    QVector3D worldCamPos{m_node.position[0], m_node.position[1], m_node.position[2]};
-    QVector3D modelCamPos = model.inverted().map(worldCamPos);
     ppUniforms.camPos[0] = modelCamPos.x();
     ppUniforms.camPos[1] = modelCamPos.y();
     ppUniforms.camPos[2] = modelCamPos.z();
@@ -777,6 +850,100 @@ void GaussianSplatRenderer::update(
   }
 }
 
+// Creates the buffer or resizes it in place when needed, then uploads the data
+template <typename T>
+static bool uploadCpuBuffer(
+    QRhi& rhi, QRhiResourceUpdateBatch& res, QRhiBuffer*& buf, QRhiBuffer::Type type,
+    QRhiBuffer::UsageFlags usage, const std::vector<T>& data)
+{
+  const quint32 bytes = data.size() * sizeof(T);
+  if(!buf || buf->size() != bytes)
+  {
+    if(!buf)
+    {
+      buf = rhi.newBuffer(type, usage, bytes);
+    }
+    else
+    {
+      buf->destroy();
+      buf->setSize(bytes);
+    }
+
+    if(!buf->create())
+    {
+      qWarning() << "[GaussianSplat] Failed to create CPU splat buffer size=" << bytes;
+      delete buf;
+      buf = nullptr;
+      return false;
+    }
+  }
+
+  if(type == QRhiBuffer::Dynamic)
+    res.updateDynamicBuffer(buf, 0, bytes, data.data());
+  else
+    res.uploadStaticBuffer(buf, 0, bytes, data.data());
+  return true;
+}
+
+void GaussianSplatRenderer::updateCpuSplats(
+    RenderList& renderer, QRhiResourceUpdateBatch& res, const QMatrix4x4& modelView,
+    QVector3D modelCamPos)
+{
+  CpuSplatSorter::Camera cam;
+  memcpy(cam.modelView, modelView.constData(), 64);
+  cam.position[0] = modelCamPos.x();
+  cam.position[1] = modelCamPos.y();
+  cam.position[2] = modelCamPos.z();
+  cam.nearPlane = m_node.near;
+  cam.farPlane = m_node.far;
+  cam.scaleMod = m_node.scaleFactor;
+  cam.shDegree = m_node.shDegree;
+  cam.sort = m_node.enableSorting;
+  m_cpuSorter->setCamera(cam);
+
+  // The loader keeps a CPU copy of what it uploaded in the input buffer.
+  // The camera is set first so that the first sort already uses it.
+  if(auto raw = Threedim::cpuSplats(m_rawSplatBuffer); raw != m_cpuSplats)
+  {
+    m_cpuSplats = raw;
+    m_cpuSorter->setSplats(std::move(raw));
+  }
+
+  const auto result = m_cpuSorter->takeResult();
+  if(!result)
+    return;
+
+  m_cpuSplatCount = 0;
+  if(result->splats == 0)
+    return;
+
+  // The indexed geometry only changes with the splats: it is uploaded once.
+  // What a sort rewrites is updated in place.
+  auto& rhi = *renderer.state.rhi;
+  const auto vertexType = m_cpuIndexed ? QRhiBuffer::Static : QRhiBuffer::Dynamic;
+  if(result->vertices
+     && !uploadCpuBuffer(
+         rhi, res, m_cpuVertexBuffer, vertexType, QRhiBuffer::VertexBuffer,
+         *result->vertices))
+    return;
+
+  if(m_cpuIndexed)
+  {
+    if(result->colors
+       && !uploadCpuBuffer(
+           rhi, res, m_cpuColorBuffer, QRhiBuffer::Dynamic, QRhiBuffer::VertexBuffer,
+           *result->colors))
+      return;
+
+    if(!uploadCpuBuffer(
+           rhi, res, m_cpuIndexBuffer, QRhiBuffer::Dynamic, QRhiBuffer::IndexBuffer,
+           *result->indices))
+      return;
+  }
+
+  m_cpuSplatCount = result->splats;
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Compute passes: preprocess → sort
 // ─────────────────────────────────────────────────────────────────────────────
@@ -946,6 +1113,37 @@ void GaussianSplatRenderer::runInitialPasses(
 void GaussianSplatRenderer::runRenderPass(
     RenderList& renderer, QRhiCommandBuffer& cb, Edge& edge)
 {
+  if(m_cpuSorter)
+  {
+    if(!m_pipeline || !m_cpuVertexBuffer || m_cpuSplatCount <= 0)
+      return;
+    if(m_cpuIndexed && (!m_cpuColorBuffer || !m_cpuIndexBuffer))
+      return;
+
+    cb.setGraphicsPipeline(m_pipeline);
+    cb.setShaderResources(m_bindings);
+    cb.setViewport(
+        QRhiViewport{
+            0, 0, (float)renderer.state.renderSize.width(),
+            (float)renderer.state.renderSize.height()});
+
+    if(m_cpuIndexed)
+    {
+      const QRhiCommandBuffer::VertexInput inputs[]{
+          {m_cpuVertexBuffer, 0}, {m_cpuColorBuffer, 0}};
+      cb.setVertexInput(
+          0, 2, inputs, m_cpuIndexBuffer, 0, QRhiCommandBuffer::IndexUInt32);
+      cb.drawIndexed(CpuSplatSorter::indicesPerSplat * m_cpuSplatCount);
+    }
+    else
+    {
+      const QRhiCommandBuffer::VertexInput input{m_cpuVertexBuffer, 0};
+      cb.setVertexInput(0, 1, &input);
+      cb.draw(CpuSplatSorter::verticesPerSplat * m_cpuSplatCount);
+    }
+    return;
+  }
+
   if(!m_pipeline || !m_renderSplatBuffer)
   {
     static bool logged = false;
@@ -1058,6 +1256,17 @@ void GaussianSplatRenderer::release(RenderList& r)
   m_sortSrbAlt = nullptr;
   m_sortResourcesCreated = false;
 
+  // CPU fallback
+  m_cpuSorter.reset();
+  m_cpuSplats.reset();
+  delete m_cpuVertexBuffer;
+  m_cpuVertexBuffer = nullptr;
+  delete m_cpuColorBuffer;
+  m_cpuColorBuffer = nullptr;
+  delete m_cpuIndexBuffer;
+  m_cpuIndexBuffer = nullptr;
+  m_cpuSplatCount = 0;
+
   m_rawSplatBuffer = nullptr;
 }
 
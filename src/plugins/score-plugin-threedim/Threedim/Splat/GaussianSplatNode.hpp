@@ -7,6 +7,10 @@
 
 #include <ossia/detail/pod_vector.hpp>
 
+#include <Threedim/Splat/CpuSplatSort.hpp>
+
+#include <memory>
+
 // clang-format off
 #if defined(near)
 #undef near
@@ -30,6 +34,12 @@ namespace score::gfx
  *   3. Radix sort (compute): sorts indices back-to-front
  *   4. Render pass: instanced alpha-blended quads using sorted indices
  *
+ * Without compute shaders, steps 1 to 3 run on the CPU (see CpuSplatSorter)
+ * on the copy of the splats kept by the SplatLoader. The quads of the splats
+ * are uploaded once and drawn through an index buffer in sorted order,
+ * or as six vertices per splat rewritten at each sort when 32-bit indices
+ * are not supported.
+ *
  * Input ports:
  *   - Raw Splat Buffer: GPU storage buffer, 256 bytes per splat
  *     (layout matches GaussianSplatData from Ply.hpp)
@@ -89,6 +99,9 @@ private:
   void createPreprocessPipeline(RenderList& renderer);
   void createRenderPipeline(RenderList& renderer);
   void createSortPipelines(RenderList& renderer);
+  void updateCpuSplats(
+      RenderList& renderer, QRhiResourceUpdateBatch& res,
+      const QMatrix4x4& modelView, QVector3D modelCamPos);
 
   const GaussianSplatNode& m_node;
 
@@ -128,6 +141,15 @@ private:
   QRhiShaderResourceBindings* m_sortSrb{};
   QRhiShaderResourceBindings* m_sortSrbAlt{}; // For ping-pong
 
+  // CPU fallback when compute is not available
+  std::unique_ptr<CpuSplatSorter> m_cpuSorter;
+  Threedim::CpuSplats m_cpuSplats; // Given to m_cpuSorter
+  QRhiBuffer* m_cpuVertexBuffer{}; // Indexed geometry, or expanded sorted splats
+  QRhiBuffer* m_cpuColorBuffer{};  // Indexed: RGBA8 color of each vertex
+  QRhiBuffer* m_cpuIndexBuffer{};  // Indexed: quads in draw order
+  int64_t m_cpuSplatCount{};
+  bool m_cpuIndexed{};
+
   ossia::small_vector<Sampler, 8> m_samplers;
 
   int64_t m_lastSplatCount{0};
@@ -600,7 +622,7 @@ void main() {
 // RENDER SHADERS
 //=============================================================================
 
-static constexpr auto vertex_shader = R"_(#version 450
+static constexpr auto vertex_shader_header = R"_(#version 450
 
 // Quad vertex positions
 const vec2 positions[6] = vec2[6](
@@ -612,7 +634,7 @@ const vec2 positions[6] = vec2[6](
     vec2(-1.0,  1.0)
 );
 
-// Compact rendering splat (output of preprocess compute shader)
+// Compact rendering splat (output of the preprocess)
 struct RenderSplat {
     vec4 position;  // xyz = position
     vec4 scale;     // xyz = scale (already exp'd)
@@ -620,22 +642,13 @@ struct RenderSplat {
     vec4 color;     // RGBA (SH evaluated, sigmoid applied)
 };
 
-layout(std430, binding = 0) readonly buffer SplatBuffer {
-    RenderSplat splats[];
-};
-
-// Sorted indices from depth sort pass
-layout(std430, binding = 1) readonly buffer SortedIndices {
-    uint sortedIndices[];
-};
-
 layout(std140, binding = 2) uniform Uniforms {
     mat4 view;
     mat4 projection;
     mat4 clipSpaceCorr;
     vec2 viewport;
     float _pad0;
-    uint useSorting; // 0 = no sorting, 1 = use sorted indices
+    int useSorting; // 0 = no sorting, 1 = use sorted indices (int for GLSL ES 100)
 };
 
 layout(location = 0) out vec2 f_center;  // screen-space splat center (pixels)
@@ -651,12 +664,74 @@ mat3 quatToMat(vec4 q) {
         2.0*(x*z + w*y), 2.0*(y*z - w*x), 1.0 - 2.0*(x*x + y*y)    // col 2
     );
 }
+)_";
 
-void main() {
+// Splats read from the storage buffers written by the compute passes
+static constexpr auto vertex_shader_storage_fetch = R"_(
+layout(std430, binding = 0) readonly buffer SplatBuffer {
+    RenderSplat splats[];
+};
+
+// Sorted indices from depth sort pass
+layout(std430, binding = 1) readonly buffer SortedIndices {
+    uint sortedIndices[];
+};
+
+RenderSplat fetchSplat() {
     // Get splat index (sorted or unsorted)
     uint splatIdx = useSorting != 0 ? sortedIndices[gl_InstanceIndex] : gl_InstanceIndex;
-    RenderSplat splat = splats[splatIdx];
-    vec2 quadPos = positions[gl_VertexIndex];
+    return splats[splatIdx];
+}
+)_";
+
+// Geometry of the splat at a corner of its quad, with the color, which changes
+// with the view direction, in a separate stream: the indexed CPU path.
+static constexpr auto vertex_shader_indexed_fetch = R"_(
+layout(location = 0) in vec4 i_position; // w: opacity
+layout(location = 1) in vec4 i_scale;
+layout(location = 2) in vec4 i_rotation;
+layout(location = 3) in vec4 i_color;
+
+RenderSplat fetchSplat() {
+    return RenderSplat(
+        vec4(i_position.xyz, 0.0), i_scale, i_rotation, vec4(i_color.rgb, i_position.w));
+}
+)_";
+
+// Splats as vertex attributes, already in draw order:
+// used by the CPU path on backends without compute, storage buffers
+// nor 32-bit indices.
+static constexpr auto vertex_shader_attribute_fetch = R"_(
+layout(location = 0) in vec4 i_position;
+layout(location = 1) in vec4 i_scale;
+layout(location = 2) in vec4 i_rotation;
+layout(location = 3) in vec4 i_color;
+
+RenderSplat fetchSplat() {
+    return RenderSplat(i_position, i_scale, i_rotation, i_color);
+}
+)_";
+
+// One splat per instance: the corner comes from the vertex index
+static constexpr auto vertex_shader_index_corner = R"_(
+vec2 fetchCorner() {
+    return positions[gl_VertexIndex];
+}
+)_";
+
+// In the CPU path, each vertex of the quad carries its corner
+static constexpr auto vertex_shader_attribute_corner = R"_(
+layout(location = 4) in vec2 i_corner;
+
+vec2 fetchCorner() {
+    return i_corner;
+}
+)_";
+
+static constexpr auto vertex_shader_main = R"_(
+void main() {
+    RenderSplat splat = fetchSplat();
+    vec2 quadPos = fetchCorner();
 
     // Early opacity cull: skip splats that are nearly invisible
     if (splat.color.a < 1.0 / 255.0) {
@@ -0,0 +1,91 @@
+#include <AvndProcesses/AudioRingBuffer.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+namespace
+{
+// Two channels, the second one is the negative of the first
+struct input
+{
+  explicit input(int frames, double start)
+      : left(frames)
+      , right(frames)
+  {
+    for(int i = 0; i < frames; i++)
+    {
+      left[i] = start + i;
+      right[i] = -(start + i);
+    }
+  }
+
+  std::vector<double> left, right;
+  const double* chans[2]{left.data(), right.data()};
+};
+
+std::vector<float> read(avnd_tools::audio_ring_buffer& ring, int64_t end, int channel)
+{
+  std::vector<float> res;
+  ring.consume(end, [&](const float** chans, int64_t n) {
+    res.insert(res.end(), chans[channel], chans[channel] + n);
+  });
+  return res;
+}
+}
+
+TEST_CASE("audio_ring_buffer keeps the channels apart", "[avnd][recorder]")
+{
+  avnd_tools::audio_ring_buffer ring{2, 10};
+  REQUIRE(ring.capacity() == 16);
+
+  input in{6, 1};
+  CHECK(ring.write(in.chans, 6) == 6);
+  CHECK(ring.write_position() == 6);
+
+  ring.skip_to(2);
+  const auto l = read(ring, 4, 0);
+  CHECK(l == std::vector<float>{3, 4});
+  CHECK(ring.read_position() == 4);
+
+  const auto r = read(ring, 100, 1);
+  CHECK(r == std::vector<float>{-5, -6});
+  CHECK(ring.read_position() == 6);
+}
+
+TEST_CASE("audio_ring_buffer wraps around", "[avnd][recorder]")
+{
+  avnd_tools::audio_ring_buffer ring{2, 8};
+
+  input first{6, 0};
+  ring.write(first.chans, 6);
+  ring.skip_to(6);
+
+  input second{5, 6};
+  CHECK(ring.write(second.chans, 5) == 5);
+
+  int runs = 0;
+  std::vector<float> res;
+  ring.consume(ring.write_position(), [&](const float** chans, int64_t n) {
+    runs++;
+    res.insert(res.end(), chans[0], chans[0] + n);
+  });
+  CHECK(runs == 2);
+  CHECK(res == std::vector<float>{6, 7, 8, 9, 10});
+}
+
+TEST_CASE("audio_ring_buffer counts the dropped frames", "[avnd][recorder]")
+{
+  avnd_tools::audio_ring_buffer ring{2, 4};
+
+  input in{6, 0};
+  CHECK(ring.write(in.chans, 6) == 4);
+  CHECK(ring.overruns() == 2);
+  CHECK(ring.write(in.chans, 1) == 0);
+  CHECK(ring.overruns() == 3);
+
+  // The oldest frames are kept
+  CHECK(read(ring, 4, 0) == std::vector<float>{0, 1, 2, 3});
+  CHECK(ring.write(in.chans, 2) == 2);
+  CHECK(ring.overruns() == 3);
+}
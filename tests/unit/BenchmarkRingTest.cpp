@@ -0,0 +1,81 @@
+#include <Execution/BenchmarkRing.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+const auto* node(int i)
+{
+  return reinterpret_cast<const ossia::graph_node*>(std::uintptr_t(16 * (i + 1)));
+}
+}
+
+TEST_CASE("BenchmarkRing publishes whole ticks", "[engine][bench]")
+{
+  Execution::BenchmarkRing ring{16};
+  std::vector<Execution::BenchmarkSample> read;
+  auto collect = [&](const Execution::BenchmarkSample& s) { read.push_back(s); };
+
+  ring.push(node(0), 10);
+  ring.push(node(1), 20);
+
+  // Nothing visible before the tick is committed
+  CHECK(ring.consume(collect) == 0);
+
+  ring.commit(100);
+  REQUIRE(ring.consume(collect) == 3);
+  CHECK(read[0].node == node(0));
+  CHECK(read[0].ns == 10);
+  CHECK(read[1].node == node(1));
+  CHECK(read[2].node == nullptr);
+  CHECK(read[2].ns == 100);
+}
+
+TEST_CASE("BenchmarkRing drops ticks that do not fit", "[engine][bench]")
+{
+  Execution::BenchmarkRing ring{4};
+  REQUIRE(ring.capacity() == 4);
+
+  for(int i = 0; i < 8; i++)
+    ring.push(node(i), i);
+  ring.commit(1000);
+  CHECK(ring.dropped() == 1);
+
+  std::size_t n = ring.consume([](const auto&) { });
+  CHECK(n == 0);
+
+  // The ring is usable again afterwards
+  ring.push(node(0), 5);
+  ring.commit(50);
+  CHECK(ring.consume([](const auto&) { }) == 2);
+  CHECK(ring.dropped() == 1);
+}
+
+TEST_CASE("BenchmarkAggregator statistics", "[engine][bench]")
+{
+  Execution::BenchmarkRing ring{1024};
+  Execution::BenchmarkAggregator agg;
+
+  for(int i = 1; i <= 100; i++)
+  {
+    ring.push(node(0), i);
+    ring.commit(1000);
+  }
+  agg.consume(ring);
+
+  auto s = agg.statistics(node(0));
+  CHECK(s.count == 100);
+  CHECK(s.min == 1);
+  CHECK(s.max == 100);
+  CHECK(s.mean == 50);
+  CHECK(s.p99 == 99);
+
+  CHECK(agg.total().mean == 1000);
+  CHECK(agg.statistics(node(1)).count == 0);
+
+  agg.remove(node(0));
+  CHECK(agg.statistics(node(0)).count == 0);
+}
@@ -0,0 +1,181 @@
+// Unit tests for score::CommandBackupFile::toCommandStack: replaying the
+// on-disk command journal into the data loadCommandStack expects.
+
+#include <score/command/CommandData.hpp>
+#include <score/plugins/StringFactoryKeySerialization.hpp>
+#include <score/serialization/DataStreamVisitor.hpp>
+
+#include <core/application/CommandBackupFile.hpp>
+
+#include <QDataStream>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+// Journal format, as written by CommandBackupFile
+constexpr quint64 journal_magic = 0x53434F52454A4E4CULL;
+constexpr quint32 journal_version = 1;
+enum RecordType : quint8
+{
+  Checkpoint = 0,
+  Push,
+  Undo,
+  Redo
+};
+
+score::CommandData command(const char* name)
+{
+  score::CommandData c;
+  c.parentKey = CommandGroupKey{"test"};
+  c.commandKey = CommandKey{name};
+  c.data = QByteArray{name};
+  return c;
+}
+
+QByteArray serialize(const score::CommandData& c)
+{
+  QByteArray res;
+  DataStream::Serializer ser(&res);
+  ser.readFrom(c);
+  return res;
+}
+
+QByteArray stackData(
+    const std::vector<const char*>& undo, const std::vector<const char*>& redo)
+{
+  std::vector<score::CommandData> undoStack, redoStack;
+  for(auto name : undo)
+    undoStack.push_back(command(name));
+  for(auto name : redo)
+    redoStack.push_back(command(name));
+
+  QByteArray res;
+  DataStream::Serializer ser(&res);
+  ser.readFrom(undoStack);
+  ser.readFrom(redoStack);
+  ser.insertDelimiter();
+  return res;
+}
+
+//! Names of the commands in the undo and redo stacks
+struct Stack
+{
+  std::vector<std::string> undo;
+  std::vector<std::string> redo;
+};
+
+Stack parse(const QByteArray& data)
+{
+  std::vector<score::CommandData> undoStack, redoStack;
+  DataStream::Deserializer writer{data};
+  writer.writeTo(undoStack);
+  writer.writeTo(redoStack);
+  writer.checkDelimiter();
+
+  Stack res;
+  for(const auto& c : undoStack)
+    res.undo.push_back(c.commandKey.toString());
+  for(const auto& c : redoStack)
+    res.redo.push_back(c.commandKey.toString());
+  return res;
+}
+
+struct Journal
+{
+  QByteArray data;
+  QDataStream stream{&data, QIODevice::WriteOnly};
+
+  explicit Journal(const QByteArray& checkpoint)
+  {
+    stream << journal_magic << journal_version;
+    record(Checkpoint, checkpoint);
+  }
+
+  void record(RecordType t, const QByteArray& payload = {})
+  {
+    stream << quint8(t) << payload;
+  }
+};
+}
+
+TEST_CASE("A journal replays pushes, undos and redos", "[unit][backup]")
+{
+  Journal j{stackData({"a"}, {})};
+  j.record(Push, serialize(command("b")));
+  j.record(Push, serialize(command("c")));
+  j.record(Undo);
+  j.record(Undo);
+  j.record(Redo);
+
+  auto s = parse(score::CommandBackupFile::toCommandStack(j.data));
+  CHECK(s.undo == std::vector<std::string>{"a", "b"});
+  CHECK(s.redo == std::vector<std::string>{"c"});
+
+  SECTION("A push clears the redo stack")
+  {
+    j.record(Push, serialize(command("d")));
+    s = parse(score::CommandBackupFile::toCommandStack(j.data));
+    CHECK(s.undo == std::vector<std::string>{"a", "b", "d"});
+    CHECK(s.redo.empty());
+  }
+
+  SECTION("Undo and redo past the ends of the stacks do nothing")
+  {
+    for(int i = 0; i < 5; i++)
+      j.record(Undo);
+    j.record(Redo);
+    s = parse(score::CommandBackupFile::toCommandStack(j.data));
+    CHECK(s.undo == std::vector<std::string>{"a"});
+    CHECK(s.redo == std::vector<std::string>{"c", "b"});
+  }
+
+  SECTION("A checkpoint replaces what came before")
+  {
+    j.record(Checkpoint, stackData({"x"}, {"y"}));
+    s = parse(score::CommandBackupFile::toCommandStack(j.data));
+    CHECK(s.undo == std::vector<std::string>{"x"});
+    CHECK(s.redo == std::vector<std::string>{"y"});
+  }
+}
+
+TEST_CASE("A truncated last record is ignored", "[unit][backup]")
+{
+  Journal j{stackData({"a"}, {})};
+  j.record(Push, serialize(command("b")));
+  const auto complete = j.data.size();
+  j.record(Push, serialize(command("c")));
+
+  // Cut anywhere in the last record: in its type, its size or its payload
+  for(auto size = complete; size < j.data.size(); size++)
+  {
+    auto s = parse(score::CommandBackupFile::toCommandStack(j.data.left(size)));
+    CHECK(s.undo == std::vector<std::string>{"a", "b"});
+    CHECK(s.redo.empty());
+  }
+}
+
+TEST_CASE("A backup from an older version is returned as-is", "[unit][backup]")
+{
+  // Before the journal, the file contained the whole stack
+  const auto legacy = stackData({"a", "b"}, {"c"});
+  const auto res = score::CommandBackupFile::toCommandStack(legacy);
+  CHECK(res == legacy);
+
+  auto s = parse(res);
+  CHECK(s.undo == std::vector<std::string>{"a", "b"});
+  CHECK(s.redo == std::vector<std::string>{"c"});
+}
+
+TEST_CASE("A journal from a newer version is not loaded", "[unit][backup]")
+{
+  QByteArray data;
+  QDataStream s{&data, QIODevice::WriteOnly};
+  s << journal_magic << quint32(journal_version + 1);
+  s << quint8(Checkpoint) << stackData({"a"}, {});
+
+  CHECK(score::CommandBackupFile::toCommandStack(data).isEmpty());
+}
@@ -0,0 +1,269 @@
+// Unit tests for RemoteControl::WS::IntervalStream: the messages sent to the
+// remote clients about the running intervals. Covers the binary frames, full
+// and delta, with their changed-field masks and stopped entries, and the JSON
+// messages which give an id to each interval.
+
+#include <RemoteControl/Websockets/IntervalStream.hpp>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstring>
+#include <map>
+
+using namespace RemoteControl::WS;
+
+namespace
+{
+struct Entry
+{
+  uint8_t fields{};
+  float progress{}, speed{}, gain{};
+};
+
+struct Frame
+{
+  bool full{};
+  std::map<uint32_t, Entry> entries;
+};
+
+// Reads a frame as a client does
+Frame parse(const QByteArray& buf)
+{
+  Frame f;
+  int pos = 0;
+  const auto u8 = [&] {
+    REQUIRE(pos + 1 <= buf.size());
+    return uint8_t(buf[pos++]);
+  };
+  const auto u32 = [&] {
+    REQUIRE(pos + 4 <= buf.size());
+    uint32_t v = 0;
+    for(int i = 0; i < 4; i++)
+      v |= uint32_t(uint8_t(buf[pos + i])) << (8 * i);
+    pos += 4;
+    return v;
+  };
+  const auto f32 = [&] {
+    const uint32_t v = u32();
+    float res;
+    std::memcpy(&res, &v, sizeof(res));
+    return res;
+  };
+
+  REQUIRE(u8() == 1);
+  const auto full = u8();
+  REQUIRE(full <= 1);
+  f.full = full == 1;
+
+  const uint32_t count = u32();
+  for(uint32_t i = 0; i < count; i++)
+  {
+    const uint32_t id = u32();
+    Entry e;
+    e.fields = u8();
+    if(e.fields & 1)
+      e.progress = f32();
+    if(e.fields & 2)
+      e.speed = f32();
+    if(e.fields & 4)
+      e.gain = f32();
+    REQUIRE(f.entries.emplace(id, e).second);
+  }
+  REQUIRE(pos == buf.size());
+  return f;
+}
+
+QJsonObject json(const QString& str)
+{
+  const auto doc = QJsonDocument::fromJson(str.toUtf8());
+  REQUIRE(doc.isObject());
+  return doc.object();
+}
+
+struct Stream
+{
+  IntervalStream stream;
+  IntervalMessages last;
+  int count{};
+
+  Stream()
+  {
+    QObject::connect(&stream, &IntervalStream::ready, [this](IntervalMessages m) {
+      last = std::move(m);
+      count++;
+    });
+  }
+
+  const IntervalMessages& process(IntervalUpdate u)
+  {
+    stream.process(std::move(u));
+    return last;
+  }
+};
+
+QByteArray path(const char* name)
+{
+  return QByteArray("[\"") + name + "\"]";
+}
+}
+
+TEST_CASE("New intervals get all their fields", "[unit][remotecontrol]")
+{
+  Stream s;
+  const auto& m = s.process(
+      {.running = {{.id = 1, .progress = 0.25, .speed = 1., .gain = 0.5},
+                   {.id = 2, .progress = 0., .speed = 2., .gain = 1.}}});
+  REQUIRE(s.count == 1);
+
+  const auto f = parse(m.delta);
+  CHECK_FALSE(f.full);
+  REQUIRE(f.entries.size() == 2);
+  CHECK(f.entries.at(1).fields == (1 | 2 | 4));
+  CHECK(f.entries.at(1).progress == 0.25f);
+  CHECK(f.entries.at(1).speed == 1.f);
+  CHECK(f.entries.at(1).gain == 0.5f);
+  CHECK(f.entries.at(2).speed == 2.f);
+
+  // Nobody subscribed
+  CHECK(m.full.isEmpty());
+  CHECK(m.allIdentifiers.isEmpty());
+}
+
+TEST_CASE("Delta frames only contain the changed fields", "[unit][remotecontrol]")
+{
+  Stream s;
+  s.process({.running = {{.id = 1, .progress = 0.1, .speed = 1., .gain = 1.},
+                         {.id = 2, .progress = 0.1, .speed = 1., .gain = 1.}}});
+
+  const auto& m = s.process(
+      {.running = {{.id = 1, .progress = 0.2, .speed = 1., .gain = 1.},
+                   {.id = 2, .progress = 0.1, .speed = 1.5, .gain = 0.}}});
+  const auto f = parse(m.delta);
+  REQUIRE(f.entries.size() == 2);
+  CHECK(f.entries.at(1).fields == 1);
+  CHECK(f.entries.at(1).progress == 0.2f);
+  CHECK(f.entries.at(2).fields == (2 | 4));
+  CHECK(f.entries.at(2).speed == 1.5f);
+  CHECK(f.entries.at(2).gain == 0.f);
+
+  // Changes smaller than a float32 are not sent
+  const auto& same = s.process(
+      {.running = {{.id = 1, .progress = 0.2 + 1e-12, .speed = 1., .gain = 1.},
+                   {.id = 2, .progress = 0.1, .speed = 1.5, .gain = 0.}}});
+  CHECK(same.delta.isEmpty());
+}
+
+TEST_CASE("Stopped intervals are sent once", "[unit][remotecontrol]")
+{
+  Stream s;
+  s.process({.running = {{.id = 1, .progress = 0.5, .speed = 1., .gain = 1.},
+                         {.id = 2, .progress = 0.5, .speed = 1., .gain = 1.}}});
+
+  const auto& m
+      = s.process({.running = {{.id = 2, .progress = 0.5, .speed = 1., .gain = 1.}}});
+  const auto f = parse(m.delta);
+  REQUIRE(f.entries.size() == 1);
+  CHECK(f.entries.at(1).fields == 8);
+
+  CHECK(s.process({.running = {{.id = 2, .progress = 0.5, .speed = 1., .gain = 1.}}})
+            .delta.isEmpty());
+
+  // Started again
+  const auto& again = s.process(
+      {.running = {{.id = 1, .progress = 0., .speed = 1., .gain = 1.},
+                   {.id = 2, .progress = 0.5, .speed = 1., .gain = 1.}}});
+  const auto g = parse(again.delta);
+  REQUIRE(g.entries.size() == 1);
+  CHECK(g.entries.at(1).fields == (1 | 2 | 4));
+}
+
+TEST_CASE("Full frames contain every running interval", "[unit][remotecontrol]")
+{
+  Stream s;
+  s.process({.running = {{.id = 1, .progress = 0.5, .speed = 1., .gain = 1.},
+                         {.id = 2, .progress = 0.5, .speed = 1., .gain = 1.}}});
+
+  // Nothing changed, but a client subscribed
+  const auto& m = s.process(
+      {.running = {{.id = 1, .progress = 0.5, .speed = 1., .gain = 1.},
+                   {.id = 2, .progress = 0.5, .speed = 1., .gain = 1.}},
+       .full = true});
+  CHECK(m.delta.isEmpty());
+
+  const auto f = parse(m.full);
+  CHECK(f.full);
+  REQUIRE(f.entries.size() == 2);
+  for(const auto& [id, e] : f.entries)
+  {
+    CHECK(e.fields == (1 | 2 | 4));
+    CHECK(e.progress == 0.5f);
+  }
+
+  // No running interval
+  const auto& empty = s.process({.full = true});
+  CHECK(parse(empty.full).entries.empty());
+  CHECK(parse(empty.delta).entries.size() == 2);
+}
+
+TEST_CASE("Ids are added and removed", "[unit][remotecontrol]")
+{
+  Stream s;
+  const auto& m = s.process({.added = {{1, path("A")}, {2, path("B")}}});
+  CHECK(m.delta.isEmpty());
+
+  auto ids = json(m.identifiers);
+  CHECK(ids["Message"].toString() == "IntervalIds");
+  const auto added = ids["Added"].toArray();
+  REQUIRE(added.size() == 2);
+  CHECK(added[0].toObject()["Id"].toInt() == 1);
+  CHECK(added[0].toObject()["Path"].toArray() == QJsonArray{"A"});
+  CHECK(added[1].toObject()["Id"].toInt() == 2);
+  CHECK(ids["Removed"].toArray().isEmpty());
+
+  const auto& r = s.process({.removed = {1}});
+  ids = json(r.identifiers);
+  CHECK(ids["Added"].toArray().isEmpty());
+  CHECK(ids["Removed"].toArray() == QJsonArray{1});
+
+  // Nothing changed
+  CHECK(s.process({}).identifiers.isEmpty());
+
+  // The new subscribers get the ids which are still there
+  const auto& full = s.process({.full = true});
+  CHECK(full.identifiers.isEmpty());
+  ids = json(full.allIdentifiers);
+  const auto all = ids["Added"].toArray();
+  REQUIRE(all.size() == 1);
+  CHECK(all[0].toObject()["Id"].toInt() == 2);
+  CHECK(all[0].toObject()["Path"].toArray() == QJsonArray{"B"});
+  CHECK(ids["Removed"].toArray().isEmpty());
+}
+
+TEST_CASE("The JSON document is sent when something changed", "[unit][remotecontrol]")
+{
+  Stream s;
+  const auto& m = s.process(
+      {.running = {{.id = 1, .progress = 0.5, .speed = 1., .gain = 0.25},
+                   {.id = 2, .progress = 0.5, .speed = 1., .gain = 1.}},
+       .added = {{1, path("A")}},
+       .json = true});
+
+  // Only the intervals with a path
+  const auto doc = json(m.json);
+  const auto intervals = doc["Intervals"].toArray();
+  REQUIRE(intervals.size() == 1);
+  const auto i = intervals[0].toObject();
+  CHECK(i["Path"].toArray() == QJsonArray{"A"});
+  CHECK(i["Progress"].toDouble() == 0.5);
+  CHECK(i["Speed"].toDouble() == 1.);
+  CHECK(i["Gain"].toDouble() == 0.25);
+
+  CHECK(s.process({.running = {{.id = 1, .progress = 0.5, .speed = 1., .gain = 0.25},
+                               {.id = 2, .progress = 0.5, .speed = 1., .gain = 1.}},
+                   .json = true})
+            .json.isEmpty());
+}
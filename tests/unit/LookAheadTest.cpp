@@ -0,0 +1,131 @@
+// Unit tests for the execution look-ahead: the dates at which the time syncs
+// of a scenario are estimated to execute, and which intervals get their
+// processes created.
+
+#include <Scenario/Document/Interval/LookAhead.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace Execution;
+
+namespace
+{
+TimeVal sec(double s)
+{
+  return TimeVal::fromMsecs(1000. * s);
+}
+
+const auto lookAhead = sec(5);
+
+//! Time syncs at 0, 10, 20, ... and an interval between each of them
+struct Chain
+{
+  std::vector<LookAheadSync> syncs;
+  std::vector<LookAheadInterval> intervals;
+
+  explicit Chain(int count)
+  {
+    for(int i = 0; i <= count; i++)
+      syncs.push_back({sec(10 * i)});
+    for(int i = 0; i < count; i++)
+      intervals.push_back({i, i + 1, sec(10), sec(10)});
+  }
+
+  std::vector<bool> wanted(TimeVal now, TimeVal start = TimeVal::zero()) const
+  {
+    const auto dates = estimateSyncDates(syncs, intervals, start, now);
+    std::vector<bool> res;
+    for(const auto& itv : intervals)
+      res.push_back(lookAheadWanted(itv, syncs, dates, now, lookAhead));
+    return res;
+  }
+};
+}
+
+TEST_CASE("Without triggers, the dates are those of the score", "[unit][lookahead]")
+{
+  Chain c{3};
+  CHECK(c.wanted(sec(0)) == std::vector<bool>{true, false, false});
+  CHECK(c.wanted(sec(6)) == std::vector<bool>{true, true, false});
+
+  // Started 2 seconds into the execution
+  c.syncs[0].happened = true;
+  c.intervals[0].executing = true;
+  c.intervals[0].elapsed = sec(1);
+
+  const auto dates = estimateSyncDates(c.syncs, c.intervals, sec(2), sec(3));
+  CHECK(dates[0] == sec(2));
+  CHECK(dates[1] == sec(12));
+  CHECK(dates[2] == sec(22));
+  CHECK(dates[3] == sec(32));
+}
+
+TEST_CASE("The intervals after a trigger which waited are still wanted", "[unit][lookahead]")
+{
+  // 0 -> 10 is flexible and ends on a trigger, which is only triggered at 30
+  Chain c{3};
+  c.syncs[1].interactive = true;
+  c.intervals[0].minDuration = sec(5);
+  c.syncs[0].happened = true;
+
+  SECTION("While the trigger waits")
+  {
+    c.intervals[0].executing = true;
+    c.intervals[0].elapsed = sec(25);
+
+    const auto dates = estimateSyncDates(c.syncs, c.intervals, TimeVal::zero(), sec(25));
+    CHECK(dates[1] == sec(25));
+    CHECK(dates[2] == sec(35));
+
+    // With the dates of the score, 10 -> 20 would be over and not be created
+    CHECK(c.wanted(sec(25)) == std::vector<bool>{true, true, false});
+  }
+
+  SECTION("Once the trigger was triggered")
+  {
+    c.syncs[1].happened = true;
+    c.intervals[1].executing = true;
+    c.intervals[1].elapsed = sec(4);
+
+    const auto dates = estimateSyncDates(c.syncs, c.intervals, TimeVal::zero(), sec(34));
+    CHECK(dates[1] == sec(30));
+    CHECK(dates[2] == sec(40));
+    CHECK(dates[3] == sec(50));
+
+    CHECK(c.wanted(sec(34)) == std::vector<bool>{false, true, false});
+
+    c.intervals[1].elapsed = sec(6);
+    CHECK(c.wanted(sec(36)) == std::vector<bool>{false, true, true});
+  }
+
+  SECTION("The trigger may come as soon as the minimum duration is reached")
+  {
+    c.intervals[0].executing = true;
+    c.intervals[0].elapsed = sec(1);
+
+    const auto dates = estimateSyncDates(c.syncs, c.intervals, TimeVal::zero(), sec(1));
+    CHECK(dates[1] == sec(5));
+    CHECK(c.wanted(sec(1)) == std::vector<bool>{true, true, false});
+  }
+}
+
+TEST_CASE("Starting after the beginning skips what is before", "[unit][lookahead]")
+{
+  Chain c{6};
+
+  // Nothing happened yet: the dates are those of the score
+  CHECK(
+      c.wanted(sec(45))
+      == std::vector<bool>{false, false, false, false, true, true});
+}
+
+TEST_CASE("Finished and disposed intervals are not wanted", "[unit][lookahead]")
+{
+  Chain c{2};
+  c.syncs[0].happened = true;
+  c.syncs[1].happened = true;
+  CHECK(c.wanted(sec(9)) == std::vector<bool>{false, true});
+
+  c.intervals[1].disposed = true;
+  CHECK(c.wanted(sec(9)) == std::vector<bool>{false, false});
+}
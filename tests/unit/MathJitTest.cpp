@@ -0,0 +1,156 @@
+// Unit tests for Jit::translateMathExpression: the exprtk subset of the Math
+// audio nodes translated to C++, and the constructs which must give
+// std::nullopt so that the node keeps running the expression with exprtk.
+
+#include <MathJit/MathJit.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+
+namespace
+{
+using Nodes::MathAudioKind;
+
+// The translated expression, inside the per-sample loop of the generated function
+std::optional<std::string> body(std::string_view expr, MathAudioKind kind)
+{
+  auto src = Jit::translateMathExpression(expr, kind);
+  if(!src)
+    return std::nullopt;
+
+  static constexpr std::string_view open = "    {\n      ";
+  static constexpr std::string_view close = "\n    }\n";
+  const auto b = src->find(open);
+  REQUIRE(b != std::string::npos);
+  const auto e = src->find(close, b);
+  REQUIRE(e != std::string::npos);
+  return src->substr(b + open.size(), e - b - open.size());
+}
+
+std::optional<std::string> filter(std::string_view expr)
+{
+  return body(expr, MathAudioKind::Filter);
+}
+}
+
+TEST_CASE("Arithmetic and numbers", "[unit][mathjit]")
+{
+  // Integers become doubles
+  CHECK(filter("a + 2") == "a + 2. ; ");
+  CHECK(filter("1.5e3 * b") == "1.5e3 * b ; ");
+  CHECK(filter(".5 - c") == ".5 - c ; ");
+  CHECK(filter("sin(2 * pi * t / fs)") == "sin ( 2. * pi * t / fs ) ; ");
+}
+
+TEST_CASE("Assignments, comparisons and logic", "[unit][mathjit]")
+{
+  CHECK(filter("a := b") == "a = b ; ");
+  CHECK(filter("a += 1") == "a += 1. ; ");
+  CHECK(filter("a = b") == "a == b ; ");
+  CHECK(filter("a <> b") == "a != b ; ");
+  CHECK(filter("not(a) or b and c") == "! ( a ) || b && c ; ");
+  CHECK(filter("a & b | c") == "a && b || c ; ");
+}
+
+TEST_CASE("Vectors are indexed with a clamp", "[unit][mathjit]")
+{
+  CHECK(
+      filter("out[0] := x[0] * a")
+      == "out [score_idx( 0. )] = x [score_idx( 0. )] * a ; ");
+  CHECK(filter("m1[1] := px[1]") == "m1 [score_idx( 1. )] = px [score_idx( 1. )] ; ");
+
+  // x[] is the size of the vector
+  CHECK(filter("x[]") == "score_N ; ");
+}
+
+TEST_CASE("Local variables", "[unit][mathjit]")
+{
+  CHECK(filter("var v := 1.5; v * 2") == "double v = 1.5 ; v * 2. ; ");
+  CHECK(filter("var v; v") == "double v = 0. ; v ; ");
+}
+
+TEST_CASE("Control flow", "[unit][mathjit]")
+{
+  // The function form of if is a conditional expression
+  CHECK(
+      filter("if(x[0] > 0, 1, -1)")
+      == "(( x [score_idx( 0. )] > 0. ) ? ( 1. ) : ( - 1. )) ; ");
+
+  // The statement form is kept, with the missing semicolon before }
+  CHECK(
+      filter("if(a = 1) { out[0] := 1 }")
+      == "if ( a == 1. ) { out [score_idx( 0. )] = 1. ; } ");
+
+  CHECK(
+      filter("for(var i := 0; i < x[]; i += 1) { out[i] := x[i] }")
+      == "for ( double i = 0. ; i < score_N ; i += 1. ) "
+         "{ out [score_idx( i )] = x [score_idx( i )] ; } ");
+  CHECK(filter("while(a < 1) { a += 0.1 }") == "while ( a < 1. ) { a += 0.1 ; } ");
+}
+
+TEST_CASE("Comments are skipped", "[unit][mathjit]")
+{
+  CHECK(filter("a // comment\n+ b") == "a + b ; ");
+  CHECK(filter("a # comment\n+ b") == "a + b ; ");
+  CHECK(filter("a /* comment */ + b") == "a + b ; ");
+}
+
+TEST_CASE("The filter reads its inputs, the generator does not", "[unit][mathjit]")
+{
+  auto f = Jit::translateMathExpression("out[0] := x[0]", MathAudioKind::Filter);
+  REQUIRE(f);
+  CHECK(f->find("extern \"C\" void score_math_audio(") != std::string::npos);
+  CHECK(f->find("score_blk->in[score_c][score_i]") != std::string::npos);
+  CHECK(f->find("px[score_c] = x[score_c]") != std::string::npos);
+
+  auto g = Jit::translateMathExpression("out[0] := sin(t)", MathAudioKind::Generator);
+  REQUIRE(g);
+  CHECK(g->find("score_blk->in") == std::string::npos);
+  CHECK(g->find("score_blk->x") == std::string::npos);
+
+  // x and px are only vectors for the filters
+  CHECK_FALSE(body("x[]", MathAudioKind::Generator) == "score_N ; ");
+}
+
+TEST_CASE("Unsupported constructs fall back to exprtk", "[unit][mathjit]")
+{
+  // Empty
+  CHECK_FALSE(filter(""));
+  CHECK_FALSE(filter("  // nothing\n"));
+
+  // Operators and literals with no C++ equivalent
+  CHECK_FALSE(filter("x[0] ^ 2"));
+  CHECK_FALSE(filter("a % 2"));
+  CHECK_FALSE(filter("'text'"));
+  CHECK_FALSE(filter("a ~ b"));
+
+  // Implicit multiplication
+  CHECK_FALSE(filter("2a"));
+  CHECK_FALSE(filter("2.5.1"));
+
+  // Unterminated comment, malformed exponent
+  CHECK_FALSE(filter("a /* b"));
+  CHECK_FALSE(filter("1e+"));
+
+  // exprtk statements and functions that are not translated
+  CHECK_FALSE(filter("return [a]"));
+  CHECK_FALSE(filter("repeat a += 1 until (a > 2)"));
+  CHECK_FALSE(filter("switch { case a > 0 : 1; default : 0; }"));
+  CHECK_FALSE(filter("a xor b"));
+  CHECK_FALSE(filter("sum(x)"));
+  CHECK_FALSE(filter("swap(a, b)"));
+  CHECK_FALSE(filter("if(a, b)"));
+
+  // Vector variables, and vectors not indexed
+  CHECK_FALSE(filter("var v[3]"));
+  CHECK_FALSE(filter("out := 1"));
+  CHECK_FALSE(filter("var x := 1"));
+
+  // C++ keywords and the names of the generated code
+  CHECK_FALSE(filter("int"));
+  CHECK_FALSE(filter("var double := 1"));
+  CHECK_FALSE(filter("score_n"));
+  CHECK_FALSE(filter("__builtin_trap()"));
+  CHECK_FALSE(filter("block"));
+}
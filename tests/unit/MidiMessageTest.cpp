@@ -4,6 +4,7 @@
 
 #include <Midi/MidiNote.hpp>
 #include <Midi/MidiProcess.hpp>
+#include <Midi/NoteContainer.hpp>
 #include <Patternist/PatternParsing.hpp>
 
 #include <score/application/ApplicationComponents.hpp>
@@ -282,8 +283,10 @@ TEST_CASE("Midi note model", "[midi][model]")
 
   SECTION("Note scaling multiplies start and duration")
   {
-    Midi::Note n{Id<Midi::Note>{1}, Midi::NoteData{0.2, 0.4, 65, 80}, nullptr};
-    n.scale(0.5);
+    Midi::NoteContainer notes;
+    notes.add(Id<Midi::Note>{1}, Midi::NoteData{0.2, 0.4, 65, 80});
+    notes.scale(0.5);
+    const auto n = notes.at(Id<Midi::Note>{1});
     CHECK(n.start() == 0.1);
     CHECK(n.duration() == 0.2);
     CHECK(n.pitch() == 65);
@@ -291,34 +294,74 @@ TEST_CASE("Midi note model", "[midi][model]")
   }
 }
 
-TEST_CASE("Midi note serialization round-trip", "[midi][serialization]")
+TEST_CASE("Midi note container", "[midi]")
 {
-  testApp();
+  Midi::NoteContainer notes;
+  notes.add(Id<Midi::Note>{1}, Midi::NoteData{0.0, 0.1, 60, 100});
+  notes.add(Id<Midi::Note>{2}, Midi::NoteData{0.2, 0.1, 62, 90});
+  notes.add(Id<Midi::Note>{5}, Midi::NoteData{0.4, 0.1, 64, 80});
 
-  Midi::Note src{Id<Midi::Note>{7}, Midi::NoteData{0.25, 0.5, 61, 101}, nullptr};
+  SECTION("New ids are not in the container")
+  {
+    CHECK(notes.newId() == Id<Midi::Note>{6});
+    const auto ids = notes.newIds(2);
+    REQUIRE(ids.size() == 2);
+    CHECK(ids[0] == Id<Midi::Note>{6});
+    CHECK(ids[1] == Id<Midi::Note>{7});
+  }
 
-  SECTION("DataStream")
+  SECTION("Ids stay valid when a note is removed")
   {
-    const QByteArray arr = score::marshall<DataStream>(src);
-    Midi::Note dst{DataStream::Deserializer{arr}, nullptr};
-    CHECK(dst.id().val() == 7);
-    CHECK(dst.start() == 0.25);
-    CHECK(dst.duration() == 0.5);
-    CHECK(dst.pitch() == 61);
-    CHECK(dst.velocity() == 101);
+    struct Counter : Nano::Observer
+    {
+      int count{};
+      void on_removing(const Id<Midi::Note>&, const Midi::NoteData&) { count++; }
+    } counter;
+    notes.removing.connect<&Counter::on_removing>(&counter);
+
+    notes.remove(Id<Midi::Note>{1});
+    CHECK(counter.count == 1);
+    REQUIRE(notes.size() == 2);
+    CHECK(!notes.contains(Id<Midi::Note>{1}));
+    CHECK(notes.at(Id<Midi::Note>{2}).pitch() == 62);
+    CHECK(notes.at(Id<Midi::Note>{5}).pitch() == 64);
+
+    // Removing a note which is not there does nothing
+    notes.remove(Id<Midi::Note>{1});
+    CHECK(counter.count == 1);
+    CHECK(notes.size() == 2);
   }
 
-  SECTION("JSON")
+  SECTION("Updates only notify actual changes")
   {
-    JSONReader r;
-    r.readFrom(src);
-    const rapidjson::Document doc = readJson(r.toByteArray());
-    Midi::Note dst{JSONObject::Deserializer{doc}, nullptr};
-    CHECK(dst.id().val() == 7);
-    CHECK(dst.start() == 0.25);
-    CHECK(dst.duration() == 0.5);
-    CHECK(dst.pitch() == 61);
-    CHECK(dst.velocity() == 101);
+    struct Counter : Nano::Observer
+    {
+      int count{};
+      void on_changed(
+          const Id<Midi::Note>&, const Midi::NoteData&, const Midi::NoteData&)
+      {
+        count++;
+      }
+    } counter;
+    notes.changed.connect<&Counter::on_changed>(&counter);
+
+    notes.update(Id<Midi::Note>{2}, Midi::NoteData{0.2, 0.1, 62, 90});
+    CHECK(counter.count == 0);
+    notes.update(Id<Midi::Note>{2}, Midi::NoteData{0.3, 0.1, 67, 90});
+    CHECK(counter.count == 1);
+    CHECK(notes.at(Id<Midi::Note>{2}).start() == 0.3);
+    CHECK(notes.at(Id<Midi::Note>{2}).pitch() == 67);
+  }
+
+  SECTION("Replacing round-trips through toVector")
+  {
+    const auto saved = notes.toVector();
+    notes.clear();
+    CHECK(notes.empty());
+    notes.replace(saved);
+    REQUIRE(notes.size() == 3);
+    CHECK(notes.at(Id<Midi::Note>{5}).start() == 0.4);
+    CHECK(notes.newId() == Id<Midi::Note>{6});
   }
 }
 
@@ -330,10 +373,8 @@ TEST_CASE("Midi::ProcessModel serialization round-trip", "[midi][serialization]"
       TimeVal::fromMsecs(5000), Id<Process::ProcessModel>{123}, nullptr};
   src.setChannel(11);
   src.setRange(48, 84);
-  src.notes.add(
-      new Midi::Note{Id<Midi::Note>{0}, Midi::NoteData{0., 0.25, 36, 64}, &src});
-  src.notes.add(
-      new Midi::Note{Id<Midi::Note>{1}, Midi::NoteData{0.5, 0.5, 84, 127}, &src});
+  src.notes.add(Id<Midi::Note>{0}, Midi::NoteData{0., 0.25, 36, 64});
+  src.notes.add(Id<Midi::Note>{1}, Midi::NoteData{0.5, 0.5, 84, 127});
 
   auto checkLoaded = [&](Midi::ProcessModel& dst) {
     CHECK(dst.channel() == 11);
@@ -345,12 +386,12 @@ TEST_CASE("Midi::ProcessModel serialization round-trip", "[midi][serialization]"
     CHECK(dst.outlet->type() == Process::PortType::Midi);
 
     REQUIRE(dst.notes.size() == 2);
-    auto& n0 = dst.notes.at(Id<Midi::Note>{0});
+    const auto n0 = dst.notes.at(Id<Midi::Note>{0});
     CHECK(n0.start() == 0.);
     CHECK(n0.duration() == 0.25);
     CHECK(n0.pitch() == 36);
     CHECK(n0.velocity() == 64);
-    auto& n1 = dst.notes.at(Id<Midi::Note>{1});
+    const auto n1 = dst.notes.at(Id<Midi::Note>{1});
     CHECK(n1.start() == 0.5);
     CHECK(n1.duration() == 0.5);
     CHECK(n1.pitch() == 84);
@@ -681,22 +722,13 @@ TEST_CASE("fuzz: malformed inputs are handled gracefully", "[midi][fuzz]")
 
   SECTION("truncated DataStream note buffers throw instead of crashing")
   {
-    Midi::Note src{Id<Midi::Note>{3}, Midi::NoteData{0.1, 0.5, 60, 100}, nullptr};
-    const QByteArray arr = score::marshall<DataStream>(src);
+    const QByteArray arr
+        = score::marshall<DataStream>(Midi::NoteData{0.1, 0.5, 60, 100});
 
     ScopedIgnoreDebugBreak guard;
     for(int len = 0; len < arr.size(); len += 2)
     {
       const QByteArray cut = arr.left(len);
-      try
-      {
-        Midi::Note dst{DataStream::Deserializer{cut}, nullptr};
-      }
-      catch(const std::exception&)
-      {
-        // "Corrupt save file." from checkDelimiter is the expected failure mode
-      }
-
       const Midi::NoteData d = score::unmarshall<Midi::NoteData>(cut);
       CHECK(d.duration() >= 0.);
     }
@@ -0,0 +1,183 @@
+// Unit tests for Pd::BlockRing: the planar FIFO which adapts the buffers of
+// the graph to the fixed block size of Pd.
+
+#include <Pd/Executor/PdBlockRing.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <numeric>
+#include <vector>
+
+namespace
+{
+std::vector<float> ramp(std::size_t frames, float start)
+{
+  std::vector<float> v(frames);
+  std::iota(v.begin(), v.end(), start);
+  return v;
+}
+
+std::vector<float> read(const Pd::BlockRing& ring, std::size_t chan, std::size_t frames)
+{
+  std::vector<float> v(frames);
+  ring.read(chan, v.data(), frames);
+  return v;
+}
+}
+
+TEST_CASE("BlockRing rounds its capacity to a power of two", "[unit][pd]")
+{
+  Pd::BlockRing ring;
+  ring.reset(2, 100);
+  CHECK(ring.channels() == 2);
+  CHECK(ring.capacity() == 128);
+  CHECK(ring.size() == 0);
+
+  ring.reset(1, 0);
+  CHECK(ring.capacity() == 1);
+}
+
+TEST_CASE("BlockRing keeps the channels apart", "[unit][pd]")
+{
+  Pd::BlockRing ring;
+  ring.reset(2, 8);
+
+  const auto left = ramp(4, 1);
+  const auto right = ramp(4, -4);
+  ring.write(0, left.data(), 4);
+  ring.write(1, right.data(), 4);
+
+  // Nothing is readable before the commit
+  CHECK(ring.size() == 0);
+  ring.commit(4);
+  CHECK(ring.size() == 4);
+
+  CHECK(read(ring, 0, 4) == left);
+  CHECK(read(ring, 1, 4) == right);
+
+  ring.consume(3);
+  CHECK(ring.size() == 1);
+  CHECK(read(ring, 0, 1) == std::vector<float>{4});
+  CHECK(read(ring, 1, 1) == std::vector<float>{-1});
+}
+
+TEST_CASE("BlockRing wraps around", "[unit][pd]")
+{
+  Pd::BlockRing ring;
+  ring.reset(1, 8);
+
+  const auto first = ramp(6, 0);
+  ring.write(0, first.data(), 6);
+  ring.commit(6);
+  ring.consume(5);
+
+  // Written across the end of the storage
+  const auto second = ramp(6, 6);
+  ring.write(0, second.data(), 6);
+  ring.commit(6);
+  CHECK(ring.size() == 7);
+  CHECK(read(ring, 0, 7) == ramp(7, 5));
+
+  ring.consume(7);
+  CHECK(ring.size() == 0);
+}
+
+TEST_CASE("BlockRing reads from double buffers", "[unit][pd]")
+{
+  Pd::BlockRing ring;
+  ring.reset(1, 4);
+
+  const std::vector<double> in{0.5, 1.5, 2.5};
+  ring.write(0, in.data(), 3);
+  ring.commit(3);
+
+  std::vector<double> out(3);
+  ring.read(0, out.data(), 3);
+  CHECK(out == in);
+}
+
+TEST_CASE("BlockRing fills after the written frames", "[unit][pd]")
+{
+  Pd::BlockRing ring;
+  ring.reset(1, 8);
+
+  // As for an input with fewer samples than requested
+  const auto in = ramp(2, 1);
+  ring.write(0, in.data(), 2);
+  ring.fill(0, 2, 3, 0.f);
+  ring.commit(5);
+  CHECK(read(ring, 0, 5) == std::vector<float>{1, 2, 0, 0, 0});
+
+  // Across the end of the storage
+  ring.consume(5);
+  ring.fill(0, 0, 6, 7.f);
+  ring.commit(6);
+  CHECK(read(ring, 0, 6) == std::vector<float>(6, 7.f));
+}
+
+TEST_CASE("BlockRing prepends silence", "[unit][pd]")
+{
+  Pd::BlockRing ring;
+  ring.reset(2, 8);
+
+  const auto in = ramp(3, 1);
+  ring.write(0, in.data(), 3);
+  ring.write(1, in.data(), 3);
+  ring.commit(3);
+
+  // The read position is at the start of the storage: the silence wraps
+  ring.prepend_silence(2);
+  CHECK(ring.size() == 5);
+  CHECK(read(ring, 0, 5) == std::vector<float>{0, 0, 1, 2, 3});
+  CHECK(read(ring, 1, 5) == std::vector<float>{0, 0, 1, 2, 3});
+
+  // The next writes go after the existing frames
+  const auto more = ramp(2, 4);
+  ring.write(0, more.data(), 2);
+  ring.write(1, more.data(), 2);
+  ring.commit(2);
+  CHECK(read(ring, 0, 7) == std::vector<float>{0, 0, 1, 2, 3, 4, 5});
+}
+
+TEST_CASE("BlockRing adapts requests to blocks", "[unit][pd]")
+{
+  // Requests of 3 frames through blocks of 4, as PdGraphNode::run does
+  static constexpr std::size_t bs = 4;
+  static constexpr std::size_t req = 3;
+  Pd::BlockRing in, out;
+  in.reset(1, req + bs);
+  out.reset(1, req + 4 * bs);
+
+  std::vector<float> block(bs);
+  std::vector<float> result;
+  float next = 1;
+  for(int tick = 0; tick < 8; tick++)
+  {
+    const auto samples = ramp(req, next);
+    next += req;
+    in.write(0, samples.data(), req);
+    in.commit(req);
+
+    while(in.size() >= bs)
+    {
+      in.read(0, block.data(), bs);
+      in.consume(bs);
+      out.write(0, block.data(), bs);
+      out.commit(bs);
+    }
+
+    if(out.size() < req)
+      out.prepend_silence(bs - 1);
+
+    REQUIRE(out.size() >= req);
+    const auto o = read(out, 0, req);
+    result.insert(result.end(), o.begin(), o.end());
+    out.consume(req);
+  }
+
+  // The output is the input, delayed by one block minus one frame
+  std::vector<float> expected(bs - 1, 0.f);
+  for(float v = 1; expected.size() < result.size(); v++)
+    expected.push_back(v);
+  CHECK(result == expected);
+}
@@ -0,0 +1,274 @@
+// Unit tests for Video::ThumbnailCache: the on-disk cache of the timeline
+// thumbnails of the videos. Covers the file format, the lookups after a
+// reopen, the recovery from damaged files and the eviction of old files.
+
+#include <Video/ThumbnailCache.hpp>
+
+#include <ossia/detail/flicks.hpp>
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstring>
+
+namespace
+{
+constexpr int width = 4;
+constexpr int height = 2;
+constexpr int64_t header_size = 24;
+constexpr int64_t record_size = 8 + width * height * 3;
+
+QImage thumbnail(int seed)
+{
+  QImage img{width, height, QImage::Format_RGB888};
+  for(int y = 0; y < height; y++)
+  {
+    uchar* line = img.scanLine(y);
+    for(int x = 0; x < width * 3; x++)
+      line[x] = uchar(seed + y * width * 3 + x);
+  }
+  return img;
+}
+
+QString writeFile(const QString& path, int64_t size, const QDateTime& time = {})
+{
+  QFile f{path};
+  REQUIRE(f.open(QIODevice::WriteOnly));
+  REQUIRE(f.write(QByteArray(size, 'v')) == size);
+  f.flush();
+  if(time.isValid())
+    f.setFileTime(time, QFileDevice::FileModificationTime);
+  return path;
+}
+
+QFileInfoList cacheFiles(const QTemporaryDir& dir)
+{
+  return QDir{dir.path()}.entryInfoList({QStringLiteral("*.thumbs")}, QDir::Files);
+}
+}
+
+TEST_CASE("Thumbnails are bucketed by 100 ms", "[unit][thumbnails]")
+{
+  const int64_t ms = ossia::flicks_per_millisecond<int64_t>;
+  CHECK(Video::ThumbnailCache::bucket(-5 * ms) == 0);
+  CHECK(Video::ThumbnailCache::bucket(0) == 0);
+  CHECK(Video::ThumbnailCache::bucket(99 * ms) == 0);
+  CHECK(Video::ThumbnailCache::bucket(100 * ms) == 1);
+  CHECK(Video::ThumbnailCache::bucket(2500 * ms) == 25);
+}
+
+TEST_CASE("Thumbnails are found again after a reopen", "[unit][thumbnails]")
+{
+  QTemporaryDir dir;
+  REQUIRE(dir.isValid());
+  const auto video = writeFile(dir.filePath("video.mp4"), 1000);
+
+  {
+    Video::ThumbnailCache cache{dir.path(), video, width, height, false};
+    REQUIRE(cache.isValid());
+    CHECK(cache.find(3).isNull());
+
+    // Read back from the file, as it was appended after the mapping
+    cache.store(3, thumbnail(1));
+    CHECK(cache.find(3) == thumbnail(1));
+
+    // Only the first thumbnail of a bucket is kept
+    cache.store(3, thumbnail(2));
+    CHECK(cache.find(3) == thumbnail(1));
+  }
+
+  {
+    // Read back from the mapping
+    Video::ThumbnailCache cache{dir.path(), video, width, height, false};
+    REQUIRE(cache.isValid());
+    CHECK(cache.find(3) == thumbnail(1));
+    CHECK(cache.find(4).isNull());
+
+    cache.store(4, thumbnail(5));
+  }
+
+  Video::ThumbnailCache cache{dir.path(), video, width, height, false};
+  CHECK(cache.find(3) == thumbnail(1));
+  CHECK(cache.find(4) == thumbnail(5));
+  CHECK(cacheFiles(dir).size() == 1);
+}
+
+TEST_CASE("The file is a header followed by records", "[unit][thumbnails]")
+{
+  QTemporaryDir dir;
+  REQUIRE(dir.isValid());
+  const auto video = writeFile(dir.filePath("video.mp4"), 1000);
+  {
+    Video::ThumbnailCache cache{dir.path(), video, width, height, false};
+    cache.store(7, thumbnail(3));
+  }
+
+  const auto files = cacheFiles(dir);
+  REQUIRE(files.size() == 1);
+  QFile f{files.first().absoluteFilePath()};
+  REQUIRE(f.open(QIODevice::ReadOnly));
+  const auto data = f.readAll();
+  REQUIRE(data.size() == header_size + record_size);
+
+  const auto u32 = [&](int offset) {
+    uint32_t v{};
+    std::memcpy(&v, data.constData() + offset, sizeof(v));
+    return v;
+  };
+  const auto i64 = [&](int offset) {
+    int64_t v{};
+    std::memcpy(&v, data.constData() + offset, sizeof(v));
+    return v;
+  };
+
+  CHECK(data.left(4) == "STHC");
+  CHECK(u32(4) == 1);
+  CHECK(u32(8) == width);
+  CHECK(u32(12) == height);
+  CHECK(i64(16) == 100 * ossia::flicks_per_millisecond<int64_t>);
+
+  CHECK(i64(header_size) == 7);
+  const auto img = thumbnail(3);
+  CHECK(
+      std::memcmp(
+          data.constData() + header_size + 8, img.constScanLine(0), width * height * 3)
+      == 0);
+}
+
+TEST_CASE("Each size and mode has its own file", "[unit][thumbnails]")
+{
+  QTemporaryDir dir;
+  REQUIRE(dir.isValid());
+  const auto video = writeFile(dir.filePath("video.mp4"), 1000);
+  const auto other = writeFile(dir.filePath("other.mp4"), 2000);
+
+  Video::ThumbnailCache cache{dir.path(), video, width, height, false};
+  cache.store(1, thumbnail(1));
+
+  Video::ThumbnailCache exact{dir.path(), video, width, height, true};
+  CHECK(exact.find(1).isNull());
+
+  Video::ThumbnailCache otherVideo{dir.path(), other, width, height, false};
+  CHECK(otherVideo.find(1).isNull());
+
+  CHECK(cacheFiles(dir).size() == 3);
+
+  // The same content at another path shares the thumbnails
+  QFile::copy(video, dir.filePath("copy.mp4"));
+  Video::ThumbnailCache copy{dir.path(), dir.filePath("copy.mp4"), width, height, false};
+  CHECK(copy.find(1) == thumbnail(1));
+}
+
+TEST_CASE("Invalid thumbnails are not stored", "[unit][thumbnails]")
+{
+  QTemporaryDir dir;
+  REQUIRE(dir.isValid());
+  const auto video = writeFile(dir.filePath("video.mp4"), 1000);
+
+  Video::ThumbnailCache cache{dir.path(), video, width, height, false};
+  cache.store(1, thumbnail(1).convertToFormat(QImage::Format_RGB32));
+  cache.store(2, thumbnail(1).scaled(width * 2, height));
+  CHECK(cache.find(1).isNull());
+  CHECK(cache.find(2).isNull());
+
+  // Nothing to open, or no size
+  const auto missing = dir.filePath("missing.mp4");
+  CHECK_FALSE(Video::ThumbnailCache{dir.path(), missing, width, height, false}.isValid());
+  CHECK_FALSE(Video::ThumbnailCache{dir.path(), video, 0, height, false}.isValid());
+}
+
+TEST_CASE("Damaged files are recovered", "[unit][thumbnails]")
+{
+  QTemporaryDir dir;
+  REQUIRE(dir.isValid());
+  const auto video = writeFile(dir.filePath("video.mp4"), 1000);
+  {
+    Video::ThumbnailCache cache{dir.path(), video, width, height, false};
+    cache.store(1, thumbnail(1));
+  }
+  const auto path = cacheFiles(dir).first().absoluteFilePath();
+
+  SECTION("A record cut by a crash is dropped")
+  {
+    {
+      QFile f{path};
+      REQUIRE(f.open(QIODevice::Append));
+      f.write("partial");
+    }
+
+    Video::ThumbnailCache cache{dir.path(), video, width, height, false};
+    REQUIRE(cache.isValid());
+    CHECK(cache.find(1) == thumbnail(1));
+    CHECK(QFileInfo{path}.size() == header_size + record_size);
+  }
+
+  SECTION("A file of another version is emptied")
+  {
+    {
+      QFile f{path};
+      REQUIRE(f.open(QIODevice::ReadWrite));
+      REQUIRE(f.seek(4));
+      const uint32_t version = 1000;
+      f.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    }
+
+    Video::ThumbnailCache cache{dir.path(), video, width, height, false};
+    REQUIRE(cache.isValid());
+    CHECK(cache.find(1).isNull());
+    CHECK(QFileInfo{path}.size() == header_size);
+  }
+}
+
+TEST_CASE("The least recently used files are evicted", "[unit][thumbnails]")
+{
+  QTemporaryDir dir;
+  REQUIRE(dir.isValid());
+  const auto now = QDateTime::currentDateTime();
+  const auto oldest = writeFile(dir.filePath("a.thumbs"), 100, now.addDays(-3));
+  const auto old = writeFile(dir.filePath("b.thumbs"), 100, now.addDays(-2));
+  const auto recent = writeFile(dir.filePath("c.thumbs"), 100, now.addDays(-1));
+  const auto other = writeFile(dir.filePath("d.txt"), 1000, now.addDays(-4));
+
+  // Fits
+  Video::ThumbnailCache::evict(dir.path(), 300);
+  CHECK(cacheFiles(dir).size() == 3);
+
+  Video::ThumbnailCache::evict(dir.path(), 250, QFileInfo{oldest}.absoluteFilePath());
+  CHECK(QFile::exists(oldest));
+  CHECK_FALSE(QFile::exists(old));
+  CHECK(QFile::exists(recent));
+
+  Video::ThumbnailCache::evict(dir.path(), 100);
+  CHECK_FALSE(QFile::exists(oldest));
+  CHECK(QFile::exists(recent));
+
+  // Only the cache files are touched
+  CHECK(QFile::exists(other));
+}
+
+TEST_CASE("Opening a cache file makes it the most recent", "[unit][thumbnails]")
+{
+  QTemporaryDir dir;
+  REQUIRE(dir.isValid());
+  const auto video = writeFile(dir.filePath("video.mp4"), 1000);
+  {
+    Video::ThumbnailCache cache{dir.path(), video, width, height, false};
+    cache.store(1, thumbnail(1));
+  }
+  const auto path = cacheFiles(dir).first().absoluteFilePath();
+  {
+    QFile f{path};
+    REQUIRE(f.open(QIODevice::ReadWrite));
+    f.setFileTime(
+        QDateTime::currentDateTime().addDays(-10), QFileDevice::FileModificationTime);
+  }
+
+  Video::ThumbnailCache cache{dir.path(), video, width, height, false};
+  CHECK(cache.find(1) == thumbnail(1));
+  CHECK(QFileInfo{path}.lastModified() > QDateTime::currentDateTime().addDays(-1));
+}
@@ -0,0 +1,101 @@
+// Unit tests for Execution::wavHeader: the header of the 32-bit float .wav
+// files written when bouncing, as RIFF and past 4 GiB as RF64.
+
+#include <Execution/Bounce/AudioFileWriter.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+
+namespace
+{
+std::string tag(const unsigned char* p)
+{
+  return std::string((const char*)p, 4);
+}
+uint32_t u16(const unsigned char* p)
+{
+  return p[0] | (p[1] << 8);
+}
+uint32_t u32(const unsigned char* p)
+{
+  return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16)
+         | (uint32_t(p[3]) << 24);
+}
+uint64_t u64(const unsigned char* p)
+{
+  return u32(p) | (uint64_t(u32(p + 4)) << 32);
+}
+}
+
+TEST_CASE("A small file has a RIFF header", "[unit][bounce]")
+{
+  // 1 second of stereo at 48 kHz
+  const auto h = Execution::wavHeader(2, 48000, 48000);
+  const unsigned char* p = h.data();
+  const uint32_t data_size = 48000 * 2 * 4;
+
+  CHECK(tag(p) == "RIFF");
+  CHECK(u32(p + 4) == Execution::wavHeaderSize - 8 + data_size);
+  CHECK(tag(p + 8) == "WAVE");
+
+  // Room for a ds64 chunk
+  CHECK(tag(p + 12) == "JUNK");
+  CHECK(u32(p + 16) == 28);
+
+  CHECK(tag(p + 48) == "fmt ");
+  CHECK(u32(p + 52) == 18);
+  CHECK(u16(p + 56) == 3); // WAVE_FORMAT_IEEE_FLOAT
+  CHECK(u16(p + 58) == 2);
+  CHECK(u32(p + 60) == 48000);
+  CHECK(u32(p + 64) == 48000 * 8);
+  CHECK(u16(p + 68) == 8);
+  CHECK(u16(p + 70) == 32);
+  CHECK(u16(p + 72) == 0);
+
+  CHECK(tag(p + 74) == "fact");
+  CHECK(u32(p + 78) == 4);
+  CHECK(u32(p + 82) == 48000);
+
+  CHECK(tag(p + 86) == "data");
+  CHECK(u32(p + 90) == data_size);
+}
+
+TEST_CASE("An empty file is valid", "[unit][bounce]")
+{
+  const auto h = Execution::wavHeader(1, 44100, 0);
+  CHECK(tag(h.data()) == "RIFF");
+  CHECK(u32(h.data() + 4) == Execution::wavHeaderSize - 8);
+  CHECK(u32(h.data() + 90) == 0);
+}
+
+TEST_CASE("Past 4 GiB the header is RF64", "[unit][bounce]")
+{
+  // The largest RIFF file, and one more frame
+  const int64_t frames_max = (0xFFFFFFFFull - (Execution::wavHeaderSize - 8)) / 8;
+  CHECK(tag(Execution::wavHeader(2, 48000, frames_max).data()) == "RIFF");
+
+  const int64_t frames = frames_max + 1;
+  const uint64_t data_size = uint64_t(frames) * 8;
+  const auto h = Execution::wavHeader(2, 48000, frames);
+  const unsigned char* p = h.data();
+
+  CHECK(tag(p) == "RF64");
+  CHECK(u32(p + 4) == 0xFFFFFFFF);
+  CHECK(tag(p + 8) == "WAVE");
+
+  CHECK(tag(p + 12) == "ds64");
+  CHECK(u32(p + 16) == 28);
+  CHECK(u64(p + 20) == Execution::wavHeaderSize - 8 + data_size);
+  CHECK(u64(p + 28) == data_size);
+  CHECK(u64(p + 36) == uint64_t(frames));
+  CHECK(u32(p + 44) == 0);
+
+  // The format does not change
+  CHECK(tag(p + 48) == "fmt ");
+  CHECK(u16(p + 58) == 2);
+
+  CHECK(u32(p + 82) == 0xFFFFFFFF);
+  CHECK(tag(p + 86) == "data");
+  CHECK(u32(p + 90) == 0xFFFFFFFF);
+}